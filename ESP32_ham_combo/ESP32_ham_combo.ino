@@ -10,13 +10,15 @@ Commercial use is prohibited.
 #include "declarations.h"
 
 // --- Global Objects ---
-TFT_eSPI tft = TFT_eSPI();
+TFT_eSPI panel = TFT_eSPI();
+FrameSprite tft(&panel);
 WiFiClient telnetClient;
 Preferences preferences;
 SPIClass touchscreenSPI = SPIClass(VSPI);
-// Touchscreen pins are defined in User_Setup.h or constants.h
-XPT2046_Touchscreen touchscreen(TOUCH_CS, TOUCH_IRQ);
-WiFiClientSecure secureClient;
+// Touchscreen pins are defined in User_Setup.h or constants.h. TOUCH_IRQ is
+// left out here: touch_input.cpp owns the interrupt and reads on demand.
+XPT2046_Touchscreen touchscreen(TOUCH_CS);
+TlsClient secureClient;
 HttpClient httpClient(secureClient, PROP_HOST, HTTPS_PORT);
 AsyncWebServer webServer(80);
 
@@ -25,6 +27,8 @@ ApplicationState applicationState;
 
 // --- Initialization State Machine ---
 InitializationState initState = INIT_BEGIN;
+unsigned long wifiBeginTime = 0; // Fast boot: when WiFi.begin() was called
+bool wifiHintUsed = false;       // Fast boot: connecting straight to the access point from before sleep
 
 // --- Helper Functions ---
 
@@ -38,6 +42,12 @@ void determineAndDrawActiveScreen(ApplicationState& state) {
     targetScreen = state.display.startupScreen;
   }
 
+  showMainScreen(state, targetScreen);
+}
+
+// Makes one of the main screens the active one and draws it.
+void showMainScreen(ApplicationState& state, ActiveScreen targetScreen) {
+  CPU_BOOST_SCOPE(); // A whole screen is redrawn
   // Handle Spots Screens (Simple vs Extended)
   if (targetScreen == SCREEN_SPOTS || targetScreen == SCREEN_SPOTS_AND_PROP) {
     if (state.display.spotsViewMode == SPOTS_WITH_PROP) {
@@ -66,6 +76,15 @@ void determineAndDrawActiveScreen(ApplicationState& state) {
     case SCREEN_PROPAGATION:
       drawPropagationScreen(state);
       break;
+    case SCREEN_GREY_LINE:
+      drawGreyLineScreen(state);
+      break;
+    case SCREEN_BAND_MAP:
+      drawBandMapScreen(state);
+      break;
+    case SCREEN_SPOT_MAP:
+      drawSpotMapScreen(state);
+      break;
     default: 
       // Fallback
       state.activeScreen = SCREEN_SPOTS;
@@ -80,11 +99,27 @@ void determineAndDrawActiveScreen(ApplicationState& state) {
   }
 }
 
+// Sets the timezone and starts NTP. The clock syncs in the background.
+void configureTime(const ApplicationState& state) {
+  char fullTimezoneString[128];
+  strlcpy(fullTimezoneString, state.network.timezone, sizeof(fullTimezoneString));
+
+  // Append DST rules
+  switch (state.network.dstMode) {
+    case 1: strlcat(fullTimezoneString, ",M3.5.0,M10.5.0/3", sizeof(fullTimezoneString)); break; // EU
+    case 2: strlcat(fullTimezoneString, ",M3.2.0,M11.1.0", sizeof(fullTimezoneString)); break;   // NA
+    case 3: strlcat(fullTimezoneString, state.network.customDstRule, sizeof(fullTimezoneString)); break; // Custom
+  }
+
+  Serial.print("Using full timezone string: "); Serial.println(fullTimezoneString);
+  configTzTime(fullTimezoneString, NTP_SERVER);
+}
+
 // Starts a SoftAP and a simple web server to configure WiFi credentials.
 // This is a blocking function that never returns (device restarts after save).
 void startConfigurationPortal() {
   tft.fillScreen(TFT_BLACK);
-  tft.invertDisplay(true); // Ensure readability
+  panel.invertDisplay(true); // Ensure readability
   tft.setTextDatum(MC_DATUM);
   tft.setFreeFont(&FreeSans9pt7b);
   tft.setTextColor(TFT_WHITE, TFT_BLACK);
@@ -96,6 +131,7 @@ void startConfigurationPortal() {
   tft.drawString("ESP32-Ham-Combo-Setup", tft.width() / 2, yPos); yPos += 40;
   tft.setTextColor(TFT_WHITE);
   tft.drawString("Then open 192.168.4.1", tft.width() / 2, yPos);
+  flushFrame();
 
   WiFi.softAP("ESP32-Ham-Combo-Setup");
   IPAddress apIP(192, 168, 4, 1);
@@ -142,6 +178,7 @@ input[type=submit]{width:100%;background:#00796B;color:white;padding:10px;border
     tft.setTextColor(TFT_BLACK, TFT_GREEN);
     tft.drawString("Settings Saved!", tft.width() / 2, tft.height() / 2 - 10);
     tft.drawString("Restarting...", tft.width() / 2, tft.height() / 2 + 10);
+    flushFrame();
     delay(RESTART_DELAY_MS);
     ESP.restart();
   });
@@ -154,14 +191,17 @@ input[type=submit]{width:100%;background:#00796B;color:white;padding:10px;border
 }
 
 void enterDeepSleep(const ApplicationState& state) {
+  if (state.spotsCacheDirty) saveSpotCache(state);
+
   tft.fillScreen(TFT_BLACK);
   tft.setTextColor(TFT_WHITE, TFT_BLACK);
   tft.setTextDatum(MC_DATUM);
   tft.drawString("Entering sleep mode...", tft.width() / 2, tft.height() / 2);
+  flushFrame();
   delay(1500);
 
   setBrightness(0);
-  tft.writecommand(TFT_DISPOFF);
+  panel.writecommand(TFT_DISPOFF);
 
   // Wake up on touch screen press (IRQ pin)
   // GPIO_NUM_36 corresponds to the standard TOUCH_IRQ on many ESP32 TFT boards
@@ -185,6 +225,7 @@ void enterDeepSleep(const ApplicationState& state) {
     }
   }
 
+  saveRtcSnapshot(state);
   Serial.println("Entering deep sleep.");
   esp_deep_sleep_start();
 }
@@ -230,11 +271,25 @@ bool shouldEnterSleep(const ApplicationState& state) {
 
 void setup() {
   Serial.begin(115200);
+  configureCpuGovernor(false); // Light sleep, if wanted, comes with WiFi
 
   // Initialize Display
-  tft.init();
+  panel.init();
   loadSettings(applicationState); // Load settings early to get rotation
-  tft.setRotation(applicationState.display.screenRotation);
+  panel.setRotation(applicationState.display.screenRotation);
+  panel.fillScreen(TFT_BLACK);
+
+  // The frame follows the rotation, so it is allocated once it is known.
+  // The heap is nearly empty at this point; if even this fails, start over.
+  if (!setupFrameBuffer()) {
+    delay(RESTART_DELAY_MS);
+    ESP.restart();
+  }
+  layoutWidgets();
+  checkGlyphAtlases();
+#if GLYPH_ATLAS_BENCHMARK
+  runGlyphAtlasBenchmark();
+#endif
   tft.fillScreen(TFT_BLACK);
 
   // Check Wakeup Cause
@@ -246,7 +301,12 @@ void setup() {
   // Initialize Touchscreen
   touchscreenSPI.begin(XPT2046_CLK, XPT2046_MISO, XPT2046_MOSI, TOUCH_CS);
   touchscreen.begin(touchscreenSPI);
-  touchscreen.setRotation(applicationState.display.screenRotation);
+  startTouchInput();
+
+#if FAST_BOOT
+  // Show the last screen from cache; the network comes up behind it
+  if (startFromCache(applicationState)) return;
+#endif
 
   // Draw Splash Screen
   tft.setTextColor(TFT_YELLOW, TFT_BLACK);
@@ -276,11 +336,12 @@ void setup() {
   preferences.end();
 
   if (ssid.length() > 0) {
-    WiFi.begin(ssid.c_str(), password.c_str());
+    beginWifi(applicationState, 0, nullptr);
     tft.setTextDatum(MC_DATUM);
     tft.setFreeFont(&FreeSans9pt7b);
     tft.setTextColor(TFT_CYAN, TFT_BLACK);
     tft.drawString("Connecting to " + ssid, tft.width() / 2, applicationState.startupScreenYPos - 5);
+    flushFrame();
     
     int attempts = 0;
     while (WiFi.status() != WL_CONNECTED && attempts < WIFI_CONNECT_ATTEMPTS) {
@@ -297,6 +358,7 @@ void setup() {
 
   Serial.println("\nWiFi Connected!");
   applicationState.network.isWifiConnected = true;
+  applyPowerMode(applicationState);
   
   // Clear "Connecting..." message
   tft.fillRect(0, applicationState.startupScreenYPos - 15, tft.width(), 40, TFT_BLACK);
@@ -309,15 +371,14 @@ void setup() {
 
   updateStartupStatus("Loading settings", STATUS_IN_PROGRESS, applicationState);
   loadCalibrationData(applicationState);
-  tft.invertDisplay(applicationState.display.colorInversion); 
+  panel.invertDisplay(applicationState.display.colorInversion); 
   updateStartupStatus("Loading settings", STATUS_SUCCESS, applicationState);
 
   setupAudio(applicationState);
   setBrightness(applicationState.display.brightnessPercent);
   
   applicationState.power.lastInteractionTime = millis();
-  applicationState.lastPeriodicCheckTime = millis();
-  secureClient.setInsecure(); // Allow self-signed certs for HTTPS
+  setupHttpsClients();
 }
 
 // --- State Machines ---
@@ -333,19 +394,7 @@ void handleInitialization() {
 
     case INIT_SYNC_TIME:
       updateStartupStatus("Syncing time (NTP)", STATUS_IN_PROGRESS, applicationState);
-
-      char fullTimezoneString[128];
-      strlcpy(fullTimezoneString, applicationState.network.timezone, sizeof(fullTimezoneString));
-
-      // Append DST rules
-      switch (applicationState.network.dstMode) {
-        case 1: strlcat(fullTimezoneString, ",M3.5.0,M10.5.0/3", sizeof(fullTimezoneString)); break; // EU
-        case 2: strlcat(fullTimezoneString, ",M3.2.0,M11.1.0", sizeof(fullTimezoneString)); break;   // NA
-        case 3: strlcat(fullTimezoneString, applicationState.network.customDstRule, sizeof(fullTimezoneString)); break; // Custom
-      }
-
-      Serial.print("Using full timezone string: "); Serial.println(fullTimezoneString);
-      configTzTime(fullTimezoneString, NTP_SERVER);
+      configureTime(applicationState);
       delay(1000);
       updateStartupStatus("Syncing time (NTP)", STATUS_SUCCESS, applicationState);
 
@@ -387,6 +436,9 @@ void handleInitialization() {
 
     case INIT_FINALIZE:
       delay(1000);
+#if RENDER_BENCHMARK
+      runRenderBenchmark(applicationState);
+#endif
       // Check if we woke up during a sleep schedule
       if (isWithinScheduledSleepWindow(applicationState)) {
           applicationState.activeScreen = SCREEN_SLEEP_GRACE_PERIOD;
@@ -397,6 +449,9 @@ void handleInitialization() {
           delay(500);
           determineAndDrawActiveScreen(applicationState);
       }
+      Serial.printf("First useful frame at %lu ms.\n", millis());
+      startRuntimeTimers(applicationState);
+      startNetworkTimers(applicationState);
       initState = INIT_RUNNING;
       break;
 
@@ -405,115 +460,302 @@ void handleInitialization() {
   }
 }
 
-void handlePeriodicTasks() {
+// --- Runtime Timers ---
+
+// Checks the WiFi and HamAlert connections and closes idle HTTPS ones.
+void handlePeriodicTasks(ApplicationState& state) {
   // 1. Check WiFi Connection
   bool isCurrentlyConnected = (WiFi.status() == WL_CONNECTED);
-  if (isCurrentlyConnected != applicationState.network.isWifiConnected) {
-    applicationState.network.isWifiConnected = isCurrentlyConnected;
+  if (isCurrentlyConnected != state.network.isWifiConnected) {
+    state.network.isWifiConnected = isCurrentlyConnected;
     if (!isCurrentlyConnected) {
       Serial.println("WiFi connection lost. Attempting to reconnect...");
       telnetClient.stop();
-      applicationState.network.hamAlertConnected = false;
+      state.network.hamAlertConnected = false;
     } else {
       Serial.println("WiFi connection restored.");
     }
-    determineAndDrawActiveScreen(applicationState);
+    determineAndDrawActiveScreen(state);
   }
 
-  if (applicationState.network.isWifiConnected) {
-    // 2. Update Propagation Data
-    if (millis() - applicationState.lastPropUpdateTime > PROPAGATION_UPDATE_INTERVAL_MS) {
-      if (fetchPropagationData(applicationState)) {
-        if (applicationState.activeScreen == SCREEN_PROPAGATION || applicationState.activeScreen == SCREEN_SPOTS_AND_PROP) {
-          determineAndDrawActiveScreen(applicationState);
-        }
+  // 2. Check Telnet Connection
+  if ((state.activeScreen == SCREEN_SPOTS || state.activeScreen == SCREEN_SPOTS_AND_PROP ||
+       state.activeScreen == SCREEN_BAND_MAP || state.activeScreen == SCREEN_SPOT_MAP) &&
+      state.network.isWifiConnected) {
+    if (!telnetClient.connected() || (millis() - state.network.lastReconnectTime >= TELNET_RECONNECT_INTERVAL_MS)) {
+      telnetClient.stop();
+      clearSpots(state); 
+      state.network.hamAlertConnected = connectToTelnet(state, true);
+      if(state.network.hamAlertConnected) {
+        determineAndDrawActiveScreen(state);
       }
+      state.network.lastReconnectTime = millis();
     }
-    // 3. Check for Updates
-    if (applicationState.checkForUpdates && millis() - applicationState.lastUpdateCheckTime > UPDATE_CHECK_INTERVAL_MS) {
-      Serial.println("Periodic update check...");
-      checkGithubForUpdate(applicationState);
+  }
+
+  // 3. Release kept-alive HTTPS connections nobody reused
+  closeIdleHttpsConnections();
+}
+
+// Refreshes the propagation data, retrying sooner than usual after a failure.
+void refreshPropagation(ApplicationState& state) {
+  if (state.network.isWifiConnected && fetchPropagationData(state)) {
+    if (state.activeScreen == SCREEN_PROPAGATION || state.activeScreen == SCREEN_SPOTS_AND_PROP) {
+      determineAndDrawActiveScreen(state);
     }
+    return;
   }
+  startTimer(TIMER_PROPAGATION, refreshPropagation, PERIODIC_CHECK_INTERVAL_MS, PROPAGATION_UPDATE_INTERVAL_MS);
+}
 
-  // 4. Check Telnet Connection
-  if ((applicationState.activeScreen == SCREEN_SPOTS || applicationState.activeScreen == SCREEN_SPOTS_AND_PROP) && applicationState.network.isWifiConnected) {
-    if (!telnetClient.connected() || (millis() - applicationState.network.lastReconnectTime >= TELNET_RECONNECT_INTERVAL_MS)) {
-      telnetClient.stop();
-      clearSpots(applicationState); 
-      applicationState.network.hamAlertConnected = connectToTelnet(applicationState, true);
-      if(applicationState.network.hamAlertConnected) {
-        determineAndDrawActiveScreen(applicationState);
-      }
-      applicationState.network.lastReconnectTime = millis();
+void checkForUpdatesPeriodically(ApplicationState& state) {
+  if (state.checkForUpdates && state.network.isWifiConnected) {
+    Serial.println("Periodic update check...");
+    checkGithubForUpdate(state);
+  }
+}
+
+// Starts the sleep countdown when the inactivity timeout or the schedule says so
+void checkSleepConditions(ApplicationState& state) {
+  if (state.activeScreen == SCREEN_SLEEP_GRACE_PERIOD || state.activeScreen == SCREEN_SLEEP_SETTINGS) return;
+  if (shouldEnterSleep(state)) {
+    state.activeScreen = SCREEN_SLEEP_GRACE_PERIOD;
+    state.power.gracePeriodStartTime = millis();
+    drawGracePeriodScreen(state);
+  }
+}
+
+// Advances the solar ephemeris; band estimates and the grey-line map follow it each minute
+void advanceEphemeris(ApplicationState& state) {
+  if (updateSolarEphemeris(state)) {
+    updateBandConditions(state);
+    if (state.activeScreen == SCREEN_GREY_LINE) {
+      drawGreyLineScreen(state);
+    } else if (state.activeScreen == SCREEN_SPOTS_AND_PROP && state.bandConditionsValid) {
+      drawPropagationFooter(state);
     }
   }
 }
 
-void handleRuntime() {
-  // Handle Calibration Request from Web UI
-  if (applicationState.calibrationRequested) {
-    runTouchCalibration(applicationState);
-    applicationState.calibrationRequested = false;
-    return;
+void pollTelnet(ApplicationState& state) {
+  // Not while a fast boot's startup task is still logging in
+  if (state.network.isWifiConnected && state.network.hamAlertConnected && telnetClient.connected()) {
+    readTelnetSpots();
   }
+  processQueuedSpots(state);
+}
 
-  // Run Periodic Tasks
-  if (millis() - applicationState.lastPeriodicCheckTime > PERIODIC_CHECK_INTERVAL_MS) {
-    applicationState.lastPeriodicCheckTime = millis();
-    handlePeriodicTasks();
+// Updates the elapsed times on the spot list, or ages out old band map spots
+void ageSpots(ApplicationState& state) {
+  if (state.activeScreen == SCREEN_BAND_MAP) {
+    refreshBandMap(state);
+  } else {
+    updateSpotTimesOnly(state);
   }
+}
 
-  // Check Sleep Conditions (unless already in grace period or settings)
-  if (applicationState.activeScreen != SCREEN_SLEEP_GRACE_PERIOD && applicationState.activeScreen != SCREEN_SLEEP_SETTINGS) {
-    if (shouldEnterSleep(applicationState)) {
-      applicationState.activeScreen = SCREEN_SLEEP_GRACE_PERIOD;
-      applicationState.power.gracePeriodStartTime = millis();
-      drawGracePeriodScreen(applicationState);
+// Redraws the clock, then sleeps until the next second, or the next dot
+// step when the dot sweeps. Aiming at the boundary keeps the display in
+// step with the wall clock without polling.
+void tickClock(ApplicationState& state) {
+  drawClockScreen(state);
+  const unsigned long stepMs = state.display.secondDotSweep ? CLOCK_SWEEP_TICK_MS : CLOCK_TICK_MS;
+  struct timeval timeOfDay;
+  gettimeofday(&timeOfDay, nullptr);
+  startTimer(TIMER_CLOCK_TICK, tickClock, stepMs - (timeOfDay.tv_usec / 1000) % stepMs);
+}
+
+void countDownToSleep(ApplicationState& state) {
+  unsigned long elapsed = millis() - state.power.gracePeriodStartTime;
+  if (elapsed >= SLEEP_GRACE_PERIOD_MS) {
+    enterDeepSleep(state);
+    return;
+  }
+  int secondsLeft = (SLEEP_GRACE_PERIOD_MS - elapsed + 500) / 1000;
+  tft.setTextDatum(MC_DATUM);
+  tft.setFreeFont(&FreeSansBold12pt7b);
+  tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+  tft.fillRect(0, tft.height() / 2 + GRACE_PERIOD_TIMER_Y_OFFSET, tft.width(), GRACE_PERIOD_TIMER_HEIGHT, TFT_BLACK);
+  tft.drawString(String(secondsLeft) + "s to sleep", tft.width() / 2, tft.height() / 2 + GRACE_PERIOD_TIMER_TEXT_Y_OFFSET);
+}
+
+#if ENABLE_PROFILER && PROFILER_OVERLAY
+void showProfilerOverlay(ApplicationState& state) {
+  drawProfilerOverlay();
+}
+#endif
+
+// Writes the spots to flash for the next boot if new ones came in.
+void saveCachedSpots(ApplicationState& state) {
+  if (!state.spotsCacheDirty) return;
+  saveSpotCache(state);
+  state.spotsCacheDirty = false;
+}
+
+// The timers that run whatever the screen and need no network.
+void startRuntimeTimers(ApplicationState& state) {
+  startTimer(TIMER_SLEEP_CHECK, checkSleepConditions, SLEEP_CHECK_INTERVAL_MS, SLEEP_CHECK_INTERVAL_MS);
+  startTimer(TIMER_EPHEMERIS, advanceEphemeris, 0, EPHEMERIS_CHECK_INTERVAL_MS);
+  startTimer(TIMER_SPOT_CACHE, saveCachedSpots, SPOT_CACHE_SAVE_INTERVAL_MS, SPOT_CACHE_SAVE_INTERVAL_MS);
+#if ENABLE_PROFILER && PROFILER_OVERLAY
+  startTimer(TIMER_PROFILER_OVERLAY, showProfilerOverlay, PROFILER_OVERLAY_INTERVAL_MS, PROFILER_OVERLAY_INTERVAL_MS);
+#endif
+}
+
+// Milliseconds until the solar data is due for a refresh, 0 if it is due now.
+unsigned long getPropagationRefreshDelay(const ApplicationState& state) {
+  if (!state.propDataAvailable || state.propDataTime == 0) return 0;
+  const time_t age = time(nullptr) - state.propDataTime;
+  if (age < 0 || (unsigned long)age >= PROPAGATION_UPDATE_INTERVAL_MS / 1000) return 0;
+  return PROPAGATION_UPDATE_INTERVAL_MS - age * 1000UL;
+}
+
+// The timers that keep the connections and network data fresh. The startup
+// sequence has just checked for updates and fetched the propagation data,
+// or found it fresh; if that failed, the fetch is retried soon.
+void startNetworkTimers(ApplicationState& state) {
+  const unsigned long propagationDelay = getPropagationRefreshDelay(state);
+  startTimer(TIMER_CONNECTION_CHECK, handlePeriodicTasks, PERIODIC_CHECK_INTERVAL_MS, PERIODIC_CHECK_INTERVAL_MS);
+  startTimer(TIMER_PROPAGATION, refreshPropagation, propagationDelay > 0 ? propagationDelay : PERIODIC_CHECK_INTERVAL_MS,
+             PROPAGATION_UPDATE_INTERVAL_MS);
+  startTimer(TIMER_UPDATE_CHECK, checkForUpdatesPeriodically, UPDATE_CHECK_INTERVAL_MS, UPDATE_CHECK_INTERVAL_MS);
+}
+
+// --- Fast Boot ---
+
+// Waits for WiFi, then starts the network half of startup and applies its
+// results as they come in. Hands over to the network timers once done.
+void advanceStartup(ApplicationState& state) {
+  if (!state.network.isWifiConnected) {
+    if (WiFi.status() != WL_CONNECTED) {
+      if (wifiHintUsed && millis() - wifiBeginTime >= WIFI_HINT_TIMEOUT_MS) {
+        // The access point may have moved to another channel: scan after all
+        Serial.println("No WiFi on the channel from before sleep. Scanning.");
+        WiFi.disconnect();
+        beginWifi(state, 0, nullptr);
+      } else if (millis() - wifiBeginTime >= WIFI_CONNECT_ATTEMPTS * WIFI_CONNECT_DELAY_MS) {
+        Serial.println("Could not connect to WiFi. Starting Configuration Portal.");
+        startConfigurationPortal();
+      }
       return;
     }
+    Serial.printf("WiFi connected at %lu ms, IP %s.\n", millis(), WiFi.localIP().toString().c_str());
+    state.network.isWifiConnected = true;
+    applyPowerMode(state);
+    // Not earlier: the configuration portal registers its own pages
+    setupWebServer(state);
+    startStartupSteps(state, getPropagationRefreshDelay(state) == 0,
+                      state.checkForUpdates &&
+                      (millis() - state.lastUpdateCheckTime > UPDATE_CHECK_INTERVAL_MS || state.lastUpdateCheckTime == 0));
   }
 
-  // Screen-Specific Logic
-  switch (applicationState.activeScreen) {
-    case SCREEN_SPOTS:
-    case SCREEN_SPOTS_AND_PROP:
-      if (applicationState.network.isWifiConnected && telnetClient.connected()) {
-        readTelnetSpots(applicationState);
-      }
-      if (millis() - applicationState.lastDisplayUpdateTime >= SPOT_LIST_UPDATE_INTERVAL_MS) {
-        updateSpotTimesOnly(applicationState);
-      }
-      break;
+  if (!finishStartupSteps(state)) return;
+  Serial.printf("Startup finished at %lu ms.\n", millis());
+  stopTimer(TIMER_STARTUP);
+  startNetworkTimers(state);
+}
 
-    case SCREEN_CLOCK:
-      if (millis() - applicationState.lastClockUpdateTime >= 1000) {
-        drawClockScreen(applicationState);
-        applicationState.lastClockUpdateTime = millis();
-      }
-      break;
+// Starts connecting with the saved credentials. A channel and BSSID, from
+// before a deep sleep, let the connection skip the scan. Returns false if
+// there are no credentials.
+bool beginWifi(const ApplicationState& state, uint8_t channel, const uint8_t* bssid) {
+  preferences.begin("wifi-creds", true);
+  String ssid = preferences.getString("ssid", "");
+  String password = preferences.getString("password", "");
+  preferences.end();
+  if (ssid.length() == 0) return false;
+
+  wifiHintUsed = channel > 0;
+  if (state.power.lowPowerMode) beginLowPowerWifi(state, ssid.c_str(), password.c_str(), channel, bssid);
+  else if (wifiHintUsed) WiFi.begin(ssid.c_str(), password.c_str(), channel, bssid);
+  else WiFi.begin(ssid.c_str(), password.c_str());
+  wifiBeginTime = millis();
+  return true;
+}
 
-    case SCREEN_SLEEP_GRACE_PERIOD:
-      {
-        unsigned long elapsed = millis() - applicationState.power.gracePeriodStartTime;
-        if (elapsed >= SLEEP_GRACE_PERIOD_MS) {
-          enterDeepSleep(applicationState);
-        } else {
-          // Update countdown every second
-          if ((elapsed / 1000) != ((elapsed - 100) / 1000)) {
-             int secondsLeft = (SLEEP_GRACE_PERIOD_MS - elapsed) / 1000;
-             tft.setTextDatum(MC_DATUM);
-             tft.setFreeFont(&FreeSansBold12pt7b);
-             tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-             tft.fillRect(0, tft.height() / 2 + GRACE_PERIOD_TIMER_Y_OFFSET, tft.width(), GRACE_PERIOD_TIMER_HEIGHT, TFT_BLACK);
-             tft.drawString(String(secondsLeft) + "s to sleep", tft.width() / 2, tft.height() / 2 + GRACE_PERIOD_TIMER_TEXT_Y_OFFSET);
-          }
-        }
-      }
-      break;
+// Draws the last used screen from the spots and solar data cached in flash,
+// or on a wake-up from deep sleep from the RTC snapshot taken before it,
+// then leaves WiFi, NTP and the network steps to advanceStartup(). Returns
+// false, for the full startup, when there are no WiFi credentials.
+bool startFromCache(ApplicationState& state) {
+  const esp_sleep_wakeup_cause_t wakeupReason = esp_sleep_get_wakeup_cause();
+  uint8_t wifiChannel = 0;
+  uint8_t wifiBssid[6];
+  const bool resumed = (wakeupReason == ESP_SLEEP_WAKEUP_EXT0 || wakeupReason == ESP_SLEEP_WAKEUP_TIMER) &&
+                       restoreRtcSnapshot(state, wifiChannel, wifiBssid);
+  if (!beginWifi(state, wifiChannel, wifiBssid)) return false;
+  configureTime(state); // After a wake-up the clock is still running
+
+  loadCalibrationData(state);
+  panel.invertDisplay(state.display.colorInversion);
+  setupAudio(state);
+  setBrightness(state.display.brightnessPercent);
+  state.power.lastInteractionTime = millis();
+  setupHttpsClients();
+  if (!resumed) loadDataCache(state);
+  if (updateSolarEphemeris(state)) updateBandConditions(state);
+
+  state.network.isWifiConnected = false;
+  state.network.starting = true;
+  if (isWithinScheduledSleepWindow(state)) {
+    state.activeScreen = SCREEN_SLEEP_GRACE_PERIOD;
+    state.power.gracePeriodStartTime = millis();
+    drawGracePeriodScreen(state);
+  } else if (resumed) {
+    showMainScreen(state, state.lastMainScreen);
+  } else {
+    determineAndDrawActiveScreen(state);
+  }
+  flushFrame();
+  Serial.printf("First useful frame at %lu ms (from %s).\n", millis(), resumed ? "RTC snapshot" : "cache");
 
-    default:
-      break;
+  startRuntimeTimers(state);
+  startTimer(TIMER_STARTUP, advanceStartup, WIFI_CONNECT_DELAY_MS, WIFI_CONNECT_DELAY_MS);
+  initState = INIT_RUNNING;
+  return true;
+}
+
+// Runs timer while the active screen needs it. A timer that is already
+// running keeps its phase, so moving between screens that share it does
+// not restart it.
+void keepTimerFor(bool needed, TimerId id, TimerCallback callback, unsigned long periodMs) {
+  if (!needed) stopTimer(id);
+  else if (!isTimerRunning(id)) startTimer(id, callback, periodMs, periodMs);
+}
+
+// Starts and stops the timers that only some screens use.
+void updateScreenTimers(const ApplicationState& state) {
+  const ActiveScreen screen = state.activeScreen;
+  const bool spotList = (screen == SCREEN_SPOTS || screen == SCREEN_SPOTS_AND_PROP);
+  keepTimerFor(spotList || screen == SCREEN_BAND_MAP || screen == SCREEN_SPOT_MAP, TIMER_TELNET_POLL, pollTelnet, getTelnetPollInterval(state));
+  keepTimerFor(spotList || screen == SCREEN_BAND_MAP, TIMER_SPOT_AGING, ageSpots, SPOT_LIST_UPDATE_INTERVAL_MS);
+  keepTimerFor(screen == SCREEN_CLOCK, TIMER_CLOCK_TICK, tickClock, 0); // Draws now, then schedules itself
+  keepTimerFor(screen == SCREEN_SLEEP_GRACE_PERIOD, TIMER_GRACE_COUNTDOWN, countDownToSleep, GRACE_COUNTDOWN_INTERVAL_MS);
+}
+
+bool isMainScreen(ActiveScreen screen) {
+  return screen == SCREEN_SPOTS || screen == SCREEN_SPOTS_AND_PROP || screen == SCREEN_BAND_MAP || screen == SCREEN_SPOT_MAP ||
+         screen == SCREEN_PROPAGATION || screen == SCREEN_GREY_LINE || screen == SCREEN_CLOCK;
+}
+
+void handleRuntime() {
+  // Handle Calibration Request from Web UI
+  if (applicationState.calibrationRequested) {
+    runTouchCalibration(applicationState);
+    applicationState.calibrationRequested = false;
+    return;
+  }
+
+  // On every pass, so the statistics cost no wake-up of their own
+  samplePowerStats(applicationState);
+  runDueTimers(applicationState);
+
+  // Touches and timers may have changed the screen since the last pass
+  static int timedScreen = -1;
+  if (applicationState.activeScreen != timedScreen) {
+    timedScreen = applicationState.activeScreen;
+    updateScreenTimers(applicationState);
+    if (isMainScreen(applicationState.activeScreen)) applicationState.lastMainScreen = applicationState.activeScreen;
   }
 }
 
@@ -521,10 +763,15 @@ void handleRuntime() {
 
 void loop() {
   handleTouch(applicationState);
+  flushFrame(); // Show the touch response before anything below blocks
 
   if (initState != INIT_RUNNING) {
     handleInitialization();
-  } else {
-    handleRuntime();
+    flushFrame();
+    return;
   }
+
+  handleRuntime();
+  flushFrame();
+  waitForTimerOrInput(); // Until the next timer, a touch or a web request
 }
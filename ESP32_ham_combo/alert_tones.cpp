@@ -0,0 +1,340 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include "driver/dac_continuous.h"
+#include "esp_pm.h"
+#include <math.h>
+#include <mutex>
+
+// Alert tones, synthesized without holding up loop(). An alert is turned
+// into a sequence of tones and pauses, which an audio task renders from a
+// sine wavetable into blocks of 8-bit samples. The blocks are streamed by
+// DMA to the DAC on AUDIO_OUT_PIN, two buffers deep, so one block plays
+// while the next is rendered. Every tone rises and falls over
+// AUDIO_RAMP_MS, and the output eases onto its mid-scale bias at the start
+// of a stream and off it at the end, so nothing clicks. A change of volume
+// while a tone plays ramps the same way. A block costs the
+// same whatever it plays, and with the profiler on its render time is
+// reported at /profile against the block's length in playback time.
+//
+// Each mode has its own pattern, a watchlist hit a longer one, and the DX
+// callsign can follow in CW. Only one alert waits behind the one playing:
+// a burst of spots, such as the backfill after a login, leaves the most
+// important of them (the newest if they are equal) to play next.
+
+namespace {
+  struct ToneStep {
+    uint16_t freqHz; // 0 for a pause
+    uint16_t ms;
+  };
+
+  // Higher kinds win when alerts are coalesced
+  enum AlertKind : uint8_t {
+    ALERT_NONE,
+    ALERT_PLAIN,
+    ALERT_DIGITAL,
+    ALERT_CW,
+    ALERT_WATCHLIST
+  };
+
+  const int32_t FULL_SCALE = 32767;                 // Q15 gains
+  const int32_t AUDIO_BIAS = 128;                   // DAC mid-scale
+  const int32_t RAMP_SAMPLES = AUDIO_SAMPLE_RATE_HZ / 1000 * AUDIO_RAMP_MS;
+  const int32_t ENVELOPE_STEP = (FULL_SCALE + RAMP_SAMPLES - 1) / RAMP_SAMPLES; // Rounded up: a ramp is RAMP_SAMPLES long
+  const uint32_t DRAIN_MS = 2 * AUDIO_BLOCK_SAMPLES * 1000 / AUDIO_SAMPLE_RATE_HZ + 1; // Both DMA buffers
+
+  std::mutex toneMutex; // Between loop() and the audio task
+  TaskHandle_t audioTask = nullptr;
+  dac_continuous_handle_t dacHandle = nullptr;
+  esp_pm_lock_handle_t awakeLock = nullptr; // DMA does not run in light sleep
+  int8_t wavetable[256];
+
+  // Copied from the settings by setupAudio()
+  int32_t gainTarget = 0; // Q15, 0 when muted
+  uint16_t baseFreqHz = 0;
+  uint16_t baseMs = 0;
+  uint16_t ditMs = 0;
+
+  ToneStep steps[TONE_SEQUENCE_MAX_STEPS];
+  int stepCount = 0;
+  int nextStep = 0;
+  bool playing = false; // From queueing an alert until its release has faded
+
+  AlertKind pendingKind = ALERT_NONE;
+  char pendingCall[sizeof(DxSpot::call)] = "";
+
+  // The voice, rendered by the audio task
+  uint32_t phase = 0;        // Top 8 bits index the wavetable
+  uint32_t phaseStep = 0;
+  int32_t envelope = 0;      // Q15
+  int32_t envelopeTarget = 0;
+  int32_t gain = 0;          // Q15, follows gainTarget like the envelope
+  uint32_t stepSamplesLeft = 0;
+
+  // Perceived loudness follows amplitude roughly as a square law, so the
+  // percent steps are squared to sound even.
+  int32_t getVolumeGain(int volumePercent) {
+    volumePercent = constrain(volumePercent, 0, 100);
+    return volumePercent * volumePercent * FULL_SCALE / 10000;
+  }
+
+  const char* getMorseCode(char c) {
+    static const char* const letters[] = {
+      ".-", "-...", "-.-.", "-..", ".", "..-.", "--.", "....", "..", ".---", "-.-", ".-..", "--",
+      "-.", "---", ".--.", "--.-", ".-.", "...", "-", "..-", "...-", ".--", "-..-", "-.--", "--.."
+    };
+    static const char* const digits[] = {
+      "-----", ".----", "..---", "...--", "....-", ".....", "-....", "--...", "---..", "----."
+    };
+    c = toupper(c);
+    if (c >= 'A' && c <= 'Z') return letters[c - 'A'];
+    if (c >= '0' && c <= '9') return digits[c - '0'];
+    if (c == '/') return "-..-.";
+    return nullptr;
+  }
+
+  // Appends a step, merging pauses. Returns false once the sequence is full.
+  bool addStep(uint16_t freqHz, uint16_t ms) {
+    if (freqHz == 0 && stepCount > 0 && steps[stepCount - 1].freqHz == 0) {
+      steps[stepCount - 1].ms += ms;
+      return true;
+    }
+    if (stepCount >= TONE_SEQUENCE_MAX_STEPS) return false;
+    steps[stepCount++] = {freqHz, ms};
+    return true;
+  }
+
+  // Standard timing: a dah is three dits, elements are a dit apart,
+  // characters three dits.
+  void addMorse(const char* call) {
+    addStep(0, ditMs * 3);
+    for (const char* c = call; *c; c++) {
+      const char* code = getMorseCode(*c);
+      if (!code) continue;
+      for (const char* element = code; *element; element++) {
+        if (!addStep(baseFreqHz, *element == '-' ? ditMs * 3 : ditMs)) return;
+        addStep(0, ditMs);
+      }
+      addStep(0, ditMs * 2);
+    }
+  }
+
+  void buildSequence(AlertKind kind, const char* call) {
+    stepCount = 0;
+    nextStep = 0;
+    const uint16_t f = baseFreqHz;
+    switch (kind) {
+      case ALERT_DIGITAL: // Rising fifth
+        addStep(f, baseMs);
+        addStep(f * 3 / 2, baseMs);
+        break;
+      case ALERT_CW: // Two short tones
+        addStep(f, baseMs / 2);
+        addStep(0, baseMs / 2);
+        addStep(f, baseMs / 2);
+        break;
+      case ALERT_WATCHLIST: // Rising major triad, the top held
+        addStep(f, baseMs);
+        addStep(f * 5 / 4, baseMs);
+        addStep(f * 3 / 2, baseMs * 2);
+        break;
+      default:
+        addStep(f, baseMs);
+        break;
+    }
+    if (call[0] && ditMs > 0) addMorse(call);
+    addStep(0, TONE_ALERT_GAP_MS);
+  }
+
+  // Moves the voice on to the next step, or to the pending alert once the
+  // sequence is done. Returns false if there is nothing left to play.
+  // Called with toneMutex held.
+  bool startNextStep() {
+    if (nextStep >= stepCount) {
+      if (pendingKind == ALERT_NONE) return false;
+      buildSequence(pendingKind, pendingCall);
+      pendingKind = ALERT_NONE;
+    }
+    const ToneStep& step = steps[nextStep++];
+    // A pause keeps the pitch, so the release fades the tone before it
+    if (step.freqHz > 0) phaseStep = (uint32_t)(((uint64_t)step.freqHz << 32) / AUDIO_SAMPLE_RATE_HZ);
+    envelopeTarget = step.freqHz > 0 ? FULL_SCALE : 0;
+    stepSamplesLeft = (uint32_t)step.ms * AUDIO_SAMPLE_RATE_HZ / 1000;
+    return true;
+  }
+
+  // One sample's move of a ramp: a full-scale change takes RAMP_SAMPLES.
+  int32_t rampToward(int32_t value, int32_t target) {
+    if (value < target) return min(value + ENVELOPE_STEP, target);
+    return max(value - ENVELOPE_STEP, target);
+  }
+
+  // Advances the voice by one sample. Called with toneMutex held.
+  uint8_t renderSample() {
+    while (stepSamplesLeft == 0 && playing) {
+      if (!startNextStep()) {
+        envelopeTarget = 0;
+        if (envelope == 0) playing = false;
+        else stepSamplesLeft = 1; // Let the release finish
+      }
+    }
+    if (stepSamplesLeft > 0) stepSamplesLeft--;
+
+    envelope = rampToward(envelope, envelopeTarget);
+    gain = rampToward(gain, gainTarget);
+
+    const int32_t amplitude = envelope * gain >> 15;
+    const uint8_t sample = AUDIO_BIAS + (wavetable[phase >> 24] * amplitude >> 15);
+    phase += phaseStep;
+    return sample;
+  }
+
+  // Renders one block. Returns false once the last alert has faded out.
+  // Called with toneMutex held.
+  bool renderBlock(uint8_t* block) {
+    for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) block[i] = renderSample();
+    return playing;
+  }
+
+  // A block that moves the output between 0 and the bias.
+  void renderBiasRamp(uint8_t* block, bool up) {
+    for (int i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+      const int32_t level = AUDIO_BIAS * i / AUDIO_BLOCK_SAMPLES;
+      block[i] = up ? level : AUDIO_BIAS - level;
+    }
+  }
+
+  void writeBlock(uint8_t* block) {
+    dac_continuous_write(dacHandle, block, AUDIO_BLOCK_SAMPLES, nullptr, -1);
+  }
+
+  // Sleeps until an alert is queued, then streams until it has played.
+  void audioTaskMain(void*) {
+    static uint8_t block[AUDIO_BLOCK_SAMPLES];
+    for (;;) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      if (awakeLock) esp_pm_lock_acquire(awakeLock);
+      dac_continuous_enable(dacHandle);
+      renderBiasRamp(block, true);
+      writeBlock(block);
+
+      bool more = true;
+      while (more) {
+        {
+          PROFILE_SCOPE(PROF_AUDIO_BLOCK);
+          std::lock_guard<std::mutex> guard(toneMutex);
+          more = renderBlock(block);
+        }
+        writeBlock(block);
+      }
+
+      renderBiasRamp(block, false);
+      writeBlock(block);
+      // A write returns once its block is queued, not once it has played.
+      // One more block at the level the ramp ends on pushes the ramp into
+      // the DMA, and waiting out both buffers lets it play before the DAC
+      // is switched off.
+      memset(block, 0, sizeof(block));
+      writeBlock(block);
+      vTaskDelay(pdMS_TO_TICKS(DRAIN_MS));
+      dac_continuous_disable(dacHandle);
+      if (awakeLock) esp_pm_lock_release(awakeLock);
+    }
+  }
+
+  bool startAudio() {
+    for (int i = 0; i < 256; i++) {
+      wavetable[i] = (int8_t)lroundf(127.0f * sinf(2.0f * (float)M_PI * i / 256));
+    }
+
+    dac_continuous_config_t config = {};
+    config.chan_mask = DAC_CHANNEL_MASK_CH1; // GPIO 26, AUDIO_OUT_PIN
+    config.desc_num = 2;                     // Double-buffered
+    config.buf_size = AUDIO_BLOCK_SAMPLES;
+    config.freq_hz = AUDIO_SAMPLE_RATE_HZ;
+    config.offset = 0;
+    config.clk_src = DAC_DIGI_CLK_SRC_DEFAULT;
+    config.chan_mode = DAC_CHANNEL_MODE_SIMUL;
+    const esp_err_t result = dac_continuous_new_channels(&config, &dacHandle);
+    if (result != ESP_OK) {
+      Serial.printf("Failed to create DAC DMA channel: %s\n", esp_err_to_name(result));
+      dacHandle = nullptr;
+      return false;
+    }
+    esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "tones", &awakeLock);
+    xTaskCreatePinnedToCore(audioTaskMain, "audio", AUDIO_TASK_STACK_SIZE, nullptr, AUDIO_TASK_PRIORITY, &audioTask, ARDUINO_RUNNING_CORE);
+    return true;
+  }
+
+  void queueAlert(AlertKind kind, const char* call) {
+    std::lock_guard<std::mutex> guard(toneMutex);
+    if (gainTarget == 0 || !audioTask) return; // Muted
+    if (!playing) {
+      gain = gainTarget;
+      buildSequence(kind, call);
+      playing = true;
+      xTaskNotifyGive(audioTask);
+    } else if (kind >= pendingKind) {
+      pendingKind = kind;
+      strlcpy(pendingCall, call, sizeof(pendingCall));
+    }
+  }
+
+  // The watchlist is a comma or space separated list of callsigns; an entry
+  // ending in '*' matches every callsign starting with the rest.
+  bool isOnWatchlist(const char* watchlist, const char* call) {
+    const char* entry = watchlist;
+    while (*entry) {
+      while (*entry == ',' || *entry == ' ') entry++;
+      size_t length = strcspn(entry, ", ");
+      if (length == 0) break;
+      const bool prefix = entry[length - 1] == '*';
+      const size_t compared = prefix ? length - 1 : length;
+      if (strncasecmp(entry, call, compared) == 0 && (prefix || call[compared] == '\0')) return true;
+      entry += length;
+    }
+    return false;
+  }
+}
+
+// Takes over the audio settings. Whatever is playing fades out, and its
+// volume ramps to the new one.
+void setupAudio(const ApplicationState& state) {
+  if (!dacHandle && !startAudio()) return;
+  std::lock_guard<std::mutex> guard(toneMutex);
+  stepCount = 0;
+  nextStep = 0;
+  stepSamplesLeft = 0;
+  pendingKind = ALERT_NONE;
+
+  gainTarget = getVolumeGain(state.audio.volumePercent);
+  if (!playing) gain = gainTarget;
+  baseFreqHz = state.audio.toneFrequency;
+  baseMs = state.audio.toneDurationMs;
+  ditMs = state.audio.cwCalls != CW_CALLS_OFF ? 1200 / max(state.audio.cwWpm, 5) : 0;
+}
+
+// A single tone, as for a test of the settings.
+void playNewSpotSound(const ApplicationState& state) {
+  queueAlert(ALERT_PLAIN, "");
+}
+
+// The alert for a new spot: a pattern for its mode or a watchlist hit,
+// followed by the callsign in CW if the settings ask for it.
+void playSpotAlert(const ApplicationState& state, const DxSpot& spot) {
+  const bool watched = isOnWatchlist(state.audio.watchlist, spot.call);
+  AlertKind kind = ALERT_PLAIN;
+  if (watched) kind = ALERT_WATCHLIST;
+  else if (strcmp(spot.mode, "CW") == 0) kind = ALERT_CW;
+  else if (strcmp(spot.mode, "FT8") == 0 || strcmp(spot.mode, "FT4") == 0) kind = ALERT_DIGITAL;
+
+  const bool sendCall = state.audio.cwCalls == CW_CALLS_ALL || (state.audio.cwCalls == CW_CALLS_WATCHLIST && watched);
+  queueAlert(kind, sendCall ? spot.call : "");
+}
@@ -0,0 +1,177 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+// Per-band propagation estimate. Each band gets a score made of four table
+// reads - solar flux, time of day at the QTH, season and a geomagnetic
+// penalty - and the score maps to GOOD/FAIR/POOR. The tables are a rule of
+// thumb for a mid-latitude station, not a propagation model.
+
+namespace {
+  struct BandRange {
+    const char* label;
+    uint16_t startKHz;
+    uint16_t endKHz;
+  };
+
+  const BandRange BANDS[BAND_COUNT] = {
+    {"160", 1800, 2000}, {"80", 3500, 4000}, {"60", 5250, 5450}, {"40", 7000, 7300},
+    {"30", 10100, 10150}, {"20", 14000, 14350}, {"17", 18068, 18168}, {"15", 21000, 21450},
+    {"12", 24890, 24990}, {"10", 28000, 29700}, {"6", 50000, 54000}
+  };
+
+  enum SunPhase { PHASE_NIGHT, PHASE_GREYLINE, PHASE_DAY, PHASE_COUNT };
+  enum Season { SEASON_WINTER, SEASON_EQUINOX, SEASON_SUMMER, SEASON_COUNT };
+
+  const int SFI_BUCKETS = 5; // <80, 80-99, 100-129, 130-169, >=170
+  const int K_BUCKETS = 4;   // 0-2, 3-4, 5-6, 7-9
+
+  const int8_t SFI_SCORE[BAND_COUNT][SFI_BUCKETS] = {
+    { 1,  1,  1,  1,  1}, // 160m
+    { 2,  2,  2,  2,  2}, // 80m
+    { 2,  2,  2,  2,  2}, // 60m
+    { 2,  2,  3,  3,  3}, // 40m
+    { 1,  2,  2,  3,  3}, // 30m
+    { 0,  1,  2,  3,  3}, // 20m
+    {-1,  0,  1,  2,  3}, // 17m
+    {-2, -1,  1,  2,  3}, // 15m
+    {-3, -2,  0,  1,  3}, // 12m
+    {-4, -3, -1,  1,  2}, // 10m
+    {-6, -5, -4, -2, -1}  // 6m
+  };
+
+  // Low bands suffer D-layer absorption by day; high bands need a sunlit path.
+  const int8_t PHASE_SCORE[BAND_COUNT][PHASE_COUNT] = {
+    { 2,  2, -4}, // 160m
+    { 1,  2, -2}, // 80m
+    { 1,  1, -1}, // 60m
+    { 1,  1,  0}, // 40m
+    { 1,  1,  0}, // 30m
+    {-2,  1,  1}, // 20m
+    {-3,  0,  1}, // 17m
+    {-4,  0,  1}, // 15m
+    {-5, -1,  1}, // 12m
+    {-5, -1,  1}, // 10m
+    {-2,  0,  0}  // 6m
+  };
+
+  // Summer static hurts the low bands, equinoxes favour the high bands and
+  // 6m depends on summer sporadic-E.
+  const int8_t SEASON_SCORE[BAND_COUNT][SEASON_COUNT] = {
+    { 1,  0, -2}, // 160m
+    { 1,  0, -1}, // 80m
+    { 0,  0,  0}, // 60m
+    { 0,  0,  0}, // 40m
+    { 0,  0,  0}, // 30m
+    { 0,  1,  0}, // 20m
+    { 0,  1,  0}, // 17m
+    { 0,  1, -1}, // 15m
+    { 0,  1, -1}, // 12m
+    { 1,  1, -1}, // 10m
+    {-1, -1,  3}  // 6m
+  };
+
+  const int8_t K_PENALTY[BAND_COUNT][K_BUCKETS] = {
+    {0, 1, 2, 3}, // 160m
+    {0, 1, 2, 3}, // 80m
+    {0, 1, 2, 3}, // 60m
+    {0, 1, 2, 3}, // 40m
+    {0, 1, 2, 4}, // 30m
+    {0, 1, 3, 4}, // 20m
+    {0, 1, 3, 5}, // 17m
+    {0, 1, 3, 5}, // 15m
+    {0, 2, 4, 5}, // 12m
+    {0, 2, 4, 5}, // 10m
+    {0, 1, 2, 2}  // 6m
+  };
+
+  const int GOOD_SCORE = 3;
+  const int FAIR_SCORE = 1;
+
+  int sfiBucket(int solarFlux) {
+    if (solarFlux < 80) return 0;
+    if (solarFlux < 100) return 1;
+    if (solarFlux < 130) return 2;
+    if (solarFlux < 170) return 3;
+    return 4;
+  }
+
+  int kBucket(int kIndex) {
+    if (kIndex <= 2) return 0;
+    if (kIndex <= 4) return 1;
+    if (kIndex <= 6) return 2;
+    return 3;
+  }
+
+  SunPhase qthSunPhase(const ApplicationState& state) {
+    int32_t elevation = fxAsin(getSunElevationSine(state.solar, state.station.latitude, state.station.longitude));
+    if (elevation < GREYLINE_MIN_ELEVATION) return PHASE_NIGHT;
+    if (elevation > GREYLINE_MAX_ELEVATION) return PHASE_DAY;
+    return PHASE_GREYLINE;
+  }
+
+  // Summer is when the sun is well over the QTH's own hemisphere.
+  Season qthSeason(const ApplicationState& state) {
+    const int32_t EQUINOX_DECLINATION = 800;
+    int32_t declination = state.solar.declination;
+    if (declination > -EQUINOX_DECLINATION && declination < EQUINOX_DECLINATION) return SEASON_EQUINOX;
+    bool sunNorth = declination > 0;
+    bool qthNorth = state.station.latitude >= 0;
+    return (sunNorth == qthNorth) ? SEASON_SUMMER : SEASON_WINTER;
+  }
+}
+
+// Returns the band index for a frequency, or -1 outside the amateur bands.
+int getBandIndex(float freqKHz) {
+  for (int i = 0; i < BAND_COUNT; i++) {
+    if (freqKHz >= BANDS[i].startKHz && freqKHz <= BANDS[i].endKHz) return i;
+  }
+  return -1;
+}
+
+const char* getBandLabel(int band) {
+  return (band >= 0 && band < BAND_COUNT) ? BANDS[band].label : "";
+}
+
+// Band edges in kHz, for screens that draw a frequency scale.
+bool getBandRange(int band, uint16_t& startKHz, uint16_t& endKHz) {
+  if (band < 0 || band >= BAND_COUNT) return false;
+  startKHz = BANDS[band].startKHz;
+  endKHz = BANDS[band].endKHz;
+  return true;
+}
+
+// Re-evaluates all bands. Needs HamQSL data, a synced clock and a QTH locator.
+void updateBandConditions(ApplicationState& state) {
+  state.bandConditionsValid = state.propDataAvailable && state.solar.valid && state.station.locationValid;
+  if (!state.bandConditionsValid) return;
+
+  int sfi = sfiBucket(state.solarData.solarFlux);
+  int k = kBucket(state.solarData.kIndex);
+  SunPhase phase = qthSunPhase(state);
+  Season season = qthSeason(state);
+
+  for (int band = 0; band < BAND_COUNT; band++) {
+    int score = SFI_SCORE[band][sfi] + PHASE_SCORE[band][phase] + SEASON_SCORE[band][season] - K_PENALTY[band][k];
+    if (score >= GOOD_SCORE) state.bandConditions[band] = GOOD;
+    else if (score >= FAIR_SCORE) state.bandConditions[band] = FAIR;
+    else state.bandConditions[band] = POOR;
+  }
+}
+
+PropagationCondition getBandCondition(const ApplicationState& state, int band) {
+  if (!state.bandConditionsValid || band < 0 || band >= BAND_COUNT) return UNKNOWN;
+  return state.bandConditions[band];
+}
+
+bool isQthDaylight(const ApplicationState& state) {
+  if (!state.solar.valid || !state.station.locationValid) return true;
+  return getSunElevationSine(state.solar, state.station.latitude, state.station.longitude) > 0;
+}
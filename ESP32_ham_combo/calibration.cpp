@@ -9,9 +9,97 @@ Commercial use is prohibited.
 
 #include "declarations.h"
 
+// Touch calibration. The XPT2046 reports raw 12-bit positions whose axes
+// may be swapped, mirrored, rotated or skewed against the screen depending
+// on the board revision and rotation, so the mapping is a full affine
+// transform fitted to three touched targets:
+//   x = (xx * rawX + xy * rawY + x0) >> 16
+//   y = (yx * rawX + yy * rawY + y0) >> 16
+// with Q16 coefficients, i.e. four multiply-adds per touch. Calibrations
+// from before this change stored two corners in the touch library's rotated
+// coordinates; they are converted on load.
+
+namespace {
+  // Targets as percentages of the screen: spread out and not on one line
+  const int TARGETS[3][2] = { {15, 15}, {85, 50}, {50, 85} };
+  const int CALIBRATION_SAMPLES = 16;
+
+  // The two-corner defaults used before, in the touch library's coordinates
+  const int32_t LEGACY_TOP_LEFT_X = 200;
+  const int32_t LEGACY_TOP_LEFT_Y = 240;
+  const int32_t LEGACY_BOTTOM_RIGHT_X = 3700;
+  const int32_t LEGACY_BOTTOM_RIGHT_Y = 3800;
+
+  // Fits the transform taking each raw point to its screen point. Returns
+  // false when the raw points are (nearly) on one line.
+  bool solveAffine(const int32_t raw[3][2], const int32_t screen[3][2], TouchCalibration& calibration) {
+    const double x0 = raw[0][0] - raw[2][0], y0 = raw[0][1] - raw[2][1];
+    const double x1 = raw[1][0] - raw[2][0], y1 = raw[1][1] - raw[2][1];
+    const double det = x0 * y1 - x1 * y0;
+    if (fabs(det) < 1000.0) return false;
+
+    double coefficients[2][3];
+    for (int axis = 0; axis < 2; axis++) {
+      const double s0 = screen[0][axis] - screen[2][axis];
+      const double s1 = screen[1][axis] - screen[2][axis];
+      const double a = (s0 * y1 - s1 * y0) / det;
+      const double b = (x0 * s1 - x1 * s0) / det;
+      coefficients[axis][0] = a;
+      coefficients[axis][1] = b;
+      coefficients[axis][2] = screen[2][axis] - a * raw[2][0] - b * raw[2][1];
+    }
+    calibration.xx = lround(coefficients[0][0] * 65536);
+    calibration.xy = lround(coefficients[0][1] * 65536);
+    calibration.x0 = lround(coefficients[0][2] * 65536);
+    calibration.yx = lround(coefficients[1][0] * 65536);
+    calibration.yy = lround(coefficients[1][1] * 65536);
+    calibration.y0 = lround(coefficients[1][2] * 65536);
+    return true;
+  }
+
+  // What XPT2046_Touchscreen::getPoint() reported for a raw point under
+  // setRotation(rotation), which the old two-corner calibration was made in.
+  void libraryRotatedPoint(uint8_t rotation, int32_t x, int32_t y, int32_t& rotatedX, int32_t& rotatedY) {
+    switch (rotation) {
+      case 0: rotatedX = 4095 - y; rotatedY = x; break;
+      case 1: rotatedX = x; rotatedY = y; break;
+      case 2: rotatedX = y; rotatedY = 4095 - x; break;
+      default: rotatedX = 4095 - x; rotatedY = 4095 - y; break;
+    }
+  }
+
+  // The affine equivalent of the old two-corner map() calibration.
+  bool fromCorners(uint8_t rotation, int32_t topLeftX, int32_t topLeftY, int32_t bottomRightX, int32_t bottomRightY,
+                   TouchCalibration& calibration) {
+    if (topLeftX == bottomRightX || topLeftY == bottomRightY) return false;
+    const int32_t raw[3][2] = { {0, 0}, {4095, 0}, {0, 4095} };
+    int32_t screen[3][2];
+    for (int i = 0; i < 3; i++) {
+      int32_t x, y;
+      libraryRotatedPoint(rotation, raw[i][0], raw[i][1], x, y);
+      screen[i][0] = TOUCH_CALIBRATION_MARGIN + (x - topLeftX) * (tft.width() - 2 * TOUCH_CALIBRATION_MARGIN) / (bottomRightX - topLeftX);
+      screen[i][1] = TOUCH_CALIBRATION_MARGIN + (y - topLeftY) * (tft.height() - 2 * TOUCH_CALIBRATION_MARGIN) / (bottomRightY - topLeftY);
+    }
+    calibration.rotation = rotation;
+    return solveAffine(raw, screen, calibration);
+  }
+
+  void saveCalibration(const TouchCalibration& calibration) {
+    const int32_t coefficients[6] = { calibration.xx, calibration.xy, calibration.x0,
+                                      calibration.yx, calibration.yy, calibration.y0 };
+    preferences.begin("calibration", false);
+    preferences.putBytes("affine", coefficients, sizeof(coefficients));
+    preferences.putUChar("rotation", calibration.rotation);
+    preferences.putBool("calibrated", true);
+    preferences.end();
+  }
+}
+
 // Waits until the touchscreen is no longer being pressed.
 static void waitForTouchRelease() {
-  while (touchscreen.touched()) {
+  TS_Point p;
+  for (int misses = 0; misses < TOUCH_RELEASE_SAMPLES;) {
+    misses = readTouchPoint(p) ? 0 : misses + 1;
     delay(20);
   }
 }
@@ -22,55 +110,69 @@ static void drawCrosshair(int x, int y, uint16_t color) {
   tft.drawFastVLine(x, y - 10, 21, color);
 }
 
-// Displays instructions and waits for the user to touch a calibration point.
-static void getCalibrationPoint(int x, int y, const char* text, uint16_t &rawX, uint16_t &rawY) {
+// Displays a target and returns the raw position it was touched at,
+// averaged over a steady press.
+static void getCalibrationPoint(int x, int y, int step, int32_t &rawX, int32_t &rawY) {
   tft.fillScreen(TFT_BLACK);
   tft.setTextColor(TFT_WHITE, TFT_BLACK);
   tft.setTextDatum(MC_DATUM);
   tft.setFreeFont(&FreeSans9pt7b);
 
   tft.drawString("Touch the center of the crosshair", tft.width() / 2, tft.height() / 2 - 40);
-  tft.drawString(text, tft.width() / 2, tft.height() / 2 - 15);
+  tft.drawString(String("(point ") + step + " of 3)", tft.width() / 2, tft.height() / 2 - 15);
 
   drawCrosshair(x, y, TFT_CYAN);
+  flushFrame();
 
-  TS_Point touchPoint;
-  bool touched = false;
-
-  while (!touched) {
-    if (touchscreen.touched()) {
-      delay(50); // Debounce
-      touchPoint = touchscreen.getPoint();
-      // A z-value greater than 100 indicates a firm press
-      if (touchPoint.z > 100) {
-        rawX = touchPoint.x;
-        rawY = touchPoint.y;
-        touched = true;
-      }
-    }
-    delay(10);
+  TS_Point p;
+  while (!readTouchPoint(p)) delay(10);
+  delay(50); // Let the finger settle
+
+  int32_t sumX = 0, sumY = 0;
+  int count = 0;
+  while (count < CALIBRATION_SAMPLES && readTouchPoint(p)) {
+    sumX += p.x;
+    sumY += p.y;
+    count++;
+    delay(TOUCH_SAMPLE_INTERVAL_MS);
+  }
+  if (count == 0) { // Lifted straight away: use the first reading
+    sumX = p.x;
+    sumY = p.y;
+    count = 1;
   }
+  rawX = sumX / count;
+  rawY = sumY / count;
 
   waitForTouchRelease();
 }
 
-void runTouchCalibration(ApplicationState& state) {
+static void calibrateTouch(ApplicationState& state) {
   delay(500); // Wait for the user to lift their finger after pressing the menu button
 
-  uint16_t newTopLeftX, newTopLeftY;
-  uint16_t newBottomRightX, newBottomRightY;
-
-  // 1. Get Top-Left Point
-  getCalibrationPoint(TOUCH_CALIBRATION_MARGIN, TOUCH_CALIBRATION_MARGIN,
-                      "(top left corner)",
-                      newTopLeftX, newTopLeftY);
+  int32_t raw[3][2];
+  int32_t screen[3][2];
+  for (int i = 0; i < 3; i++) {
+    screen[i][0] = tft.width() * TARGETS[i][0] / 100;
+    screen[i][1] = tft.height() * TARGETS[i][1] / 100;
+    getCalibrationPoint(screen[i][0], screen[i][1], i + 1, raw[i][0], raw[i][1]);
+  }
 
-  // 2. Get Bottom-Right Point
-  getCalibrationPoint(tft.width() - TOUCH_CALIBRATION_MARGIN, tft.height() - TOUCH_CALIBRATION_MARGIN,
-                      "(bottom right corner)",
-                      newBottomRightX, newBottomRightY);
+  TouchCalibration calibration;
+  calibration.calibrated = true;
+  calibration.rotation = state.display.screenRotation;
+  if (!solveAffine(raw, screen, calibration)) {
+    tft.fillScreen(TFT_BLACK);
+    tft.setTextColor(TFT_RED, TFT_BLACK);
+    tft.setTextDatum(MC_DATUM);
+    tft.drawString("Calibration failed, try again.", tft.width() / 2, tft.height() / 2);
+    flushFrame();
+    delay(CALIBRATION_SAVE_DELAY_MS);
+    drawSystemSettingsScreen(state);
+    return;
+  }
 
-  // 3. Show Confirmation Screen
+  // Confirm before saving
   tft.fillScreen(TFT_BLACK);
   tft.setTextColor(TFT_WHITE, TFT_BLACK);
   tft.setTextDatum(TL_DATUM);
@@ -99,15 +201,16 @@ void runTouchCalibration(ApplicationState& state) {
   // Draw Save Button
   tft.fillRoundRect(SAVE_BTN_X, BTN_Y, CALIBRATION_BTN_W, CALIBRATION_BTN_H, BUTTON_CORNER_RADIUS, COLOR_DARK_GREEN);
   tft.drawString("Save", SAVE_BTN_X + CALIBRATION_BTN_W / 2, BTN_Y + CALIBRATION_BTN_H / 2);
+  flushFrame();
 
   while (true) {
-    if (touchscreen.touched()) {
-      TS_Point p = touchscreen.getPoint();
+    TS_Point p;
+    if (readTouchPoint(p)) {
       waitForTouchRelease();
 
       // Map raw touch coordinates using the *old* calibration to detect button presses.
-      uint16_t t_x = map(p.x, state.calibration.topLeftX, state.calibration.bottomRightX, TOUCH_CALIBRATION_MARGIN, tft.width() - TOUCH_CALIBRATION_MARGIN);
-      uint16_t t_y = map(p.y, state.calibration.topLeftY, state.calibration.bottomRightY, TOUCH_CALIBRATION_MARGIN, tft.height() - TOUCH_CALIBRATION_MARGIN);
+      uint16_t t_x, t_y;
+      mapTouchPoint(state.calibration, p.x, p.y, t_x, t_y);
 
       // Check Cancel
       if (isButtonTouched(t_x, t_y, CANCEL_BTN_X, BTN_Y, CALIBRATION_BTN_W, CALIBRATION_BTN_H)) {
@@ -117,25 +220,14 @@ void runTouchCalibration(ApplicationState& state) {
 
       // Check Save
       if (isButtonTouched(t_x, t_y, SAVE_BTN_X, BTN_Y, CALIBRATION_BTN_W, CALIBRATION_BTN_H)) {
-        preferences.begin("calibration", false);
-        preferences.putUShort("tl_x", newTopLeftX);
-        preferences.putUShort("tl_y", newTopLeftY);
-        preferences.putUShort("br_x", newBottomRightX);
-        preferences.putUShort("br_y", newBottomRightY);
-        preferences.putBool("calibrated", true);
-        preferences.end();
-
-        // Update RAM state
-        state.calibration.topLeftX = newTopLeftX;
-        state.calibration.topLeftY = newTopLeftY;
-        state.calibration.bottomRightX = newBottomRightX;
-        state.calibration.bottomRightY = newBottomRightY;
-        state.calibration.calibrated = true;
+        saveCalibration(calibration);
+        state.calibration = calibration;
 
         tft.fillScreen(TFT_GREEN);
         tft.setTextColor(TFT_BLACK, TFT_GREEN);
         tft.setTextDatum(MC_DATUM);
         tft.drawString("Calibration Saved!", tft.width() / 2, tft.height() / 2);
+        flushFrame();
         delay(CALIBRATION_SAVE_DELAY_MS);
 
         drawSystemSettingsScreen(state);
@@ -146,20 +238,58 @@ void runTouchCalibration(ApplicationState& state) {
   }
 }
 
+// The calibration screens poll the controller themselves, so queued touch
+// input is paused while they run.
+void runTouchCalibration(ApplicationState& state) {
+  setTouchInputPaused(true);
+  calibrateTouch(state);
+  setTouchInputPaused(false);
+}
+
+// Maps a raw controller position to screen pixels.
+void mapTouchPoint(const TouchCalibration& calibration, int16_t rawX, int16_t rawY, uint16_t& x, uint16_t& y) {
+  // |coefficient| < 2^16 for any sensible fit and raw < 2^12, so the sums fit in 32 bits
+  int32_t screenX = (calibration.xx * rawX + calibration.xy * rawY + calibration.x0) >> 16;
+  int32_t screenY = (calibration.yx * rawX + calibration.yy * rawY + calibration.y0) >> 16;
+  x = constrain(screenX, 0, tft.width() - 1);
+  y = constrain(screenY, 0, tft.height() - 1);
+}
+
+// Loads the calibration for the current rotation. A calibration made in
+// another rotation does not fit, so the defaults are used until the screen
+// is calibrated again.
 bool loadCalibrationData(ApplicationState& state) {
+  const uint8_t rotation = state.display.screenRotation;
+  TouchCalibration& calibration = state.calibration;
   preferences.begin("calibration", true); // Read-only
-  state.calibration.calibrated = preferences.getBool("calibrated", false);
+  bool loaded = false;
+
+  if (preferences.getBool("calibrated", false)) {
+    int32_t coefficients[6];
+    if (preferences.getBytes("affine", coefficients, sizeof(coefficients)) == sizeof(coefficients)) {
+      calibration.rotation = preferences.getUChar("rotation", rotation);
+      calibration.xx = coefficients[0];
+      calibration.xy = coefficients[1];
+      calibration.x0 = coefficients[2];
+      calibration.yx = coefficients[3];
+      calibration.yy = coefficients[4];
+      calibration.y0 = coefficients[5];
+      loaded = (calibration.rotation == rotation);
+    } else {
+      // Two corners from an older firmware, made in the current rotation
+      loaded = fromCorners(rotation, preferences.getUShort("tl_x", LEGACY_TOP_LEFT_X), preferences.getUShort("tl_y", LEGACY_TOP_LEFT_Y),
+                           preferences.getUShort("br_x", LEGACY_BOTTOM_RIGHT_X), preferences.getUShort("br_y", LEGACY_BOTTOM_RIGHT_Y),
+                           calibration);
+    }
+  }
+  preferences.end();
 
-  if (state.calibration.calibrated) {
-    state.calibration.topLeftX = preferences.getUShort("tl_x", 200);
-    state.calibration.topLeftY = preferences.getUShort("tl_y", 240);
-    state.calibration.bottomRightX = preferences.getUShort("br_x", 3700);
-    state.calibration.bottomRightY = preferences.getUShort("br_y", 3800);
+  calibration.calibrated = loaded;
+  if (loaded) {
     Serial.println("Calibration data loaded.");
   } else {
-    Serial.println("No calibration data found. Using defaults.");
+    fromCorners(rotation, LEGACY_TOP_LEFT_X, LEGACY_TOP_LEFT_Y, LEGACY_BOTTOM_RIGHT_X, LEGACY_BOTTOM_RIGHT_Y, calibration);
+    Serial.println("No calibration data for this rotation. Using defaults.");
   }
-
-  preferences.end();
   return true;
 }
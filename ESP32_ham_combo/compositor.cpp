@@ -0,0 +1,556 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+// Off-screen compositing. Screens draw into a full-screen 4 bpp frame
+// (38.4 kB, no PSRAM needed) and flushFrame() sends the panel only the tiles
+// whose contents changed since the previous flush, so a redraw that starts
+// with fillScreen() no longer flashes black on the display.
+
+namespace {
+  // Every color the UI uses.
+  const uint16_t FRAME_PALETTE[16] = {
+    TFT_BLACK,         //  0
+    TFT_WHITE,         //  1
+    TFT_YELLOW,        //  2
+    TFT_CYAN,          //  3
+    COLOR_DARK_BLUE,   //  4
+    TFT_GREEN,         //  5
+    TFT_RED,           //  6
+    COLOR_DARK_GREEN,  //  7
+    TFT_DARKGREY,      //  8
+    TFT_ORANGE,        //  9
+    TFT_MAROON,        // 10
+    COLOR_DARK_PURPLE, // 11
+    COLOR_DARK_RED,    // 12
+    TFT_DARKGREEN,     // 13
+    TFT_DARKCYAN,      // 14
+    TFT_MAGENTA        // 15
+  };
+
+  const int MAX_TILE_COLS = (TFT_HEIGHT + FRAME_TILE_W - 1) / FRAME_TILE_W;
+  const int MAX_TILE_ROWS = (TFT_HEIGHT + FRAME_TILE_H - 1) / FRAME_TILE_H;
+  const int MAX_TILES = MAX_TILE_COLS * MAX_TILE_ROWS;
+
+  int frameWidth = 0;
+  int frameHeight = 0;
+  int tileCols = 0;
+  int tileRows = 0;
+  bool frameDirty = false;
+
+  uint32_t tileHashes[MAX_TILES];
+  bool tileStale[MAX_TILES]; // Panel contents unknown, push regardless of the hash
+
+  // Tile range (end exclusive) that is drawn straight to the panel
+  bool holeActive = false;
+  int holeCol0, holeCol1, holeRow0, holeRow1;
+
+  FrameStats frameStats;
+
+  // Leaf primitives drawn since the last flush. Shapes and text reach the
+  // frame through the primitives below, so each pixel is counted once.
+  uint32_t pendingDrawCalls = 0;
+  uint32_t pendingPixels = 0;
+
+  void countDraw(int32_t pixels) {
+    pendingDrawCalls++;
+    if (pixels > 0) pendingPixels += pixels;
+    frameDirty = true;
+  }
+
+  // Non-zero while a primitive runs with a color already mapped to an index.
+  // TFT_eSprite's own text and shape code calls the overridden primitives
+  // again with that index, which must not be mapped a second time.
+  int mappedDepth = 0;
+
+  class MappedColorScope {
+  public:
+    MappedColorScope() { mappedDepth++; }
+    ~MappedColorScope() { mappedDepth--; }
+  };
+
+  uint8_t paletteIndex(uint32_t color) {
+    if (mappedDepth > 0) return color;
+
+    int best = 0;
+    int32_t bestDistance = INT32_MAX;
+    for (int i = 0; i < 16; i++) {
+      if (FRAME_PALETTE[i] == color) return i;
+      // Compare in a common 6-bit scale per channel
+      int32_t dr = (int32_t)((FRAME_PALETTE[i] >> 11) << 1) - (int32_t)((color >> 11 & 0x1F) << 1);
+      int32_t dg = (int32_t)(FRAME_PALETTE[i] >> 5 & 0x3F) - (int32_t)(color >> 5 & 0x3F);
+      int32_t db = (int32_t)((FRAME_PALETTE[i] & 0x1F) << 1) - (int32_t)((color & 0x1F) << 1);
+      int32_t distance = dr * dr + dg * dg + db * db;
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        best = i;
+      }
+    }
+    return best;
+  }
+
+  bool isInsideHole(int col, int row) {
+    return holeActive && col >= holeCol0 && col < holeCol1 && row >= holeRow0 && row < holeRow1;
+  }
+
+  // FNV-1a over the tile's packed pixels (two per byte, high nibble first).
+  uint32_t hashTile(const uint8_t* pixels, int x, int y, int w, int h) {
+    const int rowBytes = frameWidth / 2;
+    uint32_t hash = 2166136261UL;
+    for (int row = y; row < y + h; row++) {
+      const uint8_t* p = pixels + row * rowBytes + x / 2;
+      for (int i = 0; i < (w + 1) / 2; i++) {
+        hash ^= p[i];
+        hash *= 16777619UL;
+      }
+    }
+    return hash;
+  }
+
+  // Hardware scroll area, in frame rows (end exclusive), and how far its
+  // contents are currently rotated in panel memory. Zero offset means frame
+  // rows and panel rows match.
+  int scrollTop = 0;
+  int scrollBottom = 0;
+  int scrollOffset = 0;
+
+  // The ILI9341 scrolls along its native 320-line axis, which is vertical on
+  // screen only in the portrait rotations. Rotation 2 runs that axis upwards.
+  bool isScrollFlipped() {
+    return panel.getRotation() == 2;
+  }
+
+  // Panel line (native axis, top to bottom) of a frame row.
+  int frameRowToLine(int y) {
+    return isScrollFlipped() ? frameHeight - 1 - y : y;
+  }
+
+  // Frame row to address so that pixels sent there show up at frame row y
+  // while the scroll area is rotated.
+  int scrolledRow(int y) {
+    if (scrollOffset == 0 || y < scrollTop || y >= scrollBottom) return y;
+    const int firstLine = frameRowToLine(isScrollFlipped() ? scrollBottom - 1 : scrollTop);
+    const int areaLines = scrollBottom - scrollTop;
+    const int memoryLine = firstLine + (frameRowToLine(y) - firstLine + scrollOffset) % areaLines;
+    return frameRowToLine(memoryLine); // The mapping is its own inverse
+  }
+
+  void writeScrollCommand(uint8_t command, const uint16_t* values, int count) {
+    panel.writecommand(command);
+    for (int i = 0; i < count; i++) {
+      panel.writedata(values[i] >> 8);
+      panel.writedata(values[i] & 0xFF);
+    }
+  }
+
+  // VSCRDEF (0x33) sets the fixed top, scrolled and fixed bottom lines;
+  // VSCRSADD (0x37) the memory line shown first in the scrolled part.
+  void applyScroll() {
+    const uint16_t firstLine = frameRowToLine(isScrollFlipped() ? scrollBottom - 1 : scrollTop);
+    const uint16_t areaLines = scrollBottom - scrollTop;
+    const uint16_t definition[3] = { firstLine, areaLines, (uint16_t)(frameHeight - firstLine - areaLines) };
+    const uint16_t startLine = firstLine + scrollOffset;
+    writeScrollCommand(0x33, definition, 3);
+    writeScrollCommand(0x37, &startLine, 1);
+  }
+
+  // Puts the panel back in frame order. Its memory no longer matches any
+  // tile hash, so everything is pushed again.
+  void resetFrameScroll() {
+    if (scrollOffset == 0) return;
+    scrollOffset = 0;
+    applyScroll();
+    for (int i = 0; i < tileCols * tileRows; i++) tileStale[i] = true;
+    frameDirty = true;
+  }
+
+  // Expands a horizontal run of tiles through the palette and sends it, in
+  // one window unless the run crosses the wrap of a scrolled area.
+  void pushRun(const uint8_t* pixels, int x, int y, int w, int h) {
+    static uint16_t runBuffer[TFT_HEIGHT * FRAME_TILE_H];
+    const int rowBytes = frameWidth / 2;
+    uint16_t* out = runBuffer;
+    for (int row = y; row < y + h; row++) {
+      const uint8_t* p = pixels + row * rowBytes + x / 2;
+      for (int i = 0; i < w; i += 2) {
+        *out++ = FRAME_PALETTE[p[i / 2] >> 4];
+        if (i + 1 < w) *out++ = FRAME_PALETTE[p[i / 2] & 0x0F];
+      }
+    }
+    for (int row = 0; row < h;) {
+      const int target = scrolledRow(y + row);
+      int count = 1;
+      while (row + count < h && scrolledRow(y + row + count) == target + count) count++;
+      panel.pushImage(x, target, w, count, runBuffer + row * w);
+      row += count;
+    }
+  }
+
+  void clearFrameHole() {
+    if (!holeActive) return;
+    holeActive = false;
+    frameDirty = true; // Tiles under the hole are stale and get pushed next flush
+  }
+}
+
+// --- FrameSprite ---
+
+void FrameSprite::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  const uint8_t index = paletteIndex(color);
+  MappedColorScope mapped;
+  TFT_eSprite::drawPixel(x, y, index);
+  countDraw(1);
+}
+
+// A line is counted through the pixels and spans TFT_eSprite draws it with.
+void FrameSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+  const uint8_t index = paletteIndex(color);
+  MappedColorScope mapped;
+  TFT_eSprite::drawLine(x0, y0, x1, y1, index);
+  frameDirty = true;
+}
+
+void FrameSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  const uint8_t index = paletteIndex(color);
+  MappedColorScope mapped;
+  TFT_eSprite::drawFastHLine(x, y, w, index);
+  countDraw(w);
+}
+
+void FrameSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  const uint8_t index = paletteIndex(color);
+  MappedColorScope mapped;
+  TFT_eSprite::drawFastVLine(x, y, h, index);
+  countDraw(h);
+}
+
+// fillScreen() ends up here too. A full-screen fill means a new screen, which
+// ends any direct-to-panel area the previous one had.
+void FrameSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  if (x <= 0 && y <= 0 && x + w >= frameWidth && y + h >= frameHeight) clearFrameHole();
+  const uint8_t index = paletteIndex(color);
+  MappedColorScope mapped;
+  TFT_eSprite::fillRect(x, y, w, h, index);
+  countDraw(w > 0 && h > 0 ? w * h : 0);
+}
+
+// Free-font glyphs come from the glyph atlas when there is one for the font.
+void FrameSprite::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size) {
+  const uint8_t colorIndex = paletteIndex(color);
+  const uint8_t bgIndex = paletteIndex(bg);
+  MappedColorScope mapped;
+  int32_t pixels = (size == 1 && gfxFont) ? drawAtlasGlyph(*this, gfxFont, c, x, y, colorIndex) : -1;
+  if (pixels < 0) {
+    TFT_eSprite::drawChar(x, y, c, colorIndex, bgIndex, size);
+  } else {
+    countDraw(pixels); // Atlas spans bypass the counted primitives
+  }
+  frameDirty = true;
+}
+
+// The font-number path reads the text colors from members, so they are mapped
+// for the duration of the call.
+int16_t FrameSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) {
+  uint32_t color = textcolor;
+  uint32_t bg = textbgcolor;
+  textcolor = paletteIndex(color);
+  textbgcolor = paletteIndex(bg);
+  int16_t width;
+  {
+    MappedColorScope mapped;
+    width = TFT_eSprite::drawChar(uniCode, x, y, font);
+  }
+  textcolor = color;
+  textbgcolor = bg;
+  frameDirty = true;
+  return width;
+}
+
+// --- Frame management ---
+
+// Allocates the frame at the panel's current size, so it must run after
+// setRotation(). Returns false if the heap cannot hold it.
+bool setupFrameBuffer() {
+  tft.setColorDepth(4);
+  if (tft.createSprite(panel.width(), panel.height()) == nullptr) {
+    Serial.println("Frame buffer allocation failed.");
+    return false;
+  }
+  tft.createPalette(FRAME_PALETTE, 16);
+
+  frameWidth = tft.width();
+  frameHeight = tft.height();
+  tileCols = (frameWidth + FRAME_TILE_W - 1) / FRAME_TILE_W;
+  tileRows = (frameHeight + FRAME_TILE_H - 1) / FRAME_TILE_H;
+  holeActive = false;
+  invalidateFrame();
+  Serial.printf("Frame buffer %dx%d, %d tiles.\n", frameWidth, frameHeight, tileCols * tileRows);
+  return true;
+}
+
+// Sends every changed tile to the panel. Cheap when nothing was drawn, so the
+// main loop calls it on every pass; code that blocks after drawing (delays,
+// touch waits) calls it first so the screen is up to date.
+void flushFrame() {
+  if (!frameDirty || frameWidth == 0) return;
+  PROFILE_SCOPE(PROF_FLUSH_FRAME);
+  frameDirty = false;
+
+  unsigned long startTime = micros();
+  const uint8_t* pixels = (const uint8_t*)tft.getPointer();
+  uint16_t tilesPushed = 0;
+  uint32_t bytesPushed = 0;
+
+  bool swapBytes = panel.getSwapBytes();
+  panel.setSwapBytes(true);
+  panel.startWrite();
+  for (int row = 0; row < tileRows; row++) {
+    const int y = row * FRAME_TILE_H;
+    const int h = min(FRAME_TILE_H, frameHeight - y);
+    int runStart = -1;
+
+    // One column past the end closes a run that reaches the right edge
+    for (int col = 0; col <= tileCols; col++) {
+      bool changed = false;
+      if (col < tileCols) {
+        const int tile = row * tileCols + col;
+        if (isInsideHole(col, row)) {
+          tileStale[tile] = true;
+        } else {
+          const int x = col * FRAME_TILE_W;
+          uint32_t hash = hashTile(pixels, x, y, min(FRAME_TILE_W, frameWidth - x), h);
+          changed = tileStale[tile] || hash != tileHashes[tile];
+          tileHashes[tile] = hash;
+          tileStale[tile] = false;
+        }
+      }
+
+      if (changed && runStart < 0) {
+        runStart = col;
+      } else if (!changed && runStart >= 0) {
+        const int x = runStart * FRAME_TILE_W;
+        const int w = min(col * FRAME_TILE_W, frameWidth) - x;
+        pushRun(pixels, x, y, w, h);
+        tilesPushed += col - runStart;
+        bytesPushed += (uint32_t)w * h * 2;
+        runStart = -1;
+      }
+    }
+  }
+  panel.endWrite();
+  panel.setSwapBytes(swapBytes);
+
+  frameStats.drawCalls = pendingDrawCalls;
+  frameStats.pixelsWritten = pendingPixels;
+  pendingDrawCalls = 0;
+  pendingPixels = 0;
+  frameStats.tilesPushed = tilesPushed;
+  frameStats.bytesPushed = bytesPushed;
+  frameStats.flushMicros = micros() - startTime;
+  frameStats.frameCount++;
+  frameStats.totalBytesPushed += bytesPushed;
+#if FRAME_STATS_LOGGING
+  Serial.printf("Frame %lu: %lu draws, %lu pixels, %u tiles, %lu bytes, %lu us\n", (unsigned long)frameStats.frameCount,
+                (unsigned long)frameStats.drawCalls, (unsigned long)frameStats.pixelsWritten,
+                tilesPushed, (unsigned long)bytesPushed, frameStats.flushMicros);
+#endif
+}
+
+// Forces the next flush to push every tile, e.g. after something drew on the
+// panel directly.
+void invalidateFrame() {
+  for (int i = 0; i < tileCols * tileRows; i++) tileStale[i] = true;
+  frameDirty = true;
+}
+
+// Leaves an area of the panel to code that draws there directly (the grey-line
+// map). Every tile the rectangle touches is skipped by flushFrame() until the
+// next full-screen fill.
+void setFrameHole(int x, int y, int w, int h) {
+  resetFrameScroll(); // Direct drawing uses plain panel coordinates
+  holeCol0 = max(x, 0) / FRAME_TILE_W;
+  holeRow0 = max(y, 0) / FRAME_TILE_H;
+  holeCol1 = min((x + w + FRAME_TILE_W - 1) / FRAME_TILE_W, tileCols);
+  holeRow1 = min((y + h + FRAME_TILE_H - 1) / FRAME_TILE_H, tileRows);
+  holeActive = true;
+}
+
+// Moves the frame rows [top, bottom) down by lines, using the panel's
+// hardware scroll so only the rows uncovered at the top need sending once the
+// caller draws them. Returns false, leaving everything as it was, where the
+// panel cannot scroll that way (the landscape rotations); the caller then
+// redraws instead.
+bool scrollFrameArea(int top, int bottom, int lines) {
+  top = max(top, 0);
+  bottom = min(bottom, frameHeight);
+  if (panel.getRotation() % 2 != 0 || holeActive || lines <= 0 || lines >= bottom - top) return false;
+
+  // Tile hashes must describe the panel exactly before it is rotated
+  flushFrame();
+  if (top != scrollTop || bottom != scrollBottom) {
+    resetFrameScroll();
+    flushFrame();
+    scrollTop = top;
+    scrollBottom = bottom;
+  }
+
+  const int areaLines = bottom - top;
+  scrollOffset = (scrollOffset + (isScrollFlipped() ? lines : areaLines - lines)) % areaLines;
+  applyScroll();
+
+  // Shift the frame the same way, so it still matches the panel
+  uint8_t* pixels = (uint8_t*)tft.getPointer();
+  const int rowBytes = frameWidth / 2;
+  memmove(pixels + (top + lines) * rowBytes, pixels + top * rowBytes, (areaLines - lines) * rowBytes);
+
+  // Rows uncovered at the top show old lines wrapped round from the bottom
+  for (int row = top / FRAME_TILE_H; row < tileRows && row * FRAME_TILE_H < bottom; row++) {
+    const int y = row * FRAME_TILE_H;
+    const int h = min(FRAME_TILE_H, frameHeight - y);
+    const bool uncovered = y < top + lines && y + h > top;
+    for (int col = 0; col < tileCols; col++) {
+      const int tile = row * tileCols + col;
+      const int x = col * FRAME_TILE_W;
+      tileHashes[tile] = hashTile(pixels, x, y, min(FRAME_TILE_W, frameWidth - x), h);
+      if (uncovered) tileStale[tile] = true;
+    }
+  }
+  frameDirty = true;
+  return true;
+}
+
+const FrameStats& getFrameStats() {
+  return frameStats;
+}
+
+// --- Frame capture ---
+
+// The frame as a 4 bpp BMP with the frame palette, served by /screenshot.bmp
+// in chunks straight from the sprite. The grey-line map is drawn on the panel
+// directly and does not appear in it.
+namespace {
+  const size_t BMP_HEADER_SIZE = 14 + 40 + 16 * 4;
+
+  size_t bmpRowBytes() {
+    return ((frameWidth / 2) + 3) & ~3;
+  }
+
+  void putLe(uint8_t* p, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) p[i] = value >> (8 * i);
+  }
+
+  void buildBmpHeader(uint8_t* header) {
+    memset(header, 0, BMP_HEADER_SIZE);
+    header[0] = 'B';
+    header[1] = 'M';
+    putLe(header + 2, getFrameBmpSize(), 4);
+    putLe(header + 10, BMP_HEADER_SIZE, 4);
+    putLe(header + 14, 40, 4);          // BITMAPINFOHEADER
+    putLe(header + 18, frameWidth, 4);
+    putLe(header + 22, frameHeight, 4); // Positive height: rows bottom-up
+    putLe(header + 26, 1, 2);
+    putLe(header + 28, 4, 2);           // Bits per pixel
+    putLe(header + 34, bmpRowBytes() * frameHeight, 4);
+    putLe(header + 46, 16, 4);          // Palette entries
+    for (int i = 0; i < 16; i++) {
+      uint8_t* entry = header + 54 + i * 4; // Blue, green, red, reserved
+      entry[0] = (FRAME_PALETTE[i] & 0x1F) << 3;
+      entry[1] = (FRAME_PALETTE[i] >> 5 & 0x3F) << 2;
+      entry[2] = (FRAME_PALETTE[i] >> 11) << 3;
+    }
+  }
+}
+
+size_t getFrameBmpSize() {
+  return BMP_HEADER_SIZE + bmpRowBytes() * frameHeight;
+}
+
+// Copies up to maxLen bytes of the BMP starting at index, for a chunked
+// response. Returns the number of bytes written, 0 at the end.
+size_t readFrameBmp(uint8_t* buffer, size_t maxLen, size_t index) {
+  const size_t total = getFrameBmpSize();
+  if (frameWidth == 0 || index >= total) return 0;
+
+  uint8_t header[BMP_HEADER_SIZE];
+  const uint8_t* pixels = (const uint8_t*)tft.getPointer();
+  const size_t rowBytes = bmpRowBytes();
+  const size_t frameRowBytes = frameWidth / 2;
+  size_t written = 0;
+
+  if (index < BMP_HEADER_SIZE) {
+    buildBmpHeader(header);
+    written = min(maxLen, BMP_HEADER_SIZE - index);
+    memcpy(buffer, header + index, written);
+  }
+  // The sprite packs two pixels per byte, high nibble first, as BMP does
+  while (written < maxLen && index + written < total) {
+    const size_t offset = index + written - BMP_HEADER_SIZE;
+    const int row = frameHeight - 1 - offset / rowBytes;
+    const size_t column = offset % rowBytes;
+    const size_t count = min(maxLen - written, rowBytes - column);
+    for (size_t i = 0; i < count; i++) {
+      buffer[written + i] = (column + i < frameRowBytes) ? pixels[row * frameRowBytes + column + i] : 0;
+    }
+    written += count;
+  }
+  return written;
+}
+
+#if RENDER_BENCHMARK
+// Draws every screen once from a black frame and reports what it cost: time
+// spent drawing, primitives and pixels drawn, and the flush that follows.
+// Runs once startup has data to show; the caller draws the real screen after.
+void runRenderBenchmark(ApplicationState& state) {
+  struct BenchmarkScreen {
+    const char* name;
+    ActiveScreen screen;
+    void (*draw)(ApplicationState& state);
+  };
+  const BenchmarkScreen SCREENS[] = {
+    { "Spots", SCREEN_SPOTS, [](ApplicationState& s) { drawSpotsScreen(s); } },
+    { "Spots + Prop", SCREEN_SPOTS_AND_PROP, [](ApplicationState& s) { drawSpotsAndPropScreen(s); } },
+    { "Clock", SCREEN_CLOCK, [](ApplicationState& s) { s.lastSecond = -1; drawClockScreen(s); } },
+    { "Propagation", SCREEN_PROPAGATION, [](ApplicationState& s) { drawPropagationScreen(s); } },
+    { "Grey Line", SCREEN_GREY_LINE, [](ApplicationState& s) { drawGreyLineScreen(s); } },
+    { "Band Map", SCREEN_BAND_MAP, [](ApplicationState& s) { drawBandMapScreen(s); } },
+    { "Spot Map", SCREEN_SPOT_MAP, [](ApplicationState& s) { drawSpotMapScreen(s); } },
+    { "Settings Menu", SCREEN_SETTINGS_MENU, [](ApplicationState& s) { drawSettingsMenuScreen(s); } },
+    { "Display Settings", SCREEN_DISPLAY_SETTINGS, [](ApplicationState& s) { drawDisplaySettingsScreen(s); } },
+    { "Audio Settings", SCREEN_AUDIO_SETTINGS, [](ApplicationState& s) { drawAudioSettingsScreen(s); } },
+    { "Sleep Settings", SCREEN_SLEEP_SETTINGS, [](ApplicationState& s) { drawSleepSettingsScreen(s); } },
+    { "System Settings", SCREEN_SYSTEM_SETTINGS, [](ApplicationState& s) { drawSystemSettingsScreen(s); } },
+    { "Info", SCREEN_INFO, [](ApplicationState& s) { drawInfoScreen(s); } },
+    { "Updates", SCREEN_UPDATES_INFO, [](ApplicationState& s) { drawUpdatesScreen(s); } },
+    { "Wi-Fi Reset", SCREEN_WIFI_RESET_CONFIRM, [](ApplicationState& s) { drawWifiResetConfirmScreen(s); } },
+    { "Grace Period", SCREEN_SLEEP_GRACE_PERIOD, [](ApplicationState& s) { drawGracePeriodScreen(s); } }
+  };
+  const ActiveScreen activeScreen = state.activeScreen;
+
+  Serial.println("Screen            draw us   draws  pixels  tiles  bytes  flush us");
+  for (const BenchmarkScreen& entry : SCREENS) {
+    tft.fillScreen(TFT_BLACK);
+    flushFrame();
+
+    state.activeScreen = entry.screen;
+    unsigned long start = micros();
+    entry.draw(state);
+    unsigned long drawMicros = micros() - start;
+    flushFrame();
+
+    const FrameStats& stats = getFrameStats();
+    Serial.printf("%-16s %8lu %7lu %7lu %6u %6lu %9lu\n", entry.name, drawMicros,
+                  (unsigned long)stats.drawCalls, (unsigned long)stats.pixelsWritten,
+                  stats.tilesPushed, (unsigned long)stats.bytesPushed, stats.flushMicros);
+  }
+
+  state.activeScreen = activeScreen;
+  tft.fillScreen(TFT_BLACK);
+}
+#endif
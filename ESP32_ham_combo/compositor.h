@@ -0,0 +1,31 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "TFT_eSPI.h"
+
+// Full-screen 4 bpp sprite that all screens draw into. Colors are ordinary
+// RGB565 values; the overrides below map them to the 16-entry frame palette
+// before TFT_eSprite stores them, and note that the frame needs a flush.
+class FrameSprite : public TFT_eSprite {
+public:
+  explicit FrameSprite(TFT_eSPI* display) : TFT_eSprite(display) {}
+
+  void drawPixel(int32_t x, int32_t y, uint32_t color) override;
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) override;
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) override;
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) override;
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+  void drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size) override;
+  int16_t drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) override;
+};
+
+#endif // COMPOSITOR_H
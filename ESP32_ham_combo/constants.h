@@ -14,15 +14,28 @@ Commercial use is prohibited.
 #define FW_VERSION "1.0.0"
 #define FW_DATE "2025-11-23"
 #define GITHUB_REPO "hf7a/ESP32-ham-combo"
-#define GITHUB_API_HOST "api.github.com"
 #define PROJECT_URL "github.com/" GITHUB_REPO
 
+// --- HTTPS Test Server ---
+// Set to 1 to send all HTTPS fetches (HamQSL, GitHub) to a local TLS server
+// for measuring handshake cost: tools/https_test_server.sh runs one.
+#define HTTPS_USE_TEST_SERVER 0
+#define HTTPS_TEST_SERVER_HOST "192.168.1.100"
+#define HTTPS_TEST_SERVER_PORT 4443
+
 // --- Network Configuration ---
 const char* const TELNET_HOST = "hamalert.org";
 const int TELNET_PORT = 7300;
 const char* const NTP_SERVER = "pool.ntp.org";
+#if HTTPS_USE_TEST_SERVER
+#define GITHUB_API_HOST HTTPS_TEST_SERVER_HOST
+const char* const PROP_HOST = HTTPS_TEST_SERVER_HOST;
+const int HTTPS_PORT = HTTPS_TEST_SERVER_PORT;
+#else
+#define GITHUB_API_HOST "api.github.com"
 const char* const PROP_HOST = "www.hamqsl.com";
 const int HTTPS_PORT = 443;
+#endif
 const char* const PROP_URL = "/solarxml.php";
 
 // --- Defaults ---
@@ -35,12 +48,24 @@ const unsigned long PERIODIC_CHECK_INTERVAL_MS = 5000UL;
 const unsigned long TELNET_RECONNECT_INTERVAL_MS = 60 * 60 * 1000UL;
 const unsigned long TELNET_LOGIN_TIMEOUT_MS = 5000UL;
 const unsigned long SPOT_LIST_UPDATE_INTERVAL_MS = 30 * 1000UL;
+const unsigned long CLOCK_TICK_MS = 1000UL;       // Clock redraws, on the second
+const unsigned long CLOCK_SWEEP_TICK_MS = 250UL;  // With a sweeping second dot: one per dot step
 const unsigned long PROPAGATION_UPDATE_INTERVAL_MS = 30 * 60 * 1000UL;
 const unsigned long SLEEP_GRACE_PERIOD_MS = 60 * 1000UL;
 const unsigned long UPDATE_CHECK_INTERVAL_MS = 24 * 60 * 60 * 1000UL;
+const unsigned long TELNET_POLL_INTERVAL_MS = 100UL;
+const unsigned long SLEEP_CHECK_INTERVAL_MS = 1000UL;
+const unsigned long EPHEMERIS_CHECK_INTERVAL_MS = 1000UL; // The ephemeris advances each minute
+const unsigned long GRACE_COUNTDOWN_INTERVAL_MS = 1000UL;
+const unsigned long TOUCH_HOLD_CHECK_INTERVAL_MS = 20UL;  // Long press and repeat timing while a finger is down
 const unsigned long RESTART_DELAY_MS = 2000UL;
 const unsigned long WIFI_CONNECT_DELAY_MS = 500UL;
+const unsigned long WIFI_HINT_TIMEOUT_MS = 3000UL; // Connecting to the access point from before sleep, before scanning
 const unsigned long CALIBRATION_SAVE_DELAY_MS = 1500UL;
+const unsigned long BAND_MAP_SPOT_MAX_AGE_MS = 30 * 60 * 1000UL;
+const unsigned long SPOT_CACHE_SAVE_INTERVAL_MS = 10 * 60 * 1000UL; // Flash wear: at most one write per interval
+const unsigned long HTTPS_KEEPALIVE_IDLE_MS = 20 * 1000UL; // Idle TLS connections are closed after this to free ~40 kB of heap
+const unsigned long HTTPS_READ_TIMEOUT_MS = 10 * 1000UL;   // Longest wait for the server within a TLS handshake or record
 
 // --- Hardware Pins ---
 #define AUDIO_OUT_PIN 26
@@ -53,6 +78,30 @@ const unsigned long CALIBRATION_SAVE_DELAY_MS = 1500UL;
 // Note: TOUCH_CS and TOUCH_IRQ are usually defined in User_Setup.h,
 // but if not, ensure they match your wiring (e.g., 33 and 36).
 
+// --- Touch Input ---
+#define TOUCH_QUEUE_SIZE 16          // Events between loop() passes; a power of two
+#define TOUCH_SAMPLE_INTERVAL_MS 10  // Controller reads while pressed
+#define TOUCH_RELEASE_SAMPLES 3      // Empty reads in a row that end a press
+#define TOUCH_MOVE_THRESHOLD_RAW 40  // Raw controller units, about 3 px
+#define TOUCH_TASK_STACK_SIZE 3072
+#define TOUCH_TASK_PRIORITY 2        // Above loop(), so samples stay evenly spaced
+#define TOUCH_OVERSAMPLE 5           // Conversions per axis per sample; the median is kept
+#define TOUCH_MIN_PRESSURE 400       // Z1 + 4095 - Z2 below this is a light or no touch
+#define XPT2046_SPI_HZ 2000000
+
+// --- Touch Gestures ---
+#define GESTURE_TAP_SLOP_PX 12          // Further than this from the start, a press is a drag
+#define GESTURE_SWIPE_MIN_PX 60         // Horizontal travel of a swipe
+#define GESTURE_SWIPE_MAX_MS 700
+#define GESTURE_LONG_PRESS_MS 600
+#define GESTURE_REPEAT_DELAY_MS 450     // Hold on a - or + before it starts repeating
+#define GESTURE_REPEAT_INTERVAL_MS 120
+
+// --- Scheduler ---
+#define TIMER_WHEEL_SLOTS 64           // A power of two
+#define TIMER_WHEEL_TICK_MS 10
+#define SCHEDULER_MAX_WAIT_MS 1000     // Longest loop() sleeps with no timer due
+
 // --- Data Thresholds ---
 #define SUNSPOTS_GOOD_THRESHOLD 100
 #define SUNSPOTS_FAIR_THRESHOLD 50
@@ -61,7 +110,16 @@ const unsigned long CALIBRATION_SAVE_DELAY_MS = 1500UL;
 #define COLOR_DARK_GREEN 0x0100
 #define COLOR_DARK_PURPLE 0x1806
 #define COLOR_DARK_BLUE 0x0004
+#define COLOR_DARK_RED 0x3800
 #define SECOND_DOT_COLOR TFT_ORANGE
+#define COLOR_GREYLINE TFT_MAGENTA
+#define COLOR_WIDGET_PRESSED TFT_WHITE
+#define COLOR_MAP_OCEAN_DAY 0x1A7B
+#define COLOR_MAP_OCEAN_TWILIGHT 0x1130
+#define COLOR_MAP_OCEAN_NIGHT 0x0008
+#define COLOR_MAP_LAND_DAY 0x4D06
+#define COLOR_MAP_LAND_TWILIGHT 0x3344
+#define COLOR_MAP_LAND_NIGHT 0x1161
 
 // --- Main UI Layout ---
 #define BUTTON_W 70
@@ -69,6 +127,11 @@ const unsigned long CALIBRATION_SAVE_DELAY_MS = 1500UL;
 #define BUTTON_GAP 10
 #define BUTTON_CORNER_RADIUS 5
 #define BUTTON_Y_MARGIN 10
+#define WIDGET_GRID_COLS 8 // Touch lookup grid, see widgets.cpp
+#define WIDGET_GRID_ROWS 8
+
+// --- Clock Screen Layout ---
+#define CLOCK_SECONDS_GAP 4
 
 // --- Spots Screen Layout ---
 #define SPOT_LINE_HEIGHT 30
@@ -77,6 +140,8 @@ const unsigned long CALIBRATION_SAVE_DELAY_MS = 1500UL;
 #define SPOT_COL_MODE_X 190
 #define SPOT_COL_FREQ_X_MARGIN 10
 #define SPOT_COL_TIME_WIDTH 45
+#define SPOT_COL_GREYLINE_X 53
+#define GREYLINE_MARKER_RADIUS 3
 
 // --- Propagation Screen Layout ---
 #define PROP_H_LINE_Y 122
@@ -89,6 +154,86 @@ const unsigned long CALIBRATION_SAVE_DELAY_MS = 1500UL;
 #define PROP_SIMPLE_V_LINE_TOP_MARGIN 10
 #define PROP_SIMPLE_V_LINE_BOTTOM_MARGIN 20
 
+// --- Frame Compositor ---
+// Tiles divide both rotations of the 320x240 panel and the grey-line map.
+#define FRAME_TILE_W 40
+#define FRAME_TILE_H 8
+// Set to 1 to print the tiles and bytes pushed by every frame flush.
+#define FRAME_STATS_LOGGING 0
+// Set to 1 to time a spot list row with and without the glyph atlas at startup.
+#define GLYPH_ATLAS_BENCHMARK 0
+// Set to 1 to print the draw and flush cost of every screen once startup is done.
+#define RENDER_BENCHMARK 0
+
+// --- Profiler ---
+// Set to 1 to time the draw functions, touch handling and frame flushes,
+// reported at /profile. At 0 the profiler is not compiled in at all.
+#define ENABLE_PROFILER 0
+// Set to 1 (with ENABLE_PROFILER) to show the slowest section in a corner of the screen.
+#define PROFILER_OVERLAY 0
+#define PROFILER_OVERLAY_W 170
+#define PROFILER_OVERLAY_H 40
+const unsigned long PROFILER_OVERLAY_INTERVAL_MS = 1000;
+
+// --- Startup ---
+// Set to 1 to draw the last screen from the data cached in flash as soon as
+// the display is up, and bring up WiFi, NTP, HamAlert and the HTTPS fetches
+// behind it. At 0 the splash screen lists each step until all are done.
+#define FAST_BOOT 1
+#define STARTUP_TASK_STACK_SIZE 10240 // The TLS handshake needs most of this
+#define STARTUP_TASK_PRIORITY 1       // Same as loop()
+#define SPOT_CACHE_MAX_AGE_S (2 * 60 * 60UL) // Older cached spots are not shown
+#define RTC_SNAPSHOT_MAX_BYTES 2048   // Of the 8 kB of RTC slow memory
+
+// --- Alert Tones ---
+#define AUDIO_SAMPLE_RATE_HZ 20000
+#define AUDIO_BLOCK_SAMPLES 256     // One DMA buffer, 12.8 ms of playback to render the next in
+#define AUDIO_RAMP_MS 5             // Attack and release of every tone
+#define AUDIO_TASK_STACK_SIZE 3072
+#define AUDIO_TASK_PRIORITY 3       // Above loop(), so the DMA never runs dry
+#define TONE_SEQUENCE_MAX_STEPS 160 // A pattern and an 11-character callsign in CW
+#define TONE_ALERT_GAP_MS 150       // Silence after each alert, so queued ones stay apart
+
+// --- CPU Governor ---
+#define CPU_BOOST_MHZ 240
+#define CPU_IDLE_MHZ 80 // Not below 80: APB, and with it the SPI clocks, would slow down too
+
+// --- Low Power Mode ---
+#define WIFI_BEACON_INTERVAL_MS 102 // The usual 100 TU
+#define WIFI_MAX_LISTEN_INTERVAL 10 // Beacons the radio may sleep through
+#define POWER_ACTIVE_MA 100         // Current estimates for the ESP32 module, display excluded: radio always on
+#define POWER_MODEM_SLEEP_MA 30     // Awake, radio asleep between beacons
+#define POWER_LIGHT_SLEEP_MA 2      // Light sleep, with the radio waking for beacons
+
+// --- Grey Line Screen ---
+#define GREYLINE_MAP_MAX_WIDTH 320
+#define GREYLINE_TEXT_LINE_HEIGHT 19
+#define GREYLINE_TEXT_MARGIN 5
+#define GREYLINE_SPOT_MARKER_R 3
+
+// --- Spot Map Screen ---
+#define SPOT_MAP_STRIP_H 8 // Map rows decoded and sent to the panel at a time
+#define SPOT_MAP_DX_MARKER_R 3
+#define SPOT_MAP_SPOTTER_MARKER_R 2
+#define SPOT_MAP_QTH_MARKER_R 4
+#define SPOT_MAP_TEXT_LINE_HEIGHT 19
+#define SPOT_MAP_TEXT_MARGIN 5
+
+// --- Band Map Screen ---
+#define BAND_MAP_HEADER_H 24
+#define BAND_MAP_PLOT_MARGIN 8
+#define BAND_MAP_AXIS_X 56
+#define BAND_MAP_LABEL_X 92
+#define BAND_MAP_SLOT_H 18
+#define BAND_MAP_MAX_SLOTS 16 // At most 16: the dirty slots are kept in a 16-bit mask
+#define BAND_MAP_MIN_SCALE_GAP 24
+#define BAND_MAP_EDGE_TOUCH_W 80 // Taps this close to the left or right edge change the band
+
+// --- Solar Ephemeris (angles in centidegrees) ---
+#define SUN_HORIZON_ELEVATION -83    // Refraction and solar disc radius at sunrise/sunset
+#define GREYLINE_MIN_ELEVATION -600  // Civil twilight
+#define GREYLINE_MAX_ELEVATION 600
+
 // --- Settings Screens Layout ---
 #define SETTINGS_V_GAP 8
 #define SETTINGS_CONTROL_H 30
@@ -138,6 +283,7 @@ const unsigned long CALIBRATION_SAVE_DELAY_MS = 1500UL;
 // --- Buffers ---
 #define WIFI_CONNECT_ATTEMPTS 20
 #define TELNET_LINE_BUFFER_SIZE 256
+#define SPOT_QUEUE_SIZE 16 // Parsed spots waiting for the UI; a power of two
 #define UPTIME_BUFFER_SIZE 20
 
 #endif // CONSTANTS_H
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include "esp_pm.h"
+#include <mutex>
+
+// Runs the CPU at CPU_IDLE_MHZ and raises it to CPU_BOOST_MHZ while a boost
+// is held: TLS handshakes, parsing downloads, bursts of spots and full
+// screen redraws. With power management in the build, esp_pm switches the
+// clock (a CPU_FREQ_MAX lock is the boost) and can add light sleep; without
+// it the clock is set directly on the first acquire and the last release.
+//
+// The idle clock stays at 80 MHz or above. Below that the APB clock slows
+// down with the CPU, and the SPI dividers TFT_eSPI worked out from
+// SPI_FREQUENCY at start would no longer give the clock it asked for. From
+// 80 MHz up APB stays at 80 MHz, so no SPI clock has to be derived again.
+
+namespace {
+  static_assert(CPU_IDLE_MHZ >= 80, "Below 80 MHz the APB and SPI clocks slow down with the CPU");
+
+  std::mutex governorMutex;
+  bool governorStarted = false;
+  esp_pm_lock_handle_t boostLock = nullptr; // Set when esp_pm does the switching
+  int boostCount = 0;
+  int64_t startUs = 0;
+  int64_t boostStartUs = 0;
+  uint64_t boostedUs = 0;
+  uint32_t boosts = 0;
+}
+
+// Starts the governor, or changes whether it may use light sleep. Returns
+// false if esp_pm is not available, in which case there is no light sleep.
+bool configureCpuGovernor(bool lightSleep) {
+  std::lock_guard<std::mutex> guard(governorMutex);
+  if (!governorStarted) startUs = esp_timer_get_time();
+  governorStarted = true;
+
+  esp_pm_config_t config = {};
+  config.max_freq_mhz = CPU_BOOST_MHZ;
+  config.min_freq_mhz = CPU_IDLE_MHZ;
+  config.light_sleep_enable = lightSleep;
+  esp_err_t err = esp_pm_configure(&config);
+  if (err == ESP_OK && !boostLock) {
+    err = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "boost", &boostLock);
+    if (err == ESP_OK && boostCount > 0) esp_pm_lock_acquire(boostLock);
+  }
+  if (err != ESP_OK) {
+    Serial.printf("esp_pm unavailable (%s), setting the CPU clock directly.\n", esp_err_to_name(err));
+    setCpuFrequencyMhz(boostCount > 0 ? CPU_BOOST_MHZ : CPU_IDLE_MHZ);
+    return false;
+  }
+  if (getApbFrequency() != 80000000) Serial.printf("Unexpected APB clock: %u Hz.\n", (unsigned)getApbFrequency());
+  return true;
+}
+
+void acquireCpuBoost() {
+  std::lock_guard<std::mutex> guard(governorMutex);
+  if (boostCount++ > 0) return;
+  boostStartUs = esp_timer_get_time();
+  boosts++;
+  if (boostLock) esp_pm_lock_acquire(boostLock);
+  else if (governorStarted) setCpuFrequencyMhz(CPU_BOOST_MHZ);
+}
+
+void releaseCpuBoost() {
+  std::lock_guard<std::mutex> guard(governorMutex);
+  if (--boostCount > 0) return;
+  boostedUs += esp_timer_get_time() - boostStartUs;
+  if (boostLock) esp_pm_lock_release(boostLock);
+  else if (governorStarted) setCpuFrequencyMhz(CPU_IDLE_MHZ);
+}
+
+// Time spent at each clock since the governor started.
+CpuGovernorStats getCpuGovernorStats() {
+  std::lock_guard<std::mutex> guard(governorMutex);
+  const int64_t now = esp_timer_get_time();
+  CpuGovernorStats stats;
+  stats.boostedUs = boostedUs + (boostCount > 0 ? now - boostStartUs : 0);
+  stats.idleUs = governorStarted ? now - startUs - stats.boostedUs : 0;
+  stats.boosts = boosts;
+  return stats;
+}
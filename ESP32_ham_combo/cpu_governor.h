@@ -0,0 +1,29 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#ifndef CPU_GOVERNOR_H
+#define CPU_GOVERNOR_H
+
+// CPU_BOOST_SCOPE() runs the rest of the enclosing block at the full CPU
+// clock. Boosts nest and may be held from any task; the clock drops back
+// once the last one is released.
+void acquireCpuBoost();
+void releaseCpuBoost();
+
+class CpuBoostScope {
+public:
+  CpuBoostScope() { acquireCpuBoost(); }
+  ~CpuBoostScope() { releaseCpuBoost(); }
+  CpuBoostScope(const CpuBoostScope&) = delete;
+  CpuBoostScope& operator=(const CpuBoostScope&) = delete;
+};
+
+#define CPU_BOOST_SCOPE() CpuBoostScope cpuBoostScope
+
+#endif // CPU_GOVERNOR_H
@@ -16,36 +16,30 @@ Commercial use is prohibited.
 #include <SPI.h>
 #include "TFT_eSPI.h"
 #include <XPT2046_Touchscreen.h>
-#include <WiFiClientSecure.h>
 #include <ArduinoHttpClient.h>
 #include <Preferences.h>
 #include <ESPAsyncWebServer.h>
-#include "driver/dac_cosine.h"
 #include "constants.h"
+#include "compositor.h"
+#include "profiler.h"
+#include "cpu_governor.h"
+#include "tls_client.h"
 
 // --- External Object Declarations ---
-extern TFT_eSPI tft;
+extern TFT_eSPI panel;
+extern FrameSprite tft; // All drawing goes to the off-screen frame, see compositor.cpp
 extern WiFiClient telnetClient;
 extern Preferences preferences;
 extern SPIClass touchscreenSPI;
 extern XPT2046_Touchscreen touchscreen;
-extern WiFiClientSecure secureClient;
+extern TlsClient secureClient;
 extern HttpClient httpClient;
 extern AsyncWebServer webServer;
 
 // --- Dynamic UI Layout Definitions ---
-// These macros depend on the 'tft' object and must be defined after it is declared.
-#define BUTTON_Y (tft.height() - BUTTON_H - BUTTON_Y_MARGIN)
-
-// Main screen buttons
-#define SETUP_BTN_X (tft.width() - BUTTON_W - 10)
-#define PROP_BTN_X (SETUP_BTN_X - BUTTON_W - BUTTON_GAP)
-#define CLOCK_BTN_X (PROP_BTN_X - BUTTON_W - BUTTON_GAP)
-#define SLEEP_NOW_BTN_X (CLOCK_BTN_X - BUTTON_W - BUTTON_GAP)
-
-// Footer and Settings dynamic widths
-#define PROP_FOOTER_Y (BUTTON_Y - 40)
-#define SETTINGS_BUTTON_W (tft.width() - SETTINGS_CONTROL_X - 20)
+// Resolved once for the current rotation by layoutWidgets(), see widgets.cpp.
+#define BUTTON_Y (getScreenLayout().buttonY)
+#define PROP_FOOTER_Y (getScreenLayout().propFooterY)
 
 // --- Enumerations ---
 
@@ -62,7 +56,10 @@ SCREEN_INFO,
 SCREEN_SLEEP_GRACE_PERIOD,
 SCREEN_UPDATES_INFO,
 SCREEN_SPOTS_AND_PROP,
-SCREEN_WIFI_RESET_CONFIRM
+SCREEN_WIFI_RESET_CONFIRM,
+SCREEN_GREY_LINE,
+SCREEN_BAND_MAP,
+SCREEN_SPOT_MAP
 };
 
 enum OperationStatus {
@@ -87,6 +84,13 @@ SPOTS_ONLY,
 SPOTS_WITH_PROP
 };
 
+// Which spots have their callsign played in CW after the alert.
+enum CwCallsMode {
+CW_CALLS_OFF,
+CW_CALLS_WATCHLIST,
+CW_CALLS_ALL
+};
+
 enum PropagationCondition {
 POOR,
 FAIR,
@@ -94,6 +98,27 @@ GOOD,
 UNKNOWN
 };
 
+enum HfBand {
+BAND_160M,
+BAND_80M,
+BAND_60M,
+BAND_40M,
+BAND_30M,
+BAND_20M,
+BAND_17M,
+BAND_15M,
+BAND_12M,
+BAND_10M,
+BAND_6M,
+BAND_COUNT
+};
+
+enum HttpsHostId {
+HTTPS_HOST_PROPAGATION,
+HTTPS_HOST_GITHUB,
+HTTPS_HOST_COUNT
+};
+
 enum InitializationState {
 INIT_BEGIN,
 INIT_SYNC_TIME,
@@ -103,14 +128,120 @@ INIT_FINALIZE,
 INIT_RUNNING
 };
 
+// Touch controls declared in widgets.cpp
+enum WidgetId {
+WID_NONE,
+WID_SLEEP_NOW,
+WID_CLOCK,
+WID_PROP,
+WID_SETUP,
+WID_BACK,
+WID_MENU_DISPLAY,
+WID_MENU_AUDIO,
+WID_MENU_SLEEP,
+WID_MENU_SYSTEM,
+WID_CLOCK_MODE,
+WID_SPOTS_VIEW,
+WID_PROP_VIEW,
+WID_BRIGHTNESS_DOWN,
+WID_BRIGHTNESS_VALUE,
+WID_BRIGHTNESS_UP,
+WID_INVERT,
+WID_VOLUME_DOWN,
+WID_VOLUME_VALUE,
+WID_VOLUME_UP,
+WID_TONE_FREQ_DOWN,
+WID_TONE_FREQ_VALUE,
+WID_TONE_FREQ_UP,
+WID_TONE_DURATION_DOWN,
+WID_TONE_DURATION_VALUE,
+WID_TONE_DURATION_UP,
+WID_INACTIVITY_DOWN,
+WID_INACTIVITY_VALUE,
+WID_INACTIVITY_UP,
+WID_SCHEDULE,
+WID_SLEEP_HOUR_LABEL,
+WID_SLEEP_HOUR_DOWN,
+WID_SLEEP_HOUR_VALUE,
+WID_SLEEP_HOUR_UP,
+WID_WAKE_HOUR_LABEL,
+WID_WAKE_HOUR_DOWN,
+WID_WAKE_HOUR_VALUE,
+WID_WAKE_HOUR_UP,
+WID_DEVICE_INFO,
+WID_CALIBRATE,
+WID_REMEMBER_SCREEN,
+WID_UPDATES,
+WID_WIFI_RESET,
+WID_CHECK_UPDATES,
+WID_CANCEL_SLEEP,
+WID_WIFI_RESET_CANCEL,
+WID_WIFI_RESET_CONFIRM
+};
+
+enum WidgetKind {
+WIDGET_BUTTON,      // Round rect with centred text
+WIDGET_MENU_BUTTON, // Bold label on the left, arrow on the right
+WIDGET_ON_OFF,      // Bold label with an ON/OFF status
+WIDGET_STEP,        // "-" or "+" of a stepper, greyed out at the limit
+WIDGET_LABEL,       // Text left-aligned in its rectangle
+WIDGET_VALUE        // Text centred in its rectangle
+};
+
+// Which screen edge a widget's position is measured from
+enum WidgetAnchor {
+ANCHOR_LEFT = 0,
+ANCHOR_RIGHT = 1,
+ANCHOR_HCENTER = 2,
+ANCHOR_TOP = 0,
+ANCHOR_BOTTOM = 4
+};
+
 // --- Data Structures ---
 
+// Affine map from raw controller coordinates to screen pixels, Q16 fixed
+// point: x = (xx * rawX + xy * rawY + x0) >> 16, and likewise for y.
 struct TouchCalibration {
 bool calibrated = false;
-uint16_t topLeftX = 200;
-uint16_t topLeftY = 240;
-uint16_t bottomRightX = 3700;
-uint16_t bottomRightY = 3800;
+uint8_t rotation = 3; // Screen rotation the fit was made in
+int32_t xx = 0;
+int32_t xy = 0;
+int32_t x0 = 0;
+int32_t yx = 0;
+int32_t yy = 0;
+int32_t y0 = 0;
+};
+
+// Timers run by the scheduler; each can be pending once
+enum TimerId {
+TIMER_TOUCH_HOLD,
+TIMER_TELNET_POLL,
+TIMER_CONNECTION_CHECK,
+TIMER_PROPAGATION,
+TIMER_UPDATE_CHECK,
+TIMER_SPOT_AGING,
+TIMER_CLOCK_TICK,
+TIMER_GRACE_COUNTDOWN,
+TIMER_SLEEP_CHECK,
+TIMER_EPHEMERIS,
+TIMER_PROFILER_OVERLAY,
+TIMER_STARTUP,
+TIMER_SPOT_CACHE,
+TIMER_COUNT
+};
+
+enum TouchEventType {
+TOUCH_PRESS,
+TOUCH_MOVE,
+TOUCH_RELEASE
+};
+
+// Raw XPT2046 coordinates; handleTouch() maps them to the screen.
+struct TouchEvent {
+TouchEventType type;
+int16_t rawX;
+int16_t rawY;
+uint32_t time; // millis()
 };
 
 struct DxSpot {
@@ -120,6 +251,54 @@ char spotter[12];
 int spotHour;
 int spotMinute;
 char mode[5];
+int band;            // HfBand, or -1 outside the amateur bands
+bool dxLocated;      // DX entity found in the prefix table
+int16_t dxLatitude;  // Centidegrees, north positive
+int16_t dxLongitude; // Centidegrees, east positive
+int dxSunrise;       // UTC minutes of day, -1 if the sun does not rise or set
+int dxSunset;
+bool nearGreyLine;
+bool spotterLocated;       // Spotter's entity found in the prefix table
+int16_t spotterLatitude;   // Centidegrees, north positive
+int16_t spotterLongitude;  // Centidegrees, east positive
+};
+
+// Cost of the most recent HTTPS request to a host, plus lifetime counters.
+struct HttpsRequestStats {
+unsigned long handshakeMs = 0;
+unsigned long requestMs = 0;
+uint32_t peakHeapBytes = 0;
+bool reusedConnection = false;
+bool resumedSession = false; // The handshake resumed the host's last TLS session
+uint32_t handshakeCount = 0;
+uint32_t reuseCount = 0;
+uint32_t resumeCount = 0;
+};
+
+// Time spent at each CPU clock since the governor started.
+struct CpuGovernorStats {
+uint64_t idleUs = 0;    // At CPU_IDLE_MHZ, or asleep
+uint64_t boostedUs = 0; // At CPU_BOOST_MHZ
+uint32_t boosts = 0;
+};
+
+// Shared positions that depend on the rotation, resolved by layoutWidgets().
+struct ScreenLayout {
+int16_t width = 0;
+int16_t height = 0;
+int16_t buttonY = 0;
+int16_t propFooterY = 0;
+};
+
+// Cost of the most recent frame flush, plus lifetime counters.
+struct FrameStats {
+uint32_t drawCalls = 0;     // Primitives drawn into the frame since the flush before
+uint32_t pixelsWritten = 0;
+uint16_t tilesPushed = 0;
+uint32_t bytesPushed = 0;
+unsigned long flushMicros = 0;
+uint32_t frameCount = 0;
+uint64_t totalBytesPushed = 0;
 };
 
 struct VhfPropagationData {
@@ -150,14 +329,19 @@ bool colorInversion = true;
 bool rememberLastScreen = false;
 ActiveScreen startupScreen = SCREEN_SPOTS;
 bool secondDotEnabled = true;
+bool clockSecondsEnabled = false;
+bool secondDotSweep = false; // Move the dot four times a second instead of once
 int screenRotation = 3;
+bool hideClosedBands = false; // Drop spots on bands the estimator predicts closed
 };
 
 struct AudioState {
-int volumeStep = 3;
+int volumePercent = 25; // Digital gain, in steps of 5
 int toneFrequency = 880;
 int toneDurationMs = 100;
-dac_cosine_handle_t cos_handle = nullptr;
+char watchlist[64] = "";          // Callsigns, comma separated; "DL*" matches a prefix
+CwCallsMode cwCalls = CW_CALLS_OFF;
+int cwWpm = 20;
 };
 
 struct PowerState {
@@ -167,6 +351,8 @@ int scheduledSleepHour = 23;
 int scheduledWakeHour = 7;
 unsigned long lastInteractionTime = 0;
 unsigned long gracePeriodStartTime = 0;
+bool lowPowerMode = false;  // Modem and light sleep while idle
+int maxSpotDelayMs = 1000;  // Low power mode: longest a new spot may wait to be shown
 };
 
 struct NetworkState {
@@ -178,10 +364,34 @@ char customDstRule[64];
 bool hamAlertConnected = false;
 unsigned long lastReconnectTime = 0;
 bool isWifiConnected = true;
+bool starting = false; // Fast boot: the cached screen is up, the network is not yet
+};
+
+struct StationState {
+char locator[7] = "";
+bool locationValid = false;
+int16_t latitude = 0;  // Centidegrees, north positive
+int16_t longitude = 0; // Centidegrees, east positive
+};
+
+// Sun position cached per UTC day, plus the terminator recomputed once a minute.
+struct SolarEphemeris {
+bool valid = false;
+long dayNumber = -1;            // Days since 2000-01-01 of the cached values
+int32_t declination = 0;        // Centidegrees
+int32_t sinDeclination = 0;     // Q14
+int32_t cosDeclination = 0;     // Q14
+int32_t equationOfTime = 0;     // Seconds
+int minuteOfDay = -1;           // UTC minute the terminator was computed for
+int32_t subsolarLongitude = 0;  // Centidegrees
+int qthSunrise = -1;            // UTC minutes of day, -1 if the sun does not rise or set
+int qthSunset = -1;
+bool qthNearGreyLine = false;
 };
 
 struct ApplicationState {
 ActiveScreen activeScreen = SCREEN_SPOTS;
+ActiveScreen lastMainScreen = SCREEN_SPOTS; // Shown again after waking from deep sleep
 int startupScreenYPos = 0;
 bool calibrationRequested = false;
 
@@ -189,6 +399,7 @@ DisplayState display;
 AudioState audio;
 PowerState power;
 NetworkState network;
+StationState station;
 
 bool checkForUpdates = true;
 bool newVersionAvailable = false;
@@ -198,23 +409,25 @@ unsigned long lastUpdateCheckTime = 0;
 static const int MAX_SPOTS = 6;
 DxSpot spots[MAX_SPOTS];
 int spotCount = 0;
+bool spotsCacheDirty = false; // Spots added since they were last saved to flash
 int latestSpotIndex = -1;
 
 SolarPropagationData solarData;
 bool propDataAvailable = false;
+time_t propDataTime = 0; // When solarData was fetched
+SolarEphemeris solar;
+PropagationCondition bandConditions[BAND_COUNT];
+bool bandConditionsValid = false;
 
 TouchCalibration calibration;
 
-unsigned long lastDisplayUpdateTime = 0;
-unsigned long lastClockUpdateTime = 0;
-unsigned long lastPropUpdateTime = 0;
-unsigned long lastPeriodicCheckTime = 0;
 
-char lastUtcTimeStr[6] = "";
-char lastLocalTimeStr[6] = "";
+char lastUtcTimeStr[9] = "";   // Clock text on screen, "HH:MM" or "HH:MM:SS"
+char lastLocalTimeStr[9] = "";
 int lastSecond = -1;
 int lastSecondDotX = -1;
 int lastSecondDotY = -1;
+int lastSecondDotStep = -1;
 };
 
 // --- Function Prototypes ---
@@ -224,26 +437,59 @@ void startConfigurationPortal();
 void enterDeepSleep(const ApplicationState& state);
 bool isWithinScheduledSleepWindow(const ApplicationState& state);
 bool shouldEnterSleep(const ApplicationState& state);
+void startRuntimeTimers(ApplicationState& state);
+void startNetworkTimers(ApplicationState& state);
+bool beginWifi(const ApplicationState& state, uint8_t channel, const uint8_t* bssid);
+bool startFromCache(ApplicationState& state);
 void determineAndDrawActiveScreen(ApplicationState& state);
+void showMainScreen(ApplicationState& state, ActiveScreen targetScreen);
+
+// bands.cpp
+int getBandIndex(float freqKHz);
+const char* getBandLabel(int band);
+bool getBandRange(int band, uint16_t& startKHz, uint16_t& endKHz);
+void updateBandConditions(ApplicationState& state);
+PropagationCondition getBandCondition(const ApplicationState& state, int band);
+bool isQthDaylight(const ApplicationState& state);
 
 // calibration.cpp
 void runTouchCalibration(ApplicationState& state);
 bool loadCalibrationData(ApplicationState& state);
+void mapTouchPoint(const TouchCalibration& calibration, int16_t rawX, int16_t rawY, uint16_t& x, uint16_t& y);
 
 // tab_prop.cpp
 bool fetchPropagationData(ApplicationState& state);
+bool downloadPropagationData(String& body);
+bool applyPropagationData(ApplicationState& state, const String& body);
 void drawPropagationScreen(const ApplicationState& state);
 PropagationCondition toConditionValue(const char* val);
 
+// tab_bandmap.cpp
+void addBandMapSpot(const DxSpot& spot);
+void drawBandMapScreen(ApplicationState& state);
+void refreshBandMap(ApplicationState& state);
+void stepBandMapBand(ApplicationState& state, int direction);
+void showBandMapBand(ApplicationState& state, int band);
+
+// tab_spotmap.cpp
+void drawSpotMapScreen(const ApplicationState& state);
+
+// tab_greyline.cpp
+void drawGreyLineScreen(const ApplicationState& state);
+
 // tab_settings.cpp
 void saveSettings(const ApplicationState& state);
 void loadSettings(ApplicationState& state);
+void saveSpotCache(const ApplicationState& state);
+void saveSolarCache(const ApplicationState& state);
+void loadDataCache(ApplicationState& state);
 void clearWiFiSettings();
 
 // tab_spots.cpp
 bool connectToTelnet(ApplicationState& state, bool silentMode);
-void readTelnetSpots(ApplicationState& state);
-void parseSpot(const char* line, ApplicationState& state);
+void readTelnetSpots();
+void processQueuedSpots(ApplicationState& state);
+bool parseSpotLine(const char* line, DxSpot& newSpot);
 void addSpot(const DxSpot& newSpot, ApplicationState& state);
 void clearSpots(ApplicationState& state);
 void getModeFromLine(const char* line, float freq_khz, char* mode_buffer, size_t buffer_size);
@@ -252,11 +498,11 @@ String formatElapsedMinutes(long elapsedSeconds);
 void drawSpotsScreen(ApplicationState& state);
 void drawSpotsAndPropScreen(ApplicationState& state);
 void updateSpotTimesOnly(ApplicationState& state);
+void showNewSpots(ApplicationState& state, int newSpots);
+int findSpotAtRow(const ApplicationState& state, uint16_t y);
 
 // ui_core.cpp
 void setBrightness(int percent);
-void setupAudio(ApplicationState& state);
-void playNewSpotSound(const ApplicationState& state);
 void handleTouch(ApplicationState& state);
 void updateStartupStatus(const String& message, OperationStatus status, ApplicationState& state);
 bool isButtonTouched(uint16_t tx, uint16_t ty, int x, int y, int w, int h);
@@ -284,11 +530,114 @@ void drawSystemSettingsScreen(const ApplicationState& state);
 void drawInfoScreen(const ApplicationState& state);
 void drawUpdatesScreen(const ApplicationState& state);
 void drawWifiResetConfirmScreen(const ApplicationState& state);
+void refreshSettingsScreen(const ApplicationState& state);
 
 // webserver.cpp
 void setupWebServer(ApplicationState& state);
 
 // updates.cpp
 bool checkGithubForUpdate(ApplicationState& state);
+bool fetchLatestReleaseTag(char* tag, size_t tagSize);
+bool applyLatestReleaseTag(ApplicationState& state, const char* tag);
+
+// startup.cpp
+void startStartupSteps(ApplicationState& state, bool fetchPropagation, bool checkUpdates);
+bool finishStartupSteps(ApplicationState& state);
+
+// alert_tones.cpp
+void setupAudio(const ApplicationState& state);
+void playNewSpotSound(const ApplicationState& state);
+void playSpotAlert(const ApplicationState& state, const DxSpot& spot);
+
+// cpu_governor.cpp
+bool configureCpuGovernor(bool lightSleep);
+CpuGovernorStats getCpuGovernorStats();
+
+// power_mode.cpp
+uint16_t getWifiListenInterval(const ApplicationState& state);
+unsigned long getTelnetPollInterval(const ApplicationState& state);
+void beginLowPowerWifi(const ApplicationState& state, const char* ssid, const char* password, uint8_t channel, const uint8_t* bssid);
+void applyPowerMode(const ApplicationState& state);
+void samplePowerStats(ApplicationState& state);
+int getAwakePercent();
+int getEstimatedCurrentMa(const ApplicationState& state);
+
+// rtc_snapshot.cpp
+void saveRtcSnapshot(const ApplicationState& state);
+bool restoreRtcSnapshot(ApplicationState& state, uint8_t& wifiChannel, uint8_t* wifiBssid);
+
+// solar.cpp
+int32_t fxSin(int32_t angle);
+int32_t fxCos(int32_t angle);
+int32_t fxAsin(int32_t value);
+bool updateSolarEphemeris(ApplicationState& state);
+void computeSunTimes(const SolarEphemeris& eph, int16_t latitude, int16_t longitude, int& sunrise, int& sunset);
+int32_t getSunElevationSine(const SolarEphemeris& eph, int16_t latitude, int16_t longitude);
+bool isNearGreyLine(const SolarEphemeris& eph, int16_t latitude, int16_t longitude);
+void locateSpot(DxSpot& spot, const ApplicationState& state);
+
+// geo.cpp
+bool locatorToLatLon(const char* locator, int16_t& latitude, int16_t& longitude);
+bool lookupCallsignLocation(const char* call, int16_t& latitude, int16_t& longitude);
+
+// world_map.cpp
+void decodeWorldMapRow(int y, int width, int height, uint8_t* land);
+
+// compositor.cpp
+bool setupFrameBuffer();
+void flushFrame();
+void invalidateFrame();
+void setFrameHole(int x, int y, int w, int h);
+bool scrollFrameArea(int top, int bottom, int lines);
+const FrameStats& getFrameStats();
+size_t getFrameBmpSize();
+size_t readFrameBmp(uint8_t* buffer, size_t maxLen, size_t index);
+void runRenderBenchmark(ApplicationState& state);
+
+// glyph_atlas.cpp
+void checkGlyphAtlases();
+int32_t drawAtlasGlyph(TFT_eSprite& frame, const GFXfont* font, uint16_t c, int32_t x, int32_t y, uint32_t color);
+void runGlyphAtlasBenchmark();
+
+// widgets.cpp
+void layoutWidgets();
+const ScreenLayout& getScreenLayout();
+void setWidgetText(WidgetId id, const char* text);
+void setWidgetColor(WidgetId id, uint16_t color);
+void setWidgetOn(WidgetId id, bool on);
+void setWidgetHidden(WidgetId id, bool hidden);
+void drawWidgets(ActiveScreen screen, bool fullRedraw);
+WidgetId hitTestWidgets(ActiveScreen screen, uint16_t x, uint16_t y);
+WidgetId pressWidget(ActiveScreen screen, uint16_t x, uint16_t y);
+void releasePressedWidget(ActiveScreen activeScreen);
+bool pressedWidgetRepeats();
+
+// https_client.cpp
+void setupHttpsClients();
+TlsClient* beginHttpsRequest(HttpsHostId hostId);
+void endHttpsRequest(HttpsHostId hostId, bool keepAlive);
+void closeIdleHttpsConnections();
+const HttpsRequestStats& getHttpsStats(HttpsHostId hostId);
+
+// touch_input.cpp
+void startTouchInput();
+bool readTouchEvent(TouchEvent& event);
+void setTouchInputPaused(bool paused);
+bool readTouchPoint(TS_Point& point);
+
+// spot_queue.cpp
+bool pushSpot(const DxSpot& spot);
+bool popSpot(DxSpot& spot);
+uint32_t getDroppedSpotCount();
+
+// scheduler.cpp
+typedef void (*TimerCallback)(ApplicationState& state);
+void startTimer(TimerId id, TimerCallback callback, unsigned long delayMs, unsigned long periodMs = 0);
+void stopTimer(TimerId id);
+bool isTimerRunning(TimerId id);
+void runDueTimers(ApplicationState& state);
+unsigned long getNextTimerDelay();
+void waitForTimerOrInput();
+void wakeMainLoop();
 
 #endif // DECLARATIONS_H
\ No newline at end of file
@@ -0,0 +1,250 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include <ctype.h>
+
+namespace {
+  struct PrefixLocation {
+    const char* prefix;
+    int16_t latitude;  // Centidegrees
+    int16_t longitude; // Centidegrees
+  };
+
+  // Approximate centre of common DXCC entities. A callsign resolves to the
+  // entry with the longest matching prefix, so "KH6" wins over "K".
+  const PrefixLocation PREFIX_TABLE[] = {
+    // North America
+    {"K", 3900, -9800}, {"N", 3900, -9800}, {"W", 3900, -9800},
+    {"AA", 3900, -9800}, {"AB", 3900, -9800}, {"AC", 3900, -9800}, {"AD", 3900, -9800},
+    {"AE", 3900, -9800}, {"AF", 3900, -9800}, {"AG", 3900, -9800}, {"AI", 3900, -9800},
+    {"AJ", 3900, -9800}, {"AK", 3900, -9800},
+    {"KL7", 6100, -15000}, {"AL7", 6100, -15000}, {"NL7", 6100, -15000}, {"WL7", 6100, -15000},
+    {"KH6", 2100, -15700}, {"AH6", 2100, -15700}, {"NH6", 2100, -15700}, {"WH6", 2100, -15700},
+    {"KP4", 1820, -6650}, {"NP4", 1820, -6650}, {"WP4", 1820, -6650},
+    {"KH2", 1350, 14480}, {"KH0", 1520, 14575}, {"KH8", -1430, -17070},
+    {"VE", 5400, -10000}, {"VA", 5400, -10000}, {"VO", 4850, -5600}, {"VY", 6300, -13500}, {"CY", 4700, -6000},
+    {"XE", 2300, -10200}, {"XA", 2300, -10200}, {"XF", 2300, -10200},
+    {"CO", 2150, -7950}, {"CM", 2150, -7950}, {"CL", 2150, -7950},
+    {"HI", 1900, -7050}, {"HH", 1900, -7250}, {"6Y", 1810, -7730}, {"C6", 2450, -7750},
+    {"8P", 1320, -5950}, {"9Y", 1050, -6130}, {"ZF", 1930, -8130}, {"P4", 1250, -7000},
+    {"PJ2", 1220, -6900}, {"PJ4", 1220, -6830}, {"PJ7", 1800, -6300},
+    {"FG", 1620, -6160}, {"FM", 1460, -6100}, {"TI", 1000, -8400}, {"HP", 850, -8000},
+    {"YN", 1290, -8520}, {"HR", 1500, -8650}, {"TG", 1550, -9030}, {"YS", 1380, -8890}, {"V3", 1720, -8870},
+    {"OX", 7200, -4000}, {"XP", 7200, -4000},
+    // South America
+    {"PY", -1000, -5200}, {"PP", -1000, -5200}, {"PQ", -1000, -5200}, {"PR", -1000, -5200},
+    {"PS", -1000, -5200}, {"PT", -1000, -5200}, {"PU", -1000, -5200}, {"PV", -1000, -5200},
+    {"PW", -1000, -5200}, {"PX", -1000, -5200}, {"ZV", -1000, -5200}, {"ZW", -1000, -5200},
+    {"ZX", -1000, -5200}, {"ZY", -1000, -5200}, {"ZZ", -1000, -5200},
+    {"LU", -3400, -6400}, {"LO", -3400, -6400}, {"LP", -3400, -6400}, {"LQ", -3400, -6400},
+    {"LR", -3400, -6400}, {"LS", -3400, -6400}, {"LT", -3400, -6400}, {"LV", -3400, -6400},
+    {"LW", -3400, -6400}, {"AY", -3400, -6400}, {"AZ", -3400, -6400},
+    {"CE", -3300, -7100}, {"CA", -3300, -7100}, {"CB", -3300, -7100}, {"CC", -3300, -7100},
+    {"CD", -3300, -7100}, {"XQ", -3300, -7100}, {"XR", -3300, -7100}, {"CE0Y", -2710, -10940},
+    {"CX", -3300, -5600}, {"ZP", -2340, -5840}, {"CP", -1630, -6360}, {"OA", -1000, -7600},
+    {"HC", -150, -7800}, {"HC8", -70, -9050}, {"HK", 450, -7400}, {"YV", 700, -6600},
+    {"8R", 500, -5900}, {"PZ", 400, -5600}, {"FY", 400, -5300}, {"VP8", -5170, -5900},
+    // Europe
+    {"G", 5250, -150}, {"M", 5250, -150}, {"2E", 5250, -150},
+    {"GM", 5700, -400}, {"MM", 5700, -400}, {"2M", 5700, -400},
+    {"GW", 5230, -370}, {"MW", 5230, -370}, {"2W", 5230, -370},
+    {"GI", 5460, -670}, {"MI", 5460, -670}, {"2I", 5460, -670},
+    {"GD", 5420, -450}, {"MD", 5420, -450}, {"GJ", 4920, -210}, {"MJ", 4920, -210},
+    {"GU", 4950, -260}, {"MU", 4950, -260}, {"EI", 5340, -800}, {"EJ", 5340, -800},
+    {"F", 4650, 250}, {"TK", 4200, 900}, {"TM", 4650, 250},
+    {"DA", 5100, 1000}, {"DB", 5100, 1000}, {"DC", 5100, 1000}, {"DD", 5100, 1000},
+    {"DF", 5100, 1000}, {"DG", 5100, 1000}, {"DH", 5100, 1000}, {"DJ", 5100, 1000},
+    {"DK", 5100, 1000}, {"DL", 5100, 1000}, {"DM", 5100, 1000}, {"DO", 5100, 1000},
+    {"DP", 5100, 1000}, {"DQ", 5100, 1000}, {"DR", 5100, 1000},
+    {"ON", 5060, 450}, {"OO", 5060, 450}, {"OP", 5060, 450}, {"OQ", 5060, 450}, {"OR", 5060, 450},
+    {"OS", 5060, 450}, {"OT", 5060, 450},
+    {"PA", 5220, 550}, {"PB", 5220, 550}, {"PC", 5220, 550}, {"PD", 5220, 550},
+    {"PE", 5220, 550}, {"PF", 5220, 550}, {"PG", 5220, 550}, {"PH", 5220, 550}, {"PI", 5220, 550},
+    {"LX", 4980, 610}, {"HB", 4680, 820}, {"HB0", 4710, 950}, {"OE", 4750, 1450},
+    {"I", 4250, 1250}, {"IS0", 4000, 900}, {"IM0", 4000, 900}, {"IT9", 3750, 1400},
+    {"9H", 3590, 1440}, {"T7", 3890, 1245}, {"HV", 4190, 1245},
+    {"EA", 4000, -370}, {"EB", 4000, -370}, {"EC", 4000, -370}, {"ED", 4000, -370},
+    {"EE", 4000, -370}, {"EF", 4000, -370}, {"EG", 4000, -370}, {"EH", 4000, -370},
+    {"EA6", 3950, 290}, {"EA8", 2830, -1580}, {"EA9", 3590, -530},
+    {"CT", 3950, -800}, {"CT3", 3270, -1700}, {"CU", 3850, -2800}, {"C3", 4250, 150}, {"3A", 4370, 740},
+    {"OZ", 5600, 1000}, {"OY", 6200, -700}, {"TF", 6500, -1800},
+    {"LA", 6100, 900}, {"LB", 6100, 900}, {"LC", 6100, 900}, {"LD", 6100, 900}, {"LE", 6100, 900},
+    {"LF", 6100, 900}, {"LG", 6100, 900}, {"LH", 6100, 900}, {"LI", 6100, 900}, {"LJ", 6100, 900},
+    {"LK", 6100, 900}, {"LL", 6100, 900}, {"LM", 6100, 900}, {"LN", 6100, 900},
+    {"JW", 7800, 1600}, {"JX", 7100, -850},
+    {"SM", 6200, 1500}, {"SA", 6200, 1500}, {"SB", 6200, 1500}, {"SC", 6200, 1500}, {"SD", 6200, 1500},
+    {"SE", 6200, 1500}, {"SF", 6200, 1500}, {"SG", 6200, 1500}, {"SH", 6200, 1500}, {"SI", 6200, 1500},
+    {"SJ", 6200, 1500}, {"SK", 6200, 1500}, {"SL", 6200, 1500}, {"7S", 6200, 1500}, {"8S", 6200, 1500},
+    {"OH", 6300, 2600}, {"OG", 6300, 2600}, {"OF", 6300, 2600}, {"OI", 6300, 2600}, {"OH0", 6020, 2000},
+    {"ES", 5870, 2550}, {"YL", 5700, 2500}, {"LY", 5530, 2400},
+    {"SP", 5200, 1950}, {"SN", 5200, 1950}, {"SO", 5200, 1950}, {"SQ", 5200, 1950}, {"SR", 5200, 1950},
+    {"HF", 5200, 1950}, {"3Z", 5200, 1950},
+    {"OK", 4980, 1550}, {"OL", 4980, 1550}, {"OM", 4870, 1950}, {"HA", 4720, 1950}, {"HG", 4720, 1950},
+    {"YO", 4580, 2500}, {"YP", 4580, 2500}, {"YQ", 4580, 2500}, {"YR", 4580, 2500}, {"LZ", 4270, 2530},
+    {"SV", 3900, 2200}, {"SW", 3900, 2200}, {"SX", 3900, 2200}, {"SY", 3900, 2200}, {"SZ", 3900, 2200},
+    {"J4", 3900, 2200}, {"SV9", 3520, 2490}, {"SV5", 3620, 2800},
+    {"TA", 3900, 3500}, {"TB", 3900, 3500}, {"TC", 3900, 3500}, {"YM", 3900, 3500},
+    {"5B", 3500, 3300}, {"C4", 3500, 3300}, {"H2", 3500, 3300}, {"P3", 3500, 3300},
+    {"ZB", 3610, -535}, {"S5", 4610, 1480}, {"9A", 4520, 1550}, {"E7", 4400, 1780},
+    {"YU", 4400, 2080}, {"YT", 4400, 2080}, {"4O", 4270, 1930}, {"Z3", 4160, 2170},
+    {"ZA", 4100, 2000}, {"Z6", 4260, 2090}, {"ER", 4700, 2850},
+    {"UR", 4900, 3200}, {"US", 4900, 3200}, {"UT", 4900, 3200}, {"UU", 4900, 3200}, {"UV", 4900, 3200},
+    {"UW", 4900, 3200}, {"UX", 4900, 3200}, {"UY", 4900, 3200}, {"UZ", 4900, 3200},
+    {"EM", 4900, 3200}, {"EN", 4900, 3200}, {"EO", 4900, 3200},
+    {"EU", 5370, 2800}, {"EV", 5370, 2800}, {"EW", 5370, 2800},
+    {"R", 5600, 3800}, {"UA", 5600, 3800}, {"UB", 5600, 3800}, {"UC", 5600, 3800}, {"UD", 5600, 3800},
+    {"UE", 5600, 3800}, {"UF", 5600, 3800}, {"UG", 5600, 3800}, {"UH", 5600, 3800}, {"UI", 5600, 3800},
+    // Asia
+    {"JA", 3600, 13800}, {"JE", 3600, 13800}, {"JF", 3600, 13800}, {"JG", 3600, 13800},
+    {"JH", 3600, 13800}, {"JI", 3600, 13800}, {"JJ", 3600, 13800}, {"JK", 3600, 13800},
+    {"JL", 3600, 13800}, {"JM", 3600, 13800}, {"JN", 3600, 13800}, {"JO", 3600, 13800},
+    {"JP", 3600, 13800}, {"JQ", 3600, 13800}, {"JR", 3600, 13800}, {"JS", 3600, 13800},
+    {"7J", 3600, 13800}, {"7K", 3600, 13800}, {"7L", 3600, 13800}, {"7M", 3600, 13800}, {"7N", 3600, 13800},
+    {"8J", 3600, 13800}, {"8N", 3600, 13800},
+    {"B", 3500, 10500}, {"BV", 2370, 12100}, {"BU", 2370, 12100}, {"BX", 2370, 12100}, {"BM", 2370, 12100},
+    {"VR", 2230, 11420}, {"XX9", 2220, 11355},
+    {"HL", 3650, 12780}, {"DS", 3650, 12780}, {"6K", 3650, 12780}, {"6L", 3650, 12780},
+    {"6M", 3650, 12780}, {"6N", 3650, 12780}, {"P5", 4000, 12700},
+    {"DU", 1200, 12200}, {"DV", 1200, 12200}, {"DW", 1200, 12200}, {"DX", 1200, 12200},
+    {"DY", 1200, 12200}, {"DZ", 1200, 12200}, {"4D", 1200, 12200}, {"4F", 1200, 12200},
+    {"HS", 1500, 10100}, {"E2", 1500, 10100}, {"XV", 1600, 10700}, {"3W", 1600, 10700},
+    {"XU", 1250, 10500}, {"XW", 1800, 10300}, {"XZ", 2000, 9600},
+    {"9M2", 400, 10200}, {"9M4", 400, 10200}, {"9W2", 400, 10200}, {"9M6", 300, 11350}, {"9M8", 300, 11350},
+    {"9V", 135, 10380}, {"V8", 450, 11470},
+    {"YB", -200, 11800}, {"YC", -200, 11800}, {"YD", -200, 11800}, {"YE", -200, 11800},
+    {"YF", -200, 11800}, {"YG", -200, 11800}, {"YH", -200, 11800},
+    {"VU", 2200, 7900}, {"AT", 2200, 7900}, {"4S", 780, 8070}, {"AP", 3000, 7000},
+    {"S2", 2370, 9030}, {"9N", 2800, 8400}, {"A5", 2750, 9050}, {"8Q", 320, 7320},
+    {"EP", 3250, 5400}, {"EQ", 3250, 5400}, {"YI", 3300, 4400}, {"4X", 3150, 3500}, {"4Z", 3150, 3500},
+    {"JY", 3100, 3650}, {"OD", 3390, 3580}, {"YK", 3500, 3850},
+    {"HZ", 2400, 4500}, {"7Z", 2400, 4500}, {"8Z", 2400, 4500}, {"A6", 2400, 5450},
+    {"A7", 2530, 5120}, {"A9", 2600, 5050}, {"A4", 2100, 5700}, {"9K", 2930, 4780}, {"7O", 1550, 4750},
+    {"4J", 4030, 4780}, {"4K", 4030, 4780}, {"4L", 4200, 4350}, {"EK", 4020, 4500},
+    {"UN", 4800, 6700}, {"UO", 4800, 6700}, {"UP", 4800, 6700}, {"UQ", 4800, 6700},
+    {"EX", 4150, 7450}, {"EY", 3880, 7100}, {"EZ", 3900, 5950}, {"UK", 4150, 6450},
+    {"JT", 4700, 10400}, {"YA", 3400, 6600}, {"T6", 3400, 6600},
+    // Africa
+    {"CN", 3200, -600}, {"5C", 3200, -600}, {"7X", 2800, 260}, {"3V", 3400, 950}, {"5A", 2700, 1700},
+    {"SU", 2700, 3000}, {"ST", 1550, 3000}, {"ET", 900, 3950}, {"E3", 1520, 3900}, {"J2", 1160, 4310},
+    {"6O", 500, 4600}, {"T5", 500, 4600}, {"5Z", 0, 3800}, {"5X", 130, 3230}, {"5H", -630, 3500},
+    {"9X", -200, 3000}, {"9U", -330, 2990}, {"9Q", -300, 2350}, {"TN", -70, 1500}, {"TJ", 550, 1250},
+    {"TR", -60, 1160}, {"5N", 900, 800}, {"9G", 790, -100}, {"TU", 750, -550}, {"TY", 930, 230},
+    {"5V", 850, 110}, {"XT", 1230, -170}, {"TZ", 1700, -400}, {"5U", 1700, 900}, {"TT", 1540, 1870},
+    {"TL", 660, 2090}, {"6W", 1450, -1450}, {"C5", 1340, -1540}, {"J5", 1200, -1500}, {"3X", 1040, -1090},
+    {"9L", 850, -1180}, {"EL", 640, -940}, {"5T", 2030, -1030}, {"D4", 1600, -2400},
+    {"D2", -1230, 1750}, {"9J", -1350, 2780}, {"Z2", -1900, 2980}, {"7Q", -1330, 3430},
+    {"C9", -1870, 3550}, {"A2", -2230, 2470}, {"V5", -2250, 1700},
+    {"ZS", -2900, 2450}, {"ZR", -2900, 2450}, {"ZT", -2900, 2450}, {"ZU", -2900, 2450},
+    {"7P", -2950, 2820}, {"3DA", -2650, 3150}, {"5R", -1900, 4670}, {"3B8", -2030, 5760},
+    {"FR", -2110, 5550}, {"S7", -460, 5550}, {"D6", -1180, 4350}, {"ZD7", -1595, -570},
+    {"ZD8", -795, -1440}, {"3C", 170, 1030}, {"S9", 30, 670},
+    // Oceania
+    {"VK", -2500, 13400}, {"AX", -2500, 13400}, {"ZL", -4100, 17400}, {"FK", -2130, 16550},
+    {"3D2", -1780, 17800}, {"YJ", -1600, 16750}, {"H4", -940, 16000}, {"P2", -650, 14500},
+    {"T8", 750, 13460}, {"V6", 690, 15820}, {"V7", 710, 17140}, {"T2", -850, 17920},
+    {"T30", 140, 17300}, {"5W", -1380, -17200}, {"A3", -2120, -17520}, {"E5", -2120, -15980},
+    {"FO", -1760, -14950}
+  };
+
+  const char* const CALL_MODIFIERS[] = { "P", "M", "MM", "AM", "QRP", "A", "LH" };
+
+  bool isCallModifier(const char* part) {
+    if (strlen(part) == 1 && isdigit(part[0])) return true;
+    for (const char* modifier : CALL_MODIFIERS) {
+      if (strcmp(part, modifier) == 0) return true;
+    }
+    return false;
+  }
+
+  // Picks the part of a portable callsign that identifies the entity:
+  // "EA8/DL1ABC" and "DL1ABC/EA8" both resolve to EA8, "DL1ABC/P" to DL1ABC.
+  void extractPrefixPart(const char* call, char* out, size_t outSize) {
+    char buffer[16];
+    strlcpy(buffer, call, sizeof(buffer));
+    for (char* p = buffer; *p; ++p) *p = toupper(*p);
+
+    out[0] = '\0';
+    char* savePtr = nullptr;
+    for (char* part = strtok_r(buffer, "/", &savePtr); part; part = strtok_r(nullptr, "/", &savePtr)) {
+      if (isCallModifier(part)) continue;
+      if (out[0] == '\0' || strlen(part) < strlen(out)) strlcpy(out, part, outSize);
+    }
+  }
+}
+
+// Converts a 4 or 6 character Maidenhead locator to the centre of its square
+// in centidegrees. Returns false if the locator is malformed.
+bool locatorToLatLon(const char* locator, int16_t& latitude, int16_t& longitude) {
+  size_t len = strlen(locator);
+  if (len != 4 && len != 6) return false;
+
+  char field0 = toupper(locator[0]);
+  char field1 = toupper(locator[1]);
+  if (field0 < 'A' || field0 > 'R' || field1 < 'A' || field1 > 'R') return false;
+  if (!isdigit(locator[2]) || !isdigit(locator[3])) return false;
+
+  int32_t lon = (field0 - 'A') * 2000 - 18000 + (locator[2] - '0') * 200;
+  int32_t lat = (field1 - 'A') * 1000 - 9000 + (locator[3] - '0') * 100;
+
+  if (len == 6) {
+    char sub0 = tolower(locator[4]);
+    char sub1 = tolower(locator[5]);
+    if (sub0 < 'a' || sub0 > 'x' || sub1 < 'a' || sub1 > 'x') return false;
+    // Subsquares are 5' of longitude by 2.5' of latitude
+    lon += (sub0 - 'a') * 500 / 60 + 4;
+    lat += (sub1 - 'a') * 250 / 60 + 2;
+  } else {
+    lon += 100;
+    lat += 50;
+  }
+
+  latitude = lat;
+  longitude = lon;
+  return true;
+}
+
+// Looks up the approximate location of a callsign's DXCC entity.
+bool lookupCallsignLocation(const char* call, int16_t& latitude, int16_t& longitude) {
+  char prefix[12];
+  extractPrefixPart(call, prefix, sizeof(prefix));
+  if (prefix[0] == '\0') return false;
+
+  // Russian calls share letter prefixes between Europe and Asia; the call
+  // area digit tells them apart (0, 8 and 9 are Asiatic, 2 is Kaliningrad).
+  if (prefix[0] == 'R' || (prefix[0] == 'U' && prefix[1] >= 'A' && prefix[1] <= 'I')) {
+    const char* digit = prefix;
+    while (*digit && !isdigit(*digit)) digit++;
+    if (*digit == '0' || *digit == '8' || *digit == '9') {
+      latitude = 6000;
+      longitude = 9000;
+      return true;
+    }
+    if (*digit == '2') {
+      latitude = 5470;
+      longitude = 2050;
+      return true;
+    }
+  }
+
+  const PrefixLocation* best = nullptr;
+  size_t bestLength = 0;
+  for (const PrefixLocation& entry : PREFIX_TABLE) {
+    size_t length = strlen(entry.prefix);
+    if (length > bestLength && strncmp(prefix, entry.prefix, length) == 0) {
+      best = &entry;
+      bestLength = length;
+    }
+  }
+  if (!best) return false;
+
+  latitude = best->latitude;
+  longitude = best->longitude;
+  return true;
+}
@@ -0,0 +1,157 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include "esp_rom_crc.h"
+
+// Run-length glyph atlas for the free fonts on the busy screens. TFT_eSPI
+// draws a GFX glyph by testing its bitmap one bit at a time; the atlas keeps
+// each glyph as alternating background/foreground runs (starting with
+// background, runs over 255 split by a zero-length run, as in world_map.h)
+// so the frame gets one horizontal span per run instead of one call per pixel.
+// The runs are generated from the TFT_eSPI font headers by
+// tools/make_glyph_atlas.py into glyph_atlas.h and stay in flash. Without
+// that header every font is drawn by the library.
+
+struct GlyphAtlas {
+  const GFXfont* font;
+  const uint16_t* glyphStart; // Offset of each glyph's runs; one extra entry marks the end
+  const uint8_t* runs;
+  uint32_t fontCrc;           // Of the font the runs were made from, see fontCrc()
+};
+
+#if __has_include("glyph_atlas.h")
+#include "glyph_atlas.h"
+#else
+#define GLYPH_ATLAS_COUNT 0
+const GlyphAtlas* const GLYPH_ATLASES = nullptr;
+#endif
+
+namespace {
+  uint32_t validAtlases = 0; // Bit per GLYPH_ATLASES entry that matches its font
+  bool atlasEnabled = true;
+
+  static_assert(GLYPH_ATLAS_COUNT <= 32, "validAtlases has a bit per atlas");
+
+  // CRC32 of what the runs depend on, as make_glyph_atlas.py computes it:
+  // the character range, the bitmap up to the end of the last glyph, then
+  // each glyph's bitmap offset and size.
+  uint32_t fontCrc(const GFXfont* font) {
+    const int glyphCount = font->last - font->first + 1;
+    const uint8_t range[] = { (uint8_t)font->first, (uint8_t)(font->first >> 8), (uint8_t)font->last, (uint8_t)(font->last >> 8) };
+    uint32_t crc = esp_rom_crc32_le(0, range, sizeof(range));
+    uint32_t bitmapBytes = 0;
+    for (int i = 0; i < glyphCount; i++) {
+      const GFXglyph& glyph = font->glyph[i];
+      bitmapBytes = max(bitmapBytes, (uint32_t)(glyph.bitmapOffset + (glyph.width * glyph.height + 7) / 8));
+    }
+    crc = esp_rom_crc32_le(crc, font->bitmap, bitmapBytes);
+    for (int i = 0; i < glyphCount; i++) {
+      const GFXglyph& glyph = font->glyph[i];
+      const uint8_t shape[] = { (uint8_t)glyph.bitmapOffset, (uint8_t)(glyph.bitmapOffset >> 8), glyph.width, glyph.height };
+      crc = esp_rom_crc32_le(crc, shape, sizeof(shape));
+    }
+    return crc;
+  }
+
+  const GlyphAtlas* findAtlas(const GFXfont* font) {
+    for (int i = 0; i < GLYPH_ATLAS_COUNT; i++) {
+      if (GLYPH_ATLASES[i].font == font) return (validAtlases & (1UL << i)) ? &GLYPH_ATLASES[i] : nullptr;
+    }
+    return nullptr;
+  }
+}
+
+// Checks each generated atlas against the font it was made from. One made
+// from another TFT_eSPI version's font is left unused.
+void checkGlyphAtlases() {
+  size_t totalBytes = 0;
+  for (int i = 0; i < GLYPH_ATLAS_COUNT; i++) {
+    const GlyphAtlas& atlas = GLYPH_ATLASES[i];
+    if (fontCrc(atlas.font) != atlas.fontCrc) {
+      Serial.println("Glyph atlas does not match its font, using the font bitmaps. Rerun tools/make_glyph_atlas.py.");
+      continue;
+    }
+    validAtlases |= 1UL << i;
+    const int glyphCount = atlas.font->last - atlas.font->first + 1;
+    totalBytes += (glyphCount + 1) * sizeof(uint16_t) + pgm_read_word(&atlas.glyphStart[glyphCount]);
+  }
+  Serial.printf("Glyph atlases: %d fonts, %u bytes in flash.\n", __builtin_popcount(validAtlases), (unsigned)totalBytes);
+}
+
+// Draws a glyph with its baseline origin at (x, y), as TFT_eSPI does for free
+// fonts, and returns the number of pixels set. Returns -1 when the font has
+// no atlas, so the caller falls back.
+int32_t drawAtlasGlyph(TFT_eSprite& frame, const GFXfont* font, uint16_t c, int32_t x, int32_t y, uint32_t color) {
+  if (!atlasEnabled) return -1;
+  const GlyphAtlas* atlas = findAtlas(font);
+  if (!atlas) return -1;
+  if (c < font->first || c > font->last) return 0; // Not in the font: nothing to draw
+
+  const int index = c - font->first;
+  const GFXglyph& glyph = font->glyph[index];
+  const int width = glyph.width;
+  if (width == 0) return 0;
+  int32_t pixels = 0;
+  x += glyph.xOffset;
+  y += glyph.yOffset;
+
+  const uint8_t* run = atlas->runs + pgm_read_word(&atlas->glyphStart[index]);
+  const uint8_t* end = atlas->runs + pgm_read_word(&atlas->glyphStart[index + 1]);
+  int position = 0;
+  bool foreground = false;
+  for (; run < end; run++, foreground = !foreground) {
+    int length = pgm_read_byte(run);
+    // A foreground run can wrap onto following rows of the glyph
+    if (foreground) pixels += length;
+    for (int p = position; foreground && p < position + length;) {
+      int column = p % width;
+      int span = min(position + length - p, width - column);
+      frame.TFT_eSprite::drawFastHLine(x + column, y + p / width, span, color);
+      p += span;
+    }
+    position += length;
+  }
+  return pixels;
+}
+
+#if GLYPH_ATLAS_BENCHMARK
+// Times a typical spot list row drawn into the frame with and without the
+// atlas. Runs before anything else is on screen; the frame is cleared after.
+void runGlyphAtlasBenchmark() {
+  const int ROWS = 50;
+  unsigned long elapsed[2];
+
+  for (int pass = 0; pass < 2; pass++) {
+    atlasEnabled = (pass == 1);
+    unsigned long start = micros();
+    for (int i = 0; i < ROWS; i++) {
+      int yPos = 20 + (i % 6) * SPOT_LINE_HEIGHT;
+      tft.setFreeFont(&FreeSans9pt7b);
+      tft.setTextDatum(TR_DATUM);
+      tft.setTextColor(TFT_WHITE, TFT_BLACK);
+      tft.drawString("12m", SPOT_COL_TIME_X, yPos);
+      tft.setTextDatum(TL_DATUM);
+      tft.setTextColor(TFT_CYAN, TFT_BLACK);
+      tft.drawString("VP2V/W6XYZ", SPOT_COL_CALL_X, yPos);
+      tft.setTextColor(TFT_ORANGE, TFT_BLACK);
+      tft.drawString("FT8", SPOT_COL_MODE_X, yPos);
+      tft.setTextDatum(TR_DATUM);
+      tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+      tft.drawString("14074.0", tft.width() - SPOT_COL_FREQ_X_MARGIN, yPos);
+    }
+    elapsed[pass] = micros() - start;
+  }
+  atlasEnabled = true;
+  tft.fillScreen(TFT_BLACK);
+
+  Serial.printf("Spot row: %.3f ms with font bitmaps, %.3f ms with glyph atlas.\n",
+                elapsed[0] / 1000.0f / ROWS, elapsed[1] / 1000.0f / ROWS);
+}
+#endif
@@ -0,0 +1,128 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+namespace {
+  // The GitHub check gets its own client so it never tears down a kept-alive
+  // HamQSL connection (and vice versa). Each client also keeps its host's
+  // TLS session, so a new connection to it resumes the last one.
+  TlsClient githubClient;
+
+  struct HttpsConnection {
+    const char* host;
+    int port;
+    TlsClient* client;
+    unsigned long lastUsedTime;
+    unsigned long requestStartTime;
+    uint32_t heapBeforeRequest;
+    uint32_t lowWaterBeforeRequest;
+    uint32_t minFreeHeap;
+    HttpsRequestStats stats;
+  };
+
+  HttpsConnection connections[HTTPS_HOST_COUNT] = {
+    { PROP_HOST, HTTPS_PORT, &secureClient, 0, 0, 0, 0, 0, HttpsRequestStats() },
+    { GITHUB_API_HOST, HTTPS_PORT, &githubClient, 0, 0, 0, 0, 0, HttpsRequestStats() }
+  };
+
+  // Free heap is sampled at each stage of a request, and by the client
+  // between the steps of the handshake; the lowest sample gives the
+  // transient heap cost of the TLS session and response buffers. If the
+  // heap's low-water mark fell during the request, that is its exact low.
+  void sampleHeap(HttpsConnection& conn) {
+    uint32_t freeHeap = min(ESP.getFreeHeap(), conn.client->getLowestFreeHeap());
+    const uint32_t lowWater = ESP.getMinFreeHeap();
+    if (lowWater < conn.lowWaterBeforeRequest) freeHeap = min(freeHeap, lowWater);
+    if (freeHeap < conn.minFreeHeap) conn.minFreeHeap = freeHeap;
+  }
+}
+
+void setupHttpsClients() {
+  // Keep the HamQSL connection open between requests; it is closed by
+  // closeIdleHttpsConnections() once it has been idle for a while.
+  httpClient.connectionKeepAlive();
+}
+
+// Returns a connected client for the host, reusing a kept-alive connection
+// when one is still open and resuming the last TLS session otherwise.
+// Returns nullptr if the TLS connection fails.
+TlsClient* beginHttpsRequest(HttpsHostId hostId) {
+  HttpsConnection& conn = connections[hostId];
+  conn.requestStartTime = millis();
+  conn.heapBeforeRequest = ESP.getFreeHeap();
+  conn.lowWaterBeforeRequest = ESP.getMinFreeHeap();
+  conn.minFreeHeap = conn.heapBeforeRequest;
+  conn.client->resetLowestFreeHeap();
+
+  if (conn.client->connected()) {
+    conn.stats.reusedConnection = true;
+    conn.stats.handshakeMs = 0;
+    conn.stats.reuseCount++;
+    return conn.client;
+  }
+
+  conn.client->stop(); // Release any half-closed session before reconnecting
+  conn.stats.reusedConnection = false;
+  conn.stats.resumedSession = false;
+  unsigned long handshakeStart = millis();
+  bool connected;
+  {
+    CPU_BOOST_SCOPE(); // The TLS handshake is mostly public key arithmetic
+    connected = conn.client->connect(conn.host, conn.port);
+  }
+  if (!connected) {
+    Serial.printf("HTTPS connection to %s failed.\n", conn.host);
+    conn.client->stop();
+    return nullptr;
+  }
+  conn.stats.handshakeMs = millis() - handshakeStart;
+  conn.stats.handshakeCount++;
+  if (conn.client->resumedSession()) {
+    conn.stats.resumedSession = true;
+    conn.stats.resumeCount++;
+  }
+  sampleHeap(conn);
+  return conn.client;
+}
+
+// Finishes a request and reports its cost. With keepAlive the connection is
+// left open for the next request to the same host.
+void endHttpsRequest(HttpsHostId hostId, bool keepAlive) {
+  HttpsConnection& conn = connections[hostId];
+  sampleHeap(conn);
+
+  conn.stats.requestMs = millis() - conn.requestStartTime;
+  conn.stats.peakHeapBytes = conn.heapBeforeRequest - conn.minFreeHeap;
+  conn.lastUsedTime = millis();
+
+  if (!keepAlive) {
+    conn.client->stop();
+  }
+
+  Serial.printf("HTTPS %s: %s %lu ms, request %lu ms, peak heap %u bytes\n",
+                conn.host,
+                conn.stats.reusedConnection ? "reused connection," : conn.stats.resumedSession ? "resumed handshake" : "full handshake",
+                conn.stats.handshakeMs, conn.stats.requestMs, conn.stats.peakHeapBytes);
+}
+
+// Closes kept-alive connections that have been idle too long to be worth the
+// heap they hold. The server would drop them soon anyway.
+void closeIdleHttpsConnections() {
+  for (int i = 0; i < HTTPS_HOST_COUNT; i++) {
+    HttpsConnection& conn = connections[i];
+    if (conn.client->connected() && millis() - conn.lastUsedTime > HTTPS_KEEPALIVE_IDLE_MS) {
+      conn.client->stop();
+    }
+  }
+}
+
+const HttpsRequestStats& getHttpsStats(HttpsHostId hostId) {
+  return connections[hostId].stats;
+}
@@ -0,0 +1,114 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include "esp_wifi.h"
+#include "driver/gpio.h"
+
+// Low power mode, for a display left on around the clock. The radio sleeps
+// through a few of the access point's beacons at a time (modem sleep), and
+// the chip drops into light sleep whenever every task is blocked, which
+// with the timer wheel is most of the time between deadlines. A touch (the
+// IRQ line) or a frame from the access point wakes it. The longest a spot
+// may wait is split evenly between the beacons the radio sleeps through
+// and the telnet poll period.
+//
+// How much of the time the chip is awake is read off the CPU cycle
+// counter, which stops in light sleep, against esp_timer, which does not.
+// The counter runs at whichever clock the governor picked, so the cycles
+// spent boosted are taken out at the boosted rate. It is read on every
+// pass of loop(), which wakes at least every SCHEDULER_MAX_WAIT_MS, well
+// inside the 17 s the counter takes to wrap at the boosted clock.
+
+namespace {
+  static_assert(SCHEDULER_MAX_WAIT_MS * 1000ULL * CPU_BOOST_MHZ < (1ULL << 32), "The cycle counter would wrap between samples");
+
+  uint32_t lastCycles = 0;
+  uint64_t lastBoostedUs = 0;
+  int64_t lastSampleUs = 0;
+  uint64_t awakeUs = 0;
+  uint64_t sampledUs = 0;
+}
+
+// Beacons the radio sleeps through in low power mode.
+uint16_t getWifiListenInterval(const ApplicationState& state) {
+  const int interval = state.power.maxSpotDelayMs / 2 / WIFI_BEACON_INTERVAL_MS;
+  return constrain(interval, 1, WIFI_MAX_LISTEN_INTERVAL);
+}
+
+unsigned long getTelnetPollInterval(const ApplicationState& state) {
+  if (!state.power.lowPowerMode) return TELNET_POLL_INTERVAL_MS;
+  return max(TELNET_POLL_INTERVAL_MS, (unsigned long)state.power.maxSpotDelayMs / 2);
+}
+
+// Starts connecting like WiFi.begin(), which cannot set the listen
+// interval, so the station is configured directly. The access point keeps
+// frames for as many beacons as the interval sent when associating.
+void beginLowPowerWifi(const ApplicationState& state, const char* ssid, const char* password, uint8_t channel, const uint8_t* bssid) {
+  WiFi.mode(WIFI_STA);
+  wifi_config_t config = {};
+  strlcpy((char*)config.sta.ssid, ssid, sizeof(config.sta.ssid));
+  strlcpy((char*)config.sta.password, password, sizeof(config.sta.password));
+  config.sta.channel = channel;
+  config.sta.bssid_set = channel > 0;
+  if (config.sta.bssid_set) memcpy(config.sta.bssid, bssid, sizeof(config.sta.bssid));
+  config.sta.listen_interval = getWifiListenInterval(state);
+  esp_wifi_set_config(WIFI_IF_STA, &config);
+  esp_wifi_connect();
+}
+
+// Lets the radio and the chip sleep in low power mode. The listen interval
+// was set when WiFi was started; light sleep is up to the CPU governor.
+void applyPowerMode(const ApplicationState& state) {
+  if (!state.power.lowPowerMode) return;
+  WiFi.setSleep(WIFI_PS_MAX_MODEM);
+
+  // A level wake-up: the touch interrupt is level-triggered to match
+  gpio_wakeup_enable((gpio_num_t)TOUCH_IRQ, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+
+  if (!configureCpuGovernor(true)) {
+    Serial.println("Light sleep unavailable, using modem sleep only.");
+    return;
+  }
+  Serial.printf("Low power mode: listen interval %u, telnet poll %lu ms.\n", getWifiListenInterval(state), getTelnetPollInterval(state));
+}
+
+// Adds the time since the last call to the awake statistics. Called from
+// handleRuntime() on every pass of loop().
+void samplePowerStats(ApplicationState& state) {
+  const uint32_t cycles = ESP.getCycleCount();
+  const uint64_t boostedUs = getCpuGovernorStats().boostedUs;
+  const int64_t now = esp_timer_get_time();
+  if (lastSampleUs != 0) {
+    const uint64_t elapsed = now - lastSampleUs;
+    const uint64_t boosted = boostedUs - lastBoostedUs;
+    const uint64_t boostedCycles = boosted * CPU_BOOST_MHZ;
+    const uint32_t spent = cycles - lastCycles;
+    uint64_t awake = boosted + (spent > boostedCycles ? (spent - boostedCycles) / CPU_IDLE_MHZ : 0);
+    if (awake > elapsed) awake = elapsed; // The counter wrapped during a long block
+    awakeUs += awake;
+    sampledUs += elapsed;
+  }
+  lastCycles = cycles;
+  lastBoostedUs = boostedUs;
+  lastSampleUs = now;
+}
+
+// Share of the time since startup the chip was awake, in percent.
+int getAwakePercent() {
+  return sampledUs > 0 ? (int)(awakeUs * 100 / sampledUs) : 100;
+}
+
+// Rough average current of the ESP32 module, without the display.
+int getEstimatedCurrentMa(const ApplicationState& state) {
+  if (!state.power.lowPowerMode) return POWER_ACTIVE_MA;
+  const int awake = getAwakePercent();
+  return (awake * POWER_MODEM_SLEEP_MA + (100 - awake) * POWER_LIGHT_SLEEP_MA) / 100;
+}
@@ -0,0 +1,142 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+#if ENABLE_PROFILER
+
+// Timing of the drawing and touch paths. Every section keeps its count,
+// total, min and max, plus a fixed histogram with two buckets per power of
+// two microseconds, which is enough to read a p99 to within 25% without
+// storing samples.
+
+namespace {
+  const int PROFILE_BUCKETS = 48; // Up to 2^24 us, far beyond any draw call
+
+  const char* const SECTION_NAMES[PROF_SECTION_COUNT] = {
+    "Spots", "Spots+Prop", "Clock", "Propagation", "Grey Line", "Band Map",
+    "Spot Map", "Grace Period", "Settings Menu", "Display Set.", "Audio Set.", "Sleep Set.", "System Set.",
+    "Info", "Updates", "Wi-Fi Reset", "Spot Times", "Prop Footer", "Touch", "Flush", "Audio Block"
+  };
+
+  struct SectionStats {
+    uint32_t count;
+    uint64_t totalMicros;
+    uint32_t minMicros;
+    uint32_t maxMicros;
+    uint32_t histogram[PROFILE_BUCKETS];
+  };
+
+  // Sections are recorded from loop() and the audio task and read from the
+  // web server's task, so every access goes through the lock.
+  SectionStats sections[PROF_SECTION_COUNT];
+  portMUX_TYPE sectionsLock = portMUX_INITIALIZER_UNLOCKED;
+
+  SectionStats snapshotSection(int section) {
+    portENTER_CRITICAL(&sectionsLock);
+    const SectionStats stats = sections[section];
+    portEXIT_CRITICAL(&sectionsLock);
+    return stats;
+  }
+
+  int bucketFor(uint32_t micros) {
+    if (micros < 2) return micros; // [0, 1) and [1, 2), below the first split octave
+    int octave = 31 - __builtin_clz(micros);
+    int half = (micros >> (octave - 1)) & 1; // The bit below the top one
+    return min(octave * 2 + half, PROFILE_BUCKETS - 1);
+  }
+
+  // Exclusive upper edge of a bucket, in microseconds.
+  uint32_t bucketLimit(int bucket) {
+    int octave = bucket / 2;
+    return (bucket % 2) ? (2UL << octave) : (1UL << octave) + (1UL << octave) / 2;
+  }
+
+  uint32_t percentileMicros(const SectionStats& stats, int percent) {
+    uint32_t rank = (stats.count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < PROFILE_BUCKETS; i++) {
+      seen += stats.histogram[i];
+      if (seen >= rank) return min(bucketLimit(i), stats.maxMicros);
+    }
+    return stats.maxMicros;
+  }
+
+  float averageMs(const SectionStats& stats) {
+    return stats.count ? stats.totalMicros / 1000.0f / stats.count : 0;
+  }
+}
+
+// The conversion uses the clock at the end of the sample, so a section that
+// spans a CPU frequency change is off by the ratio of the two clocks.
+void recordProfileSample(ProfileSection section, uint32_t cycles) {
+  uint32_t micros = cycles / ESP.getCpuFreqMHz();
+  const int bucket = bucketFor(micros);
+  portENTER_CRITICAL(&sectionsLock);
+  SectionStats& stats = sections[section];
+  if (stats.count == 0 || micros < stats.minMicros) stats.minMicros = micros;
+  if (micros > stats.maxMicros) stats.maxMicros = micros;
+  stats.count++;
+  stats.totalMicros += micros;
+  stats.histogram[bucket]++;
+  portEXIT_CRITICAL(&sectionsLock);
+}
+
+// One line per section that has run, in milliseconds. Served by /profile.
+String getProfilerReport() {
+  String report = "Section          count    min    avg    p99    max (ms)\n";
+  char line[80];
+  for (int i = 0; i < PROF_SECTION_COUNT; i++) {
+    const SectionStats stats = snapshotSection(i);
+    if (stats.count == 0) continue;
+    snprintf(line, sizeof(line), "%-14s %7lu %6.2f %6.2f %6.2f %6.2f\n", SECTION_NAMES[i], (unsigned long)stats.count,
+             stats.minMicros / 1000.0f, averageMs(stats), percentileMicros(stats, 99) / 1000.0f, stats.maxMicros / 1000.0f);
+    report += line;
+  }
+  return report;
+}
+
+// Shows the slowest section by p99, and touch handling, in the top right
+// corner of whatever screen is up.
+void drawProfilerOverlay() {
+  int slowest = -1;
+  SectionStats slowestStats;
+  for (int i = 0; i < PROF_SECTION_COUNT; i++) {
+    if (i == PROF_HANDLE_TOUCH) continue;
+    const SectionStats stats = snapshotSection(i);
+    if (stats.count == 0) continue;
+    if (slowest < 0 || percentileMicros(stats, 99) > percentileMicros(slowestStats, 99)) {
+      slowest = i;
+      slowestStats = stats;
+    }
+  }
+
+  char slowestLine[40];
+  char touchLine[40];
+  if (slowest >= 0) {
+    snprintf(slowestLine, sizeof(slowestLine), "%s %.1f/%.1f", SECTION_NAMES[slowest],
+             averageMs(slowestStats), percentileMicros(slowestStats, 99) / 1000.0f);
+  } else {
+    strlcpy(slowestLine, "No samples", sizeof(slowestLine));
+  }
+  const SectionStats touch = snapshotSection(PROF_HANDLE_TOUCH);
+  snprintf(touchLine, sizeof(touchLine), "Touch %.1f/%.1f", averageMs(touch), percentileMicros(touch, 99) / 1000.0f);
+
+  const int x = tft.width() - PROFILER_OVERLAY_W;
+  tft.fillRect(x, 0, PROFILER_OVERLAY_W, PROFILER_OVERLAY_H, TFT_BLACK);
+  tft.drawRect(x, 0, PROFILER_OVERLAY_W, PROFILER_OVERLAY_H, TFT_DARKGREY);
+  tft.setFreeFont(&FreeSans9pt7b);
+  tft.setTextDatum(TR_DATUM);
+  tft.setTextColor(TFT_YELLOW);
+  tft.drawString(slowestLine, tft.width() - 4, 2);
+  tft.drawString(touchLine, tft.width() - 4, PROFILER_OVERLAY_H / 2);
+  tft.setTextDatum(TL_DATUM);
+}
+
+#endif // ENABLE_PROFILER
@@ -0,0 +1,68 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "constants.h"
+
+// PROFILE_SCOPE(section) times the rest of the enclosing block with the CPU
+// cycle counter. With ENABLE_PROFILER at 0 it expands to nothing and none of
+// the profiler is compiled in.
+#if ENABLE_PROFILER
+
+enum ProfileSection {
+PROF_DRAW_SPOTS,
+PROF_DRAW_SPOTS_AND_PROP,
+PROF_DRAW_CLOCK,
+PROF_DRAW_PROPAGATION,
+PROF_DRAW_GREY_LINE,
+PROF_DRAW_BAND_MAP,
+PROF_DRAW_SPOT_MAP,
+PROF_DRAW_GRACE_PERIOD,
+PROF_DRAW_SETTINGS_MENU,
+PROF_DRAW_DISPLAY_SETTINGS,
+PROF_DRAW_AUDIO_SETTINGS,
+PROF_DRAW_SLEEP_SETTINGS,
+PROF_DRAW_SYSTEM_SETTINGS,
+PROF_DRAW_INFO,
+PROF_DRAW_UPDATES,
+PROF_DRAW_WIFI_RESET,
+PROF_UPDATE_SPOT_TIMES,
+PROF_DRAW_PROP_FOOTER,
+PROF_HANDLE_TOUCH,
+PROF_FLUSH_FRAME,
+PROF_AUDIO_BLOCK,
+PROF_SECTION_COUNT
+};
+
+void recordProfileSample(ProfileSection section, uint32_t cycles);
+String getProfilerReport();
+void drawProfilerOverlay();
+
+class ProfileScope {
+public:
+  explicit ProfileScope(ProfileSection section) : section(section), startCycles(ESP.getCycleCount()) {}
+  ~ProfileScope() { recordProfileSample(section, ESP.getCycleCount() - startCycles); }
+
+private:
+  ProfileSection section;
+  uint32_t startCycles;
+};
+
+#define PROFILE_SCOPE(section) ProfileScope profileScope(section)
+
+#else
+
+#define PROFILE_SCOPE(section)
+
+#endif // ENABLE_PROFILER
+
+#endif // PROFILER_H
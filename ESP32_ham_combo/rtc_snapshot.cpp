@@ -0,0 +1,115 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include <sys/time.h>
+#include "esp_rom_crc.h"
+#include "esp_rtc_time.h"
+
+// What the screens showed when the device went to deep sleep, kept in RTC
+// slow memory, which stays powered while the rest of the chip is off. On a
+// wake-up the last screen is redrawn from it straight away, and the WiFi
+// hint lets the reconnect skip the channel scan. A CRC over the snapshot
+// rejects a power-on (RTC memory holds junk then) or a half-written one.
+
+namespace {
+  struct RtcSnapshot {
+    uint32_t crc;           // Of everything after it
+    uint16_t size;          // sizeof(RtcSnapshot) of the firmware that wrote it
+    uint8_t lastMainScreen;
+    uint8_t wifiChannel;    // 0 if WiFi was down
+    uint8_t wifiBssid[6];
+    int8_t spotCount;
+    int8_t latestSpotIndex;
+    bool propDataAvailable;
+    int64_t epoch;          // Wall clock at sleep, 0 if it was never synced
+    uint64_t rtcTimeUs;     // RTC timer at the same moment
+    int64_t propDataTime;
+    SolarPropagationData solarData;
+    DxSpot spots[ApplicationState::MAX_SPOTS];
+  };
+  static_assert(sizeof(RtcSnapshot) <= RTC_SNAPSHOT_MAX_BYTES, "RTC snapshot is over its RTC memory budget");
+
+  RTC_DATA_ATTR RtcSnapshot snapshot;
+
+  uint32_t snapshotCrc() {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&snapshot) + sizeof(snapshot.crc);
+    return esp_rom_crc32_le(0, data, sizeof(snapshot) - sizeof(snapshot.crc));
+  }
+
+  bool isSynced(time_t t) {
+    struct tm timeinfo;
+    gmtime_r(&t, &timeinfo);
+    return timeinfo.tm_year >= (2020 - 1900);
+  }
+}
+
+// Takes the snapshot. Call just before esp_deep_sleep_start().
+void saveRtcSnapshot(const ApplicationState& state) {
+  memset(&snapshot, 0, sizeof(snapshot));
+  snapshot.size = sizeof(snapshot);
+  snapshot.lastMainScreen = state.lastMainScreen;
+  if (WiFi.status() == WL_CONNECTED) {
+    snapshot.wifiChannel = WiFi.channel();
+    memcpy(snapshot.wifiBssid, WiFi.BSSID(), sizeof(snapshot.wifiBssid));
+  }
+  snapshot.spotCount = state.spotCount;
+  snapshot.latestSpotIndex = state.latestSpotIndex;
+  memcpy(snapshot.spots, state.spots, sizeof(snapshot.spots));
+  snapshot.propDataAvailable = state.propDataAvailable;
+  snapshot.propDataTime = state.propDataTime;
+  snapshot.solarData = state.solarData;
+  const time_t now = time(nullptr);
+  snapshot.epoch = isSynced(now) ? now : 0;
+  snapshot.rtcTimeUs = esp_rtc_get_time_us();
+  snapshot.crc = snapshotCrc();
+  Serial.printf("RTC snapshot saved (%u bytes).\n", (unsigned)sizeof(snapshot));
+}
+
+// Restores the snapshot after a deep sleep wake-up; it is used only once.
+// Fills in the WiFi channel and BSSID to reconnect to, or a channel of 0
+// if there are none. Returns false if there is no valid snapshot.
+bool restoreRtcSnapshot(ApplicationState& state, uint8_t& wifiChannel, uint8_t* wifiBssid) {
+  wifiChannel = 0;
+  if (snapshot.size != sizeof(snapshot) || snapshot.crc != snapshotCrc()) return false;
+  snapshot.size = 0;
+
+  // The system clock normally runs on through deep sleep. If it did not,
+  // carry the time at sleep forward by the RTC timer.
+  time_t now = time(nullptr);
+  if (!isSynced(now) && snapshot.epoch != 0) {
+    const uint64_t slept = esp_rtc_get_time_us() - snapshot.rtcTimeUs;
+    struct timeval tv = { (time_t)(snapshot.epoch + slept / 1000000ULL), 0 };
+    settimeofday(&tv, nullptr);
+    now = tv.tv_sec;
+  }
+
+  const bool stale = snapshot.epoch != 0 && isSynced(now) && (unsigned long)(now - snapshot.epoch) > SPOT_CACHE_MAX_AGE_S;
+  if (!stale && snapshot.spotCount > 0 && snapshot.spotCount <= ApplicationState::MAX_SPOTS &&
+      snapshot.latestSpotIndex >= 0 && snapshot.latestSpotIndex < ApplicationState::MAX_SPOTS) {
+    memcpy(state.spots, snapshot.spots, sizeof(state.spots));
+    state.spotCount = snapshot.spotCount;
+    state.latestSpotIndex = snapshot.latestSpotIndex;
+    for (int i = state.spotCount - 1; i >= 0; i--) { // Oldest first, as they arrived
+      addBandMapSpot(state.spots[(state.latestSpotIndex - i + ApplicationState::MAX_SPOTS) % ApplicationState::MAX_SPOTS]);
+    }
+  }
+
+  if (snapshot.propDataAvailable) {
+    state.solarData = snapshot.solarData;
+    state.propDataAvailable = true;
+    state.propDataTime = snapshot.propDataTime;
+  }
+  state.lastMainScreen = (ActiveScreen)snapshot.lastMainScreen;
+
+  wifiChannel = snapshot.wifiChannel;
+  memcpy(wifiBssid, snapshot.wifiBssid, sizeof(snapshot.wifiBssid));
+  Serial.printf("RTC snapshot restored: %d spot(s), solar data %s.\n", state.spotCount, state.propDataAvailable ? "present" : "missing");
+  return true;
+}
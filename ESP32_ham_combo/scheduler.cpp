@@ -0,0 +1,162 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+// Cooperative timers for loop(). Each timer hashes into a slot of a wheel
+// of TIMER_WHEEL_SLOTS ticks by its deadline; a pass over the wheel only
+// visits the slots for the ticks that went by since the last pass, so a
+// pass costs the same however many timers are pending and however far off
+// they are. Timers run in loop()'s task, one after another, so they share
+// state with the rest of the UI without locking. Between passes the loop
+// task sleeps until the next deadline, or until wakeMainLoop() is called
+// for new input.
+
+namespace {
+  static_assert((TIMER_WHEEL_SLOTS & (TIMER_WHEEL_SLOTS - 1)) == 0, "TIMER_WHEEL_SLOTS must be a power of two");
+  static_assert(TIMER_COUNT < 127, "Timer links are int8_t");
+
+  struct Timer {
+    TimerCallback callback;
+    uint32_t deadline;  // millis()
+    uint32_t period;    // 0 for a one-shot timer
+    int8_t prev;        // Neighbours in the slot's list, -1 at the ends
+    int8_t next;
+    bool running;
+    bool linked;        // In a slot's list; false while it waits in a due list
+  };
+
+  Timer timers[TIMER_COUNT];
+  int8_t slotHeads[TIMER_WHEEL_SLOTS];
+  uint32_t wheelTick = 0; // Last tick the wheel was advanced to
+  bool wheelReady = false;
+  TaskHandle_t loopTask = nullptr;
+
+  uint32_t slotOf(uint32_t deadline) {
+    return (deadline / TIMER_WHEEL_TICK_MS) & (TIMER_WHEEL_SLOTS - 1);
+  }
+
+  void resetWheel() {
+    for (int8_t& head : slotHeads) head = -1;
+    wheelTick = millis() / TIMER_WHEEL_TICK_MS;
+    wheelReady = true;
+  }
+
+  void link(int id) {
+    Timer& timer = timers[id];
+    int8_t& head = slotHeads[slotOf(timer.deadline)];
+    timer.prev = -1;
+    timer.next = head;
+    if (head >= 0) timers[head].prev = id;
+    head = id;
+    timer.linked = true;
+  }
+
+  void unlink(int id) {
+    Timer& timer = timers[id];
+    if (!timer.linked) return;
+    timer.linked = false;
+    if (timer.prev >= 0) timers[timer.prev].next = timer.next;
+    else slotHeads[slotOf(timer.deadline)] = timer.next;
+    if (timer.next >= 0) timers[timer.next].prev = timer.prev;
+  }
+}
+
+// Runs callback after delayMs, then every periodMs if that is not 0.
+// Starting a running timer moves it to the new deadline.
+void startTimer(TimerId id, TimerCallback callback, unsigned long delayMs, unsigned long periodMs) {
+  if (!wheelReady) resetWheel();
+  Timer& timer = timers[id];
+  unlink(id);
+  timer.callback = callback;
+  timer.deadline = millis() + delayMs;
+  timer.period = periodMs;
+  timer.running = true;
+  link(id);
+}
+
+void stopTimer(TimerId id) {
+  Timer& timer = timers[id];
+  if (!timer.running) return;
+  unlink(id);
+  timer.running = false;
+}
+
+bool isTimerRunning(TimerId id) {
+  return timers[id].running;
+}
+
+// Runs the timers that are due. Periodic timers are rescheduled before
+// their callback runs, so a callback may stop or restart its own timer, or
+// any other, including one still waiting to run in this pass.
+void runDueTimers(ApplicationState& state) {
+  if (!wheelReady) resetWheel();
+  const uint32_t now = millis();
+  const uint32_t nowTick = now / TIMER_WHEEL_TICK_MS;
+
+  // Visit the slots of the ticks since the last pass, including the last
+  // one again for timers added to it since. After a long blocking call a
+  // single turn of the wheel covers everything.
+  uint32_t ticks = nowTick - wheelTick + 1;
+  if (ticks > TIMER_WHEEL_SLOTS) ticks = TIMER_WHEEL_SLOTS;
+
+  int8_t due[TIMER_COUNT];
+  int dueCount = 0;
+  for (uint32_t t = 0; t < ticks; t++) {
+    int8_t id = slotHeads[(wheelTick + t) & (TIMER_WHEEL_SLOTS - 1)];
+    while (id >= 0) {
+      const int8_t next = timers[id].next;
+      if ((int32_t)(now - timers[id].deadline) >= 0) {
+        unlink(id);
+        due[dueCount++] = id;
+      }
+      id = next;
+    }
+  }
+  wheelTick = nowTick;
+
+  for (int i = 0; i < dueCount; i++) {
+    Timer& timer = timers[due[i]];
+    if (!timer.running || timer.linked) continue; // Stopped or restarted by an earlier callback
+    if (timer.period > 0) {
+      timer.deadline += timer.period;
+      if ((int32_t)(now - timer.deadline) >= 0) timer.deadline = now + timer.period; // Fell behind: skip the missed runs
+      link(due[i]);
+    } else {
+      timer.running = false;
+    }
+    timer.callback(state);
+  }
+}
+
+// Milliseconds until the earliest timer is due, at most SCHEDULER_MAX_WAIT_MS.
+unsigned long getNextTimerDelay() {
+  const uint32_t now = millis();
+  unsigned long wait = SCHEDULER_MAX_WAIT_MS;
+  for (const Timer& timer : timers) {
+    if (!timer.running) continue;
+    const int32_t remaining = (int32_t)(timer.deadline - now);
+    if (remaining <= 0) return 0;
+    if ((unsigned long)remaining < wait) wait = remaining;
+  }
+  return wait;
+}
+
+// Blocks loop() until the next timer is due or wakeMainLoop() is called.
+void waitForTimerOrInput() {
+  if (!loopTask) loopTask = xTaskGetCurrentTaskHandle();
+  const unsigned long wait = getNextTimerDelay();
+  if (wait > 0) ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+}
+
+// Ends waitForTimerOrInput() early, e.g. when a touch event was queued.
+// Safe to call from other tasks, but not from an interrupt.
+void wakeMainLoop() {
+  if (loopTask) xTaskNotifyGive(loopTask);
+}
@@ -0,0 +1,192 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+// Fixed-point solar position. Angles are in centidegrees and sines/cosines in
+// Q14 (16384 = 1.0), which is plenty for a terminator drawn at ~1 degree per
+// pixel and sunrise/sunset times to the minute.
+
+namespace {
+  const int32_t Q14_ONE = 16384;
+  const time_t UNIX_2000_01_01 = 946684800; // J2000.0 is noon of this day
+  const int32_t OBLIQUITY = 2344;           // Obliquity of the ecliptic
+
+  // sin(0..90 deg) in Q14, one entry per degree.
+  const int16_t SINE_TABLE[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+  };
+
+  int32_t normalizeAngle(int32_t angle) {
+    angle %= 36000;
+    return (angle < 0) ? angle + 36000 : angle;
+  }
+
+  int32_t normalizeLongitude(int32_t angle) {
+    angle = normalizeAngle(angle + 18000);
+    return angle - 18000;
+  }
+
+  long wrapSecondsOfDay(long seconds) {
+    seconds %= 86400;
+    return (seconds < 0) ? seconds + 86400 : seconds;
+  }
+
+  // Linear interpolation between table entries, angle in 0..9000.
+  int32_t sineFirstQuadrant(int32_t angle) {
+    int index = angle / 100;
+    if (index >= 90) return SINE_TABLE[90];
+    int32_t fraction = angle % 100;
+    return SINE_TABLE[index] + (SINE_TABLE[index + 1] - SINE_TABLE[index]) * fraction / 100;
+  }
+
+  // Declination and equation of time for noon UTC of the given day, using the
+  // low-precision almanac formulas (good to about a minute of time).
+  void computeDailyEphemeris(SolarEphemeris& eph, long dayNumber, int dayOfYear) {
+    int32_t meanLongitude = normalizeAngle(28046 + (int32_t)((int64_t)dayNumber * 9856474 / 100000 % 36000));
+    int32_t meanAnomaly = normalizeAngle(35753 + (int32_t)((int64_t)dayNumber * 9856003 / 100000 % 36000));
+    int32_t eclipticLongitude = meanLongitude + (1915 * fxSin(meanAnomaly) + 20 * fxSin(2 * meanAnomaly)) / (10 * Q14_ONE);
+
+    eph.sinDeclination = fxSin(OBLIQUITY) * fxSin(eclipticLongitude) / Q14_ONE;
+    eph.declination = fxAsin(eph.sinDeclination);
+    eph.cosDeclination = fxCos(eph.declination);
+
+    int32_t b = 36000 * (dayOfYear - 81) / 364;
+    eph.equationOfTime = (592 * fxSin(2 * b) - 452 * fxCos(b) - 90 * fxSin(b)) / Q14_ONE;
+    eph.dayNumber = dayNumber;
+  }
+}
+
+int32_t fxSin(int32_t angle) {
+  angle = normalizeAngle(angle);
+  if (angle <= 9000) return sineFirstQuadrant(angle);
+  if (angle <= 18000) return sineFirstQuadrant(18000 - angle);
+  if (angle <= 27000) return -sineFirstQuadrant(angle - 18000);
+  return -sineFirstQuadrant(36000 - angle);
+}
+
+int32_t fxCos(int32_t angle) {
+  return fxSin(angle + 9000);
+}
+
+// Inverse of fxSin over -9000..9000, by binary search of the table.
+int32_t fxAsin(int32_t value) {
+  bool negative = value < 0;
+  if (negative) value = -value;
+  if (value >= Q14_ONE) return negative ? -9000 : 9000;
+
+  int low = 0;
+  int high = 90;
+  while (high - low > 1) {
+    int mid = (low + high) / 2;
+    if (SINE_TABLE[mid] <= value) low = mid;
+    else high = mid;
+  }
+  int32_t span = SINE_TABLE[high] - SINE_TABLE[low];
+  int32_t result = low * 100 + (value - SINE_TABLE[low]) * 100 / span;
+  return negative ? -result : result;
+}
+
+// Refreshes the cached ephemeris. The declination, equation of time and all
+// sunrise/sunset times only change with the date; the subsolar point and the
+// grey-line flags are updated once a minute. Returns true when the terminator
+// moved, so an open grey-line screen knows to redraw.
+bool updateSolarEphemeris(ApplicationState& state) {
+  time_t now;
+  struct tm timeinfo;
+  time(&now);
+  gmtime_r(&now, &timeinfo);
+  if (timeinfo.tm_year < (2020 - 1900)) return false; // Time not synced yet
+
+  SolarEphemeris& eph = state.solar;
+  long dayNumber = (long)((now - UNIX_2000_01_01) / 86400);
+  int minuteOfDay = timeinfo.tm_hour * 60 + timeinfo.tm_min;
+  if (eph.valid && eph.dayNumber == dayNumber && eph.minuteOfDay == minuteOfDay) return false;
+
+  if (!eph.valid || eph.dayNumber != dayNumber) {
+    computeDailyEphemeris(eph, dayNumber, timeinfo.tm_yday + 1);
+    eph.valid = true;
+
+    if (state.station.locationValid) {
+      computeSunTimes(eph, state.station.latitude, state.station.longitude, eph.qthSunrise, eph.qthSunset);
+    }
+    for (int i = 0; i < state.spotCount; i++) {
+      DxSpot& spot = state.spots[i];
+      if (spot.dxLocated) computeSunTimes(eph, spot.dxLatitude, spot.dxLongitude, spot.dxSunrise, spot.dxSunset);
+    }
+  }
+
+  // The sun is over the Greenwich meridian at 12:00 UTC, corrected by the
+  // equation of time, and moves 15 degrees (2.4 s per centidegree) west per hour.
+  eph.minuteOfDay = minuteOfDay;
+  eph.subsolarLongitude = normalizeLongitude((43200L - minuteOfDay * 60L - eph.equationOfTime) * 5 / 12);
+
+  eph.qthNearGreyLine = state.station.locationValid && isNearGreyLine(eph, state.station.latitude, state.station.longitude);
+  for (int i = 0; i < state.spotCount; i++) {
+    DxSpot& spot = state.spots[i];
+    spot.nearGreyLine = spot.dxLocated && isNearGreyLine(eph, spot.dxLatitude, spot.dxLongitude);
+  }
+  return true;
+}
+
+// Sunrise and sunset in UTC minutes of day for a location. Both are -1 during
+// polar day or night.
+void computeSunTimes(const SolarEphemeris& eph, int16_t latitude, int16_t longitude, int& sunrise, int& sunset) {
+  sunrise = -1;
+  sunset = -1;
+
+  int64_t numerator = (int64_t)fxSin(SUN_HORIZON_ELEVATION) * Q14_ONE - (int64_t)fxSin(latitude) * eph.sinDeclination;
+  int64_t denominator = (int64_t)fxCos(latitude) * eph.cosDeclination;
+  if (denominator <= 0) return;
+
+  int64_t cosHourAngle = numerator * Q14_ONE / denominator;
+  if (cosHourAngle >= Q14_ONE || cosHourAngle <= -Q14_ONE) return;
+
+  int32_t hourAngle = 9000 - fxAsin((int32_t)cosHourAngle);
+  long solarNoon = 43200L - (long)longitude * 12 / 5 - eph.equationOfTime;
+  long halfDay = (long)hourAngle * 12 / 5;
+  sunrise = wrapSecondsOfDay(solarNoon - halfDay) / 60;
+  sunset = wrapSecondsOfDay(solarNoon + halfDay) / 60;
+}
+
+// Sine of the sun's elevation (Q14) at a location for the cached minute.
+int32_t getSunElevationSine(const SolarEphemeris& eph, int16_t latitude, int16_t longitude) {
+  int32_t hourAngle = longitude - eph.subsolarLongitude;
+  int32_t cosTerm = fxCos(latitude) * eph.cosDeclination / Q14_ONE;
+  return (fxSin(latitude) * eph.sinDeclination + cosTerm * fxCos(hourAngle)) / Q14_ONE;
+}
+
+bool isNearGreyLine(const SolarEphemeris& eph, int16_t latitude, int16_t longitude) {
+  int32_t elevation = fxAsin(getSunElevationSine(eph, latitude, longitude));
+  return elevation >= GREYLINE_MIN_ELEVATION && elevation <= GREYLINE_MAX_ELEVATION;
+}
+
+// Resolves a new spot's DX and spotter entities and, once the ephemeris is
+// available, the DX sunrise/sunset and grey-line flag.
+void locateSpot(DxSpot& spot, const ApplicationState& state) {
+  spot.dxLocated = lookupCallsignLocation(spot.call, spot.dxLatitude, spot.dxLongitude);
+  spot.spotterLocated = lookupCallsignLocation(spot.spotter, spot.spotterLatitude, spot.spotterLongitude);
+  spot.dxSunrise = -1;
+  spot.dxSunset = -1;
+  spot.nearGreyLine = false;
+
+  if (spot.dxLocated && state.solar.valid) {
+    computeSunTimes(state.solar, spot.dxLatitude, spot.dxLongitude, spot.dxSunrise, spot.dxSunset);
+    spot.nearGreyLine = isNearGreyLine(state.solar, spot.dxLatitude, spot.dxLongitude);
+  }
+}
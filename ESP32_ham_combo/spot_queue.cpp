@@ -0,0 +1,67 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include <atomic>
+
+// Parsed spots on their way from the telnet reader to the spot store. One
+// side (the reader) only pushes and the other (the UI) only pops, so the
+// ring needs no lock and the reader can run on another task or core.
+//
+// When the ring is full the reader drops the oldest spot rather than the
+// new one. It does that by advancing the tail itself, so the tail is moved
+// with a compare-and-swap by both sides: the UI copies a spot out and then
+// claims it, and if the reader dropped that spot meanwhile the claim fails,
+// the copy (which may be half overwritten) is thrown away, and the UI
+// tries again with the next one.
+
+namespace {
+  static_assert((SPOT_QUEUE_SIZE & (SPOT_QUEUE_SIZE - 1)) == 0, "SPOT_QUEUE_SIZE must be a power of two");
+
+  DxSpot ring[SPOT_QUEUE_SIZE];
+  std::atomic<uint32_t> ringHead(0); // Next slot to write; only the reader advances it
+  std::atomic<uint32_t> ringTail(0); // Oldest unread spot
+  std::atomic<uint32_t> droppedSpots(0);
+}
+
+// Queues a parsed spot, dropping the oldest queued one if the ring is full.
+// Returns false if a spot was dropped. Call from the reader side only.
+bool pushSpot(const DxSpot& spot) {
+  const uint32_t head = ringHead.load(std::memory_order_relaxed);
+  bool dropped = false;
+  uint32_t tail = ringTail.load(std::memory_order_acquire);
+  while (head - tail >= SPOT_QUEUE_SIZE) {
+    // Fails if the UI took the oldest spot first, which also makes room
+    if (ringTail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel)) {
+      droppedSpots.fetch_add(1, std::memory_order_relaxed);
+      dropped = true;
+      break;
+    }
+  }
+  ring[head % SPOT_QUEUE_SIZE] = spot;
+  ringHead.store(head + 1, std::memory_order_release);
+  return !dropped;
+}
+
+// Takes the oldest queued spot. Returns false when there is none. Call
+// from the UI side only.
+bool popSpot(DxSpot& spot) {
+  uint32_t tail = ringTail.load(std::memory_order_acquire);
+  for (;;) {
+    if (tail == ringHead.load(std::memory_order_acquire)) return false;
+    spot = ring[tail % SPOT_QUEUE_SIZE];
+    // A failed claim reloads tail: the reader dropped this spot while it was copied
+    if (ringTail.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel)) return true;
+  }
+}
+
+// Spots dropped because the UI fell behind, since start-up.
+uint32_t getDroppedSpotCount() {
+  return droppedSpots.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,108 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include <atomic>
+
+// The network half of a fast boot. Once WiFi is up, a worker task logs into
+// HamAlert, downloads the solar data and checks for a new release, while
+// loop() already shows the cached screen and answers touches. The steps run
+// one after another on the one task because the HTTPS fetches share a single
+// TLS client. The worker only touches the network clients and the results
+// below; loop() applies each result to the state in finishStartupSteps(), so
+// nothing the screens read is written from two tasks.
+
+namespace {
+  const uint32_t STEP_TELNET = 1 << 0;
+  const uint32_t STEP_PROPAGATION = 1 << 1;
+  const uint32_t STEP_UPDATE = 1 << 2;
+  const uint32_t ALL_STEPS = STEP_TELNET | STEP_PROPAGATION | STEP_UPDATE;
+
+  // Written by the worker before it sets the step's bit
+  bool telnetConnected = false;
+  bool propagationDownloaded = false;
+  String propagationBody;
+  bool updateChecked = false;
+  char releaseTag[sizeof(ApplicationState::newVersionTag)];
+
+  std::atomic<uint32_t> stepsDone(0); // Set by the worker
+  uint32_t stepsApplied = 0;          // loop() only
+  bool fetchPropagationAtStart = false;
+  bool checkUpdatesAtStart = false;
+
+  void finishStep(uint32_t step) {
+    stepsDone.fetch_or(step, std::memory_order_release);
+    wakeMainLoop();
+  }
+
+  void startupTask(void* param) {
+    ApplicationState& state = *static_cast<ApplicationState*>(param);
+
+    // Spots are what the first screen is mostly about, so HamAlert goes first
+    telnetConnected = connectToTelnet(state, false);
+    finishStep(STEP_TELNET);
+
+    if (fetchPropagationAtStart) propagationDownloaded = downloadPropagationData(propagationBody);
+    finishStep(STEP_PROPAGATION);
+
+    if (checkUpdatesAtStart) updateChecked = fetchLatestReleaseTag(releaseTag, sizeof(releaseTag));
+    finishStep(STEP_UPDATE);
+
+    vTaskDelete(nullptr);
+  }
+
+  // Redraws the active screen if it shows what a step just changed.
+  void redrawIfShowing(ApplicationState& state, ActiveScreen a, ActiveScreen b) {
+    if (state.activeScreen == a || state.activeScreen == b) {
+      showMainScreen(state, state.activeScreen);
+    }
+  }
+}
+
+// Starts the worker. WiFi must be connected. Solar data still fresh from
+// before a deep sleep need not be fetched again.
+void startStartupSteps(ApplicationState& state, bool fetchPropagation, bool checkUpdates) {
+  fetchPropagationAtStart = fetchPropagation;
+  checkUpdatesAtStart = checkUpdates;
+  xTaskCreatePinnedToCore(startupTask, "startup", STARTUP_TASK_STACK_SIZE, &state, STARTUP_TASK_PRIORITY, nullptr, ARDUINO_RUNNING_CORE);
+}
+
+// Applies the steps the worker finished since the last call. Returns true
+// once all of them are done.
+bool finishStartupSteps(ApplicationState& state) {
+  const uint32_t done = stepsDone.load(std::memory_order_acquire);
+  const uint32_t fresh = done & ~stepsApplied;
+  stepsApplied = done;
+
+  if (fresh & STEP_TELNET) {
+    Serial.printf("HamAlert login %s at %lu ms.\n", telnetConnected ? "done" : "failed", millis());
+    state.network.hamAlertConnected = telnetConnected;
+    state.network.lastReconnectTime = millis();
+    state.network.starting = false;
+    // The login asks for the latest spots again, which replace the cached ones
+    if (telnetConnected) {
+      clearSpots(state);
+      playNewSpotSound(state);
+    }
+    redrawIfShowing(state, SCREEN_SPOTS, SCREEN_SPOTS_AND_PROP);
+  }
+
+  if ((fresh & STEP_PROPAGATION) && fetchPropagationAtStart) {
+    const bool updated = propagationDownloaded && applyPropagationData(state, propagationBody);
+    propagationBody = String(); // Free the XML
+    Serial.printf("Propagation data %s at %lu ms.\n", updated ? "updated" : "not updated", millis());
+    if (updated) redrawIfShowing(state, SCREEN_PROPAGATION, SCREEN_SPOTS_AND_PROP);
+  }
+
+  if ((fresh & STEP_UPDATE) && updateChecked) {
+    applyLatestReleaseTag(state, releaseTag);
+  }
+
+  return done == ALL_STEPS;
+}
@@ -0,0 +1,360 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+// Band map: one band at a time, with a frequency scale down the left edge
+// and the spotted calls in a column of fixed label slots on the right, each
+// joined to its frequency by a leader line. Every band keeps its own slots.
+// A new spot takes a free slot next to its frequency, pushing its neighbours
+// along by one only when the slots around it are full, so the labels stay in
+// frequency order and a spot only repaints the slots that changed.
+
+namespace {
+  struct BandMapLabel {
+    char call[12];         // Empty for a free slot
+    char mode[5];
+    int32_t freq;          // 0.1 kHz
+    unsigned long heardAt; // millis()
+  };
+
+  struct BandMapSlots {
+    BandMapLabel slots[BAND_MAP_MAX_SLOTS]; // Top to bottom, in frequency order
+    uint16_t dirtySlots;                    // Slots to repaint, bit per slot
+  };
+
+  BandMapSlots bandMap[BAND_COUNT];
+  int slotCount = 0;     // Slots per band the labels were packed for
+  int shownBand = -1;
+  bool emptyMessageShown = false;
+
+  struct PlotLayout {
+    int top;
+    int bottom;
+    int slots;
+  };
+
+  PlotLayout getPlotLayout() {
+    PlotLayout layout;
+    layout.top = BAND_MAP_HEADER_H + BAND_MAP_PLOT_MARGIN;
+    layout.bottom = tft.height() - BAND_MAP_PLOT_MARGIN;
+    layout.slots = min(BAND_MAP_MAX_SLOTS, (layout.bottom - layout.top) / BAND_MAP_SLOT_H);
+    return layout;
+  }
+
+  bool isFree(const BandMapLabel& label) {
+    return label.call[0] == '\0';
+  }
+
+  void markDirty(int band, int slot) {
+    bandMap[band].dirtySlots |= 1 << slot;
+  }
+
+  bool hasLabels(int band) {
+    for (int s = 0; s < slotCount; s++) {
+      if (!isFree(bandMap[band].slots[s])) return true;
+    }
+    return false;
+  }
+
+  // The slot a label would take on a band with nothing else on it.
+  int idealSlot(int band, int32_t freq) {
+    uint16_t startKHz, endKHz;
+    getBandRange(band, startKHz, endKHz);
+    int32_t span = (int32_t)(endKHz - startKHz) * 10;
+    int slot = (freq - startKHz * 10) * slotCount / span;
+    return constrain(slot, 0, slotCount - 1);
+  }
+
+  int freqToY(int band, int32_t freq, const PlotLayout& layout) {
+    uint16_t startKHz, endKHz;
+    getBandRange(band, startKHz, endKHz);
+    int32_t span = (int32_t)(endKHz - startKHz) * 10;
+    int32_t offset = constrain(freq - startKHz * 10, 0, span);
+    return layout.top + offset * (layout.bottom - layout.top) / span;
+  }
+
+  int slotCenterY(int slot, const PlotLayout& layout) {
+    return layout.top + slot * BAND_MAP_SLOT_H + BAND_MAP_SLOT_H / 2;
+  }
+
+  void evictOldest(int band) {
+    BandMapLabel* slots = bandMap[band].slots;
+    int oldest = -1;
+    for (int s = 0; s < slotCount; s++) {
+      if (isFree(slots[s])) continue;
+      if (oldest < 0 || (long)(slots[s].heardAt - slots[oldest].heardAt) < 0) oldest = s;
+    }
+    if (oldest < 0) return;
+    slots[oldest].call[0] = '\0';
+    markDirty(band, oldest);
+  }
+
+  // Moves the labels in [from, to] one slot towards `direction`, into the
+  // free slot at the far end.
+  void shiftSlots(int band, int from, int to, int direction) {
+    BandMapLabel* slots = bandMap[band].slots;
+    if (direction > 0) {
+      for (int s = to; s >= from; s--) slots[s + 1] = slots[s];
+    } else {
+      for (int s = from; s <= to; s++) slots[s - 1] = slots[s];
+    }
+    for (int s = from; s <= to; s++) markDirty(band, s + direction);
+  }
+
+  void placeLabel(int band, const BandMapLabel& label) {
+    BandMapLabel* slots = bandMap[band].slots;
+
+    for (;;) {
+      // The label belongs after every lower label and before every higher one.
+      // The slots between those two are all free.
+      int lower = -1;
+      int higher = slotCount;
+      for (int s = 0; s < slotCount; s++) {
+        if (isFree(slots[s])) continue;
+        if (slots[s].freq <= label.freq) lower = s;
+        else if (higher == slotCount) higher = s;
+      }
+
+      int target = -1;
+      if (higher - lower > 1) {
+        target = constrain(idealSlot(band, label.freq), lower + 1, higher - 1);
+      } else {
+        // No gap: push the labels on the side with the nearer free slot along by one
+        int freeAbove = lower - 1;
+        while (freeAbove >= 0 && !isFree(slots[freeAbove])) freeAbove--;
+        int freeBelow = higher + 1;
+        while (freeBelow < slotCount && !isFree(slots[freeBelow])) freeBelow++;
+
+        const bool canGoUp = freeAbove >= 0;
+        const bool canGoDown = freeBelow < slotCount;
+        if (canGoUp && (!canGoDown || lower - freeAbove <= freeBelow - higher)) {
+          shiftSlots(band, freeAbove + 1, lower, -1);
+          target = lower;
+        } else if (canGoDown) {
+          shiftSlots(band, higher, freeBelow - 1, 1);
+          target = higher;
+        }
+      }
+
+      if (target >= 0) {
+        slots[target] = label;
+        markDirty(band, target);
+        return;
+      }
+      evictOldest(band); // Every slot is taken
+    }
+  }
+
+  void pruneBand(int band) {
+    BandMapLabel* slots = bandMap[band].slots;
+    for (int s = 0; s < slotCount; s++) {
+      if (!isFree(slots[s]) && millis() - slots[s].heardAt >= BAND_MAP_SPOT_MAX_AGE_MS) {
+        slots[s].call[0] = '\0';
+        markDirty(band, s);
+      }
+    }
+  }
+
+  // Packs the labels again when the slot count changes with the screen
+  // rotation. Nothing else relays the labels out.
+  void ensureSlotLayout() {
+    const int slots = getPlotLayout().slots;
+    if (slots == slotCount) return;
+
+    const int oldCount = slotCount;
+    slotCount = slots;
+    for (int band = 0; band < BAND_COUNT; band++) {
+      BandMapLabel old[BAND_MAP_MAX_SLOTS];
+      memcpy(old, bandMap[band].slots, sizeof(old));
+      for (int s = 0; s < BAND_MAP_MAX_SLOTS; s++) bandMap[band].slots[s].call[0] = '\0';
+      for (int s = 0; s < oldCount; s++) {
+        if (!isFree(old[s])) placeLabel(band, old[s]);
+      }
+      bandMap[band].dirtySlots = 0xFFFF;
+    }
+  }
+
+  int chooseBand(const ApplicationState& state) {
+    if (shownBand >= 0 && hasLabels(shownBand)) return shownBand;
+    if (state.spotCount > 0) {
+      int newestBand = state.spots[state.latestSpotIndex].band;
+      if (newestBand >= 0 && hasLabels(newestBand)) return newestBand;
+    }
+    for (int band = 0; band < BAND_COUNT; band++) {
+      if (hasLabels(band)) return band;
+    }
+    return (shownBand >= 0) ? shownBand : BAND_20M;
+  }
+
+  void drawHeader(int band) {
+    tft.setFreeFont(&FreeSansBold9pt7b);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.setTextDatum(ML_DATUM);
+    tft.drawString("<", BAND_MAP_PLOT_MARGIN, BAND_MAP_HEADER_H / 2);
+    tft.setTextDatum(MR_DATUM);
+    tft.drawString(">", tft.width() - BAND_MAP_PLOT_MARGIN, BAND_MAP_HEADER_H / 2);
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.drawString(String(getBandLabel(band)) + "m", tft.width() / 2, BAND_MAP_HEADER_H / 2);
+  }
+
+  // Frequency axis with a label every 10, 25, 50... kHz, as fits the band.
+  void drawScale(int band, const PlotLayout& layout) {
+    static const uint16_t STEPS_KHZ[] = { 10, 25, 50, 100, 250, 500, 1000 };
+    uint16_t startKHz, endKHz;
+    getBandRange(band, startKHz, endKHz);
+
+    const int maxLabels = (layout.bottom - layout.top) / BAND_MAP_MIN_SCALE_GAP;
+    uint16_t step = STEPS_KHZ[0];
+    for (uint16_t candidate : STEPS_KHZ) {
+      step = candidate;
+      if ((endKHz - startKHz) / candidate <= maxLabels) break;
+    }
+
+    tft.drawFastVLine(BAND_MAP_AXIS_X, layout.top, layout.bottom - layout.top + 1, TFT_WHITE);
+    tft.setFreeFont(&FreeSans9pt7b);
+    tft.setTextDatum(MR_DATUM);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    for (uint32_t kHz = (startKHz + step - 1) / step * step; kHz <= endKHz; kHz += step) {
+      int y = freqToY(band, kHz * 10, layout);
+      tft.drawFastHLine(BAND_MAP_AXIS_X - 4, y, 4, TFT_WHITE);
+      tft.drawString(String(kHz), BAND_MAP_AXIS_X - 6, y);
+    }
+  }
+
+  // Leader lines run between the axis and the label column. They cross each
+  // other's rows, so the whole gutter is redrawn whenever any slot changes.
+  void drawLeaders(int band, const PlotLayout& layout) {
+    const int gutterX = BAND_MAP_AXIS_X + 1;
+    tft.fillRect(gutterX, layout.top, BAND_MAP_LABEL_X - gutterX, layout.bottom - layout.top + 1, TFT_BLACK);
+    for (int s = 0; s < slotCount; s++) {
+      const BandMapLabel& label = bandMap[band].slots[s];
+      if (isFree(label)) continue;
+      int y = freqToY(band, label.freq, layout);
+      tft.drawFastHLine(gutterX, y, 4, getModeColor(label.mode));
+      tft.drawLine(gutterX + 4, y, BAND_MAP_LABEL_X - 4, slotCenterY(s, layout), TFT_DARKGREY);
+    }
+  }
+
+  void drawSlot(int band, int slot, const PlotLayout& layout) {
+    const BandMapLabel& label = bandMap[band].slots[slot];
+    const int y = slotCenterY(slot, layout);
+    tft.fillRect(BAND_MAP_LABEL_X, y - BAND_MAP_SLOT_H / 2, tft.width() - BAND_MAP_LABEL_X, BAND_MAP_SLOT_H, TFT_BLACK);
+    if (isFree(label)) return;
+
+    tft.setFreeFont(&FreeSans9pt7b);
+    tft.setTextDatum(ML_DATUM);
+    tft.setTextColor(getModeColor(label.mode), TFT_BLACK);
+    tft.drawString(label.call, BAND_MAP_LABEL_X, y);
+
+    // The frequency only fits beside the call on a wide screen
+    char freqStr[10];
+    snprintf(freqStr, sizeof(freqStr), "%ld.%ld", (long)(label.freq / 10), (long)(label.freq % 10));
+    const int freqX = tft.width() - BAND_MAP_PLOT_MARGIN;
+    if (BAND_MAP_LABEL_X + tft.textWidth(label.call) + 8 + tft.textWidth(freqStr) <= freqX) {
+      tft.setTextDatum(MR_DATUM);
+      tft.setTextColor(TFT_WHITE, TFT_BLACK);
+      tft.drawString(freqStr, freqX, y);
+    }
+  }
+}
+
+// Files a spot on its band's map. A call spotted again on the same band
+// moves to its new frequency instead of taking a second slot.
+void addBandMapSpot(const DxSpot& spot) {
+  if (spot.band < 0 || spot.band >= BAND_COUNT) return;
+  ensureSlotLayout();
+  if (slotCount <= 0) return;
+  pruneBand(spot.band);
+
+  BandMapLabel* slots = bandMap[spot.band].slots;
+  for (int s = 0; s < slotCount; s++) {
+    if (!isFree(slots[s]) && strcmp(slots[s].call, spot.call) == 0) {
+      slots[s].call[0] = '\0';
+      markDirty(spot.band, s);
+    }
+  }
+
+  BandMapLabel label;
+  strlcpy(label.call, spot.call, sizeof(label.call));
+  strlcpy(label.mode, spot.mode, sizeof(label.mode));
+  label.freq = lround(atof(spot.freq) * 10);
+  label.heardAt = millis();
+  placeLabel(spot.band, label);
+}
+
+void drawBandMapScreen(ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_BAND_MAP);
+  ensureSlotLayout();
+  for (int band = 0; band < BAND_COUNT; band++) pruneBand(band);
+  shownBand = chooseBand(state);
+
+  const PlotLayout layout = getPlotLayout();
+  tft.fillScreen(TFT_BLACK);
+  drawHeader(shownBand);
+  drawScale(shownBand, layout);
+
+  emptyMessageShown = !hasLabels(shownBand);
+  if (emptyMessageShown) {
+    tft.setFreeFont(&FreeSans9pt7b);
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextColor(TFT_CYAN, TFT_BLACK);
+    tft.drawString("No spots", (BAND_MAP_LABEL_X + tft.width()) / 2, (layout.top + layout.bottom) / 2);
+  } else {
+    drawLeaders(shownBand, layout);
+    for (int s = 0; s < slotCount; s++) drawSlot(shownBand, s, layout);
+  }
+  bandMap[shownBand].dirtySlots = 0;
+}
+
+// Ages out old spots and repaints only the slots that changed since the
+// screen was last drawn.
+void refreshBandMap(ApplicationState& state) {
+  if (state.activeScreen != SCREEN_BAND_MAP || shownBand < 0) return;
+  ensureSlotLayout();
+  pruneBand(shownBand);
+
+  BandMapSlots& band = bandMap[shownBand];
+  if (band.dirtySlots == 0) return;
+  if (emptyMessageShown || !hasLabels(shownBand)) {
+    drawBandMapScreen(state);
+    return;
+  }
+
+  const PlotLayout layout = getPlotLayout();
+  drawLeaders(shownBand, layout);
+  for (int s = 0; s < slotCount; s++) {
+    if (band.dirtySlots & (1 << s)) drawSlot(shownBand, s, layout);
+  }
+  band.dirtySlots = 0;
+}
+
+// Shows the next band (direction 1) or previous band (-1) that has spots,
+// or simply the neighbouring band when none has.
+void stepBandMapBand(ApplicationState& state, int direction) {
+  const int from = (shownBand >= 0) ? shownBand : BAND_20M;
+  int next = (from + direction + BAND_COUNT) % BAND_COUNT;
+  for (int i = 1; i <= BAND_COUNT; i++) {
+    int band = (from + direction * i + BAND_COUNT * i) % BAND_COUNT;
+    pruneBand(band);
+    if (hasLabels(band)) {
+      next = band;
+      break;
+    }
+  }
+  shownBand = next;
+  drawBandMapScreen(state);
+}
+
+// Shows the given band, e.g. the one a spot on the spots screen is on.
+void showBandMapBand(ApplicationState& state, int band) {
+  if (band >= 0 && band < BAND_COUNT) shownBand = band;
+  drawBandMapScreen(state);
+}
@@ -0,0 +1,156 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+namespace {
+  // Twilight shading starts where the sun is 6 degrees below the horizon.
+  const int32_t TWILIGHT_SINE = -1713; // sin(-6 deg) in Q14
+
+  // The world bitmap is equirectangular, so the map is always twice as wide as tall.
+  int mapHeight() {
+    return tft.width() / 2;
+  }
+
+  int longitudeToX(int16_t longitude, int width) {
+    return (int32_t)(longitude + 18000) * width / 36000;
+  }
+
+  int latitudeToY(int16_t latitude, int height) {
+    return (int32_t)(9000 - latitude) * height / 18000;
+  }
+
+  void formatSunTime(int minutes, char* buffer, size_t size) {
+    if (minutes < 0) strlcpy(buffer, "--:--", size);
+    else snprintf(buffer, size, "%02d:%02d", minutes / 60, minutes % 60);
+  }
+
+  // Shades every pixel by the sun's elevation there: day, civil twilight or night.
+  // The map has more colors than the frame palette, so it goes straight to the panel.
+  void drawTerminatorMap(const ApplicationState& state) {
+    static int32_t cosHourAngle[GREYLINE_MAP_MAX_WIDTH];
+    static uint8_t land[GREYLINE_MAP_MAX_WIDTH];
+    static uint16_t line[GREYLINE_MAP_MAX_WIDTH];
+
+    const SolarEphemeris& eph = state.solar;
+    const int width = min((int)tft.width(), GREYLINE_MAP_MAX_WIDTH);
+    const int height = mapHeight();
+
+    // The hour angle only depends on the column, so it is computed once per frame.
+    for (int x = 0; x < width; x++) {
+      int32_t longitude = -18000 + (2 * x + 1) * 18000 / width;
+      cosHourAngle[x] = fxCos(longitude - eph.subsolarLongitude);
+    }
+
+    bool swapBytes = panel.getSwapBytes();
+    panel.setSwapBytes(true);
+    panel.startWrite();
+    for (int y = 0; y < height; y++) {
+      int32_t latitude = 9000 - (2 * y + 1) * 9000 / height;
+      int32_t sinTerm = fxSin(latitude) * eph.sinDeclination / 16384;
+      int32_t cosTerm = fxCos(latitude) * eph.cosDeclination / 16384;
+      decodeWorldMapRow(y, width, height, land);
+
+      for (int x = 0; x < width; x++) {
+        int32_t elevationSine = sinTerm + cosTerm * cosHourAngle[x] / 16384;
+        if (elevationSine > 0) {
+          line[x] = land[x] ? COLOR_MAP_LAND_DAY : COLOR_MAP_OCEAN_DAY;
+        } else if (elevationSine > TWILIGHT_SINE) {
+          line[x] = land[x] ? COLOR_MAP_LAND_TWILIGHT : COLOR_MAP_OCEAN_TWILIGHT;
+        } else {
+          line[x] = land[x] ? COLOR_MAP_LAND_NIGHT : COLOR_MAP_OCEAN_NIGHT;
+        }
+      }
+      panel.pushImage(0, y, width, 1, line);
+    }
+    panel.endWrite();
+    panel.setSwapBytes(swapBytes);
+  }
+
+  void drawMapMarkers(const ApplicationState& state) {
+    const int width = tft.width();
+    const int height = mapHeight();
+
+    for (int i = 0; i < state.spotCount; i++) {
+      const DxSpot& spot = state.spots[i];
+      if (!spot.dxLocated) continue;
+      int x = longitudeToX(spot.dxLongitude, width);
+      int y = latitudeToY(spot.dxLatitude, height);
+      panel.fillCircle(x, y, GREYLINE_SPOT_MARKER_R, getModeColor(spot.mode));
+      panel.drawCircle(x, y, GREYLINE_SPOT_MARKER_R, TFT_BLACK);
+    }
+
+    if (state.station.locationValid) {
+      int x = longitudeToX(state.station.longitude, width);
+      int y = latitudeToY(state.station.latitude, height);
+      panel.drawFastHLine(x - 4, y, 9, TFT_WHITE);
+      panel.drawFastVLine(x, y - 4, 9, TFT_WHITE);
+    }
+  }
+
+  void drawSunTimesLine(const char* label, uint16_t labelColor, int sunrise, int sunset, bool nearGreyLine, int yPos) {
+    char riseStr[6], setStr[6];
+    formatSunTime(sunrise, riseStr, sizeof(riseStr));
+    formatSunTime(sunset, setStr, sizeof(setStr));
+
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(labelColor, TFT_BLACK);
+    tft.drawString(label, GREYLINE_TEXT_MARGIN + 2 * GREYLINE_MARKER_RADIUS + 6, yPos);
+    if (nearGreyLine) {
+      tft.fillCircle(GREYLINE_TEXT_MARGIN + GREYLINE_MARKER_RADIUS, yPos + 7, GREYLINE_MARKER_RADIUS, COLOR_GREYLINE);
+    }
+
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.drawString(String("Rise ") + riseStr + "  Set " + setStr, tft.width() - GREYLINE_TEXT_MARGIN, yPos);
+  }
+}
+
+void drawGreyLineScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_GREY_LINE);
+  CPU_BOOST_SCOPE(); // The terminator is worked out for every map column
+  tft.setFreeFont(&FreeSans9pt7b);
+
+  if (!state.solar.valid) {
+    tft.fillScreen(TFT_BLACK);
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextColor(TFT_CYAN);
+    tft.drawString("Waiting for time sync...", tft.width() / 2, tft.height() / 2);
+    return;
+  }
+
+  // Sunrise/sunset list (UTC) below the map: QTH first, then the newest spots.
+  // The frame keeps off the map area, which is drawn after the list is flushed.
+  const int textTop = mapHeight();
+  tft.fillScreen(TFT_BLACK);
+  setFrameHole(0, 0, tft.width(), textTop);
+  int yPos = textTop + 4;
+
+  if (state.station.locationValid) {
+    drawSunTimesLine((String("QTH ") + state.station.locator).c_str(), TFT_YELLOW,
+                     state.solar.qthSunrise, state.solar.qthSunset, state.solar.qthNearGreyLine, yPos);
+  } else {
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.drawString("Set QTH locator in web config", GREYLINE_TEXT_MARGIN, yPos);
+  }
+  yPos += GREYLINE_TEXT_LINE_HEIGHT;
+
+  for (int i = 0; i < state.spotCount && yPos + GREYLINE_TEXT_LINE_HEIGHT <= tft.height(); i++) {
+    int index = (state.latestSpotIndex - i + ApplicationState::MAX_SPOTS) % ApplicationState::MAX_SPOTS;
+    const DxSpot& spot = state.spots[index];
+    if (!spot.dxLocated) continue;
+    drawSunTimesLine(spot.call, TFT_CYAN, spot.dxSunrise, spot.dxSunset, spot.nearGreyLine, yPos);
+    yPos += GREYLINE_TEXT_LINE_HEIGHT;
+  }
+  flushFrame();
+
+  drawTerminatorMap(state);
+  drawMapMarkers(state);
+}
@@ -164,28 +164,43 @@ namespace {
 
 } // end of anonymous namespace
 
-bool fetchPropagationData(ApplicationState& state) {
-  if (!state.network.isWifiConnected) {
-    state.propDataAvailable = false;
-    return false;
-  }
-
+// Downloads the HamQSL solar XML. Uses only the HTTPS client, so it can run
+// on another task while the UI keeps going.
+bool downloadPropagationData(String& body) {
   Serial.println("Fetching propagation data...");
+  if (!beginHttpsRequest(HTTPS_HOST_PROPAGATION)) return false;
+  bool reused = getHttpsStats(HTTPS_HOST_PROPAGATION).reusedConnection;
   httpClient.get(PROP_URL);
-
   int statusCode = httpClient.responseStatusCode();
+
+  // The server may have dropped a kept-alive connection; retry once with a fresh handshake.
+  if (statusCode < 0 && reused) {
+    endHttpsRequest(HTTPS_HOST_PROPAGATION, false);
+    if (!beginHttpsRequest(HTTPS_HOST_PROPAGATION)) return false;
+    httpClient.get(PROP_URL);
+    statusCode = httpClient.responseStatusCode();
+  }
+
   if (statusCode != 200) {
     Serial.printf("Failed to fetch data, status code: %d\n", statusCode);
-    state.propDataAvailable = false;
+    endHttpsRequest(HTTPS_HOST_PROPAGATION, false);
     return false;
   }
 
-  String response = httpClient.responseBody();
+  body = httpClient.responseBody();
+  endHttpsRequest(HTTPS_HOST_PROPAGATION, true);
+  return true;
+}
 
-  if (parsePropagationData(state, response.c_str())) {
+// Parses downloaded solar XML into the state and caches it for the next boot.
+bool applyPropagationData(ApplicationState& state, const String& body) {
+  CPU_BOOST_SCOPE(); // XML parsing and the band conditions derived from it
+  if (parsePropagationData(state, body.c_str())) {
     Serial.println("Propagation data fetched and parsed successfully.");
     state.propDataAvailable = true;
-    state.lastPropUpdateTime = millis();
+    state.propDataTime = time(nullptr);
+    updateBandConditions(state);
+    saveSolarCache(state);
     return true;
   } else {
     Serial.println("Failed to parse propagation data.");
@@ -194,7 +209,17 @@ bool fetchPropagationData(ApplicationState& state) {
   }
 }
 
+bool fetchPropagationData(ApplicationState& state) {
+  String body;
+  if (!state.network.isWifiConnected || !downloadPropagationData(body)) {
+    state.propDataAvailable = false;
+    return false;
+  }
+  return applyPropagationData(state, body);
+}
+
 void drawPropagationScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_PROPAGATION);
   tft.fillScreen(TFT_BLACK);
   tft.setTextDatum(MC_DATUM);
   tft.setFreeFont(&FreeSans9pt7b);
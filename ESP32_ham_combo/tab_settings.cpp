@@ -19,14 +19,20 @@ void saveSettings(const ApplicationState& state) {
   preferences.putInt("spotsViewMode", state.display.spotsViewMode);
   preferences.putBool("inversion", state.display.colorInversion);
   preferences.putBool("secondDot", state.display.secondDotEnabled);
+  preferences.putBool("clockSecs", state.display.clockSecondsEnabled);
+  preferences.putBool("dotSweep", state.display.secondDotSweep);
   preferences.putInt("rotation", state.display.screenRotation);
   preferences.putBool("rememberScreen", state.display.rememberLastScreen);
   preferences.putInt("startupScreen", state.display.startupScreen);
+  preferences.putBool("hideClosed", state.display.hideClosedBands);
 
   // Audio
-  preferences.putInt("volumeStep", state.audio.volumeStep);
+  preferences.putInt("volume", state.audio.volumePercent);
   preferences.putInt("toneFreq", state.audio.toneFrequency);
   preferences.putInt("toneDur", state.audio.toneDurationMs);
+  preferences.putString("watchlist", state.audio.watchlist);
+  preferences.putInt("cwCalls", state.audio.cwCalls);
+  preferences.putInt("cwWpm", state.audio.cwWpm);
 
   // Network & Credentials
   preferences.putString("telnetUser", state.network.telnetUsername);
@@ -34,12 +40,15 @@ void saveSettings(const ApplicationState& state) {
   preferences.putString("timezone", state.network.timezone);
   preferences.putInt("dstMode", state.network.dstMode);
   preferences.putString("customDst", state.network.customDstRule);
+  preferences.putString("locator", state.station.locator);
 
   // Power
   preferences.putInt("sleepTimeout", state.power.sleepTimeoutMinutes);
   preferences.putBool("schedSleepOn", state.power.scheduledSleepEnabled);
   preferences.putInt("schedSleepH", state.power.scheduledSleepHour);
   preferences.putInt("schedWakeH", state.power.scheduledWakeHour);
+  preferences.putBool("lowPower", state.power.lowPowerMode);
+  preferences.putInt("spotDelay", state.power.maxSpotDelayMs);
 
   // System
   preferences.putBool("checkUpdates", state.checkForUpdates);
@@ -59,14 +68,24 @@ void loadSettings(ApplicationState& state) {
   state.display.spotsViewMode = (SpotsViewMode)preferences.getInt("spotsViewMode", SPOTS_WITH_PROP);
   state.display.colorInversion = preferences.getBool("inversion", true);
   state.display.secondDotEnabled = preferences.getBool("secondDot", true);
+  state.display.clockSecondsEnabled = preferences.getBool("clockSecs", false);
+  state.display.secondDotSweep = preferences.getBool("dotSweep", false);
   state.display.screenRotation = preferences.getInt("rotation", 3);
   state.display.rememberLastScreen = preferences.getBool("rememberScreen", false);
   state.display.startupScreen = (ActiveScreen)preferences.getInt("startupScreen", SCREEN_SPOTS);
+  state.display.hideClosedBands = preferences.getBool("hideClosed", false);
 
   // Audio
-  state.audio.volumeStep = preferences.getInt("volumeStep", 1); // Default to -18dB (quiet)
+  // Before the digital volume, one of five DAC attenuation steps was saved
+  const int legacyVolumes[] = {0, 10, 25, 50, 100}; // Muted, -18, -12, -6 and 0 dB
+  const int legacyStep = constrain(preferences.getInt("volumeStep", 1), 0, 4);
+  state.audio.volumePercent = preferences.getInt("volume", legacyVolumes[legacyStep]);
   state.audio.toneFrequency = preferences.getInt("toneFreq", 500);
   state.audio.toneDurationMs = preferences.getInt("toneDur", 50);
+  String watchlist = preferences.getString("watchlist", "");
+  strlcpy(state.audio.watchlist, watchlist.c_str(), sizeof(state.audio.watchlist));
+  state.audio.cwCalls = (CwCallsMode)preferences.getInt("cwCalls", CW_CALLS_OFF);
+  state.audio.cwWpm = preferences.getInt("cwWpm", 20);
 
   // Network & Credentials
   String user = preferences.getString("telnetUser", DEFAULT_TELNET_USERNAME);
@@ -82,11 +101,18 @@ void loadSettings(ApplicationState& state) {
   String customDst = preferences.getString("customDst", ",M3.5.0,M10.5.0/3");
   strlcpy(state.network.customDstRule, customDst.c_str(), sizeof(state.network.customDstRule));
 
+  // Station
+  String locator = preferences.getString("locator", "");
+  strlcpy(state.station.locator, locator.c_str(), sizeof(state.station.locator));
+  state.station.locationValid = locatorToLatLon(state.station.locator, state.station.latitude, state.station.longitude);
+
   // Power
   state.power.sleepTimeoutMinutes = preferences.getInt("sleepTimeout", 0);
   state.power.scheduledSleepEnabled = preferences.getBool("schedSleepOn", false);
   state.power.scheduledSleepHour = preferences.getInt("schedSleepH", 23);
   state.power.scheduledWakeHour = preferences.getInt("schedWakeH", 7);
+  state.power.lowPowerMode = preferences.getBool("lowPower", false);
+  state.power.maxSpotDelayMs = preferences.getInt("spotDelay", 1000);
 
   // System
   state.checkForUpdates = preferences.getBool("checkUpdates", true);
@@ -96,6 +122,60 @@ void loadSettings(ApplicationState& state) {
   Serial.println("Settings loaded from flash memory.");
 }
 
+// --- Data Cache ---
+// The latest spots and solar data, kept in flash so the first screen after
+// a restart can be drawn before the network is up. The stored struct sizes
+// guard against reading a cache written by a different firmware.
+
+void saveSpotCache(const ApplicationState& state) {
+  preferences.begin("data-cache", false);
+  preferences.putUShort("spotSize", sizeof(DxSpot));
+  preferences.putBytes("spots", state.spots, sizeof(state.spots));
+  preferences.putInt("spotCount", state.spotCount);
+  preferences.putInt("spotLatest", state.latestSpotIndex);
+  preferences.putULong("spotsAt", (unsigned long)time(nullptr));
+  preferences.end();
+}
+
+void saveSolarCache(const ApplicationState& state) {
+  preferences.begin("data-cache", false);
+  preferences.putUShort("solarSize", sizeof(SolarPropagationData));
+  preferences.putBytes("solar", &state.solarData, sizeof(state.solarData));
+  preferences.end();
+}
+
+void loadDataCache(ApplicationState& state) {
+  preferences.begin("data-cache", true); // Read-only mode
+
+  // Spots saved too long ago are dropped. Without a synced clock (power on)
+  // their age is unknown, so they are kept.
+  time_t now = time(nullptr);
+  struct tm timeinfo;
+  gmtime_r(&now, &timeinfo);
+  const unsigned long savedAt = preferences.getULong("spotsAt", 0);
+  const bool stale = timeinfo.tm_year >= (2020 - 1900) && savedAt > 0 && (unsigned long)now - savedAt > SPOT_CACHE_MAX_AGE_S;
+
+  const int count = preferences.getInt("spotCount", 0);
+  const int latest = preferences.getInt("spotLatest", -1);
+  if (!stale && preferences.getUShort("spotSize", 0) == sizeof(DxSpot) &&
+      count > 0 && count <= ApplicationState::MAX_SPOTS && latest >= 0 && latest < ApplicationState::MAX_SPOTS &&
+      preferences.getBytes("spots", state.spots, sizeof(state.spots)) == sizeof(state.spots)) {
+    state.spotCount = count;
+    state.latestSpotIndex = latest;
+    for (int i = count - 1; i >= 0; i--) { // Oldest first, as they arrived
+      addBandMapSpot(state.spots[(latest - i + ApplicationState::MAX_SPOTS) % ApplicationState::MAX_SPOTS]);
+    }
+  }
+
+  if (preferences.getUShort("solarSize", 0) == sizeof(SolarPropagationData) &&
+      preferences.getBytes("solar", &state.solarData, sizeof(state.solarData)) == sizeof(state.solarData)) {
+    state.propDataAvailable = true;
+  }
+
+  preferences.end();
+  Serial.printf("Cache loaded: %d spot(s), solar data %s.\n", state.spotCount, state.propDataAvailable ? "present" : "missing");
+}
+
 void clearWiFiSettings() {
   preferences.begin("wifi-creds", false);
   preferences.clear();
@@ -0,0 +1,220 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+// Spot map: the recent spots and the stations that spotted them on a world
+// map centered on the QTH's longitude. The map is decoded from the flash
+// land mask a strip of rows at a time, the markers are painted into each
+// strip, and the strip goes straight to the panel, so no screen-sized buffer
+// is needed and markers never flicker over a redrawn map.
+
+namespace {
+  enum MarkerShape { MARKER_SPOTTER, MARKER_DX, MARKER_QTH };
+
+  struct Marker {
+    int16_t x;
+    int16_t y;
+    uint16_t color;
+    MarkerShape shape;
+  };
+
+  // Screen scale of the map, in Q16 pixels per centidegree
+  struct MapGeometry {
+    int width;
+    int height;
+    int16_t centerLongitude;
+    int32_t xScale;
+    int32_t yScale;
+  };
+
+  // A screen position and the coordinates it was projected from, so a spot
+  // is projected once rather than on every redraw.
+  struct CachedPosition {
+    bool valid;
+    int16_t latitude;
+    int16_t longitude;
+    int16_t x;
+    int16_t y;
+  };
+
+  struct ProjectedSpot {
+    CachedPosition dx;
+    CachedPosition spotter;
+  };
+
+  const int MAX_MARKERS = 2 * ApplicationState::MAX_SPOTS + 1;
+
+  MapGeometry cachedGeometry = {};
+  ProjectedSpot projected[ApplicationState::MAX_SPOTS];
+
+  MapGeometry getMapGeometry(const ApplicationState& state) {
+    MapGeometry geometry;
+    geometry.width = min((int)tft.width(), GREYLINE_MAP_MAX_WIDTH);
+    geometry.height = geometry.width / 2; // Equirectangular: twice as wide as tall
+    geometry.centerLongitude = state.station.locationValid ? state.station.longitude : 0;
+    geometry.xScale = ((int32_t)geometry.width << 16) / 36000;
+    geometry.yScale = ((int32_t)geometry.height << 16) / 18000;
+    return geometry;
+  }
+
+  void project(int16_t latitude, int16_t longitude, const MapGeometry& geometry, int16_t& x, int16_t& y) {
+    int32_t east = longitude - geometry.centerLongitude + 18000; // 0..36000 with the QTH at 18000
+    if (east < 0) east += 36000;
+    if (east >= 36000) east -= 36000;
+    x = min((int)((east * geometry.xScale) >> 16), geometry.width - 1);
+    y = min((int)(((int32_t)(9000 - latitude) * geometry.yScale) >> 16), geometry.height - 1);
+  }
+
+  void projectCached(CachedPosition& position, int16_t latitude, int16_t longitude, const MapGeometry& geometry) {
+    if (position.valid && position.latitude == latitude && position.longitude == longitude) return;
+    project(latitude, longitude, geometry, position.x, position.y);
+    position.latitude = latitude;
+    position.longitude = longitude;
+    position.valid = true;
+  }
+
+  // Spotters first, then the DX stations over them, then the QTH on top.
+  int collectMarkers(const ApplicationState& state, const MapGeometry& geometry, Marker* markers) {
+    if (geometry.width != cachedGeometry.width || geometry.centerLongitude != cachedGeometry.centerLongitude) {
+      for (ProjectedSpot& spot : projected) spot.dx.valid = spot.spotter.valid = false;
+      cachedGeometry = geometry;
+    }
+
+    int count = 0;
+    for (int i = 0; i < state.spotCount; i++) {
+      const DxSpot& spot = state.spots[i];
+      if (!spot.spotterLocated) continue;
+      CachedPosition& position = projected[i].spotter;
+      projectCached(position, spot.spotterLatitude, spot.spotterLongitude, geometry);
+      markers[count++] = { position.x, position.y, TFT_WHITE, MARKER_SPOTTER };
+    }
+    for (int i = 0; i < state.spotCount; i++) {
+      const DxSpot& spot = state.spots[i];
+      if (!spot.dxLocated) continue;
+      CachedPosition& position = projected[i].dx;
+      projectCached(position, spot.dxLatitude, spot.dxLongitude, geometry);
+      markers[count++] = { position.x, position.y, getModeColor(spot.mode), MARKER_DX };
+    }
+    if (state.station.locationValid) {
+      Marker qth = { 0, 0, TFT_WHITE, MARKER_QTH };
+      project(state.station.latitude, state.station.longitude, geometry, qth.x, qth.y);
+      markers[count++] = qth;
+    }
+    return count;
+  }
+
+  int markerRadius(MarkerShape shape) {
+    switch (shape) {
+      case MARKER_SPOTTER: return SPOT_MAP_SPOTTER_MARKER_R;
+      case MARKER_DX: return SPOT_MAP_DX_MARKER_R + 1; // Includes the outline
+      default: return SPOT_MAP_QTH_MARKER_R;
+    }
+  }
+
+  // Paints the rows of a marker that fall in the strip [top, top + rows).
+  void paintMarker(uint16_t* strip, int width, int top, int rows, const Marker& marker) {
+    const int r = markerRadius(marker.shape);
+    const int y0 = max(marker.y - r, top);
+    const int y1 = min(marker.y + r, top + rows - 1);
+    for (int y = y0; y <= y1; y++) {
+      const int dy = y - marker.y;
+      uint16_t* row = strip + (y - top) * width;
+      for (int dx = -r; dx <= r; dx++) {
+        const int x = marker.x + dx;
+        if (x < 0 || x >= width) continue;
+        const int distance = dx * dx + dy * dy;
+        switch (marker.shape) {
+          case MARKER_SPOTTER: // Hollow square
+            if (abs(dx) == r || abs(dy) == r) row[x] = marker.color;
+            break;
+          case MARKER_DX: // Filled circle with a black outline
+            if (distance <= SPOT_MAP_DX_MARKER_R * SPOT_MAP_DX_MARKER_R) row[x] = marker.color;
+            else if (distance <= r * r) row[x] = TFT_BLACK;
+            break;
+          case MARKER_QTH: // Cross
+            if (dx == 0 || dy == 0) row[x] = marker.color;
+            break;
+        }
+      }
+    }
+  }
+
+  void drawMapStrips(const MapGeometry& geometry, const Marker* markers, int markerCount) {
+    static uint8_t land[GREYLINE_MAP_MAX_WIDTH];
+    static uint16_t strip[GREYLINE_MAP_MAX_WIDTH * SPOT_MAP_STRIP_H];
+
+    const int width = geometry.width;
+    // The land mask starts at 180 W; the screen starts 180 degrees west of the QTH
+    int shift = (int32_t)geometry.centerLongitude * width / 36000;
+    if (shift < 0) shift += width;
+
+    bool swapBytes = panel.getSwapBytes();
+    panel.setSwapBytes(true);
+    panel.startWrite();
+    for (int top = 0; top < geometry.height; top += SPOT_MAP_STRIP_H) {
+      const int rows = min(SPOT_MAP_STRIP_H, geometry.height - top);
+      for (int r = 0; r < rows; r++) {
+        decodeWorldMapRow(top + r, width, geometry.height, land);
+        uint16_t* row = strip + r * width;
+        for (int x = 0; x < width; x++) {
+          int source = x + shift;
+          if (source >= width) source -= width;
+          row[x] = land[source] ? COLOR_MAP_LAND_DAY : COLOR_MAP_OCEAN_DAY;
+        }
+      }
+      for (int i = 0; i < markerCount; i++) {
+        const int r = markerRadius(markers[i].shape);
+        if (markers[i].y + r >= top && markers[i].y - r < top + rows) {
+          paintMarker(strip, width, top, rows, markers[i]);
+        }
+      }
+      panel.pushImage(0, top, width, rows, strip);
+    }
+    panel.endWrite();
+    panel.setSwapBytes(swapBytes);
+  }
+}
+
+void drawSpotMapScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_SPOT_MAP);
+  CPU_BOOST_SCOPE();
+  const MapGeometry geometry = getMapGeometry(state);
+
+  // Newest spots below the map, each with its spotter. The frame keeps off
+  // the map area, which is drawn after the list is flushed.
+  tft.fillScreen(TFT_BLACK);
+  setFrameHole(0, 0, geometry.width, geometry.height);
+  tft.setFreeFont(&FreeSans9pt7b);
+  int yPos = geometry.height + 4;
+
+  if (!state.station.locationValid) {
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.drawString("Set QTH locator in web config", SPOT_MAP_TEXT_MARGIN, yPos);
+    yPos += SPOT_MAP_TEXT_LINE_HEIGHT;
+  }
+
+  for (int i = 0; i < state.spotCount && yPos + SPOT_MAP_TEXT_LINE_HEIGHT <= tft.height(); i++) {
+    int index = (state.latestSpotIndex - i + ApplicationState::MAX_SPOTS) % ApplicationState::MAX_SPOTS;
+    const DxSpot& spot = state.spots[index];
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(getModeColor(spot.mode), TFT_BLACK);
+    tft.drawString(spot.call, SPOT_MAP_TEXT_MARGIN, yPos);
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.drawString(String("de ") + spot.spotter, tft.width() - SPOT_MAP_TEXT_MARGIN, yPos);
+    yPos += SPOT_MAP_TEXT_LINE_HEIGHT;
+  }
+  flushFrame();
+
+  Marker markers[MAX_MARKERS];
+  const int markerCount = collectMarkers(state, geometry, markers);
+  drawMapStrips(geometry, markers, markerCount);
+}
@@ -29,6 +29,55 @@ namespace {
     return (availableHeight - BLOCK_HEIGHT) / 2;
   }
 
+  // True while the spot rows are on screen, rather than a status message, so
+  // new spots can be scrolled in without a full redraw.
+  bool isSpotListShown = false;
+
+  // Draws the spot shown in row i (0 = newest) of the list. A negative time
+  // of day, before the clock is synced, leaves the elapsed time out.
+  void drawSpotRow(const ApplicationState& state, int i, int startY, long currentTimeInSeconds) {
+    const int COL_FREQ_X = tft.width() - SPOT_COL_FREQ_X_MARGIN;
+
+    // Calculate index in the circular buffer (newest first)
+    int displayIndex = (state.latestSpotIndex - i + ApplicationState::MAX_SPOTS) % ApplicationState::MAX_SPOTS;
+    int yPos = startY + (i * SPOT_LINE_HEIGHT) + 5;
+
+    // Draw Time (Elapsed)
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    if (currentTimeInSeconds >= 0) {
+      long spotTimeInSeconds = state.spots[displayIndex].spotHour * 3600 + state.spots[displayIndex].spotMinute * 60;
+      long elapsedSeconds = currentTimeInSeconds - spotTimeInSeconds;
+      if (elapsedSeconds < 0) elapsedSeconds += 86400; // Handle spots from the previous day
+      tft.drawString(formatElapsedMinutes(elapsedSeconds), SPOT_COL_TIME_X, yPos);
+    } else {
+      tft.drawString("--", SPOT_COL_TIME_X, yPos);
+    }
+
+    // Mark spots whose DX entity is on the grey line
+    if (state.spots[displayIndex].nearGreyLine) {
+      tft.fillCircle(SPOT_COL_GREYLINE_X, yPos + 7, GREYLINE_MARKER_RADIUS, COLOR_GREYLINE);
+    }
+
+    // Draw Callsign
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(TFT_CYAN, TFT_BLACK);
+    tft.drawString(state.spots[displayIndex].call, SPOT_COL_CALL_X, yPos);
+
+    // Draw Mode
+    tft.setTextColor(getModeColor(state.spots[displayIndex].mode), TFT_BLACK);
+    tft.drawString(state.spots[displayIndex].mode, SPOT_COL_MODE_X, yPos);
+
+    // Draw Frequency, colored by the predicted state of its band
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextColor(getPropagationColor(getBandCondition(state, state.spots[displayIndex].band)), TFT_BLACK);
+    tft.drawString(state.spots[displayIndex].freq, COL_FREQ_X, yPos);
+  }
+
+  long getCurrentTimeInSeconds(const struct tm& timeinfo) {
+    return timeinfo.tm_hour * 3600 + timeinfo.tm_min * 60 + timeinfo.tm_sec;
+  }
+
   // Internal function to draw just the list of spots. Reused by both screen variants.
   static void drawSpotsList(ApplicationState& state) {
     time_t now;
@@ -36,51 +85,33 @@ namespace {
     time(&now);
     gmtime_r(&now, &timeinfo);
 
+    const int START_Y = calculateSpotsStartY(state);
+    int spotsToDisplay = (state.display.spotsViewMode == SPOTS_ONLY) ? 6 : 5;
+    int spotsAvailable = (state.spotCount > spotsToDisplay) ? spotsToDisplay : state.spotCount;
+
     // Check if time is synchronized (year > 2020)
     if (timeinfo.tm_year < (2020 - 1900)) {
+      isDisplayingTimeSyncMessage = true;
+      // Spots cached from before a restart are shown without their age
+      if (spotsAvailable > 0) {
+        for (int i = 0; i < spotsAvailable; i++) {
+          drawSpotRow(state, i, START_Y, -1);
+        }
+        return;
+      }
       tft.setTextColor(TFT_CYAN);
       tft.setTextDatum(MC_DATUM);
       tft.drawString("Waiting for time sync...", tft.width() / 2, tft.height() / 2);
-      isDisplayingTimeSyncMessage = true;
       return;
     }
 
     isDisplayingTimeSyncMessage = false;
-    long currentTimeInSeconds = timeinfo.tm_hour * 3600 + timeinfo.tm_min * 60 + timeinfo.tm_sec;
-
-    const int START_Y = calculateSpotsStartY(state);
-    const int COL_FREQ_X = tft.width() - SPOT_COL_FREQ_X_MARGIN;
-    int spotsToDisplay = (state.display.spotsViewMode == SPOTS_ONLY) ? 6 : 5;
-    int spotsAvailable = (state.spotCount > spotsToDisplay) ? spotsToDisplay : state.spotCount;
+    long currentTimeInSeconds = getCurrentTimeInSeconds(timeinfo);
 
     for (int i = 0; i < spotsAvailable; i++) {
-      // Calculate index in the circular buffer (newest first)
-      int displayIndex = (state.latestSpotIndex - i + ApplicationState::MAX_SPOTS) % ApplicationState::MAX_SPOTS;
-      int yPos = START_Y + (i * SPOT_LINE_HEIGHT) + 5;
-
-      long spotTimeInSeconds = state.spots[displayIndex].spotHour * 3600 + state.spots[displayIndex].spotMinute * 60;
-      long elapsedSeconds = currentTimeInSeconds - spotTimeInSeconds;
-      if (elapsedSeconds < 0) elapsedSeconds += 86400; // Handle spots from the previous day
-
-      // Draw Time (Elapsed)
-      tft.setTextDatum(TR_DATUM);
-      tft.setTextColor(TFT_WHITE, TFT_BLACK);
-      tft.drawString(formatElapsedMinutes(elapsedSeconds), SPOT_COL_TIME_X, yPos);
-
-      // Draw Callsign
-      tft.setTextDatum(TL_DATUM);
-      tft.setTextColor(TFT_CYAN, TFT_BLACK);
-      tft.drawString(state.spots[displayIndex].call, SPOT_COL_CALL_X, yPos);
-
-      // Draw Mode
-      tft.setTextColor(getModeColor(state.spots[displayIndex].mode), TFT_BLACK);
-      tft.drawString(state.spots[displayIndex].mode, SPOT_COL_MODE_X, yPos);
-
-      // Draw Frequency
-      tft.setTextDatum(TR_DATUM);
-      tft.setTextColor(TFT_WHITE, TFT_BLACK);
-      tft.drawString(state.spots[displayIndex].freq, COL_FREQ_X, yPos);
+      drawSpotRow(state, i, START_Y, currentTimeInSeconds);
     }
+    isSpotListShown = true;
   }
 }
 
@@ -130,10 +161,12 @@ bool connectToTelnet(ApplicationState& state, bool silentMode) {
   }
 }
 
-void readTelnetSpots(ApplicationState& state) {
+// Reads the lines that arrived from HamAlert and queues the spots among
+// them. Touches nothing but the telnet client and the spot queue, so it can
+// run apart from the UI.
+void readTelnetSpots() {
   static char lineBuffer[TELNET_LINE_BUFFER_SIZE];
   static int bufferPos = 0;
-  bool newSpotReceived = false; 
 
   // Process all available characters from the telnet buffer
   while (telnetClient.available()) {
@@ -148,9 +181,9 @@ void readTelnetSpots(ApplicationState& state) {
           lineBuffer[i--] = '\0';
         }
 
-        if (strlen(lineBuffer) > 0) {
-          parseSpot(lineBuffer, state);
-          newSpotReceived = true;
+        DxSpot spot;
+        if (strlen(lineBuffer) > 0 && parseSpotLine(lineBuffer, spot)) {
+          pushSpot(spot);
         }
         bufferPos = 0; // Reset for next line
       }
@@ -159,38 +192,67 @@ void readTelnetSpots(ApplicationState& state) {
     }
   }
 
-  // Redraw only if new data arrived to avoid flickering
-  if (newSpotReceived) {
-    determineAndDrawActiveScreen(state);
+}
+
+// Moves the queued spots into the spot list and puts them on screen.
+void processQueuedSpots(ApplicationState& state) {
+  static uint32_t reportedDrops = 0;
+  int newSpots = 0;
+  int popped = 0;
+  DxSpot spot;
+  while (popSpot(spot)) {
+    // A burst, such as the backfill after a login, runs at the full clock
+    if (++popped == 2) acquireCpuBoost();
+
+    // Skip spots on bands that are predicted closed, if the user asked for it
+    if (state.display.hideClosedBands && getBandCondition(state, spot.band) == POOR) continue;
+
+    // Resolve DX location, sunrise/sunset and grey-line flag
+    locateSpot(spot, state);
+    addSpot(spot, state);
+    newSpots++;
+  }
+
+  const uint32_t drops = getDroppedSpotCount();
+  if (drops != reportedDrops) {
+    Serial.printf("Spot queue full: %lu spot(s) dropped so far.\n", (unsigned long)drops);
+    reportedDrops = drops;
   }
+
+  // Redraw only if new spots arrived to avoid flickering
+  if (newSpots > 0) {
+    showNewSpots(state, min(newSpots, ApplicationState::MAX_SPOTS));
+  }
+  if (popped >= 2) releaseCpuBoost();
 }
 
-void parseSpot(const char* line, ApplicationState& state) {
+// Parses a "DX de" line. Returns false for any other line.
+bool parseSpotLine(const char* line, DxSpot& newSpot) {
   // Expected format: "DX de SPOTTER:  FREQ  CALL  TEXT  TIMEZ"
   // Example: "DX de SP7ABC:  14074.0  K1ABC  FT8 -10dB  1234Z"
   
   const char* de_ptr = strstr(line, "DX de ");
-  if (!de_ptr) return;
+  if (!de_ptr) return false;
 
   const char* spotter_start = de_ptr + 6;
   const char* colon_ptr = strchr(spotter_start, ':');
-  if (!colon_ptr) return;
+  if (!colon_ptr) return false;
 
   const char* freq_start = colon_ptr + 1;
   while (*freq_start && isspace(*freq_start)) freq_start++;
   const char* freq_end = strchr(freq_start, ' ');
-  if (!freq_end) return;
+  if (!freq_end) return false;
 
   const char* call_start = freq_end + 1;
   while (*call_start && isspace(*call_start)) call_start++;
   const char* call_end = strchr(call_start, ' ');
-  if (!call_end) return;
+  if (!call_end) return false;
 
   const char* time_ptr = strrchr(line, ' ');
-  if (!time_ptr || strlen(time_ptr + 1) < 4) return;
+  if (!time_ptr || strlen(time_ptr + 1) < 4) return false;
   const char* time_start = time_ptr + 1;
 
-  DxSpot newSpot;
+  newSpot = DxSpot();
 
   // Copy Spotter
   size_t len = colon_ptr - spotter_start;
@@ -220,7 +282,8 @@ void parseSpot(const char* line, ApplicationState& state) {
   // Determine Mode
   getModeFromLine(line, freqKHz, newSpot.mode, sizeof(newSpot.mode));
 
-  addSpot(newSpot, state);
+  newSpot.band = getBandIndex(freqKHz);
+  return true;
 }
 
 void addSpot(const DxSpot& newSpot, ApplicationState& state) {
@@ -229,10 +292,14 @@ void addSpot(const DxSpot& newSpot, ApplicationState& state) {
   if (state.spotCount < ApplicationState::MAX_SPOTS) {
     state.spotCount++;
   }
-  playNewSpotSound(state);
+  state.spotsCacheDirty = true;
+  addBandMapSpot(newSpot);
+  playSpotAlert(state, newSpot);
 }
 
 void clearSpots(ApplicationState& state) {
+  DxSpot spot;
+  while (popSpot(spot)) {} // Spots still queued from the old connection
   state.spotCount = 0;
   state.latestSpotIndex = -1;
   Serial.println("Spot list cleared.");
@@ -281,10 +348,13 @@ String formatElapsedMinutes(long elapsedSeconds) {
 }
 
 void drawSpotsScreen(ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_SPOTS);
   tft.fillScreen(TFT_BLACK);
+  isSpotListShown = false;
   tft.setFreeFont(&FreeSans9pt7b);
 
-  if (!state.network.isWifiConnected) {
+  // While a fast boot is still connecting, the cached spots are shown instead
+  if (!state.network.isWifiConnected && !state.network.starting) {
     tft.setTextDatum(MC_DATUM);
     tft.setTextColor(TFT_RED);
     tft.drawString("WiFi Connection Lost", tft.width() / 2, tft.height() / 2 - 15);
@@ -295,7 +365,7 @@ void drawSpotsScreen(ApplicationState& state) {
     return;
   }
 
-  if (!state.network.hamAlertConnected) {
+  if (!state.network.hamAlertConnected && !state.network.starting) {
     tft.setTextDatum(MC_DATUM);
     int yPos = tft.height() / 2 - 40;
     tft.setTextColor(TFT_RED);
@@ -313,22 +383,23 @@ void drawSpotsScreen(ApplicationState& state) {
 
   drawSpotsList(state);
   drawButtons(state);
-  state.lastDisplayUpdateTime = millis();
 }
 
 void drawSpotsAndPropScreen(ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_SPOTS_AND_PROP);
   // Draw the base spots screen
   drawSpotsScreen(state);
 
   // If no errors, draw the footer
-  if (state.network.isWifiConnected && state.network.hamAlertConnected) {
+  if ((state.network.isWifiConnected && state.network.hamAlertConnected) || state.network.starting) {
     drawPropagationFooter(state);
   }
 }
 
 void updateSpotTimesOnly(ApplicationState& state) {
+  PROFILE_SCOPE(PROF_UPDATE_SPOT_TIMES);
   if (state.activeScreen != SCREEN_SPOTS && state.activeScreen != SCREEN_SPOTS_AND_PROP) return;
-  if (!state.network.isWifiConnected || !state.network.hamAlertConnected) return;
+  if ((!state.network.isWifiConnected || !state.network.hamAlertConnected) && !state.network.starting) return;
 
   time_t now;
   struct tm timeinfo;
@@ -347,7 +418,7 @@ void updateSpotTimesOnly(ApplicationState& state) {
 
   if (!isTimeSynced) return;
 
-  long currentTimeInSeconds = timeinfo.tm_hour * 3600 + timeinfo.tm_min * 60 + timeinfo.tm_sec;
+  long currentTimeInSeconds = getCurrentTimeInSeconds(timeinfo);
 
   const int START_Y = calculateSpotsStartY(state);
   int spotsToDisplay = (state.display.spotsViewMode == SPOTS_ONLY) ? 6 : 5;
@@ -370,7 +441,61 @@ void updateSpotTimesOnly(ApplicationState& state) {
     tft.fillRect(0, yPos, SPOT_COL_TIME_WIDTH + 5, 20, TFT_BLACK);
     tft.setTextColor(TFT_WHITE, TFT_BLACK);
     tft.drawString(timeStr, SPOT_COL_TIME_X, yPos);
+
+    // The grey-line flag is refreshed every minute, so redraw its marker too
+    tft.fillRect(SPOT_COL_GREYLINE_X - GREYLINE_MARKER_RADIUS, yPos + 7 - GREYLINE_MARKER_RADIUS,
+                 2 * GREYLINE_MARKER_RADIUS + 1, 2 * GREYLINE_MARKER_RADIUS + 1, TFT_BLACK);
+    if (state.spots[displayIndex].nearGreyLine) {
+      tft.fillCircle(SPOT_COL_GREYLINE_X, yPos + 7, GREYLINE_MARKER_RADIUS, COLOR_GREYLINE);
+    }
+  }
+
+}
+
+// Puts newly received spots on screen. The band map repaints the slots the
+// new spots took. On the spot screens the list is
+// scrolled down by the new rows with the panel's hardware scroll and only
+// those rows are drawn. Anywhere else, when the whole list is new, or where
+// the panel cannot scroll, the active screen is redrawn as before.
+void showNewSpots(ApplicationState& state, int newSpots) {
+  if (state.activeScreen == SCREEN_BAND_MAP) {
+    refreshBandMap(state);
+    return;
+  }
+  const int spotsToDisplay = (state.display.spotsViewMode == SPOTS_ONLY) ? 6 : 5;
+  const bool onSpotList = (state.activeScreen == SCREEN_SPOTS || state.activeScreen == SCREEN_SPOTS_AND_PROP) && isSpotListShown;
+  if (!onSpotList || newSpots <= 0 || newSpots >= spotsToDisplay) {
+    determineAndDrawActiveScreen(state);
+    return;
+  }
+
+  const int START_Y = calculateSpotsStartY(state);
+  const int newHeight = newSpots * SPOT_LINE_HEIGHT;
+  if (!scrollFrameArea(START_Y, START_Y + spotsToDisplay * SPOT_LINE_HEIGHT, newHeight)) {
+    determineAndDrawActiveScreen(state);
+    return;
   }
 
-  state.lastDisplayUpdateTime = millis();
+  time_t now;
+  struct tm timeinfo;
+  time(&now);
+  gmtime_r(&now, &timeinfo);
+
+  tft.fillRect(0, START_Y, tft.width(), newHeight, TFT_BLACK);
+  tft.setFreeFont(&FreeSans9pt7b);
+  for (int i = 0; i < newSpots; i++) {
+    drawSpotRow(state, i, START_Y, getCurrentTimeInSeconds(timeinfo));
+  }
+}
+
+// Returns the index into state.spots of the spot shown in the list row at
+// screen height y, or -1 when no spot row is there.
+int findSpotAtRow(const ApplicationState& state, uint16_t y) {
+  if ((state.activeScreen != SCREEN_SPOTS && state.activeScreen != SCREEN_SPOTS_AND_PROP) || !isSpotListShown) return -1;
+  const int START_Y = calculateSpotsStartY(state);
+  if (y < START_Y) return -1;
+  const int spotsToDisplay = (state.display.spotsViewMode == SPOTS_ONLY) ? 6 : 5;
+  const int row = (y - START_Y) / SPOT_LINE_HEIGHT;
+  if (row >= spotsToDisplay || row >= state.spotCount) return -1;
+  return (state.latestSpotIndex - row + ApplicationState::MAX_SPOTS) % ApplicationState::MAX_SPOTS;
 }
@@ -0,0 +1,207 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include "mbedtls/net_sockets.h"
+#include "esp_random.h"
+#include <sys/select.h>
+
+// The session of each handshake is kept, ticket included, and offered on
+// the next connect. If the server still has it, the handshake skips the
+// certificate and the key exchange, which is most of its time and heap.
+// Resumption is TLS 1.2's, so the client stays at TLS 1.2. A resumed
+// handshake carries on the master secret of the session it resumes, while
+// a full one derives a new one; comparing the two tells them apart.
+
+namespace {
+  int fillRandom(void*, unsigned char* output, size_t length) {
+    esp_fill_random(output, length);
+    return 0;
+  }
+}
+
+TlsClient::TlsClient() {
+  mbedtls_ssl_config_init(&config);
+  mbedtls_ssl_session_init(&session);
+}
+
+TlsClient::~TlsClient() {
+  stop();
+  mbedtls_ssl_session_free(&session);
+  mbedtls_ssl_config_free(&config);
+}
+
+void TlsClient::sampleHeap() {
+  const uint32_t freeHeap = ESP.getFreeHeap();
+  if (freeHeap < lowestFreeHeap) lowestFreeHeap = freeHeap;
+}
+
+void TlsClient::resetLowestFreeHeap() {
+  lowestFreeHeap = UINT32_MAX;
+}
+
+int TlsClient::sendCallback(void* context, const unsigned char* buffer, size_t length) {
+  TlsClient* client = static_cast<TlsClient*>(context);
+  client->sampleHeap();
+  const size_t sent = client->WiFiClient::write(buffer, length);
+  return sent > 0 ? (int)sent : MBEDTLS_ERR_NET_SEND_FAILED;
+}
+
+// Waits up to timeoutMs for data from the socket. WiFiClient buffers what
+// it has received, so the socket is only waited on when that is empty.
+int TlsClient::receiveCallback(void* context, unsigned char* buffer, size_t length, uint32_t timeoutMs) {
+  TlsClient* client = static_cast<TlsClient*>(context);
+  client->sampleHeap();
+  if (client->WiFiClient::available() <= 0) {
+    const int fd = client->fd();
+    if (fd < 0) return MBEDTLS_ERR_NET_INVALID_CONTEXT;
+    fd_set readable;
+    FD_ZERO(&readable);
+    FD_SET(fd, &readable);
+    struct timeval timeout = { (time_t)(timeoutMs / 1000), (suseconds_t)(timeoutMs % 1000 * 1000) };
+    const int ready = select(fd + 1, &readable, nullptr, nullptr, &timeout);
+    if (ready == 0) return MBEDTLS_ERR_SSL_TIMEOUT;
+    if (ready < 0) return MBEDTLS_ERR_NET_RECV_FAILED;
+  }
+  const int received = client->WiFiClient::read(buffer, length);
+  if (received > 0) return received;
+  return client->WiFiClient::connected() ? MBEDTLS_ERR_SSL_WANT_READ : MBEDTLS_ERR_NET_CONN_RESET;
+}
+
+void TlsClient::exportKeysCallback(void* context, mbedtls_ssl_key_export_type type, const unsigned char* secret, size_t length,
+                                   const unsigned char clientRandom[32], const unsigned char serverRandom[32], mbedtls_tls_prf_types prf) {
+  TlsClient* client = static_cast<TlsClient*>(context);
+  if (type != MBEDTLS_SSL_KEY_EXPORT_TLS12_MASTER_SECRET || length != sizeof(client->masterSecret)) return;
+  client->resumed = client->haveSession && memcmp(client->masterSecret, secret, length) == 0;
+  memcpy(client->masterSecret, secret, length);
+}
+
+bool TlsClient::handshake(const char* host) {
+  if (!configured) {
+    if (mbedtls_ssl_config_defaults(&config, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT) != 0) return false;
+    mbedtls_ssl_conf_authmode(&config, MBEDTLS_SSL_VERIFY_NONE); // As WiFiClientSecure::setInsecure() did
+    mbedtls_ssl_conf_rng(&config, fillRandom, nullptr);
+    mbedtls_ssl_conf_max_tls_version(&config, MBEDTLS_SSL_VERSION_TLS1_2);
+    mbedtls_ssl_conf_session_tickets(&config, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+    mbedtls_ssl_conf_read_timeout(&config, HTTPS_READ_TIMEOUT_MS);
+    configured = true;
+  }
+
+  mbedtls_ssl_init(&ssl);
+  open = true;
+  if (mbedtls_ssl_setup(&ssl, &config) != 0 || mbedtls_ssl_set_hostname(&ssl, host) != 0) return false;
+  mbedtls_ssl_set_bio(&ssl, this, sendCallback, nullptr, receiveCallback);
+  mbedtls_ssl_set_export_keys_cb(&ssl, exportKeysCallback, this);
+  if (haveSession) mbedtls_ssl_set_session(&ssl, &session);
+
+  int result;
+  while ((result = mbedtls_ssl_handshake(&ssl)) != 0) {
+    if (result != MBEDTLS_ERR_SSL_WANT_READ && result != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      Serial.printf("TLS handshake with %s failed: -0x%04x\n", host, -result);
+      return false;
+    }
+  }
+
+  // Keep the session, with any new ticket, for the next connect
+  mbedtls_ssl_session_free(&session);
+  mbedtls_ssl_session_init(&session);
+  haveSession = mbedtls_ssl_get_session(&ssl, &session) == 0;
+  return true;
+}
+
+int TlsClient::connect(const char* host, uint16_t port) {
+  stop();
+  resumed = false;
+  if (!WiFiClient::connect(host, port)) return 0;
+  if (!handshake(host)) {
+    stop();
+    return 0;
+  }
+  return 1;
+}
+
+size_t TlsClient::write(uint8_t data) {
+  return write(&data, 1);
+}
+
+size_t TlsClient::write(const uint8_t* buffer, size_t size) {
+  if (!open) return 0;
+  size_t sent = 0;
+  while (sent < size) {
+    const int result = mbedtls_ssl_write(&ssl, buffer + sent, size - sent);
+    if (result > 0) sent += result;
+    else if (result != MBEDTLS_ERR_SSL_WANT_READ && result != MBEDTLS_ERR_SSL_WANT_WRITE) break;
+  }
+  return sent;
+}
+
+// Decrypted bytes ready to read. A record is only decrypted once some of
+// it has arrived, so this does not wait on an idle connection.
+int TlsClient::available() {
+  if (!open) return 0;
+  size_t buffered = mbedtls_ssl_get_bytes_avail(&ssl);
+  if (buffered == 0 && WiFiClient::available() > 0) {
+    const int result = mbedtls_ssl_read(&ssl, nullptr, 0);
+    if (result < 0 && result != MBEDTLS_ERR_SSL_WANT_READ && result != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      WiFiClient::stop(); // Closed by the server, or broken; what was decrypted can still be read
+    }
+    buffered = mbedtls_ssl_get_bytes_avail(&ssl);
+  }
+  return buffered + (peeked >= 0 ? 1 : 0);
+}
+
+int TlsClient::read() {
+  uint8_t data;
+  return read(&data, 1) == 1 ? data : -1;
+}
+
+int TlsClient::read(uint8_t* buffer, size_t size) {
+  if (!open) return -1;
+  size_t count = 0;
+  if (peeked >= 0 && size > 0) {
+    buffer[count++] = peeked;
+    peeked = -1;
+  }
+  while (count < size) {
+    const int ready = available();
+    if (ready <= 0) break;
+    const int result = mbedtls_ssl_read(&ssl, buffer + count, min(size - count, (size_t)ready));
+    if (result <= 0) break;
+    count += result;
+  }
+  return count > 0 ? (int)count : -1;
+}
+
+int TlsClient::peek() {
+  if (peeked < 0) {
+    uint8_t data;
+    if (read(&data, 1) == 1) peeked = data;
+  }
+  return peeked;
+}
+
+// Writes go out as they are made. WiFiClient::flush() would drop received
+// records instead.
+void TlsClient::flush() {}
+
+void TlsClient::stop() {
+  if (open) {
+    if (WiFiClient::connected()) mbedtls_ssl_close_notify(&ssl);
+    mbedtls_ssl_free(&ssl);
+    open = false;
+  }
+  peeked = -1;
+  WiFiClient::stop();
+}
+
+uint8_t TlsClient::connected() {
+  if (!open) return 0;
+  if (peeked >= 0 || mbedtls_ssl_get_bytes_avail(&ssl) > 0) return 1;
+  return WiFiClient::connected();
+}
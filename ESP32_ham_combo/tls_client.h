@@ -0,0 +1,65 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#ifndef TLS_CLIENT_H
+#define TLS_CLIENT_H
+
+#include <WiFiClient.h>
+#include "mbedtls/ssl.h"
+
+// A TLS 1.2 client run with mbedTLS over the plain TCP socket of the
+// WiFiClient it extends. Unlike WiFiClientSecure it keeps the session of
+// its last handshake and offers it on the next connect, so a reconnect to
+// the same host is an abbreviated handshake without the public key work.
+// One client talks to one host; certificates are not verified.
+class TlsClient : public WiFiClient {
+public:
+  TlsClient();
+  ~TlsClient();
+
+  int connect(const char* host, uint16_t port) override;
+  size_t write(uint8_t data) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  int available() override;
+  int read() override;
+  int read(uint8_t* buffer, size_t size) override;
+  int peek() override;
+  void flush() override;
+  void stop() override;
+  uint8_t connected() override;
+
+  // True if the last connect() resumed the session of the one before.
+  bool resumedSession() const { return resumed; }
+
+  // Lowest free heap seen in the socket callbacks since the last reset.
+  // They run between the steps of a handshake, while it holds its buffers.
+  uint32_t getLowestFreeHeap() const { return lowestFreeHeap; }
+  void resetLowestFreeHeap();
+
+private:
+  static int sendCallback(void* context, const unsigned char* buffer, size_t length);
+  static int receiveCallback(void* context, unsigned char* buffer, size_t length, uint32_t timeoutMs);
+  static void exportKeysCallback(void* context, mbedtls_ssl_key_export_type type, const unsigned char* secret, size_t length,
+                                 const unsigned char clientRandom[32], const unsigned char serverRandom[32], mbedtls_tls_prf_types prf);
+  void sampleHeap();
+  bool handshake(const char* host);
+
+  mbedtls_ssl_config config;
+  mbedtls_ssl_context ssl;
+  mbedtls_ssl_session session;
+  bool configured = false;
+  bool open = false;          // ssl is in use, from connect() to stop()
+  bool haveSession = false;   // session holds one to offer
+  bool resumed = false;
+  int peeked = -1;
+  unsigned char masterSecret[48]; // Of the last handshake, to tell a resumed one
+  uint32_t lowestFreeHeap = UINT32_MAX;
+};
+
+#endif // TLS_CLIENT_H
@@ -0,0 +1,191 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include <atomic>
+#include "driver/gpio.h"
+
+// Interrupt-driven touch input. The XPT2046 pulls TOUCH_IRQ low while the
+// panel is pressed. The interrupt is level-triggered, so it can also wake
+// the chip from light sleep; it masks itself and wakes a sampler task that
+// reads the controller every few milliseconds until the finger lifts, and
+// posts press, move and release events (raw controller coordinates) to a
+// single-producer, single-consumer ring that loop() drains. The sampler
+// unmasks the interrupt again once the panel is released. Nothing touches
+// the touch SPI bus while the screen is not being pressed.
+//
+// Samples are read from the controller directly rather than through the
+// touch library, which caches readings and averages only two conversions:
+// each axis is converted several times and the median kept, and a sample
+// counts only if the pressure is high enough both before and after, so a
+// finger landing or lifting mid-sample does not produce a stray point.
+
+namespace {
+  static_assert((TOUCH_QUEUE_SIZE & (TOUCH_QUEUE_SIZE - 1)) == 0, "TOUCH_QUEUE_SIZE must be a power of two");
+
+  TouchEvent queue[TOUCH_QUEUE_SIZE];
+  std::atomic<uint32_t> queueHead(0); // Next slot to write; only the sampler advances it
+  std::atomic<uint32_t> queueTail(0); // Next slot to read; only loop() advances it
+
+  // XPT2046 control bytes: 12-bit differential conversions, PENIRQ enabled
+  // between them, and power down after the last so the IRQ line works again
+  const uint8_t CMD_Z1 = 0xB1;
+  const uint8_t CMD_Z2 = 0xC1;
+  const uint8_t CMD_X = 0xD1;
+  const uint8_t CMD_Y = 0x91;
+  const uint8_t CMD_POWER_DOWN = 0xD0;
+
+  TaskHandle_t samplerTask = nullptr;
+  std::atomic<bool> samplerPaused(false);
+  std::atomic<bool> samplerBusy(false);
+
+  void IRAM_ATTR onTouchInterrupt() {
+    gpio_intr_disable((gpio_num_t)TOUCH_IRQ); // The line stays low for the whole press
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(samplerTask, &higherPriorityTaskWoken);
+    portYIELD_FROM_ISR(higherPriorityTaskWoken);
+  }
+
+  // Sends the next control byte while reading the conversion started by the
+  // previous one.
+  int16_t transferConversion(uint8_t nextCommand) {
+    return touchscreenSPI.transfer16((uint16_t)nextCommand << 8) >> 3;
+  }
+
+  int16_t median(int16_t* values, int count) {
+    for (int i = 1; i < count; i++) {
+      int16_t value = values[i];
+      int j = i - 1;
+      for (; j >= 0 && values[j] > value; j--) values[j + 1] = values[j];
+      values[j + 1] = value;
+    }
+    return values[count / 2];
+  }
+
+  void postEvent(TouchEventType type, const TS_Point& point) {
+    const uint32_t head = queueHead.load(std::memory_order_relaxed);
+    if (head - queueTail.load(std::memory_order_acquire) >= TOUCH_QUEUE_SIZE) return; // Full: loop() is blocked
+    TouchEvent& event = queue[head % TOUCH_QUEUE_SIZE];
+    event.type = type;
+    event.rawX = point.x;
+    event.rawY = point.y;
+    event.time = millis();
+    queueHead.store(head + 1, std::memory_order_release);
+    wakeMainLoop();
+  }
+
+  // Follows one press from first contact to release. A release needs a few
+  // empty samples in a row, so a light finger does not split one press in two.
+  void samplePress() {
+    bool pressed = false;
+    TS_Point last;
+    int misses = 0;
+    while (!samplerPaused.load() && misses < TOUCH_RELEASE_SAMPLES) {
+      TS_Point point;
+      if (readTouchPoint(point)) {
+        misses = 0;
+        if (!pressed) {
+          postEvent(TOUCH_PRESS, point);
+          pressed = true;
+          last = point;
+        } else if (abs(point.x - last.x) + abs(point.y - last.y) >= TOUCH_MOVE_THRESHOLD_RAW) {
+          postEvent(TOUCH_MOVE, point);
+          last = point;
+        }
+      } else {
+        misses++;
+      }
+      vTaskDelay(pdMS_TO_TICKS(TOUCH_SAMPLE_INTERVAL_MS));
+    }
+    if (pressed) postEvent(TOUCH_RELEASE, last);
+  }
+
+  void touchSamplerTask(void*) {
+    for (;;) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      // Busy is raised before paused is checked, so setTouchInputPaused()
+      // either sees the sampler working or the sampler sees the pause.
+      samplerBusy.store(true);
+      do {
+        if (samplerPaused.load()) break;
+        samplePress();
+      } while (digitalRead(TOUCH_IRQ) == LOW); // A new press that started meanwhile
+      samplerBusy.store(false);
+      // While paused the line is left masked; resuming unmasks it
+      if (!samplerPaused.load()) gpio_intr_enable((gpio_num_t)TOUCH_IRQ);
+    }
+  }
+}
+
+void startTouchInput() {
+  if (samplerTask) return;
+  pinMode(TOUCH_IRQ, INPUT);
+  xTaskCreatePinnedToCore(touchSamplerTask, "touch", TOUCH_TASK_STACK_SIZE, nullptr, TOUCH_TASK_PRIORITY, &samplerTask, ARDUINO_RUNNING_CORE);
+  attachInterrupt(digitalPinToInterrupt(TOUCH_IRQ), onTouchInterrupt, ONLOW);
+  Serial.println("Touch input started.");
+}
+
+// Takes the oldest touch event off the queue. Returns false when it is empty.
+bool readTouchEvent(TouchEvent& event) {
+  const uint32_t tail = queueTail.load(std::memory_order_relaxed);
+  if (tail == queueHead.load(std::memory_order_acquire)) return false;
+  event = queue[tail % TOUCH_QUEUE_SIZE];
+  queueTail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+// Hands the touch controller to code that polls it directly (calibration).
+// Pausing waits for a press in progress to stop being sampled; resuming
+// drops whatever was queued before the pause.
+void setTouchInputPaused(bool paused) {
+  samplerPaused.store(paused);
+  if (paused) {
+    while (samplerBusy.load()) delay(1);
+  } else {
+    queueTail.store(queueHead.load(std::memory_order_acquire), std::memory_order_release);
+    gpio_intr_enable((gpio_num_t)TOUCH_IRQ);
+  }
+}
+
+// Reads one filtered sample in raw controller coordinates. Returns false
+// when the panel is not pressed firmly enough for a reliable position.
+bool readTouchPoint(TS_Point& point) {
+  int16_t xs[TOUCH_OVERSAMPLE];
+  int16_t ys[TOUCH_OVERSAMPLE];
+
+  touchscreenSPI.beginTransaction(SPISettings(XPT2046_SPI_HZ, MSBFIRST, SPI_MODE0));
+  digitalWrite(TOUCH_CS, LOW);
+  touchscreenSPI.transfer(CMD_Z1);
+  int16_t z1 = transferConversion(CMD_Z2);
+  int16_t z2 = transferConversion(CMD_X);
+  const int16_t pressureBefore = z1 + 4095 - z2;
+  bool pressed = pressureBefore >= TOUCH_MIN_PRESSURE;
+  if (pressed) {
+    transferConversion(CMD_X); // The first conversion after switching axes is noisy
+    for (int i = 0; i < TOUCH_OVERSAMPLE; i++) xs[i] = transferConversion(i + 1 < TOUCH_OVERSAMPLE ? CMD_X : CMD_Y);
+    transferConversion(CMD_Y);
+    for (int i = 0; i < TOUCH_OVERSAMPLE; i++) ys[i] = transferConversion(i + 1 < TOUCH_OVERSAMPLE ? CMD_Y : CMD_Z1);
+    z1 = transferConversion(CMD_Z2);
+    z2 = transferConversion(CMD_POWER_DOWN);
+  } else {
+    transferConversion(CMD_POWER_DOWN);
+  }
+  transferConversion(0);
+  digitalWrite(TOUCH_CS, HIGH);
+  touchscreenSPI.endTransaction();
+
+  if (!pressed) return false;
+  const int16_t pressureAfter = z1 + 4095 - z2;
+  if (pressureAfter < TOUCH_MIN_PRESSURE) return false;
+
+  point.x = median(xs, TOUCH_OVERSAMPLE);
+  point.y = median(ys, TOUCH_OVERSAMPLE);
+  point.z = min(pressureBefore, pressureAfter);
+  return true;
+}
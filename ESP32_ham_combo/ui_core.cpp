@@ -10,19 +10,6 @@ Commercial use is prohibited.
 #include <Arduino.h>
 #include "declarations.h"
 
-namespace {
-  // Maps a volume step (0-4) to the hardware attenuation levels.
-  dac_cosine_atten_t getDacAttenuation(int volumeStep) {
-    switch (volumeStep) {
-      case 4: return DAC_COSINE_ATTEN_DB_0;   // 0 dB
-      case 3: return DAC_COSINE_ATTEN_DB_6;   // -6 dB
-      case 2: return DAC_COSINE_ATTEN_DB_12;  // -12 dB
-      case 1: return DAC_COSINE_ATTEN_DB_18;  // -18 dB
-      default: return DAC_COSINE_ATTEN_DB_0;
-    }
-  }
-}
-
 // --- UI Color Helper Functions ---
 
 uint16_t getPropagationColor(PropagationCondition propValue) {
@@ -103,321 +90,311 @@ void setBrightness(int percent) {
   analogWrite(TFT_BL, dutyCycle);
 }
 
-void setupAudio(ApplicationState& state) {
-  if (state.audio.cos_handle != nullptr) {
-    dac_cosine_del_channel(state.audio.cos_handle);
-    state.audio.cos_handle = nullptr;
-  }
-  if (state.audio.volumeStep == 0) { // Muted
+// --- Touch Handling Helper Functions ---
+
+// Helper to check if a touch coordinate falls within a rectangular area.
+bool isButtonTouched(uint16_t tx, uint16_t ty, int x, int y, int w, int h) {
+    return (tx >= x && tx <= (x + w) && ty >= y && ty <= (y + h));
+}
+
+// The press being followed from its TOUCH_PRESS to its TOUCH_RELEASE event
+struct TouchPress {
+  bool active = false;
+  ActiveScreen screen;
+  WidgetId widget;
+  uint16_t x;                 // Where the press started
+  uint16_t y;
+  uint32_t startTime;
+  bool dragging = false;      // Moved beyond the tap slop, so it can only be a swipe
+  bool held = false;          // A long press or repeat acted on it; the release does not
+  bool repeats = false;       // On a stepper's "-" or "+"
+  bool repeating = false;
+  uint32_t nextRepeatTime;
+  bool saveDeferred = false;  // Settings changed while repeating, saved at the release
+};
+
+static TouchPress currentPress;
+
+// Saves changed settings, or, while a stepper repeats, notes that they need
+// saving once the finger lifts.
+static void commitSettings(ApplicationState& state) {
+  if (currentPress.repeating) {
+    currentPress.saveDeferred = true;
     return;
   }
-  dac_cosine_config_t cos_cfg;
-  cos_cfg.chan_id = DAC_CHAN_1;
-  cos_cfg.freq_hz = (uint32_t)state.audio.toneFrequency;
-  cos_cfg.clk_src = DAC_COSINE_CLK_SRC_DEFAULT;
-  cos_cfg.offset = 0;
-  cos_cfg.phase = DAC_COSINE_PHASE_0;
-  cos_cfg.atten = getDacAttenuation(state.audio.volumeStep);
-  cos_cfg.flags.force_set_freq = false;
-  
-  esp_err_t result = dac_cosine_new_channel(&cos_cfg, &state.audio.cos_handle);
-  if (result != ESP_OK) {
-    Serial.printf("Failed to create DAC cosine channel: %s\n", esp_err_to_name(result));
-    state.audio.cos_handle = nullptr;
+  saveSettings(state);
+}
+
+// Returns from the clock, map and band map screens to the spots screen
+// the user chose.
+static void returnToSpotsScreen(ApplicationState& state) {
+  state.lastSecond = -1;
+  if (state.display.spotsViewMode == SPOTS_WITH_PROP) {
+    state.activeScreen = SCREEN_SPOTS_AND_PROP;
+    if (state.display.rememberLastScreen) { state.display.startupScreen = SCREEN_SPOTS_AND_PROP; saveSettings(state); }
+    drawSpotsAndPropScreen(state);
+  } else {
+    state.activeScreen = SCREEN_SPOTS;
+    if (state.display.rememberLastScreen) { state.display.startupScreen = SCREEN_SPOTS; saveSettings(state); }
+    drawSpotsScreen(state);
   }
 }
 
-void playNewSpotSound(const ApplicationState& state) {
-  if (state.audio.volumeStep == 0 || state.audio.cos_handle == nullptr) {
+// Makes one of the main screens the active one, without drawing it.
+static void selectMainScreen(ApplicationState& state, ActiveScreen screen) {
+  state.activeScreen = screen;
+  if (state.display.rememberLastScreen) { state.display.startupScreen = screen; saveSettings(state); }
+}
+
+static void openMainScreen(ApplicationState& state, ActiveScreen screen) {
+  if (screen == SCREEN_SPOTS || screen == SCREEN_SPOTS_AND_PROP) {
+    returnToSpotsScreen(state);
     return;
   }
-  dac_cosine_start(state.audio.cos_handle);
-  delay(state.audio.toneDurationMs);
-  dac_cosine_stop(state.audio.cos_handle);
+  selectMainScreen(state, screen);
+  switch (screen) {
+    case SCREEN_CLOCK:
+      state.lastSecond = -1;
+      drawClockScreen(state);
+      break;
+    case SCREEN_PROPAGATION: drawPropagationScreen(state); break;
+    case SCREEN_GREY_LINE: drawGreyLineScreen(state); break;
+    case SCREEN_BAND_MAP: drawBandMapScreen(state); break;
+    case SCREEN_SPOT_MAP: drawSpotMapScreen(state); break;
+    default: break;
+  }
 }
 
-// --- Touch Handling Helper Functions ---
+static void handleTouchSpotsScreen(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    switch (touched) {
+        case WID_CLOCK:
+            openMainScreen(state, SCREEN_CLOCK);
+            break;
+        case WID_PROP:
+            openMainScreen(state, SCREEN_PROPAGATION);
+            break;
+        case WID_SETUP:
+            state.activeScreen = SCREEN_SETTINGS_MENU;
+            drawSettingsMenuScreen(state);
+            break;
+        case WID_SLEEP_NOW:
+            enterDeepSleep(state);
+            break;
+        case WID_NONE:
+            // The spot list itself opens the band map
+            if (t_y < BUTTON_Y) openMainScreen(state, SCREEN_BAND_MAP);
+            break;
+        default:
+            break;
+    }
+}
 
-// Helper to check if a touch coordinate falls within a rectangular area.
-bool isButtonTouched(uint16_t tx, uint16_t ty, int x, int y, int w, int h) {
-    return (tx >= x && tx <= (x + w) && ty >= y && ty <= (y + h));
+// Holding a spot row opens the band map on that spot's band.
+static bool handleLongPressSpotsScreen(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    if (touched != WID_NONE) return false;
+    const int index = findSpotAtRow(state, t_y);
+    if (index < 0) return false;
+    selectMainScreen(state, SCREEN_BAND_MAP);
+    showBandMapBand(state, state.spots[index].band);
+    return true;
 }
 
-static void handleTouchSpotsScreen(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    if (isButtonTouched(t_x, t_y, CLOCK_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        state.activeScreen = SCREEN_CLOCK;
-        if (state.display.rememberLastScreen) { state.display.startupScreen = SCREEN_CLOCK; saveSettings(state); }
-        state.lastSecond = -1;
-        drawClockScreen(state);
-        state.lastClockUpdateTime = millis();
-    } else if (isButtonTouched(t_x, t_y, PROP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        state.activeScreen = SCREEN_PROPAGATION;
-        if (state.display.rememberLastScreen) { state.display.startupScreen = SCREEN_PROPAGATION; saveSettings(state); }
-        drawPropagationScreen(state);
-    } else if (isButtonTouched(t_x, t_y, SETUP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        state.activeScreen = SCREEN_SETTINGS_MENU;
-        drawSettingsMenuScreen(state);
-    } else if (isButtonTouched(t_x, t_y, SLEEP_NOW_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        enterDeepSleep(state);
+// Taps at the left or right edge step through the bands; anywhere else goes back.
+static void handleTouchBandMap(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    if (t_x < BAND_MAP_EDGE_TOUCH_W) {
+        stepBandMapBand(state, -1);
+    } else if (t_x >= tft.width() - BAND_MAP_EDGE_TOUCH_W) {
+        stepBandMapBand(state, 1);
+    } else {
+        returnToSpotsScreen(state);
     }
 }
 
-static void handleTouchSettingsMenu(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    if (isButtonTouched(t_x, t_y, SETUP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        determineAndDrawActiveScreen(state);
-    } else {
-        // Check menu items
-        const int x = SETTINGS_MENU_BTN_X_MARGIN;
-        const int w = tft.width() - 2 * x;
-        
-        if (isButtonTouched(t_x, t_y, x, SETTINGS_MENU_START_Y, w, SETTINGS_MENU_BTN_H)) {
+static void handleTouchSettingsMenu(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    switch (touched) {
+        case WID_BACK:
+            determineAndDrawActiveScreen(state);
+            break;
+        case WID_MENU_DISPLAY:
             state.activeScreen = SCREEN_DISPLAY_SETTINGS;
             drawDisplaySettingsScreen(state);
-        } else if (isButtonTouched(t_x, t_y, x, SETTINGS_MENU_START_Y + (SETTINGS_MENU_BTN_H + SETTINGS_MENU_GAP), w, SETTINGS_MENU_BTN_H)) {
+            break;
+        case WID_MENU_AUDIO:
             state.activeScreen = SCREEN_AUDIO_SETTINGS;
             drawAudioSettingsScreen(state);
-        } else if (isButtonTouched(t_x, t_y, x, SETTINGS_MENU_START_Y + 2*(SETTINGS_MENU_BTN_H + SETTINGS_MENU_GAP), w, SETTINGS_MENU_BTN_H)) {
+            break;
+        case WID_MENU_SLEEP:
             state.activeScreen = SCREEN_SLEEP_SETTINGS;
             drawSleepSettingsScreen(state);
-        } else if (isButtonTouched(t_x, t_y, x, SETTINGS_MENU_START_Y + 3*(SETTINGS_MENU_BTN_H + SETTINGS_MENU_GAP), w, SETTINGS_MENU_BTN_H)) {
+            break;
+        case WID_MENU_SYSTEM:
             state.activeScreen = SCREEN_SYSTEM_SETTINGS;
             drawSystemSettingsScreen(state);
-        }
+            break;
+        default:
+            break;
     }
 }
 
-static void handleTouchDisplaySettings(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    if (isButtonTouched(t_x, t_y, SETUP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        state.activeScreen = SCREEN_SETTINGS_MENU;
-        drawSettingsMenuScreen(state);
-        return;
-    }
-
-    // Row 1: Clock Mode
-    if (isButtonTouched(t_x, t_y, SETTINGS_CONTROL_X, SETTINGS_ROW1_Y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H)) {
-        state.display.currentClockMode = (ClockDisplayMode)((state.display.currentClockMode + 1) % 3);
-        state.lastSecond = -1;
-        saveSettings(state);
-        drawDisplaySettingsScreen(state);
-    } 
-    // Row 2: Spots View Mode
-    else if (isButtonTouched(t_x, t_y, SETTINGS_CONTROL_X, SETTINGS_ROW2_Y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H)) {
-        state.display.spotsViewMode = (state.display.spotsViewMode == SPOTS_ONLY) ? SPOTS_WITH_PROP : SPOTS_ONLY;
-        saveSettings(state);
-        drawDisplaySettingsScreen(state);
-    } 
-    // Row 3: Propagation View Mode
-    else if (isButtonTouched(t_x, t_y, SETTINGS_CONTROL_X, SETTINGS_ROW3_Y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H)) {
-        state.display.currentPropViewMode = (state.display.currentPropViewMode == VIEW_SIMPLE) ? VIEW_EXTENDED : VIEW_SIMPLE;
-        saveSettings(state);
-        drawDisplaySettingsScreen(state);
-    } 
-    // Row 4: Brightness (- / +)
-    else if (t_y >= SETTINGS_ROW4_Y && t_y <= (SETTINGS_ROW4_Y + SETTINGS_CONTROL_H)) {
-        int minus_x = SETTINGS_CONTROL_X;
-        int plus_x = tft.width() - SETTINGS_TOUCH_W - 20;
-        
-        if (isButtonTouched(t_x, t_y, minus_x, SETTINGS_ROW4_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (state.display.brightnessPercent > 10) {
-                state.display.brightnessPercent -= 10;
-                setBrightness(state.display.brightnessPercent);
-                saveSettings(state);
-                drawDisplaySettingsScreen(state);
-            }
-        } else if (isButtonTouched(t_x, t_y, plus_x, SETTINGS_ROW4_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (state.display.brightnessPercent < 100) {
-                state.display.brightnessPercent += 10;
-                setBrightness(state.display.brightnessPercent);
-                saveSettings(state);
-                drawDisplaySettingsScreen(state);
-            }
-        }
-    } 
-    // Row 5: Color Inversion
-    else if (isButtonTouched(t_x, t_y, SETTINGS_CONTROL_X, SETTINGS_ROW5_Y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H)) {
-        state.display.colorInversion = !state.display.colorInversion;
-        tft.invertDisplay(state.display.colorInversion);
-        saveSettings(state);
-        drawDisplaySettingsScreen(state);
+static void handleTouchDisplaySettings(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    switch (touched) {
+        case WID_BACK:
+            state.activeScreen = SCREEN_SETTINGS_MENU;
+            drawSettingsMenuScreen(state);
+            return;
+        case WID_CLOCK_MODE:
+            state.display.currentClockMode = (ClockDisplayMode)((state.display.currentClockMode + 1) % 3);
+            state.lastSecond = -1;
+            break;
+        case WID_SPOTS_VIEW:
+            state.display.spotsViewMode = (state.display.spotsViewMode == SPOTS_ONLY) ? SPOTS_WITH_PROP : SPOTS_ONLY;
+            break;
+        case WID_PROP_VIEW:
+            state.display.currentPropViewMode = (state.display.currentPropViewMode == VIEW_SIMPLE) ? VIEW_EXTENDED : VIEW_SIMPLE;
+            break;
+        case WID_BRIGHTNESS_DOWN:
+            if (state.display.brightnessPercent <= 10) return;
+            state.display.brightnessPercent -= 10;
+            setBrightness(state.display.brightnessPercent);
+            break;
+        case WID_BRIGHTNESS_UP:
+            if (state.display.brightnessPercent >= 100) return;
+            state.display.brightnessPercent += 10;
+            setBrightness(state.display.brightnessPercent);
+            break;
+        case WID_INVERT:
+            state.display.colorInversion = !state.display.colorInversion;
+            panel.invertDisplay(state.display.colorInversion);
+            break;
+        default:
+            return;
     }
+    commitSettings(state);
+    refreshSettingsScreen(state);
 }
 
-static void handleTouchAudioSettings(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    if (isButtonTouched(t_x, t_y, SETUP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        state.activeScreen = SCREEN_SETTINGS_MENU;
-        drawSettingsMenuScreen(state);
-        return;
-    }
-
-    int minus_x = SETTINGS_CONTROL_X;
-    int plus_x = tft.width() - SETTINGS_TOUCH_W - 20;
-
-    // Row 1: Volume
-    if (t_y >= SETTINGS_ROW1_Y && t_y <= (SETTINGS_ROW1_Y + SETTINGS_CONTROL_H)) {
-        if (isButtonTouched(t_x, t_y, minus_x, SETTINGS_ROW1_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (state.audio.volumeStep > 0) {
-                state.audio.volumeStep--;
-                saveSettings(state);
-                setupAudio(state);
-                drawAudioSettingsScreen(state);
-                playNewSpotSound(state);
-            }
-        } else if (isButtonTouched(t_x, t_y, plus_x, SETTINGS_ROW1_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (state.audio.volumeStep < 4) {
-                state.audio.volumeStep++;
-                saveSettings(state);
-                setupAudio(state);
-                drawAudioSettingsScreen(state);
-                playNewSpotSound(state);
-            }
-        }
-    }
-    // Row 2: Tone Frequency
-    else if (t_y >= SETTINGS_ROW2_Y && t_y <= (SETTINGS_ROW2_Y + SETTINGS_CONTROL_H)) {
-        if (isButtonTouched(t_x, t_y, minus_x, SETTINGS_ROW2_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (state.audio.toneFrequency > 300) {
-                state.audio.toneFrequency -= 100;
-                saveSettings(state);
-                setupAudio(state);
-                drawAudioSettingsScreen(state);
-                playNewSpotSound(state);
+static void handleTouchAudioSettings(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    bool toneChanged = true; // Volume and frequency are taken over by setupAudio()
+    switch (touched) {
+        case WID_BACK:
+            state.activeScreen = SCREEN_SETTINGS_MENU;
+            drawSettingsMenuScreen(state);
+            return;
+        case WID_VOLUME_DOWN:
+            if (state.audio.volumePercent <= 0) return;
+            state.audio.volumePercent -= 5;
+            break;
+        case WID_VOLUME_UP:
+            if (state.audio.volumePercent >= 100) return;
+            state.audio.volumePercent += 5;
+            break;
+        case WID_TONE_FREQ_DOWN:
+            if (state.audio.toneFrequency <= 300) return;
+            state.audio.toneFrequency -= 100;
+            break;
+        case WID_TONE_FREQ_UP:
+            if (state.audio.toneFrequency >= 1400) return;
+            state.audio.toneFrequency += 100;
+            break;
+        case WID_TONE_DURATION_DOWN:
+        case WID_TONE_DURATION_UP: {
+            const int durationSteps[] = {50, 75, 100, 125};
+            const int numSteps = sizeof(durationSteps) / sizeof(durationSteps[0]);
+            int currentStep = -1;
+            for (int i = 0; i < numSteps; i++) {
+                if (state.audio.toneDurationMs <= durationSteps[i]) {
+                    currentStep = i;
+                    break;
+                }
             }
-        } else if (isButtonTouched(t_x, t_y, plus_x, SETTINGS_ROW2_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (state.audio.toneFrequency < 1400) {
-                state.audio.toneFrequency += 100;
-                saveSettings(state);
-                setupAudio(state);
-                drawAudioSettingsScreen(state);
-                playNewSpotSound(state);
-            }
-        }
-    }
-    // Row 3: Tone Duration
-    else if (t_y >= SETTINGS_ROW3_Y && t_y <= (SETTINGS_ROW3_Y + SETTINGS_CONTROL_H)) {
-        const int durationSteps[] = {50, 75, 100, 125};
-        const int numSteps = sizeof(durationSteps) / sizeof(durationSteps[0]);
-        int currentStep = -1;
-        for (int i = 0; i < numSteps; i++) {
-            if (state.audio.toneDurationMs <= durationSteps[i]) {
-                currentStep = i;
-                break;
-            }
-        }
-        if (currentStep == -1) currentStep = numSteps - 1;
+            if (currentStep == -1) currentStep = numSteps - 1;
 
-        bool changed = false;
-        if (isButtonTouched(t_x, t_y, minus_x, SETTINGS_ROW3_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (currentStep > 0) {
-                state.audio.toneDurationMs = durationSteps[currentStep - 1];
-                changed = true;
-            }
-        } else if (isButtonTouched(t_x, t_y, plus_x, SETTINGS_ROW3_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (currentStep < numSteps - 1) {
-                state.audio.toneDurationMs = durationSteps[currentStep + 1];
-                changed = true;
-            }
-        }
-
-        if (changed) {
-            saveSettings(state);
-            drawAudioSettingsScreen(state);
-            playNewSpotSound(state);
+            int newStep = currentStep + ((touched == WID_TONE_DURATION_UP) ? 1 : -1);
+            if (newStep < 0 || newStep >= numSteps) return;
+            state.audio.toneDurationMs = durationSteps[newStep];
+            toneChanged = false;
+            break;
         }
+        default:
+            return;
     }
+    commitSettings(state);
+    refreshSettingsScreen(state);
+    if (toneChanged) setupAudio(state);
+    playNewSpotSound(state); // Does not block, so it keeps up with a repeating stepper
 }
 
-static void handleTouchSystemSettings(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    if (isButtonTouched(t_x, t_y, SETUP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        state.activeScreen = SCREEN_SETTINGS_MENU;
-        drawSettingsMenuScreen(state);
-        return;
-    }
-
-    const int x = SETTINGS_MENU_BTN_X_MARGIN;
-    const int w = tft.width() - 2 * x;
-
-    if (isButtonTouched(t_x, t_y, x, SETTINGS_ROW1_Y, w, SETTINGS_CONTROL_H)) {
-        state.activeScreen = SCREEN_INFO;
-        drawInfoScreen(state);
-    } else if (isButtonTouched(t_x, t_y, x, SETTINGS_ROW2_Y, w, SETTINGS_CONTROL_H)) {
-        runTouchCalibration(state);
-    } else if (isButtonTouched(t_x, t_y, x, SETTINGS_ROW3_Y, w, SETTINGS_CONTROL_H)) {
-        state.display.rememberLastScreen = !state.display.rememberLastScreen;
-        saveSettings(state);
-        drawSystemSettingsScreen(state);
-    } else if (isButtonTouched(t_x, t_y, x, SETTINGS_ROW4_Y, w, SETTINGS_CONTROL_H)) {
-        state.activeScreen = SCREEN_UPDATES_INFO;
-        drawUpdatesScreen(state);
-    } else if (isButtonTouched(t_x, t_y, x, SETTINGS_ROW5_Y, w, SETTINGS_CONTROL_H)) {
-        state.activeScreen = SCREEN_WIFI_RESET_CONFIRM;
-        drawWifiResetConfirmScreen(state);
+static void handleTouchSystemSettings(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    switch (touched) {
+        case WID_BACK:
+            state.activeScreen = SCREEN_SETTINGS_MENU;
+            drawSettingsMenuScreen(state);
+            break;
+        case WID_DEVICE_INFO:
+            state.activeScreen = SCREEN_INFO;
+            drawInfoScreen(state);
+            break;
+        case WID_CALIBRATE:
+            runTouchCalibration(state);
+            break;
+        case WID_REMEMBER_SCREEN:
+            state.display.rememberLastScreen = !state.display.rememberLastScreen;
+            saveSettings(state);
+            refreshSettingsScreen(state);
+            break;
+        case WID_UPDATES:
+            state.activeScreen = SCREEN_UPDATES_INFO;
+            drawUpdatesScreen(state);
+            break;
+        case WID_WIFI_RESET:
+            state.activeScreen = SCREEN_WIFI_RESET_CONFIRM;
+            drawWifiResetConfirmScreen(state);
+            break;
+        default:
+            break;
     }
 }
 
-static void handleTouchSleepSettings(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    if (isButtonTouched(t_x, t_y, SETUP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H)) {
-        state.activeScreen = SCREEN_SETTINGS_MENU;
-        drawSettingsMenuScreen(state);
-        return;
-    }
-
-    int minus_x = SETTINGS_CONTROL_X;
-    int plus_x = tft.width() - SETTINGS_TOUCH_W - 20;
-
-    // Row 1: Sleep Timeout
-    if (t_y >= SETTINGS_ROW1_Y && t_y <= (SETTINGS_ROW1_Y + SETTINGS_CONTROL_H)) {
-        if (isButtonTouched(t_x, t_y, minus_x, SETTINGS_ROW1_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (state.power.sleepTimeoutMinutes > 0) {
-                state.power.sleepTimeoutMinutes -= 60;
-                if(state.power.sleepTimeoutMinutes < 0) state.power.sleepTimeoutMinutes = 0;
-                saveSettings(state);
-                drawSleepSettingsScreen(state);
-            }
-        } else if (isButtonTouched(t_x, t_y, plus_x, SETTINGS_ROW1_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-            if (state.power.sleepTimeoutMinutes < 720) {
-                state.power.sleepTimeoutMinutes += 60;
-                saveSettings(state);
-                drawSleepSettingsScreen(state);
-            }
-        }
-    }
-    // Row 2: Schedule Toggle
-    else if (isButtonTouched(t_x, t_y, SETTINGS_CONTROL_X, SETTINGS_ROW2_Y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H)) {
-        state.power.scheduledSleepEnabled = !state.power.scheduledSleepEnabled;
-        saveSettings(state);
-        drawSleepSettingsScreen(state);
-    }
-    // Row 3 & 4: Schedule Times (only if enabled)
-    else if (state.power.scheduledSleepEnabled) {
-        if (t_y >= SETTINGS_ROW3_Y && t_y <= (SETTINGS_ROW3_Y + SETTINGS_CONTROL_H)) {
-            if (isButtonTouched(t_x, t_y, minus_x, SETTINGS_ROW3_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-                state.power.scheduledSleepHour = (state.power.scheduledSleepHour + 23) % 24;
-                saveSettings(state);
-                drawSleepSettingsScreen(state);
-            } else if (isButtonTouched(t_x, t_y, plus_x, SETTINGS_ROW3_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-                state.power.scheduledSleepHour = (state.power.scheduledSleepHour + 1) % 24;
-                saveSettings(state);
-                drawSleepSettingsScreen(state);
-            }
-        } else if (t_y >= SETTINGS_ROW4_Y && t_y <= (SETTINGS_ROW4_Y + SETTINGS_CONTROL_H)) {
-            if (isButtonTouched(t_x, t_y, minus_x, SETTINGS_ROW4_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-                state.power.scheduledWakeHour = (state.power.scheduledWakeHour + 23) % 24;
-                saveSettings(state);
-                drawSleepSettingsScreen(state);
-            } else if (isButtonTouched(t_x, t_y, plus_x, SETTINGS_ROW4_Y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H)) {
-                state.power.scheduledWakeHour = (state.power.scheduledWakeHour + 1) % 24;
-                saveSettings(state);
-                drawSleepSettingsScreen(state);
-            }
-        }
+static void handleTouchSleepSettings(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    // The schedule hour widgets are hidden, and so never hit, while the schedule is off
+    switch (touched) {
+        case WID_BACK:
+            state.activeScreen = SCREEN_SETTINGS_MENU;
+            drawSettingsMenuScreen(state);
+            return;
+        case WID_INACTIVITY_DOWN:
+            if (state.power.sleepTimeoutMinutes <= 0) return;
+            state.power.sleepTimeoutMinutes -= 60;
+            if (state.power.sleepTimeoutMinutes < 0) state.power.sleepTimeoutMinutes = 0;
+            break;
+        case WID_INACTIVITY_UP:
+            if (state.power.sleepTimeoutMinutes >= 720) return;
+            state.power.sleepTimeoutMinutes += 60;
+            break;
+        case WID_SCHEDULE:
+            state.power.scheduledSleepEnabled = !state.power.scheduledSleepEnabled;
+            break;
+        case WID_SLEEP_HOUR_DOWN:
+            state.power.scheduledSleepHour = (state.power.scheduledSleepHour + 23) % 24;
+            break;
+        case WID_SLEEP_HOUR_UP:
+            state.power.scheduledSleepHour = (state.power.scheduledSleepHour + 1) % 24;
+            break;
+        case WID_WAKE_HOUR_DOWN:
+            state.power.scheduledWakeHour = (state.power.scheduledWakeHour + 23) % 24;
+            break;
+        case WID_WAKE_HOUR_UP:
+            state.power.scheduledWakeHour = (state.power.scheduledWakeHour + 1) % 24;
+            break;
+        default:
+            return;
     }
+    commitSettings(state);
+    refreshSettingsScreen(state);
 }
 
-static void handleTouchGracePeriod(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    const int BTN_X = (tft.width() - GRACE_PERIOD_BTN_W) / 2;
-    const int BTN_Y = tft.height() - GRACE_PERIOD_BTN_H - GRACE_PERIOD_BTN_Y_MARGIN;
-    
-    if (isButtonTouched(t_x, t_y, BTN_X, BTN_Y, GRACE_PERIOD_BTN_W, GRACE_PERIOD_BTN_H)) {
+static void handleTouchGracePeriod(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    if (touched == WID_CANCEL_SLEEP) {
         state.power.lastInteractionTime = millis();
         state.power.scheduledSleepEnabled = false; // Disable schedule temporarily if user cancels
         saveSettings(state);
@@ -426,15 +403,11 @@ static void handleTouchGracePeriod(ApplicationState& state, uint16_t t_x, uint16
     }
 }
 
-static void handleTouchUpdatesScreen(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    const int updatesBtnY = tft.height() - SETTINGS_CONTROL_H - SETTINGS_V_GAP;
-    const int updatesBtnX = SETTINGS_MENU_BTN_X_MARGIN;
-    const int updatesBtnW = tft.width() - 2 * updatesBtnX;
-
-    if (isButtonTouched(t_x, t_y, updatesBtnX, updatesBtnY, updatesBtnW, SETTINGS_CONTROL_H)) {
+static void handleTouchUpdatesScreen(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    if (touched == WID_CHECK_UPDATES) {
         state.checkForUpdates = !state.checkForUpdates;
         saveSettings(state);
-        drawUpdatesScreen(state);
+        refreshSettingsScreen(state);
     } else {
         // Any other touch returns to system settings
         state.activeScreen = SCREEN_SYSTEM_SETTINGS;
@@ -442,17 +415,11 @@ static void handleTouchUpdatesScreen(ApplicationState& state, uint16_t t_x, uint
     }
 }
 
-static void handleTouchWifiResetConfirm(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
-    const int BTN_Y = tft.height() - CALIBRATION_BTN_H - CALIBRATION_BTN_Y_MARGIN;
-    const int TOTAL_W = CALIBRATION_BTN_W * 2 + CALIBRATION_BTN_GAP;
-    const int START_X = (tft.width() - TOTAL_W) / 2;
-    const int CANCEL_BTN_X = START_X;
-    const int CONFIRM_BTN_X = START_X + CALIBRATION_BTN_W + CALIBRATION_BTN_GAP;
-
-    if (isButtonTouched(t_x, t_y, CANCEL_BTN_X, BTN_Y, CALIBRATION_BTN_W, CALIBRATION_BTN_H)) {
+static void handleTouchWifiResetConfirm(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    if (touched == WID_WIFI_RESET_CANCEL) {
         state.activeScreen = SCREEN_SYSTEM_SETTINGS;
         drawSystemSettingsScreen(state);
-    } else if (isButtonTouched(t_x, t_y, CONFIRM_BTN_X, BTN_Y, CALIBRATION_BTN_W, CALIBRATION_BTN_H)) {
+    } else if (touched == WID_WIFI_RESET_CONFIRM) {
         tft.fillScreen(TFT_RED);
         tft.setTextColor(TFT_WHITE, TFT_RED);
         tft.setTextDatum(MC_DATUM);
@@ -460,70 +427,211 @@ static void handleTouchWifiResetConfirm(ApplicationState& state, uint16_t t_x, u
         tft.drawString("Wi-Fi settings cleared.", tft.width() / 2, tft.height() / 2 - 10);
         tft.drawString("Restarting...", tft.width() / 2, tft.height() / 2 + 10);
         clearWiFiSettings();
+        flushFrame();
         delay(RESTART_DELAY_MS);
         ESP.restart();
     }
 }
 
+static void handleTouchInfoScreen(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    state.activeScreen = SCREEN_SYSTEM_SETTINGS;
+    drawSystemSettingsScreen(state);
+}
+
+static void handleTouchReturnToSpots(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+    returnToSpotsScreen(state);
+}
+
+// Each screen's touch handler. The handler gets the widget the touch
+// landed on (WID_NONE outside every widget) and the touch position.
+typedef void (*TouchHandler)(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y);
+
+// A screen's long-press handler. Returns false if it had nothing to do
+// there, in which case the release still counts as a tap.
+typedef bool (*LongPressHandler)(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y);
+
+struct TouchRoute {
+  ActiveScreen screen;
+  TouchHandler handler;
+  LongPressHandler longPress; // nullptr where a long press is just a tap
+};
+
+static const TouchRoute TOUCH_ROUTES[] = {
+  { SCREEN_SPOTS, handleTouchSpotsScreen, handleLongPressSpotsScreen },
+  { SCREEN_SPOTS_AND_PROP, handleTouchSpotsScreen, handleLongPressSpotsScreen },
+  { SCREEN_SETTINGS_MENU, handleTouchSettingsMenu },
+  { SCREEN_DISPLAY_SETTINGS, handleTouchDisplaySettings },
+  { SCREEN_AUDIO_SETTINGS, handleTouchAudioSettings },
+  { SCREEN_SYSTEM_SETTINGS, handleTouchSystemSettings },
+  { SCREEN_SLEEP_SETTINGS, handleTouchSleepSettings },
+  { SCREEN_SLEEP_GRACE_PERIOD, handleTouchGracePeriod },
+  { SCREEN_UPDATES_INFO, handleTouchUpdatesScreen },
+  { SCREEN_WIFI_RESET_CONFIRM, handleTouchWifiResetConfirm },
+  { SCREEN_INFO, handleTouchInfoScreen },
+  { SCREEN_PROPAGATION, handleTouchReturnToSpots },
+  { SCREEN_BAND_MAP, handleTouchBandMap },
+  { SCREEN_GREY_LINE, handleTouchReturnToSpots },
+  { SCREEN_SPOT_MAP, handleTouchReturnToSpots },
+  { SCREEN_CLOCK, handleTouchReturnToSpots }
+};
+
+// Main screens in swipe order. A swipe to the left shows the next one.
+static const ActiveScreen SWIPE_ORDER[] = {
+  SCREEN_SPOTS, SCREEN_BAND_MAP, SCREEN_SPOT_MAP, SCREEN_PROPAGATION, SCREEN_GREY_LINE, SCREEN_CLOCK
+};
+
+static const TouchRoute* findTouchRoute(ActiveScreen screen) {
+  for (const TouchRoute& route : TOUCH_ROUTES) {
+    if (route.screen == screen) return &route;
+  }
+  return nullptr;
+}
+
+// Routes a touch to the active screen's handler, timed by the profiler.
+static void dispatchTouch(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+  PROFILE_SCOPE(PROF_HANDLE_TOUCH);
+  const TouchRoute* route = findTouchRoute(state.activeScreen);
+  if (route) route->handler(state, touched, t_x, t_y);
+}
+
+static bool dispatchLongPress(ApplicationState& state, WidgetId touched, uint16_t t_x, uint16_t t_y) {
+  PROFILE_SCOPE(PROF_HANDLE_TOUCH);
+  const TouchRoute* route = findTouchRoute(state.activeScreen);
+  return route && route->longPress && route->longPress(state, touched, t_x, t_y);
+}
+
+// Moves to the neighbouring main screen. Settings screens do not swipe.
+static void swipeMainScreen(ApplicationState& state, int direction) {
+  const ActiveScreen current = (state.activeScreen == SCREEN_SPOTS_AND_PROP) ? SCREEN_SPOTS : state.activeScreen;
+  const int count = sizeof(SWIPE_ORDER) / sizeof(SWIPE_ORDER[0]);
+  for (int i = 0; i < count; i++) {
+    if (SWIPE_ORDER[i] == current) {
+      openMainScreen(state, SWIPE_ORDER[(i + direction + count) % count]);
+      return;
+    }
+  }
+}
+
+// A swipe on the band map steps through the bands like its edge taps do;
+// on the other main screens it moves between screens.
+static void handleSwipe(ApplicationState& state, int direction) {
+  if (state.activeScreen == SCREEN_BAND_MAP) {
+    stepBandMapBand(state, direction);
+  } else {
+    swipeMainScreen(state, direction);
+  }
+}
+
+// Runs on a timer while a finger stays down: a stepper repeats after a
+// short delay, anything else may have a long-press action.
+static void checkHeldPress(ApplicationState& state) {
+  if (!currentPress.active || currentPress.dragging || state.activeScreen != currentPress.screen) {
+    stopTimer(TIMER_TOUCH_HOLD);
+    return;
+  }
+  const uint32_t now = millis();
+
+  if (currentPress.repeats) {
+    if (!currentPress.repeating) {
+      if (now - currentPress.startTime < GESTURE_REPEAT_DELAY_MS) return;
+      currentPress.held = currentPress.repeating = true;
+      currentPress.nextRepeatTime = now;
+    }
+    if ((int32_t)(now - currentPress.nextRepeatTime) < 0) return;
+    currentPress.nextRepeatTime = now + GESTURE_REPEAT_INTERVAL_MS;
+    dispatchTouch(state, currentPress.widget, currentPress.x, currentPress.y);
+    return;
+  }
+
+  if (now - currentPress.startTime < GESTURE_LONG_PRESS_MS) return;
+  stopTimer(TIMER_TOUCH_HOLD);
+  currentPress.held = dispatchLongPress(state, currentPress.widget, currentPress.x, currentPress.y);
+  if (currentPress.held) releasePressedWidget(state.activeScreen);
+}
+
+static void startPress(ApplicationState& state, uint16_t t_x, uint16_t t_y, uint32_t time) {
+  currentPress = TouchPress();
+  currentPress.active = true;
+  currentPress.screen = state.activeScreen;
+  currentPress.widget = pressWidget(state.activeScreen, t_x, t_y);
+  currentPress.repeats = pressedWidgetRepeats();
+  currentPress.x = t_x;
+  currentPress.y = t_y;
+  currentPress.startTime = time;
+  startTimer(TIMER_TOUCH_HOLD, checkHeldPress, TOUCH_HOLD_CHECK_INTERVAL_MS, TOUCH_HOLD_CHECK_INTERVAL_MS);
+}
+
+// Past the tap slop a press becomes a drag and lets go of its widget. A
+// repeating stepper stops when the finger slides off it.
+static void trackPress(ApplicationState& state, uint16_t t_x, uint16_t t_y) {
+  if (!currentPress.active || currentPress.dragging) return;
+  if (currentPress.repeating) {
+    if (hitTestWidgets(state.activeScreen, t_x, t_y) != currentPress.widget) {
+      currentPress.repeats = currentPress.repeating = false;
+      stopTimer(TIMER_TOUCH_HOLD);
+      releasePressedWidget(state.activeScreen);
+    }
+    return;
+  }
+  if (currentPress.held) return;
+  if (abs(t_x - currentPress.x) > GESTURE_TAP_SLOP_PX || abs(t_y - currentPress.y) > GESTURE_TAP_SLOP_PX) {
+    currentPress.dragging = true;
+    stopTimer(TIMER_TOUCH_HOLD);
+    releasePressedWidget(state.activeScreen);
+  }
+}
+
+// A quick horizontal drag is a swipe. A plain press is a tap, unless it was
+// already taken by a long press or a repeat, which only finish here.
+static void endPress(ApplicationState& state, uint16_t t_x, uint16_t t_y, uint32_t time) {
+  if (!currentPress.active) return;
+  currentPress.active = false;
+  stopTimer(TIMER_TOUCH_HOLD);
+  releasePressedWidget(state.activeScreen);
+
+  if (currentPress.held) {
+    if (currentPress.saveDeferred) saveSettings(state);
+    return;
+  }
+  if (state.activeScreen != currentPress.screen) return;
+
+  if (currentPress.dragging) {
+    const int dx = t_x - currentPress.x;
+    const int dy = t_y - currentPress.y;
+    if (abs(dx) >= GESTURE_SWIPE_MIN_PX && abs(dx) > 2 * abs(dy) && time - currentPress.startTime <= GESTURE_SWIPE_MAX_MS) {
+      handleSwipe(state, dx < 0 ? 1 : -1);
+    }
+    return;
+  }
+  if (currentPress.widget != WID_NONE && hitTestWidgets(state.activeScreen, t_x, t_y) != currentPress.widget) return;
+  dispatchTouch(state, currentPress.widget, currentPress.x, currentPress.y);
+}
+
+// Drains the touch events queued since the last pass and turns them into
+// taps, swipes, long presses and stepper repeats. A press shows the widget
+// under it as pressed; a tap acts on the release, unless the finger slid off
+// the widget or the screen changed in between. Each event costs the same
+// whatever the gesture; held presses are timed by TIMER_TOUCH_HOLD.
 void handleTouch(ApplicationState& state) {
-  if (touchscreen.tirqTouched() && touchscreen.touched()) {
+  TouchEvent event;
+  while (readTouchEvent(event)) {
     state.power.lastInteractionTime = millis();
-    TS_Point p = touchscreen.getPoint();
-    
+
     // Map raw coordinates to screen coordinates
-    uint16_t t_x = map(p.x, state.calibration.topLeftX, state.calibration.bottomRightX, TOUCH_CALIBRATION_MARGIN, tft.width() - TOUCH_CALIBRATION_MARGIN);
-    uint16_t t_y = map(p.y, state.calibration.topLeftY, state.calibration.bottomRightY, TOUCH_CALIBRATION_MARGIN, tft.height() - TOUCH_CALIBRATION_MARGIN);
-    
-    switch (state.activeScreen) {
-      case SCREEN_SPOTS:
-      case SCREEN_SPOTS_AND_PROP:
-        handleTouchSpotsScreen(state, t_x, t_y);
-        break;
-      case SCREEN_SETTINGS_MENU:
-        handleTouchSettingsMenu(state, t_x, t_y);
-        break;
-      case SCREEN_DISPLAY_SETTINGS:
-        handleTouchDisplaySettings(state, t_x, t_y);
-        break;
-      case SCREEN_AUDIO_SETTINGS:
-        handleTouchAudioSettings(state, t_x, t_y);
-        break;
-      case SCREEN_SYSTEM_SETTINGS:
-        handleTouchSystemSettings(state, t_x, t_y);
-        break;
-      case SCREEN_SLEEP_SETTINGS:
-        handleTouchSleepSettings(state, t_x, t_y);
-        break;
-      case SCREEN_SLEEP_GRACE_PERIOD:
-        handleTouchGracePeriod(state, t_x, t_y);
-        break;
-      case SCREEN_UPDATES_INFO:
-        handleTouchUpdatesScreen(state, t_x, t_y);
-        break;
-      case SCREEN_WIFI_RESET_CONFIRM:
-        handleTouchWifiResetConfirm(state, t_x, t_y);
+    uint16_t t_x, t_y;
+    mapTouchPoint(state.calibration, event.rawX, event.rawY, t_x, t_y);
+
+    switch (event.type) {
+      case TOUCH_PRESS:
+        startPress(state, t_x, t_y, event.time);
         break;
-      case SCREEN_INFO:
-        state.activeScreen = SCREEN_SYSTEM_SETTINGS;
-        drawSystemSettingsScreen(state);
+      case TOUCH_MOVE:
+        trackPress(state, t_x, t_y);
         break;
-      case SCREEN_PROPAGATION:
-      case SCREEN_CLOCK:
-        state.lastSecond = -1;
-        // Return to the appropriate spots screen
-        if (state.display.spotsViewMode == SPOTS_WITH_PROP) {
-          state.activeScreen = SCREEN_SPOTS_AND_PROP;
-          if (state.display.rememberLastScreen) { state.display.startupScreen = SCREEN_SPOTS_AND_PROP; saveSettings(state); }
-          drawSpotsAndPropScreen(state);
-        } else {
-          state.activeScreen = SCREEN_SPOTS;
-          if (state.display.rememberLastScreen) { state.display.startupScreen = SCREEN_SPOTS; saveSettings(state); }
-          drawSpotsScreen(state);
-        }
+      case TOUCH_RELEASE:
+        endPress(state, t_x, t_y, event.time);
         break;
     }
-    // Simple debounce: wait for release
-    while (touchscreen.touched()) {};
   }
 }
 
@@ -564,4 +672,5 @@ void updateStartupStatus(const String& message, OperationStatus status, Applicat
     
     tft.setTextDatum(TL_DATUM);
   }
+  flushFrame(); // The startup steps block, so each line is shown as soon as it is drawn
 }
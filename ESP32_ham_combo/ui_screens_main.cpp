@@ -12,10 +12,135 @@ Commercial use is prohibited.
 namespace {
   const int SECOND_DOT_SIZE = 3;    // Size of the second dot (3x3 pixels)
   const int SECOND_DOT_MARGIN = 2;  // Margin from the screen edge
+  const int SECOND_DOT_STEPS_PER_SECOND = 4; // Sweep resolution; a ticking dot uses every 4th step
+  const int SECOND_DOT_STEPS = 60 * SECOND_DOT_STEPS_PER_SECOND;
+
+  struct PerimeterPoint {
+    int16_t x, y;
+  };
+
+  PerimeterPoint perimeterTable[SECOND_DOT_STEPS];
+  int perimeterTableWidth = 0;
+  int perimeterTableHeight = 0;
+
+  // Clock text is drawn per character cell, "HH:MM:SS" by position. The cells
+  // are measured once per full redraw, so they follow the rotation and mode.
+  const int CLOCK_TEXT_LENGTH = 8;
+
+  struct ClockCell {
+    int16_t x, y, w, h;
+  };
+
+  struct ClockLine {
+    ClockCell cells[CLOCK_TEXT_LENGTH]; // w == 0 for positions that are not drawn
+    int16_t centerY;
+    int16_t secondsCenterY;
+  };
+
+  struct ClockLayout {
+    ClockLine lines[2];
+  };
+
+  ClockLayout clockLayout;
+
+  int maxDigitWidth(uint8_t font) {
+    int width = 0;
+    char digit[2] = "0";
+    for (char c = '0'; c <= '9'; c++) {
+      digit[0] = c;
+      width = max(width, (int)(font ? tft.textWidth(digit, font) : tft.textWidth(digit)));
+    }
+    return width;
+  }
+
+  // Places "HH:MM" in font 8 centered on centerY and the label below it. The
+  // seconds go to the right of the minutes when there is room, otherwise
+  // under the label.
+  void layoutClockLine(ClockLine& line, int centerY, const char* label, const GFXfont* labelFont, int labelOffset) {
+    const int digitW = maxDigitWidth(8);
+    const int colonW = tft.textWidth(":", 8);
+    const int digitH = tft.fontHeight(8);
+    const int totalW = 4 * digitW + colonW;
+    const int top = centerY - digitH / 2;
+
+    int x = (tft.width() - totalW) / 2;
+    for (int i = 0; i < 5; i++) {
+      int w = (i == 2) ? colonW : digitW;
+      line.cells[i] = { (int16_t)x, (int16_t)top, (int16_t)w, (int16_t)digitH };
+      x += w;
+    }
+    line.centerY = centerY;
+
+    tft.setFreeFont(labelFont);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.drawString(label, tft.width() / 2, centerY + labelOffset);
+
+    tft.setFreeFont(&FreeSansBold12pt7b);
+    const int secondsW = maxDigitWidth(0);
+    const int secondsH = tft.fontHeight();
+    int secondsX;
+    if (tft.width() - x >= 2 * secondsW + CLOCK_SECONDS_GAP) {
+      secondsX = x + CLOCK_SECONDS_GAP;
+      line.secondsCenterY = top + digitH - secondsH / 2;
+    } else {
+      secondsX = (tft.width() - 2 * secondsW) / 2;
+      line.secondsCenterY = centerY + labelOffset + secondsH;
+    }
+    line.cells[5] = { 0, 0, 0, 0 };
+    for (int i = 6; i < CLOCK_TEXT_LENGTH; i++) {
+      line.cells[i] = { (int16_t)secondsX, (int16_t)(line.secondsCenterY - secondsH / 2), (int16_t)secondsW, (int16_t)secondsH };
+      secondsX += secondsW;
+    }
+  }
+
+  void layoutClock(const ApplicationState& state) {
+    tft.setTextDatum(MC_DATUM);
+    switch (state.display.currentClockMode) {
+      case MODE_UTC:
+        layoutClockLine(clockLayout.lines[0], tft.height() / 2 - 10, "UTC", &FreeSansBold12pt7b, 80);
+        break;
+      case MODE_LOCAL:
+        layoutClockLine(clockLayout.lines[0], tft.height() / 2 - 10, "Local", &FreeSansBold12pt7b, 80);
+        break;
+      case MODE_BOTH:
+        layoutClockLine(clockLayout.lines[0], tft.height() / 4 - 15, "UTC", &FreeSans9pt7b, 60);
+        layoutClockLine(clockLayout.lines[1], tft.height() * 3 / 4 - 15, "Local", &FreeSans9pt7b, 60);
+        break;
+    }
+  }
 
-  // Calculates the (x, y) coordinates on the screen perimeter for a given second.
+  // Repaints the cells whose character differs from what is on screen.
+  void updateClockLine(const ClockLine& line, const struct tm& time, uint16_t color, char* shown, bool showSeconds) {
+    char text[CLOCK_TEXT_LENGTH + 1];
+    snprintf(text, sizeof(text), "%02d:%02d:%02d", time.tm_hour, time.tm_min, time.tm_sec);
+    const int length = showSeconds ? CLOCK_TEXT_LENGTH : 5;
+    bool reachedEnd = false; // 'shown' is shorter than 'text' after a full redraw
+
+    tft.setTextDatum(MC_DATUM);
+    tft.setTextColor(color, TFT_BLACK);
+    for (int i = 0; i < length; i++) {
+      if (shown[i] == '\0') reachedEnd = true;
+      if (!reachedEnd && shown[i] == text[i]) continue;
+      const ClockCell& cell = line.cells[i];
+      if (cell.w == 0) continue;
+
+      char glyph[2] = { text[i], '\0' };
+      tft.fillRect(cell.x, cell.y, cell.w, cell.h, TFT_BLACK);
+      if (i < 5) {
+        tft.setTextFont(8);
+        tft.drawString(glyph, cell.x + cell.w / 2, line.centerY);
+      } else {
+        tft.setFreeFont(&FreeSansBold12pt7b);
+        tft.drawString(glyph, cell.x + cell.w / 2, line.secondsCenterY);
+      }
+    }
+    memcpy(shown, text, length);
+    shown[length] = '\0';
+  }
+
+  // Calculates the (x, y) coordinates on the screen perimeter for a dot step.
   // The dot travels clockwise starting from top-center.
-  void calculatePerimeterPosition(int second, int& x, int& y) {
+  void calculatePerimeterPosition(int step, int& x, int& y) {
     int width = tft.width();
     int height = tft.height();
     int dot_offset = SECOND_DOT_MARGIN + (SECOND_DOT_SIZE / 2);
@@ -32,8 +157,8 @@ namespace {
     int path_left = h;
     // path_top_left is the remainder
 
-    // Map second (0-59) to distance along perimeter
-    long total_pos = map(second, 0, 60, 0, perimeter);
+    // Map step to distance along perimeter
+    long total_pos = map(step, 0, SECOND_DOT_STEPS, 0, perimeter);
 
     if (total_pos < path_top_right) {
       // 1. Top edge (middle to right)
@@ -57,54 +182,37 @@ namespace {
       y = dot_offset;
     }
   }
+
+  // Dot positions for every step of the minute. Rebuilt only when the screen
+  // size changes, i.e. after a rotation change.
+  void buildPerimeterTable() {
+    if (tft.width() == perimeterTableWidth && tft.height() == perimeterTableHeight) return;
+    for (int step = 0; step < SECOND_DOT_STEPS; step++) {
+      int x, y;
+      calculatePerimeterPosition(step, x, y);
+      perimeterTable[step] = { (int16_t)x, (int16_t)y };
+    }
+    perimeterTableWidth = tft.width();
+    perimeterTableHeight = tft.height();
+  }
 }
 
+// Draws the button bar of the main screens. Settings screens draw their own
+// widgets, Back button included.
 void drawButtons(const ApplicationState& state) {
-  tft.setTextDatum(MC_DATUM);
-  tft.setFreeFont(&FreeSans9pt7b);
-  tft.setTextColor(TFT_WHITE);
+  if (state.activeScreen != SCREEN_SPOTS && state.activeScreen != SCREEN_SPOTS_AND_PROP) return;
 
-  // Main Screens (Spots / Prop)
-  if (state.activeScreen == SCREEN_SPOTS || state.activeScreen == SCREEN_SPOTS_AND_PROP) {
-    // Clock Button
-    tft.fillRoundRect(CLOCK_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H, BUTTON_CORNER_RADIUS, COLOR_DARK_GREEN);
-    tft.drawString("Clock", CLOCK_BTN_X + BUTTON_W / 2, BUTTON_Y + BUTTON_H / 2);
-    
-    // Propagation Button
-    tft.fillRoundRect(PROP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H, BUTTON_CORNER_RADIUS, COLOR_DARK_PURPLE);
-    tft.drawString("Prop.", PROP_BTN_X + BUTTON_W / 2, BUTTON_Y + BUTTON_H / 2);
-
-    // Setup / Update Button
-    String setupButtonText = "Setup";
-    uint16_t setupButtonColor = COLOR_DARK_BLUE;
-    if (state.newVersionAvailable) {
-      setupButtonText = "Update!";
-      setupButtonColor = COLOR_DARK_GREEN;
-    }
-    tft.fillRoundRect(SETUP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H, BUTTON_CORNER_RADIUS, setupButtonColor);
-    tft.drawString(setupButtonText, SETUP_BTN_X + BUTTON_W / 2, BUTTON_Y + BUTTON_H / 2);
-
-    // Sleep/Off Button
-    tft.fillRoundRect(SLEEP_NOW_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H, BUTTON_CORNER_RADIUS, 0x3800); // Dark Red
-    tft.drawString("Off", SLEEP_NOW_BTN_X + BUTTON_W / 2, BUTTON_Y + BUTTON_H / 2);
-  } 
-  // Sub-menus (Settings, Info, etc.)
-  else if (state.activeScreen == SCREEN_SETTINGS_MENU ||
-             state.activeScreen == SCREEN_DISPLAY_SETTINGS ||
-             state.activeScreen == SCREEN_AUDIO_SETTINGS ||
-             state.activeScreen == SCREEN_SLEEP_SETTINGS ||
-             state.activeScreen == SCREEN_SYSTEM_SETTINGS ||
-             state.activeScreen == SCREEN_UPDATES_INFO) {
-    tft.fillRoundRect(SETUP_BTN_X, BUTTON_Y, BUTTON_W, BUTTON_H, BUTTON_CORNER_RADIUS, COLOR_DARK_BLUE);
-    tft.drawString("Back", SETUP_BTN_X + BUTTON_W / 2, BUTTON_Y + BUTTON_H / 2);
-  }
+  // The Setup button doubles as the update notice
+  setWidgetText(WID_SETUP, state.newVersionAvailable ? "Update!" : "Setup");
+  setWidgetColor(WID_SETUP, state.newVersionAvailable ? COLOR_DARK_GREEN : COLOR_DARK_BLUE);
+  drawWidgets(state.activeScreen, true);
 }
 
 void drawClockScreen(ApplicationState& state) {
-  struct tm timeinfo;
-  char timeStr[6];
-  time_t now;
-  time(&now);
+  PROFILE_SCOPE(PROF_DRAW_CLOCK);
+  struct timeval timeOfDay;
+  gettimeofday(&timeOfDay, nullptr);
+  time_t now = timeOfDay.tv_sec;
 
   // Wait for NTP sync (year > 2020)
   if (now < 1600000000) { return; } 
@@ -116,73 +224,48 @@ void drawClockScreen(ApplicationState& state) {
       state.lastLocalTimeStr[0] = '\0';
       state.lastSecondDotX = -1;
       state.lastSecondDotY = -1;
+      state.lastSecondDotStep = -1;
+      layoutClock(state);
+      buildPerimeterTable();
   }
 
-  tft.setTextDatum(MC_DATUM);
-
   // --- Draw Time Text ---
+  // Each time is converted once per tick; only changed digit cells are repainted.
+  struct tm utcTime;
+  gmtime_r(&now, &utcTime);
+
   switch (state.display.currentClockMode) {
     case MODE_UTC:
-      gmtime_r(&now, &timeinfo);
-      snprintf(timeStr, sizeof(timeStr), "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
-      if (strcmp(timeStr, state.lastUtcTimeStr) != 0) {
-        tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-        tft.setTextFont(8);
-        tft.drawString(timeStr, tft.width() / 2, tft.height() / 2 - 10);
-        tft.setFreeFont(&FreeSansBold12pt7b);
-        tft.setTextColor(TFT_WHITE, TFT_BLACK);
-        tft.drawString("UTC", tft.width() / 2, tft.height() / 2 + 70);
-        strlcpy(state.lastUtcTimeStr, timeStr, sizeof(state.lastUtcTimeStr));
-      }
+      updateClockLine(clockLayout.lines[0], utcTime, TFT_YELLOW, state.lastUtcTimeStr, state.display.clockSecondsEnabled);
       break;
 
     case MODE_LOCAL:
-      localtime_r(&now, &timeinfo);
-      snprintf(timeStr, sizeof(timeStr), "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
-      if (strcmp(timeStr, state.lastLocalTimeStr) != 0) {
-        tft.setTextColor(TFT_CYAN, TFT_BLACK);
-        tft.setTextFont(8);
-        tft.drawString(timeStr, tft.width() / 2, tft.height() / 2 - 10);
-        tft.setFreeFont(&FreeSansBold12pt7b);
-        tft.setTextColor(TFT_WHITE, TFT_BLACK);
-        tft.drawString("Local", tft.width() / 2, tft.height() / 2 + 70);
-        strlcpy(state.lastLocalTimeStr, timeStr, sizeof(state.lastLocalTimeStr));
+      {
+        struct tm localTime;
+        localtime_r(&now, &localTime);
+        updateClockLine(clockLayout.lines[0], localTime, TFT_CYAN, state.lastLocalTimeStr, state.display.clockSecondsEnabled);
       }
       break;
 
     case MODE_BOTH:
-      // UTC Part
-      gmtime_r(&now, &timeinfo);
-      snprintf(timeStr, sizeof(timeStr), "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
-      if (strcmp(timeStr, state.lastUtcTimeStr) != 0) {
-        tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-        tft.setTextFont(8);
-        tft.drawString(timeStr, tft.width() / 2, (tft.height() / 4) - 15);
-        tft.setFreeFont(&FreeSans9pt7b);
-        tft.setTextColor(TFT_WHITE, TFT_BLACK);
-        tft.drawString("UTC", tft.width() / 2, (tft.height() / 4) + 45);
-        strlcpy(state.lastUtcTimeStr, timeStr, sizeof(state.lastUtcTimeStr));
-      }
-      // Local Part
-      localtime_r(&now, &timeinfo);
-      snprintf(timeStr, sizeof(timeStr), "%02d:%02d", timeinfo.tm_hour, timeinfo.tm_min);
-      if (strcmp(timeStr, state.lastLocalTimeStr) != 0) {
-        tft.setTextColor(TFT_CYAN, TFT_BLACK);
-        tft.setTextFont(8);
-        tft.drawString(timeStr, tft.width() / 2, (tft.height() * 3 / 4) - 15);
-        tft.setFreeFont(&FreeSans9pt7b);
-        tft.setTextColor(TFT_WHITE, TFT_BLACK);
-        tft.drawString("Local", tft.width() / 2, (tft.height() * 3 / 4) + 45);
-        strlcpy(state.lastLocalTimeStr, timeStr, sizeof(state.lastLocalTimeStr));
+      {
+        struct tm localTime;
+        localtime_r(&now, &localTime);
+        updateClockLine(clockLayout.lines[0], utcTime, TFT_YELLOW, state.lastUtcTimeStr, state.display.clockSecondsEnabled);
+        updateClockLine(clockLayout.lines[1], localTime, TFT_CYAN, state.lastLocalTimeStr, state.display.clockSecondsEnabled);
       }
       break;
   }
 
   // --- Draw Second Dot ---
-  gmtime_r(&now, &timeinfo);
-  int currentSecond = timeinfo.tm_sec;
+  int currentSecond = utcTime.tm_sec;
+  int dotStep = currentSecond * SECOND_DOT_STEPS_PER_SECOND;
+  if (state.display.secondDotSweep) {
+    dotStep += timeOfDay.tv_usec / (1000000 / SECOND_DOT_STEPS_PER_SECOND);
+  }
+  state.lastSecond = currentSecond;
 
-  if (currentSecond != state.lastSecond) {
+  if (dotStep != state.lastSecondDotStep) {
     // Erase previous dot
     if (state.lastSecondDotX != -1) {
       int eraseX = state.lastSecondDotX - (SECOND_DOT_SIZE / 2);
@@ -191,8 +274,8 @@ void drawClockScreen(ApplicationState& state) {
     }
 
     if (state.display.secondDotEnabled) {
-      int newX, newY;
-      calculatePerimeterPosition(currentSecond, newX, newY);
+      int newX = perimeterTable[dotStep].x;
+      int newY = perimeterTable[dotStep].y;
       int drawX = newX - (SECOND_DOT_SIZE / 2);
       int drawY = newY - (SECOND_DOT_SIZE / 2);
       tft.fillRect(drawX, drawY, SECOND_DOT_SIZE, SECOND_DOT_SIZE, SECOND_DOT_COLOR);
@@ -203,11 +286,12 @@ void drawClockScreen(ApplicationState& state) {
       state.lastSecondDotX = -1;
       state.lastSecondDotY = -1;
     }
-    state.lastSecond = currentSecond;
+    state.lastSecondDotStep = dotStep;
   }
 }
 
 void drawGracePeriodScreen(const ApplicationState& state) {
+    PROFILE_SCOPE(PROF_DRAW_GRACE_PERIOD);
     tft.fillScreen(TFT_BLACK);
     tft.setTextDatum(MC_DATUM);
     tft.setFreeFont(&FreeSans9pt7b);
@@ -219,16 +303,11 @@ void drawGracePeriodScreen(const ApplicationState& state) {
     tft.setTextColor(TFT_YELLOW);
     tft.drawString("60s to sleep", tft.width() / 2, tft.height() / 2 + GRACE_PERIOD_TIMER_TEXT_Y_OFFSET);
 
-    const int BTN_X = (tft.width() - GRACE_PERIOD_BTN_W) / 2;
-    const int BTN_Y = tft.height() - GRACE_PERIOD_BTN_H - GRACE_PERIOD_BTN_Y_MARGIN;
-    
-    tft.fillRoundRect(BTN_X, BTN_Y, GRACE_PERIOD_BTN_W, GRACE_PERIOD_BTN_H, BUTTON_CORNER_RADIUS, COLOR_DARK_GREEN);
-    tft.setTextColor(TFT_WHITE);
-    tft.setFreeFont(&FreeSans9pt7b);
-    tft.drawString("Cancel Sleep", BTN_X + GRACE_PERIOD_BTN_W / 2, BTN_Y + GRACE_PERIOD_BTN_H / 2);
+    drawWidgets(SCREEN_SLEEP_GRACE_PERIOD, true);
 }
 
 void drawPropagationFooter(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_PROP_FOOTER);
   if (!state.propDataAvailable) {
     return;
   }
@@ -250,6 +329,33 @@ void drawPropagationFooter(const ApplicationState& state) {
 
   tft.setTextDatum(MC_DATUM);
 
+  // With a per-band estimate available, show HamQSL's groups for the current
+  // time of day at the QTH and the estimate for every band underneath.
+  if (state.bandConditionsValid) {
+    int offset = isQthDaylight(state) ? 0 : 4;
+    tft.setTextColor(TFT_WHITE);
+    tft.drawString(offset == 0 ? "D:" : "N:", label_x, yPos_day);
+
+    tft.setTextColor(getPropagationColor(state.solarData.propagation[offset + 0]));
+    tft.drawString("80-40", col1_x, yPos_day);
+    tft.setTextColor(getPropagationColor(state.solarData.propagation[offset + 1]));
+    tft.drawString("30-20", col2_x, yPos_day);
+    tft.setTextColor(getPropagationColor(state.solarData.propagation[offset + 2]));
+    tft.drawString("17-15", col3_x, yPos_day);
+    tft.setTextColor(getPropagationColor(state.solarData.propagation[offset + 3]));
+    tft.drawString("12-10", col4_x, yPos_day);
+
+    tft.setTextColor(TFT_WHITE);
+    tft.drawString("E:", label_x, yPos_night);
+    const int bands_x = label_x + 16;
+    const int band_w = (tft.width() - bands_x) / BAND_COUNT;
+    for (int band = 0; band < BAND_COUNT; band++) {
+      tft.setTextColor(getPropagationColor(getBandCondition(state, band)));
+      tft.drawString(getBandLabel(band), bands_x + band * band_w + band_w / 2, yPos_night);
+    }
+    return;
+  }
+
   // --- Draw Day Conditions ---
   tft.setTextColor(TFT_WHITE);
   tft.drawString("D:", label_x, yPos_day);
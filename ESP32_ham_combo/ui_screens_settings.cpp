@@ -11,201 +11,139 @@
 
 // --- Local Helper Functions for Settings Screens ---
 namespace {
-  // Helper function to convert volume step to a displayable dB string.
-  String getVolumeDbString(int volumeStep) {
-    const char* dbLevels[] = {"Muted", "-18 dB", "-12 dB", "-6 dB", "0 dB"};
-    if (volumeStep >= 0 && volumeStep < 5) {
-      return dbLevels[volumeStep];
-    }
-    return "Error";
+  String getVolumeString(int volumePercent) {
+    return volumePercent == 0 ? String("Muted") : String(volumePercent) + "%";
   }
 
-  void drawSliderControl(const String& label, int y, const String& valueText, int min_val, int max_val, int current_val) {
-    int minus_btn_x = SETTINGS_CONTROL_X;
-    int plus_btn_x = tft.width() - SETTINGS_TOUCH_W - 20;
-
-    tft.setFreeFont(&FreeSans9pt7b);
-    tft.setTextDatum(CL_DATUM);
-    tft.setTextColor(TFT_WHITE);
-    tft.drawString(label, SETTINGS_LABEL_X, y + SETTINGS_CONTROL_H / 2);
-
-    // Draw Minus Button
-    uint16_t minus_color = (current_val == -1 || current_val > min_val) ? COLOR_DARK_BLUE : TFT_DARKGREY;
-    tft.fillRoundRect(minus_btn_x, y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H, BUTTON_CORNER_RADIUS, minus_color);
-
-    tft.setFreeFont(&FreeSansBold12pt7b);
-    tft.setTextDatum(CC_DATUM);
-    tft.setTextColor(TFT_WHITE);
-    tft.drawString("-", minus_btn_x + SETTINGS_TOUCH_W / 2, y + SETTINGS_CONTROL_H / 2);
-
-    // Draw Value Text
-    tft.setFreeFont(&FreeSans9pt7b);
-    tft.drawString(valueText, (minus_btn_x + SETTINGS_TOUCH_W + plus_btn_x) / 2, y + SETTINGS_CONTROL_H / 2);
-
-    // Draw Plus Button
-    uint16_t plus_color = (current_val == -1 || current_val < max_val) ? COLOR_DARK_BLUE : TFT_DARKGREY;
-    tft.fillRoundRect(plus_btn_x, y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H, BUTTON_CORNER_RADIUS, plus_color);
-
-    tft.setFreeFont(&FreeSansBold12pt7b);
-    tft.drawString("+", plus_btn_x + SETTINGS_TOUCH_W / 2, y + SETTINGS_CONTROL_H / 2);
+  uint16_t getStepColor(bool enabled) {
+    return enabled ? COLOR_DARK_BLUE : TFT_DARKGREY;
   }
 
-  void drawToggleControl(const String& label, int y, bool enabled) {
-    tft.setFreeFont(&FreeSans9pt7b);
-    tft.setTextDatum(CL_DATUM);
-    tft.setTextColor(TFT_WHITE);
-    tft.drawString(label, SETTINGS_LABEL_X, y + SETTINGS_CONTROL_H / 2);
+  // A value of -1 keeps both steps enabled, for settings that wrap around.
+  void syncSliderControl(WidgetId downId, WidgetId valueId, WidgetId upId, const String& valueText, int min_val, int max_val, int current_val) {
+    setWidgetColor(downId, getStepColor(current_val == -1 || current_val > min_val));
+    setWidgetText(valueId, valueText.c_str());
+    setWidgetColor(upId, getStepColor(current_val == -1 || current_val < max_val));
+  }
 
-    tft.setTextDatum(MC_DATUM);
-    uint16_t color = enabled ? COLOR_DARK_GREEN : TFT_MAROON;
-    String text = enabled ? "Enabled" : "Disabled";
-    
-    tft.fillRoundRect(SETTINGS_CONTROL_X, y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H, BUTTON_CORNER_RADIUS, color);
-    tft.setTextColor(TFT_WHITE);
-    tft.drawString(text, SETTINGS_CONTROL_X + SETTINGS_BUTTON_W / 2, y + SETTINGS_CONTROL_H / 2);
+  void syncToggleControl(WidgetId id, bool enabled) {
+    setWidgetText(id, enabled ? "Enabled" : "Disabled");
+    setWidgetColor(id, enabled ? COLOR_DARK_GREEN : TFT_MAROON);
   }
 
-  void drawMenuButton(const String& label, int y, int h, uint16_t color) {
-    const int x = SETTINGS_MENU_BTN_X_MARGIN;
-    const int w = tft.width() - 2 * x;
+  // --- Per-screen property updates ---
 
-    tft.fillRoundRect(x, y, w, h, BUTTON_CORNER_RADIUS, color);
-    tft.setTextColor(TFT_WHITE);
-    tft.setFreeFont(&FreeSansBold9pt7b);
-    tft.setTextDatum(MC_DATUM);
+  void syncSettingsMenu(const ApplicationState& state) {
+    setWidgetText(WID_MENU_SYSTEM, state.newVersionAvailable ? "New Update Available!" : "System & Info");
+    setWidgetColor(WID_MENU_SYSTEM, state.newVersionAvailable ? COLOR_DARK_GREEN : COLOR_DARK_PURPLE);
+  }
 
-    tft.drawString(">", x + w - SETTINGS_MENU_ARROW_X_MARGIN, y + h / 2);
-    tft.setTextDatum(ML_DATUM);
-    tft.drawString(label, x + SETTINGS_MENU_LABEL_X_MARGIN, y + h / 2);
+  void syncDisplaySettings(const ApplicationState& state) {
+    const char* clockButtonText = "UTC";
+    switch (state.display.currentClockMode) {
+      case MODE_UTC: clockButtonText = "UTC"; break;
+      case MODE_LOCAL: clockButtonText = "Local"; break;
+      case MODE_BOTH: clockButtonText = "UTC + Local"; break;
+    }
+    setWidgetText(WID_CLOCK_MODE, clockButtonText);
+    setWidgetText(WID_SPOTS_VIEW, (state.display.spotsViewMode == SPOTS_ONLY) ? "6 Spots" : "5 Spots + Prop.");
+    setWidgetText(WID_PROP_VIEW, (state.display.currentPropViewMode == VIEW_SIMPLE) ? "Simple" : "Extended");
+    syncSliderControl(WID_BRIGHTNESS_DOWN, WID_BRIGHTNESS_VALUE, WID_BRIGHTNESS_UP,
+                      String(state.display.brightnessPercent) + "%", 10, 100, state.display.brightnessPercent);
+    syncToggleControl(WID_INVERT, state.display.colorInversion);
   }
 
-  void drawOnOffButton(const String& label, int y, int h, bool isOn) {
-    const int x = SETTINGS_MENU_BTN_X_MARGIN;
-    const int w = tft.width() - 2 * x;
-    uint16_t statusColor = isOn ? TFT_GREEN : TFT_RED;
-    String statusText = isOn ? "ON" : "OFF";
+  void syncAudioSettings(const ApplicationState& state) {
+    syncSliderControl(WID_VOLUME_DOWN, WID_VOLUME_VALUE, WID_VOLUME_UP,
+                      getVolumeString(state.audio.volumePercent), 0, 100, state.audio.volumePercent);
+    syncSliderControl(WID_TONE_FREQ_DOWN, WID_TONE_FREQ_VALUE, WID_TONE_FREQ_UP,
+                      String(state.audio.toneFrequency) + " Hz", 300, 1400, state.audio.toneFrequency);
+    syncSliderControl(WID_TONE_DURATION_DOWN, WID_TONE_DURATION_VALUE, WID_TONE_DURATION_UP,
+                      String(state.audio.toneDurationMs) + " ms", 50, 125, state.audio.toneDurationMs);
+  }
 
-    tft.fillRoundRect(x, y, w, h, BUTTON_CORNER_RADIUS, COLOR_DARK_BLUE);
-    tft.setFreeFont(&FreeSansBold9pt7b);
+  void syncSleepSettings(const ApplicationState& state) {
+    String inactivityText = (state.power.sleepTimeoutMinutes == 0) ? "Off" : String(state.power.sleepTimeoutMinutes / 60) + " h";
+    syncSliderControl(WID_INACTIVITY_DOWN, WID_INACTIVITY_VALUE, WID_INACTIVITY_UP, inactivityText, 0, 720, state.power.sleepTimeoutMinutes);
+    syncToggleControl(WID_SCHEDULE, state.power.scheduledSleepEnabled);
+
+    // The schedule times are only shown while the schedule is on
+    const WidgetId scheduleWidgets[] = {
+      WID_SLEEP_HOUR_LABEL, WID_SLEEP_HOUR_DOWN, WID_SLEEP_HOUR_VALUE, WID_SLEEP_HOUR_UP,
+      WID_WAKE_HOUR_LABEL, WID_WAKE_HOUR_DOWN, WID_WAKE_HOUR_VALUE, WID_WAKE_HOUR_UP
+    };
+    for (WidgetId id : scheduleWidgets) setWidgetHidden(id, !state.power.scheduledSleepEnabled);
+    syncSliderControl(WID_SLEEP_HOUR_DOWN, WID_SLEEP_HOUR_VALUE, WID_SLEEP_HOUR_UP,
+                      String(state.power.scheduledSleepHour) + ":00", 0, 23, state.power.scheduledSleepHour);
+    syncSliderControl(WID_WAKE_HOUR_DOWN, WID_WAKE_HOUR_VALUE, WID_WAKE_HOUR_UP,
+                      String(state.power.scheduledWakeHour) + ":00", 0, 23, state.power.scheduledWakeHour);
+  }
 
-    tft.setTextDatum(MC_DATUM);
-    tft.setTextColor(statusColor);
-    tft.drawString(statusText, x + w - SETTINGS_MENU_STATUS_X_MARGIN, y + h / 2);
+  void syncSystemSettings(const ApplicationState& state) {
+    setWidgetOn(WID_REMEMBER_SCREEN, state.display.rememberLastScreen);
+    setWidgetText(WID_UPDATES, state.newVersionAvailable ? "New Update Available!" : "Updates & License");
+    setWidgetColor(WID_UPDATES, state.newVersionAvailable ? COLOR_DARK_GREEN : COLOR_DARK_BLUE);
+  }
 
-    tft.setTextDatum(ML_DATUM);
-    tft.setTextColor(TFT_WHITE);
-    tft.drawString(label, x + SETTINGS_MENU_LABEL_X_MARGIN, y + h / 2);
+  void syncUpdatesScreen(const ApplicationState& state) {
+    setWidgetOn(WID_CHECK_UPDATES, state.checkForUpdates);
   }
 }
 
 // --- Settings Screens Drawing Functions ---
 
 void drawSettingsMenuScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_SETTINGS_MENU);
   tft.fillScreen(TFT_BLACK);
-  
-  drawMenuButton("Display Settings", SETTINGS_MENU_START_Y, SETTINGS_MENU_BTN_H, COLOR_DARK_BLUE);
-  drawMenuButton("Audio Settings", SETTINGS_MENU_START_Y + (SETTINGS_MENU_BTN_H + SETTINGS_MENU_GAP), SETTINGS_MENU_BTN_H, COLOR_DARK_GREEN);
-  drawMenuButton("Power Management", SETTINGS_MENU_START_Y + 2 * (SETTINGS_MENU_BTN_H + SETTINGS_MENU_GAP), SETTINGS_MENU_BTN_H, TFT_DARKCYAN);
-  
-  String systemButtonText = "System & Info";
-  uint16_t systemButtonColor = COLOR_DARK_PURPLE;
-  if (state.newVersionAvailable) {
-    systemButtonText = "New Update Available!";
-    systemButtonColor = COLOR_DARK_GREEN;
-  }
-  drawMenuButton(systemButtonText, SETTINGS_MENU_START_Y + 3 * (SETTINGS_MENU_BTN_H + SETTINGS_MENU_GAP), SETTINGS_MENU_BTN_H, systemButtonColor);
-  
-  drawButtons(state);
+  syncSettingsMenu(state);
+  drawWidgets(SCREEN_SETTINGS_MENU, true);
 }
 
 void drawDisplaySettingsScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_DISPLAY_SETTINGS);
   tft.fillScreen(TFT_BLACK);
-  tft.setFreeFont(&FreeSans9pt7b);
-  
-  // Clock Mode Button
-  String clockButtonText;
-  switch (state.display.currentClockMode) {
-    case MODE_UTC: clockButtonText = "UTC"; break;
-    case MODE_LOCAL: clockButtonText = "Local"; break;
-    case MODE_BOTH: clockButtonText = "UTC + Local"; break;
-  }
-  tft.setTextDatum(CL_DATUM); tft.setTextColor(TFT_WHITE);
-  tft.drawString("Clock:", SETTINGS_LABEL_X, SETTINGS_ROW1_Y + SETTINGS_CONTROL_H / 2);
-  tft.setTextDatum(MC_DATUM);
-  tft.fillRoundRect(SETTINGS_CONTROL_X, SETTINGS_ROW1_Y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H, BUTTON_CORNER_RADIUS, COLOR_DARK_BLUE);
-  tft.setTextColor(TFT_WHITE);
-  tft.drawString(clockButtonText, SETTINGS_CONTROL_X + SETTINGS_BUTTON_W / 2, SETTINGS_ROW1_Y + SETTINGS_CONTROL_H / 2);
-  
-  // Spots View Mode Button
-  String spotsViewText = (state.display.spotsViewMode == SPOTS_ONLY) ? "6 Spots" : "5 Spots + Prop.";
-  tft.setTextDatum(CL_DATUM); tft.setTextColor(TFT_WHITE);
-  tft.drawString("Spots View:", SETTINGS_LABEL_X, SETTINGS_ROW2_Y + SETTINGS_CONTROL_H / 2);
-  tft.setTextDatum(MC_DATUM);
-  tft.fillRoundRect(SETTINGS_CONTROL_X, SETTINGS_ROW2_Y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H, BUTTON_CORNER_RADIUS, COLOR_DARK_BLUE);
-  tft.setTextColor(TFT_WHITE);
-  tft.drawString(spotsViewText, SETTINGS_CONTROL_X + SETTINGS_BUTTON_W / 2, SETTINGS_ROW2_Y + SETTINGS_CONTROL_H / 2);
-  
-  // Propagation View Mode Button
-  String propButtonText = (state.display.currentPropViewMode == VIEW_SIMPLE) ? "Simple" : "Extended";
-  tft.setTextDatum(CL_DATUM); tft.setTextColor(TFT_WHITE);
-  tft.drawString("Propagation:", SETTINGS_LABEL_X, SETTINGS_ROW3_Y + SETTINGS_CONTROL_H / 2);
-  tft.setTextDatum(MC_DATUM);
-  tft.fillRoundRect(SETTINGS_CONTROL_X, SETTINGS_ROW3_Y, SETTINGS_BUTTON_W, SETTINGS_CONTROL_H, BUTTON_CORNER_RADIUS, COLOR_DARK_BLUE);
-  tft.setTextColor(TFT_WHITE);
-  tft.drawString(propButtonText, SETTINGS_CONTROL_X + SETTINGS_BUTTON_W / 2, SETTINGS_ROW3_Y + SETTINGS_CONTROL_H / 2);
-  
-  // Sliders and Toggles
-  drawSliderControl("Brightness:", SETTINGS_ROW4_Y, String(state.display.brightnessPercent) + "%", 10, 100, state.display.brightnessPercent);
-  drawToggleControl("Invert Colors:", SETTINGS_ROW5_Y, state.display.colorInversion);
-  
-  drawButtons(state);
+  syncDisplaySettings(state);
+  drawWidgets(SCREEN_DISPLAY_SETTINGS, true);
 }
 
 void drawAudioSettingsScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_AUDIO_SETTINGS);
   tft.fillScreen(TFT_BLACK);
-  drawSliderControl("Volume:", SETTINGS_ROW1_Y, getVolumeDbString(state.audio.volumeStep), 0, 4, state.audio.volumeStep);
-  drawSliderControl("Tone Freq:", SETTINGS_ROW2_Y, String(state.audio.toneFrequency) + " Hz", 300, 1400, state.audio.toneFrequency);
-  drawSliderControl("Tone Duration:", SETTINGS_ROW3_Y, String(state.audio.toneDurationMs) + " ms", 50, 125, state.audio.toneDurationMs);
-  drawButtons(state);
+  syncAudioSettings(state);
+  drawWidgets(SCREEN_AUDIO_SETTINGS, true);
 }
 
 void drawSystemSettingsScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_SYSTEM_SETTINGS);
   tft.fillScreen(TFT_BLACK);
-  
-  drawMenuButton("Device Info", SETTINGS_ROW1_Y, SETTINGS_CONTROL_H, COLOR_DARK_BLUE);
-  drawMenuButton("Calibrate Touch", SETTINGS_ROW2_Y, SETTINGS_CONTROL_H, COLOR_DARK_BLUE);
-  drawOnOffButton("Remember Screen:", SETTINGS_ROW3_Y, SETTINGS_CONTROL_H, state.display.rememberLastScreen);
-  
-  String updatesButtonText = "Updates & License";
-  uint16_t updatesButtonColor = COLOR_DARK_BLUE;
-  if (state.newVersionAvailable) {
-    updatesButtonText = "New Update Available!";
-    updatesButtonColor = COLOR_DARK_GREEN;
-  }
-  drawMenuButton(updatesButtonText, SETTINGS_ROW4_Y, SETTINGS_CONTROL_H, updatesButtonColor);
-  
-  drawMenuButton("Reset Wi-Fi Settings", SETTINGS_ROW5_Y, SETTINGS_CONTROL_H, TFT_MAROON);
-  
-  drawButtons(state);
+  syncSystemSettings(state);
+  drawWidgets(SCREEN_SYSTEM_SETTINGS, true);
 }
 
 void drawSleepSettingsScreen(const ApplicationState& state) {
-    tft.fillScreen(TFT_BLACK);
-    
-    String inactivityText = (state.power.sleepTimeoutMinutes == 0) ? "Off" : String(state.power.sleepTimeoutMinutes / 60) + " h";
-    drawSliderControl("Inactivity:", SETTINGS_ROW1_Y, inactivityText, 0, 720, state.power.sleepTimeoutMinutes);
-    
-    drawToggleControl("Schedule:", SETTINGS_ROW2_Y, state.power.scheduledSleepEnabled);
-    
-    if (state.power.scheduledSleepEnabled) {
-        drawSliderControl("Sleep at:", SETTINGS_ROW3_Y, String(state.power.scheduledSleepHour) + ":00", 0, 23, state.power.scheduledSleepHour);
-        drawSliderControl("Wake at:", SETTINGS_ROW4_Y, String(state.power.scheduledWakeHour) + ":00", 0, 23, state.power.scheduledWakeHour);
-    }
-    
-    drawButtons(state);
+  PROFILE_SCOPE(PROF_DRAW_SLEEP_SETTINGS);
+  tft.fillScreen(TFT_BLACK);
+  syncSleepSettings(state);
+  drawWidgets(SCREEN_SLEEP_SETTINGS, true);
+}
+
+// Brings the active settings screen in line with the state after a setting
+// changed, repainting only the widgets whose text, color or visibility moved.
+void refreshSettingsScreen(const ApplicationState& state) {
+  switch (state.activeScreen) {
+    case SCREEN_SETTINGS_MENU: syncSettingsMenu(state); break;
+    case SCREEN_DISPLAY_SETTINGS: syncDisplaySettings(state); break;
+    case SCREEN_AUDIO_SETTINGS: syncAudioSettings(state); break;
+    case SCREEN_SLEEP_SETTINGS: syncSleepSettings(state); break;
+    case SCREEN_SYSTEM_SETTINGS: syncSystemSettings(state); break;
+    case SCREEN_UPDATES_INFO: syncUpdatesScreen(state); break;
+    default: return;
+  }
+  drawWidgets(state.activeScreen, false);
 }
 
 void drawInfoScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_INFO);
   tft.fillScreen(TFT_BLACK); 
   tft.setTextDatum(TL_DATUM); 
   tft.setFreeFont(&FreeSans9pt7b);
@@ -217,7 +155,10 @@ void drawInfoScreen(const ApplicationState& state) {
   tft.setTextColor(TFT_CYAN); tft.drawString(ESP.getChipModel(), INFO_SCREEN_VALUE_X, yPos); 
   yPos += INFO_SCREEN_LINE_GAP;
   
-  String cpuInfo = String(ESP.getCpuFreqMHz()) + " MHz"; 
+  const CpuGovernorStats cpuStats = getCpuGovernorStats();
+  const uint64_t cpuTotalUs = cpuStats.idleUs + cpuStats.boostedUs;
+  String cpuInfo = String(CPU_IDLE_MHZ) + "/" + String(CPU_BOOST_MHZ) + " MHz, " +
+                   String(cpuTotalUs ? (int)(cpuStats.boostedUs * 100 / cpuTotalUs) : 0) + "% boosted";
   tft.setTextColor(TFT_WHITE); tft.drawString("CPU:", INFO_SCREEN_LABEL_X, yPos); 
   tft.setTextColor(TFT_CYAN); tft.drawString(cpuInfo, INFO_SCREEN_VALUE_X, yPos); 
   yPos += INFO_SCREEN_LINE_GAP;
@@ -248,7 +189,7 @@ void drawInfoScreen(const ApplicationState& state) {
     yPos += INFO_SCREEN_LINE_GAP;
     
     tft.setTextColor(TFT_WHITE); tft.drawString("HamAlert:", INFO_SCREEN_LABEL_X, yPos);
-    if (telnetClient.connected()) { 
+    if (state.network.hamAlertConnected && telnetClient.connected()) { 
         tft.setTextColor(TFT_GREEN); tft.drawString("Connected", INFO_SCREEN_VALUE_X, yPos); 
     } else { 
         tft.setTextColor(TFT_RED); tft.drawString("Disconnected", INFO_SCREEN_VALUE_X, yPos); 
@@ -270,9 +211,17 @@ void drawInfoScreen(const ApplicationState& state) {
   
   tft.setTextColor(TFT_WHITE); tft.drawString("Uptime:", INFO_SCREEN_LABEL_X, yPos); 
   tft.setTextColor(TFT_CYAN); tft.drawString(uptimeBuffer, INFO_SCREEN_VALUE_X, yPos);
+  yPos += INFO_SCREEN_LINE_GAP;
+
+  // Power: the current is an estimate for the ESP32 module alone
+  char powerBuffer[32];
+  snprintf(powerBuffer, sizeof(powerBuffer), "%d%% awake, ~%d mA", getAwakePercent(), getEstimatedCurrentMa(state));
+  tft.setTextColor(TFT_WHITE); tft.drawString("Power:", INFO_SCREEN_LABEL_X, yPos);
+  tft.setTextColor(state.power.lowPowerMode ? TFT_GREEN : TFT_CYAN); tft.drawString(powerBuffer, INFO_SCREEN_VALUE_X, yPos);
 }
 
 void drawUpdatesScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_UPDATES);
   tft.fillScreen(TFT_BLACK);
   tft.setTextDatum(TL_DATUM);
   tft.setFreeFont(&FreeSans9pt7b);
@@ -317,11 +266,12 @@ void drawUpdatesScreen(const ApplicationState& state) {
   tft.setTextColor(TFT_WHITE); tft.drawString("License:", xLabel, yPos); 
   tft.setTextColor(TFT_CYAN); tft.drawString("CC BY-NC-SA 4.0", xValue, yPos);
   
-  const int updatesBtnY = tft.height() - SETTINGS_CONTROL_H - SETTINGS_V_GAP;
-  drawOnOffButton("Check for Updates:", updatesBtnY, SETTINGS_CONTROL_H, state.checkForUpdates);
+  syncUpdatesScreen(state);
+  drawWidgets(SCREEN_UPDATES_INFO, true);
 }
 
 void drawWifiResetConfirmScreen(const ApplicationState& state) {
+  PROFILE_SCOPE(PROF_DRAW_WIFI_RESET);
   tft.fillScreen(TFT_BLACK);
   tft.setTextDatum(MC_DATUM);
   tft.setFreeFont(&FreeSans9pt7b);
@@ -339,18 +289,5 @@ void drawWifiResetConfirmScreen(const ApplicationState& state) {
   tft.setFreeFont(&FreeSansBold9pt7b);
   tft.drawString("Are you sure?", tft.width() / 2, yPos);
 
-  const int BTN_Y = tft.height() - CALIBRATION_BTN_H - CALIBRATION_BTN_Y_MARGIN;
-  const int TOTAL_W = CALIBRATION_BTN_W * 2 + CALIBRATION_BTN_GAP;
-  const int START_X = (tft.width() - TOTAL_W) / 2;
-
-  const int CANCEL_BTN_X = START_X;
-  const int CONFIRM_BTN_X = START_X + CALIBRATION_BTN_W + CALIBRATION_BTN_GAP;
-
-  tft.setFreeFont(&FreeSans9pt7b);
-  tft.fillRoundRect(CANCEL_BTN_X, BTN_Y, CALIBRATION_BTN_W, CALIBRATION_BTN_H, BUTTON_CORNER_RADIUS, COLOR_DARK_GREEN);
-  tft.setTextColor(TFT_WHITE);
-  tft.drawString("Cancel", CANCEL_BTN_X + CALIBRATION_BTN_W / 2, BTN_Y + CALIBRATION_BTN_H / 2);
-
-  tft.fillRoundRect(CONFIRM_BTN_X, BTN_Y, CALIBRATION_BTN_W, CALIBRATION_BTN_H, BUTTON_CORNER_RADIUS, TFT_MAROON);
-  tft.drawString("Confirm Reset", CONFIRM_BTN_X + CALIBRATION_BTN_W / 2, BTN_Y + CALIBRATION_BTN_H / 2);
+  drawWidgets(SCREEN_WIFI_RESET_CONFIRM, true);
 }
\ No newline at end of file
@@ -10,23 +10,16 @@ Commercial use is prohibited.
 #include "declarations.h"
 #include <ArduinoJson.h>
 
-// Checks the latest release on GitHub to see if a new version is available.
-// Returns true if a new version is found.
-bool checkGithubForUpdate(ApplicationState& state) {
-  if (!state.checkForUpdates || !state.network.isWifiConnected) {
-    return false;
-  }
-
-  WiFiClientSecure client;
-  // GitHub API uses a certificate that might not be in the ESP32's root store.
-  // We skip verification for this simple check.
-  client.setInsecure(); 
-
+// Reads the tag of the latest release from the GitHub API. Uses only the
+// HTTPS client, so it can run on another task while the UI keeps going.
+bool fetchLatestReleaseTag(char* tag, size_t tagSize) {
   Serial.println("Connecting to GitHub API...");
-  if (!client.connect(GITHUB_API_HOST, HTTPS_PORT)) {
+  TlsClient* clientPtr = beginHttpsRequest(HTTPS_HOST_GITHUB);
+  if (!clientPtr) {
     Serial.println("Connection to GitHub API failed.");
     return false;
   }
+  TlsClient& client = *clientPtr;
 
   // Construct the request URL for the latest release API endpoint.
   String url = String("/repos/") + GITHUB_REPO + "/releases/latest";
@@ -49,19 +42,31 @@ bool checkGithubForUpdate(ApplicationState& state) {
   // Parse the JSON response.
   // Adjust size if the API response grows significantly.
   JsonDocument doc;
-  DeserializationError error = deserializeJson(doc, client);
+  DeserializationError error;
+  {
+    CPU_BOOST_SCOPE();
+    error = deserializeJson(doc, client);
+  }
+
+  // The check runs once a day, so the connection is not worth keeping open.
+  endHttpsRequest(HTTPS_HOST_GITHUB, false);
 
   if (error) {
     Serial.print("deserializeJson() failed: ");
     Serial.println(error.c_str());
-    client.stop();
     return false;
   }
 
   // Extract the 'tag_name' (version number) from the JSON.
   const char* latest_tag = doc["tag_name"];
+  strlcpy(tag, latest_tag ? latest_tag : "", tagSize);
+  return true;
+}
 
-  if (latest_tag) {
+// Records the result of a release check. An empty tag means the response
+// had none. Returns true if a new version is available.
+bool applyLatestReleaseTag(ApplicationState& state, const char* latest_tag) {
+  if (latest_tag[0]) {
     Serial.print("Latest GitHub release tag: ");
     Serial.println(latest_tag);
     Serial.print("Current firmware version: ");
@@ -82,11 +87,20 @@ bool checkGithubForUpdate(ApplicationState& state) {
     state.newVersionAvailable = false;
   }
 
-  client.stop();
-  
   // Update state and save to memory so we don't check too often
   state.lastUpdateCheckTime = millis(); 
   saveSettings(state); 
   
   return state.newVersionAvailable;
 }
+
+// Checks the latest release on GitHub to see if a new version is available.
+// Returns true if a new version is found.
+bool checkGithubForUpdate(ApplicationState& state) {
+  if (!state.checkForUpdates || !state.network.isWifiConnected) {
+    return false;
+  }
+  char tag[sizeof(state.newVersionTag)];
+  if (!fetchLatestReleaseTag(tag, sizeof(tag))) return false;
+  return applyLatestReleaseTag(state, tag);
+}
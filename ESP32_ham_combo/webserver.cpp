@@ -46,30 +46,40 @@ void setupWebServer(ApplicationState& state) {
       if (request->hasParam("rotation", true)) newState.display.screenRotation = request->getParam("rotation", true)->value().toInt();
       newState.display.colorInversion = request->hasParam("inversion", true);
       newState.display.secondDotEnabled = request->hasParam("secondDot", true);
+      newState.display.clockSecondsEnabled = request->hasParam("clockSecs", true);
+      newState.display.secondDotSweep = request->hasParam("dotSweep", true);
       newState.display.rememberLastScreen = request->hasParam("rememberScreen", true);
+      newState.display.hideClosedBands = request->hasParam("hideClosed", true);
 
       // Audio Settings
-      if (request->hasParam("volume", true)) {
-        int volPercent = request->getParam("volume", true)->value().toInt();
-        // Map 0-100% slider to 0-4 step
-        if (volPercent == 0) newState.audio.volumeStep = 0;
-        else if (volPercent <= 25) newState.audio.volumeStep = 1;
-        else if (volPercent <= 50) newState.audio.volumeStep = 2;
-        else if (volPercent <= 75) newState.audio.volumeStep = 3;
-        else newState.audio.volumeStep = 4;
-      }
+      if (request->hasParam("volume", true)) newState.audio.volumePercent = request->getParam("volume", true)->value().toInt();
       if (request->hasParam("tone", true)) newState.audio.toneFrequency = request->getParam("tone", true)->value().toInt();
       if (request->hasParam("toneDuration", true)) newState.audio.toneDurationMs = request->getParam("toneDuration", true)->value().toInt();
+      if (request->hasParam("watchlist", true)) {
+        String watchlist = request->getParam("watchlist", true)->value();
+        watchlist.trim();
+        watchlist.toUpperCase();
+        strlcpy(newState.audio.watchlist, watchlist.c_str(), sizeof(newState.audio.watchlist));
+      }
+      if (request->hasParam("cwCalls", true)) newState.audio.cwCalls = (CwCallsMode)request->getParam("cwCalls", true)->value().toInt();
+      if (request->hasParam("cwWpm", true)) newState.audio.cwWpm = request->getParam("cwWpm", true)->value().toInt();
 
       // Power Settings
       if (request->hasParam("sleepTimeout", true)) newState.power.sleepTimeoutMinutes = request->getParam("sleepTimeout", true)->value().toInt();
       newState.power.scheduledSleepEnabled = request->hasParam("schedSleepOn", true);
       if (request->hasParam("schedSleepH", true)) newState.power.scheduledSleepHour = request->getParam("schedSleepH", true)->value().toInt();
       if (request->hasParam("schedWakeH", true)) newState.power.scheduledWakeHour = request->getParam("schedWakeH", true)->value().toInt();
+      newState.power.lowPowerMode = request->hasParam("lowPower", true);
+      if (request->hasParam("spotDelay", true)) newState.power.maxSpotDelayMs = request->getParam("spotDelay", true)->value().toInt();
 
       // Timezone and DST settings
       if (request->hasParam("timezone", true)) strlcpy(newState.network.timezone, request->getParam("timezone", true)->value().c_str(), sizeof(newState.network.timezone));
       if (request->hasParam("dstMode", true)) newState.network.dstMode = request->getParam("dstMode", true)->value().toInt();
+      if (request->hasParam("locator", true)) {
+        String locator = request->getParam("locator", true)->value();
+        locator.trim();
+        strlcpy(newState.station.locator, locator.c_str(), sizeof(newState.station.locator));
+      }
 
       if (newState.network.dstMode == 3) { // Custom rule
         int sm = request->getParam("start_m", true)->value().toInt();
@@ -126,15 +136,21 @@ button{background-color:#004D40;color:#80CBC4;border:1px solid #00796B;padding:8
 </div></fieldset>
 <fieldset><legend>Display & Sound</legend><div class="form-grid">
 <label for="brightness">Brightness:</label><div class="control range-container"><input type="range" id="brightness" name="brightness" min="10" max="100" step="10" value="{BRIGHTNESS}" oninput="this.nextElementSibling.innerText=this.value+'%'"><span class="range-value"></span></div>
-<label for="volume">Volume:</label><div class="control range-container"><input type="range" id="volume" name="volume" min="0" max="100" step="25" value="{VOLUME}" oninput="updateVolumeLabel(this)"><span class="range-value"></span></div>
+<label for="volume">Volume:</label><div class="control range-container"><input type="range" id="volume" name="volume" min="0" max="100" step="5" value="{VOLUME}" oninput="updateVolumeLabel(this)"><span class="range-value"></span></div>
 <label for="tone">Tone Freq:</label><div class="control range-container"><input type="range" id="tone" name="tone" min="300" max="1400" step="100" value="{TONE}" oninput="this.nextElementSibling.innerText=this.value+' Hz'"><span class="range-value"></span></div>
 <label for="toneDuration">Tone Duration:</label><div class="control range-container"><input type="range" id="toneDuration" name="toneDuration" min="50" max="125" step="25" value="{TONE_DURATION}" oninput="this.nextElementSibling.innerText=this.value+' ms'"><span class="range-value"></span></div>
+<label for="watchlist">Watchlist:</label><input class="control" type="text" id="watchlist" name="watchlist" maxlength="63" placeholder="e.g. 3Y0J, VP8*" value="{WATCHLIST}">
+<label for="cwCalls">Callsign in CW:</label><select class="control" id="cwCalls" name="cwCalls">{CW_CALLS_OPTIONS}</select>
+<label for="cwWpm">CW Speed:</label><select class="control" id="cwWpm" name="cwWpm">{CW_WPM_OPTIONS}</select>
 <label>Clock Mode:</label><div class="control radio-group"><label><input type="radio" name="clockMode" value="0" {CM_UTC_CHECKED}>UTC</label><label><input type="radio" name="clockMode" value="1" {CM_LOCAL_CHECKED}>Local</label><label><input type="radio" name="clockMode" value="2" {CM_BOTH_CHECKED}>Both</label></div>
 <label>Propagation View:</label><div class="control radio-group"><label><input type="radio" name="propMode" value="0" {PM_SIMPLE_CHECKED}>Simple</label><label><input type="radio" name="propMode" value="1" {PM_EXTENDED_CHECKED}>Extended</label></div>
 <label for="rotation">Screen Rotation:</label><select class="control" id="rotation" name="rotation">{ROTATION_OPTIONS}</select>
 <label for="inversion">Invert Colors:</label><input class="control" type="checkbox" id="inversion" name="inversion" {INVERSION_CHECKED}>
 <label for="secondDot">Second Dot:</label><input class="control" type="checkbox" id="secondDot" name="secondDot" {SECOND_DOT_CHECKED}>
+<label for="dotSweep">Sweep Second Dot:</label><input class="control" type="checkbox" id="dotSweep" name="dotSweep" {DOT_SWEEP_CHECKED}>
+<label for="clockSecs">Clock Seconds:</label><input class="control" type="checkbox" id="clockSecs" name="clockSecs" {CLOCK_SECONDS_CHECKED}>
 <label for="rememberScreen">Remember Screen:</label><input class="control" type="checkbox" id="rememberScreen" name="rememberScreen" {REMEMBER_SCREEN_CHECKED}>
+<label for="hideClosed">Hide Closed Bands:</label><input class="control" type="checkbox" id="hideClosed" name="hideClosed" {HIDE_CLOSED_CHECKED}>
 </div></fieldset>
 <fieldset><legend>Power Management</legend><div class="form-grid">
 <label for="sleepTimeout">Inactivity Sleep:</label><select class="control" id="sleepTimeout" name="sleepTimeout">{TIMEOUT_OPTIONS}</select>
@@ -142,10 +158,14 @@ button{background-color:#004D40;color:#80CBC4;border:1px solid #00796B;padding:8
 <div id="schedule-times" style="display:none;grid-column:1/-1;"><div class="form-grid">
 <label for="schedSleepH">Sleep Time (H):</label><input class="control" type="number" id="schedSleepH" name="schedSleepH" min="0" max="23" value="{SLEEP_H}">
 <label for="schedWakeH">Wake Time (H):</label><input class="control" type="number" id="schedWakeH" name="schedWakeH" min="0" max="23" value="{WAKE_H}">
-</div></div></div></fieldset>
+</div></div>
+<label for="lowPower">Low Power Mode:</label><input class="control" type="checkbox" id="lowPower" name="lowPower" {LOW_POWER_CHECKED}>
+<label for="spotDelay">Max Spot Delay:</label><select class="control" id="spotDelay" name="spotDelay">{SPOT_DELAY_OPTIONS}</select>
+</div></fieldset>
 <fieldset><legend>Regional Settings</legend><div class="form-grid">
 <label for="timezone">Base Timezone:</label><select class="control" id="timezone" name="timezone">{TIMEZONE_OPTIONS}</select>
 <label for="dstMode">Summer Time:</label><select class="control" id="dstMode" name="dstMode">{DST_MODE_OPTIONS}</select>
+<label for="locator">QTH Locator:</label><input class="control" type="text" id="locator" name="locator" maxlength="6" placeholder="e.g. JO91qm" value="{LOCATOR}">
 </div><div id="custom-dst-rules" style="display:none;grid-column:1/-1;">
 <div class="custom-dst-grid"><label>Starts:</label><select name="start_m">{MONTH_OPTIONS_START}</select><select name="start_w">{WEEK_OPTIONS_START}</select><select name="start_d">{DAY_OPTIONS_START}</select></div>
 <div class="custom-dst-grid"><label>Ends:</label><select name="end_m">{MONTH_OPTIONS_END}</select><select name="end_w">{WEEK_OPTIONS_END}</select><select name="end_d">{DAY_OPTIONS_END}</select></div>
@@ -157,8 +177,7 @@ button{background-color:#004D40;color:#80CBC4;border:1px solid #00796B;padding:8
 <button type="button" id="startCalBtn">Start Touch Calibration</button>
 </div>
 <script>
-const volumeLabels = ['Muted', '-18 dB', '-12 dB', '-6 dB', '0 dB'];
-function updateVolumeLabel(slider) { slider.nextElementSibling.innerText = volumeLabels[slider.value / 25]; }
+function updateVolumeLabel(slider) { slider.nextElementSibling.innerText = slider.value == 0 ? 'Muted' : slider.value + '%'; }
 document.addEventListener('DOMContentLoaded',function(){
 ['brightness','tone','toneDuration'].forEach(id=>document.getElementById(id).dispatchEvent(new Event('input')));
 updateVolumeLabel(document.getElementById('volume'));
@@ -205,6 +224,33 @@ document.getElementById('startCalBtn').addEventListener('click',function(){fetch
         return options;
     };
 
+    auto generateSpotDelayOptions = [](int selectedMs) {
+        const int delays[] = {500, 1000, 2000, 5000};
+        String options = "";
+        for (int ms : delays) {
+            options += String("<option value=\"") + ms + "\"" + (selectedMs == ms ? " selected" : "") + ">" + String(ms / 1000.0f, 1) + " s</option>";
+        }
+        return options;
+    };
+
+    auto generateCwCallsOptions = [](CwCallsMode selectedMode) {
+        const char* names[] = {"Off", "Watchlist Hits", "All Spots"};
+        String options = "";
+        for (int i = 0; i < 3; ++i) {
+            options += "<option value=\"" + String(i) + "\"" + (selectedMode == i ? " selected" : "") + ">" + names[i] + "</option>";
+        }
+        return options;
+    };
+
+    auto generateCwWpmOptions = [](int selectedWpm) {
+        const int speeds[] = {15, 20, 25, 30};
+        String options = "";
+        for (int wpm : speeds) {
+            options += String("<option value=\"") + wpm + "\"" + (selectedWpm == wpm ? " selected" : "") + ">" + wpm + " WPM</option>";
+        }
+        return options;
+    };
+
     String dstModeOptions = "";
     const char* dstNames[] = {"Disabled", "European Union Rules", "North America Rules", "Custom..."};
     for (int i = 0; i < 4; ++i) {
@@ -221,17 +267,17 @@ document.getElementById('startCalBtn').addEventListener('click',function(){fetch
     const char* weeks[] = {"1st", "2nd", "3rd", "4th", "Last"};
     const char* days[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
 
-    // Convert volume step to percentage for UI
-    int volumePercentForWeb = state.audio.volumeStep * 25;
-
     // --- Replace Placeholders ---
     html.replace("{TITLE}", "ESP32 Ham Combo v" + String(FW_VERSION) + " (" + String(FW_DATE) + ")");
     html.replace("{USER}", String(state.network.telnetUsername));
     html.replace("{PASS}", String(state.network.telnetPassword));
     html.replace("{BRIGHTNESS}", String(state.display.brightnessPercent));
-    html.replace("{VOLUME}", String(volumePercentForWeb));
+    html.replace("{VOLUME}", String(state.audio.volumePercent));
     html.replace("{TONE}", String(state.audio.toneFrequency));
     html.replace("{TONE_DURATION}", String(state.audio.toneDurationMs));
+    html.replace("{WATCHLIST}", String(state.audio.watchlist));
+    html.replace("{CW_CALLS_OPTIONS}", generateCwCallsOptions(state.audio.cwCalls));
+    html.replace("{CW_WPM_OPTIONS}", generateCwWpmOptions(state.audio.cwWpm));
     html.replace("{CM_UTC_CHECKED}", state.display.currentClockMode == MODE_UTC ? "checked" : "");
     html.replace("{CM_LOCAL_CHECKED}", state.display.currentClockMode == MODE_LOCAL ? "checked" : "");
     html.replace("{CM_BOTH_CHECKED}", state.display.currentClockMode == MODE_BOTH ? "checked" : "");
@@ -240,13 +286,19 @@ document.getElementById('startCalBtn').addEventListener('click',function(){fetch
     html.replace("{ROTATION_OPTIONS}", generateRotationOptions(state.display.screenRotation));
     html.replace("{INVERSION_CHECKED}", state.display.colorInversion ? "checked" : "");
     html.replace("{SECOND_DOT_CHECKED}", state.display.secondDotEnabled ? "checked" : "");
+    html.replace("{CLOCK_SECONDS_CHECKED}", state.display.clockSecondsEnabled ? "checked" : "");
+    html.replace("{DOT_SWEEP_CHECKED}", state.display.secondDotSweep ? "checked" : "");
     html.replace("{REMEMBER_SCREEN_CHECKED}", state.display.rememberLastScreen ? "checked" : "");
+    html.replace("{HIDE_CLOSED_CHECKED}", state.display.hideClosedBands ? "checked" : "");
     html.replace("{TIMEOUT_OPTIONS}", generateTimeoutOptions(state.power.sleepTimeoutMinutes));
     html.replace("{SCHED_ON}", state.power.scheduledSleepEnabled ? "checked" : "");
     html.replace("{SLEEP_H}", String(state.power.scheduledSleepHour));
     html.replace("{WAKE_H}", String(state.power.scheduledWakeHour));
+    html.replace("{LOW_POWER_CHECKED}", state.power.lowPowerMode ? "checked" : "");
+    html.replace("{SPOT_DELAY_OPTIONS}", generateSpotDelayOptions(state.power.maxSpotDelayMs));
     html.replace("{TIMEZONE_OPTIONS}", generateTimezoneOptions(state.network.timezone));
     html.replace("{DST_MODE_OPTIONS}", dstModeOptions);
+    html.replace("{LOCATOR}", String(state.station.locator));
     html.replace("{MONTH_OPTIONS_START}", generateRuleOptions(months, 12, sm));
     html.replace("{WEEK_OPTIONS_START}", generateRuleOptions(weeks, 5, sw));
     html.replace("{DAY_OPTIONS_START}", generateDayOptions(days, 7, sd));
@@ -260,9 +312,23 @@ document.getElementById('startCalBtn').addEventListener('click',function(){fetch
 
   webServer.on("/start_calibration", HTTP_GET, [&state](AsyncWebServerRequest *request){
     state.calibrationRequested = true;
+    wakeMainLoop();
     request->send(200, "text/plain", "Calibration process started. Please follow the instructions on the device screen.");
   });
 
+  // What the display shows, for comparing renders before and after a change
+  webServer.on("/screenshot.bmp", HTTP_GET, [](AsyncWebServerRequest *request){
+    request->send(request->beginResponse("image/bmp", getFrameBmpSize(), [](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+      return readFrameBmp(buffer, maxLen, index);
+    }));
+  });
+
+#if ENABLE_PROFILER
+  webServer.on("/profile", HTTP_GET, [](AsyncWebServerRequest *request){
+    request->send(200, "text/plain", getProfilerReport());
+  });
+#endif
+
   webServer.on("/restart", HTTP_GET, [](AsyncWebServerRequest *request){
     request->send(200, "text/plain", "Restarting...");
     delay(200);
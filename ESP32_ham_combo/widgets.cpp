@@ -0,0 +1,464 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+
+// Retained widgets for the touch screens. Each screen's buttons and controls
+// are declared once below, relative to a screen edge; layoutWidgets() turns
+// that into pixel rectangles for the current rotation, and the same
+// rectangles are used for drawing and for hit-testing. Setters only mark a
+// widget dirty when the value actually changes, so a settings tap repaints
+// the controls it affected rather than the whole screen. Hit-testing goes
+// through a coarse grid built with the layout: each cell lists the widgets
+// that overlap it, so a touch only checks the one or two widgets near it.
+
+namespace {
+  struct Widget {
+    WidgetId id;
+    WidgetKind kind;
+    uint8_t anchor;     // WidgetAnchor flags
+    int16_t specX;      // Offset from the anchored edge, or from the centre line
+    int16_t specY;
+    int16_t specW;      // 0 or less stretches to the right edge, leaving -specW
+    int16_t specH;
+    uint16_t color;
+    char text[24];
+    bool hidden;
+    bool on;            // WIDGET_ON_OFF state
+    bool pressed;       // Under the finger, drawn highlighted
+    bool dirty;
+    int16_t x, y, w, h; // Resolved by layoutWidgets()
+  };
+
+  Widget makeWidget(WidgetId id, WidgetKind kind, uint8_t anchor, int x, int y, int w, int h, uint16_t color, const char* text) {
+    Widget widget = {};
+    widget.id = id;
+    widget.kind = kind;
+    widget.anchor = anchor;
+    widget.specX = x;
+    widget.specY = y;
+    widget.specW = w;
+    widget.specH = h;
+    widget.color = color;
+    strlcpy(widget.text, text, sizeof(widget.text));
+    return widget;
+  }
+
+  // --- Shorthands for the layouts the screens share ---
+
+  // Bottom bar slot, counted from the right edge
+  Widget barButton(WidgetId id, int slot, uint16_t color, const char* text) {
+    return makeWidget(id, WIDGET_BUTTON, ANCHOR_RIGHT | ANCHOR_BOTTOM, 10 + BUTTON_W + slot * (BUTTON_W + BUTTON_GAP),
+                      BUTTON_H + BUTTON_Y_MARGIN, BUTTON_W, BUTTON_H, color, text);
+  }
+
+  Widget backButton() {
+    return barButton(WID_BACK, 0, COLOR_DARK_BLUE, "Back");
+  }
+
+  Widget label(int y, const char* text, WidgetId id = WID_NONE) {
+    return makeWidget(id, WIDGET_LABEL, ANCHOR_LEFT | ANCHOR_TOP, SETTINGS_LABEL_X, y,
+                      SETTINGS_CONTROL_X - SETTINGS_LABEL_X, SETTINGS_CONTROL_H, TFT_BLACK, text);
+  }
+
+  Widget controlButton(WidgetId id, int y) {
+    return makeWidget(id, WIDGET_BUTTON, ANCHOR_LEFT | ANCHOR_TOP, SETTINGS_CONTROL_X, y, -20, SETTINGS_CONTROL_H, COLOR_DARK_BLUE, "");
+  }
+
+  Widget stepDown(WidgetId id, int y) {
+    return makeWidget(id, WIDGET_STEP, ANCHOR_LEFT | ANCHOR_TOP, SETTINGS_CONTROL_X, y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H, COLOR_DARK_BLUE, "-");
+  }
+
+  Widget stepValue(WidgetId id, int y) {
+    return makeWidget(id, WIDGET_VALUE, ANCHOR_LEFT | ANCHOR_TOP, SETTINGS_CONTROL_X + SETTINGS_TOUCH_W, y,
+                      -(SETTINGS_TOUCH_W + 20), SETTINGS_CONTROL_H, TFT_BLACK, "");
+  }
+
+  Widget stepUp(WidgetId id, int y) {
+    return makeWidget(id, WIDGET_STEP, ANCHOR_RIGHT | ANCHOR_TOP, SETTINGS_TOUCH_W + 20, y, SETTINGS_TOUCH_W, SETTINGS_CONTROL_H, COLOR_DARK_BLUE, "+");
+  }
+
+  Widget menuButton(WidgetId id, int y, int h, uint16_t color, const char* text) {
+    return makeWidget(id, WIDGET_MENU_BUTTON, ANCHOR_LEFT | ANCHOR_TOP, SETTINGS_MENU_BTN_X_MARGIN, y,
+                      -SETTINGS_MENU_BTN_X_MARGIN, h, color, text);
+  }
+
+  int menuRowY(int row) {
+    return SETTINGS_MENU_START_Y + row * (SETTINGS_MENU_BTN_H + SETTINGS_MENU_GAP);
+  }
+
+  // --- Screens ---
+
+  Widget mainBarWidgets[] = {
+    barButton(WID_SETUP, 0, COLOR_DARK_BLUE, "Setup"),
+    barButton(WID_PROP, 1, COLOR_DARK_PURPLE, "Prop."),
+    barButton(WID_CLOCK, 2, COLOR_DARK_GREEN, "Clock"),
+    barButton(WID_SLEEP_NOW, 3, COLOR_DARK_RED, "Off")
+  };
+
+  Widget settingsMenuWidgets[] = {
+    menuButton(WID_MENU_DISPLAY, menuRowY(0), SETTINGS_MENU_BTN_H, COLOR_DARK_BLUE, "Display Settings"),
+    menuButton(WID_MENU_AUDIO, menuRowY(1), SETTINGS_MENU_BTN_H, COLOR_DARK_GREEN, "Audio Settings"),
+    menuButton(WID_MENU_SLEEP, menuRowY(2), SETTINGS_MENU_BTN_H, TFT_DARKCYAN, "Power Management"),
+    menuButton(WID_MENU_SYSTEM, menuRowY(3), SETTINGS_MENU_BTN_H, COLOR_DARK_PURPLE, "System & Info"),
+    backButton()
+  };
+
+  Widget displaySettingsWidgets[] = {
+    label(SETTINGS_ROW1_Y, "Clock:"),
+    controlButton(WID_CLOCK_MODE, SETTINGS_ROW1_Y),
+    label(SETTINGS_ROW2_Y, "Spots View:"),
+    controlButton(WID_SPOTS_VIEW, SETTINGS_ROW2_Y),
+    label(SETTINGS_ROW3_Y, "Propagation:"),
+    controlButton(WID_PROP_VIEW, SETTINGS_ROW3_Y),
+    label(SETTINGS_ROW4_Y, "Brightness:"),
+    stepDown(WID_BRIGHTNESS_DOWN, SETTINGS_ROW4_Y),
+    stepValue(WID_BRIGHTNESS_VALUE, SETTINGS_ROW4_Y),
+    stepUp(WID_BRIGHTNESS_UP, SETTINGS_ROW4_Y),
+    label(SETTINGS_ROW5_Y, "Invert Colors:"),
+    controlButton(WID_INVERT, SETTINGS_ROW5_Y),
+    backButton()
+  };
+
+  Widget audioSettingsWidgets[] = {
+    label(SETTINGS_ROW1_Y, "Volume:"),
+    stepDown(WID_VOLUME_DOWN, SETTINGS_ROW1_Y),
+    stepValue(WID_VOLUME_VALUE, SETTINGS_ROW1_Y),
+    stepUp(WID_VOLUME_UP, SETTINGS_ROW1_Y),
+    label(SETTINGS_ROW2_Y, "Tone Freq:"),
+    stepDown(WID_TONE_FREQ_DOWN, SETTINGS_ROW2_Y),
+    stepValue(WID_TONE_FREQ_VALUE, SETTINGS_ROW2_Y),
+    stepUp(WID_TONE_FREQ_UP, SETTINGS_ROW2_Y),
+    label(SETTINGS_ROW3_Y, "Tone Duration:"),
+    stepDown(WID_TONE_DURATION_DOWN, SETTINGS_ROW3_Y),
+    stepValue(WID_TONE_DURATION_VALUE, SETTINGS_ROW3_Y),
+    stepUp(WID_TONE_DURATION_UP, SETTINGS_ROW3_Y),
+    backButton()
+  };
+
+  Widget sleepSettingsWidgets[] = {
+    label(SETTINGS_ROW1_Y, "Inactivity:"),
+    stepDown(WID_INACTIVITY_DOWN, SETTINGS_ROW1_Y),
+    stepValue(WID_INACTIVITY_VALUE, SETTINGS_ROW1_Y),
+    stepUp(WID_INACTIVITY_UP, SETTINGS_ROW1_Y),
+    label(SETTINGS_ROW2_Y, "Schedule:"),
+    controlButton(WID_SCHEDULE, SETTINGS_ROW2_Y),
+    label(SETTINGS_ROW3_Y, "Sleep at:", WID_SLEEP_HOUR_LABEL),
+    stepDown(WID_SLEEP_HOUR_DOWN, SETTINGS_ROW3_Y),
+    stepValue(WID_SLEEP_HOUR_VALUE, SETTINGS_ROW3_Y),
+    stepUp(WID_SLEEP_HOUR_UP, SETTINGS_ROW3_Y),
+    label(SETTINGS_ROW4_Y, "Wake at:", WID_WAKE_HOUR_LABEL),
+    stepDown(WID_WAKE_HOUR_DOWN, SETTINGS_ROW4_Y),
+    stepValue(WID_WAKE_HOUR_VALUE, SETTINGS_ROW4_Y),
+    stepUp(WID_WAKE_HOUR_UP, SETTINGS_ROW4_Y),
+    backButton()
+  };
+
+  Widget systemSettingsWidgets[] = {
+    menuButton(WID_DEVICE_INFO, SETTINGS_ROW1_Y, SETTINGS_CONTROL_H, COLOR_DARK_BLUE, "Device Info"),
+    menuButton(WID_CALIBRATE, SETTINGS_ROW2_Y, SETTINGS_CONTROL_H, COLOR_DARK_BLUE, "Calibrate Touch"),
+    makeWidget(WID_REMEMBER_SCREEN, WIDGET_ON_OFF, ANCHOR_LEFT | ANCHOR_TOP, SETTINGS_MENU_BTN_X_MARGIN, SETTINGS_ROW3_Y,
+               -SETTINGS_MENU_BTN_X_MARGIN, SETTINGS_CONTROL_H, COLOR_DARK_BLUE, "Remember Screen:"),
+    menuButton(WID_UPDATES, SETTINGS_ROW4_Y, SETTINGS_CONTROL_H, COLOR_DARK_BLUE, "Updates & License"),
+    menuButton(WID_WIFI_RESET, SETTINGS_ROW5_Y, SETTINGS_CONTROL_H, TFT_MAROON, "Reset Wi-Fi Settings"),
+    backButton()
+  };
+
+  // Any touch outside the toggle leaves this screen, so it has no Back button
+  Widget updatesWidgets[] = {
+    makeWidget(WID_CHECK_UPDATES, WIDGET_ON_OFF, ANCHOR_LEFT | ANCHOR_BOTTOM, SETTINGS_MENU_BTN_X_MARGIN, SETTINGS_CONTROL_H + SETTINGS_V_GAP,
+               -SETTINGS_MENU_BTN_X_MARGIN, SETTINGS_CONTROL_H, COLOR_DARK_BLUE, "Check for Updates:")
+  };
+
+  Widget gracePeriodWidgets[] = {
+    makeWidget(WID_CANCEL_SLEEP, WIDGET_BUTTON, ANCHOR_HCENTER | ANCHOR_BOTTOM, -GRACE_PERIOD_BTN_W / 2, GRACE_PERIOD_BTN_H + GRACE_PERIOD_BTN_Y_MARGIN,
+               GRACE_PERIOD_BTN_W, GRACE_PERIOD_BTN_H, COLOR_DARK_GREEN, "Cancel Sleep")
+  };
+
+  const int WIFI_RESET_PAIR_X = -(CALIBRATION_BTN_W * 2 + CALIBRATION_BTN_GAP) / 2;
+  Widget wifiResetWidgets[] = {
+    makeWidget(WID_WIFI_RESET_CANCEL, WIDGET_BUTTON, ANCHOR_HCENTER | ANCHOR_BOTTOM, WIFI_RESET_PAIR_X, CALIBRATION_BTN_H + CALIBRATION_BTN_Y_MARGIN,
+               CALIBRATION_BTN_W, CALIBRATION_BTN_H, COLOR_DARK_GREEN, "Cancel"),
+    makeWidget(WID_WIFI_RESET_CONFIRM, WIDGET_BUTTON, ANCHOR_HCENTER | ANCHOR_BOTTOM, WIFI_RESET_PAIR_X + CALIBRATION_BTN_W + CALIBRATION_BTN_GAP,
+               CALIBRATION_BTN_H + CALIBRATION_BTN_Y_MARGIN, CALIBRATION_BTN_W, CALIBRATION_BTN_H, TFT_MAROON, "Confirm Reset")
+  };
+
+  struct ScreenWidgets {
+    ActiveScreen screen;
+    Widget* widgets;
+    int count;
+  };
+
+  #define SCREEN_WIDGETS(screen, widgets) { screen, widgets, sizeof(widgets) / sizeof(widgets[0]) }
+  const ScreenWidgets SCREENS[] = {
+    SCREEN_WIDGETS(SCREEN_SPOTS, mainBarWidgets),
+    SCREEN_WIDGETS(SCREEN_SPOTS_AND_PROP, mainBarWidgets),
+    SCREEN_WIDGETS(SCREEN_SETTINGS_MENU, settingsMenuWidgets),
+    SCREEN_WIDGETS(SCREEN_DISPLAY_SETTINGS, displaySettingsWidgets),
+    SCREEN_WIDGETS(SCREEN_AUDIO_SETTINGS, audioSettingsWidgets),
+    SCREEN_WIDGETS(SCREEN_SLEEP_SETTINGS, sleepSettingsWidgets),
+    SCREEN_WIDGETS(SCREEN_SYSTEM_SETTINGS, systemSettingsWidgets),
+    SCREEN_WIDGETS(SCREEN_UPDATES_INFO, updatesWidgets),
+    SCREEN_WIDGETS(SCREEN_SLEEP_GRACE_PERIOD, gracePeriodWidgets),
+    SCREEN_WIDGETS(SCREEN_WIFI_RESET_CONFIRM, wifiResetWidgets)
+  };
+  #undef SCREEN_WIDGETS
+  const int SCREEN_COUNT = sizeof(SCREENS) / sizeof(SCREENS[0]);
+
+  ScreenLayout screenLayout;
+
+  const ScreenWidgets* findScreen(ActiveScreen screen) {
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+      if (SCREENS[i].screen == screen) return &SCREENS[i];
+    }
+    return nullptr;
+  }
+
+  Widget* findWidget(WidgetId id) {
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+      for (int j = 0; j < SCREENS[i].count; j++) {
+        if (SCREENS[i].widgets[j].id == id) return &SCREENS[i].widgets[j];
+      }
+    }
+    return nullptr;
+  }
+
+  // Bit i of a cell is set when the screen's widget i overlaps the cell and
+  // can take a touch.
+  uint32_t hitGrid[SCREEN_COUNT][WIDGET_GRID_COLS * WIDGET_GRID_ROWS];
+
+  Widget* pressedWidget = nullptr;
+  ActiveScreen pressedScreen;
+
+  int gridColumn(int x) {
+    return constrain(x * WIDGET_GRID_COLS / screenLayout.width, 0, WIDGET_GRID_COLS - 1);
+  }
+
+  int gridRow(int y) {
+    return constrain(y * WIDGET_GRID_ROWS / screenLayout.height, 0, WIDGET_GRID_ROWS - 1);
+  }
+
+  bool takesTouch(const Widget& widget) {
+    return widget.kind != WIDGET_LABEL && widget.kind != WIDGET_VALUE;
+  }
+
+  void buildHitGrid(int screenIndex) {
+    uint32_t* cells = hitGrid[screenIndex];
+    memset(cells, 0, sizeof(hitGrid[screenIndex]));
+    const ScreenWidgets& list = SCREENS[screenIndex];
+    for (int i = 0; i < list.count; i++) {
+      const Widget& widget = list.widgets[i];
+      if (!takesTouch(widget)) continue;
+      if (i >= 32) {
+        Serial.printf("Widget %d on screen %d is past the hit grid's 32 widgets.\n", i, list.screen);
+        continue;
+      }
+      // isButtonTouched() includes the right and bottom edges
+      for (int row = gridRow(widget.y); row <= gridRow(widget.y + widget.h); row++) {
+        for (int col = gridColumn(widget.x); col <= gridColumn(widget.x + widget.w); col++) {
+          cells[row * WIDGET_GRID_COLS + col] |= 1UL << i;
+        }
+      }
+    }
+  }
+
+  Widget* findTouchedWidget(ActiveScreen screen, uint16_t x, uint16_t y) {
+    const ScreenWidgets* list = findScreen(screen);
+    if (!list) return nullptr;
+
+    uint32_t candidates = hitGrid[list - SCREENS][gridRow(y) * WIDGET_GRID_COLS + gridColumn(x)];
+    while (candidates) {
+      const int i = __builtin_ctz(candidates); // Lowest first: declaration order decides overlaps
+      candidates &= candidates - 1;
+      Widget& widget = list->widgets[i];
+      if (!widget.hidden && isButtonTouched(x, y, widget.x, widget.y, widget.w, widget.h)) return &widget;
+    }
+    return nullptr;
+  }
+
+  void resolveWidget(Widget& widget, int screenWidth, int screenHeight) {
+    if (widget.anchor & ANCHOR_RIGHT) {
+      widget.x = screenWidth - widget.specX;
+    } else if (widget.anchor & ANCHOR_HCENTER) {
+      widget.x = screenWidth / 2 + widget.specX;
+    } else {
+      widget.x = widget.specX;
+    }
+    widget.y = (widget.anchor & ANCHOR_BOTTOM) ? screenHeight - widget.specY : widget.specY;
+    widget.w = (widget.specW > 0) ? widget.specW : screenWidth + widget.specW - widget.x;
+    widget.h = widget.specH;
+  }
+
+  void drawWidget(const Widget& widget) {
+    const int centerX = widget.x + widget.w / 2;
+    const int centerY = widget.y + widget.h / 2;
+
+    switch (widget.kind) {
+      case WIDGET_BUTTON:
+        tft.fillRoundRect(widget.x, widget.y, widget.w, widget.h, BUTTON_CORNER_RADIUS, widget.color);
+        tft.setFreeFont(&FreeSans9pt7b);
+        tft.setTextDatum(MC_DATUM);
+        tft.setTextColor(TFT_WHITE);
+        tft.drawString(widget.text, centerX, centerY);
+        break;
+      case WIDGET_MENU_BUTTON:
+        tft.fillRoundRect(widget.x, widget.y, widget.w, widget.h, BUTTON_CORNER_RADIUS, widget.color);
+        tft.setFreeFont(&FreeSansBold9pt7b);
+        tft.setTextColor(TFT_WHITE);
+        tft.setTextDatum(MC_DATUM);
+        tft.drawString(">", widget.x + widget.w - SETTINGS_MENU_ARROW_X_MARGIN, centerY);
+        tft.setTextDatum(ML_DATUM);
+        tft.drawString(widget.text, widget.x + SETTINGS_MENU_LABEL_X_MARGIN, centerY);
+        break;
+      case WIDGET_ON_OFF:
+        tft.fillRoundRect(widget.x, widget.y, widget.w, widget.h, BUTTON_CORNER_RADIUS, widget.color);
+        tft.setFreeFont(&FreeSansBold9pt7b);
+        tft.setTextDatum(MC_DATUM);
+        tft.setTextColor(widget.on ? TFT_GREEN : TFT_RED);
+        tft.drawString(widget.on ? "ON" : "OFF", widget.x + widget.w - SETTINGS_MENU_STATUS_X_MARGIN, centerY);
+        tft.setTextDatum(ML_DATUM);
+        tft.setTextColor(TFT_WHITE);
+        tft.drawString(widget.text, widget.x + SETTINGS_MENU_LABEL_X_MARGIN, centerY);
+        break;
+      case WIDGET_STEP:
+        tft.fillRoundRect(widget.x, widget.y, widget.w, widget.h, BUTTON_CORNER_RADIUS, widget.color);
+        tft.setFreeFont(&FreeSansBold12pt7b);
+        tft.setTextDatum(CC_DATUM);
+        tft.setTextColor(TFT_WHITE);
+        tft.drawString(widget.text, centerX, centerY);
+        break;
+      case WIDGET_LABEL:
+        tft.setFreeFont(&FreeSans9pt7b);
+        tft.setTextDatum(CL_DATUM);
+        tft.setTextColor(TFT_WHITE);
+        tft.drawString(widget.text, widget.x, centerY);
+        break;
+      case WIDGET_VALUE:
+        tft.setFreeFont(&FreeSans9pt7b);
+        tft.setTextDatum(CC_DATUM);
+        tft.setTextColor(TFT_WHITE);
+        tft.drawString(widget.text, centerX, centerY);
+        break;
+    }
+
+    if (widget.pressed) {
+      tft.drawRoundRect(widget.x, widget.y, widget.w, widget.h, BUTTON_CORNER_RADIUS, COLOR_WIDGET_PRESSED);
+      tft.drawRoundRect(widget.x + 1, widget.y + 1, widget.w - 2, widget.h - 2, BUTTON_CORNER_RADIUS - 1, COLOR_WIDGET_PRESSED);
+    }
+  }
+}
+
+// Resolves every widget rectangle for the frame's current size. Must run
+// after setupFrameBuffer(), and again if the rotation ever changes.
+void layoutWidgets() {
+  const int screenWidth = tft.width();
+  const int screenHeight = tft.height();
+  for (int i = 0; i < SCREEN_COUNT; i++) {
+    for (int j = 0; j < SCREENS[i].count; j++) {
+      resolveWidget(SCREENS[i].widgets[j], screenWidth, screenHeight);
+    }
+  }
+
+  // The spot list and propagation footer are laid out against the button bar
+  screenLayout.width = screenWidth;
+  screenLayout.height = screenHeight;
+  screenLayout.buttonY = findWidget(WID_SETUP)->y;
+  screenLayout.propFooterY = screenLayout.buttonY - 40;
+
+  for (int i = 0; i < SCREEN_COUNT; i++) buildHitGrid(i);
+}
+
+const ScreenLayout& getScreenLayout() {
+  return screenLayout;
+}
+
+// --- Properties ---
+
+void setWidgetText(WidgetId id, const char* text) {
+  Widget* widget = findWidget(id);
+  if (!widget || strncmp(widget->text, text, sizeof(widget->text) - 1) == 0) return;
+  strlcpy(widget->text, text, sizeof(widget->text));
+  widget->dirty = true;
+}
+
+void setWidgetColor(WidgetId id, uint16_t color) {
+  Widget* widget = findWidget(id);
+  if (!widget || widget->color == color) return;
+  widget->color = color;
+  widget->dirty = true;
+}
+
+void setWidgetOn(WidgetId id, bool on) {
+  Widget* widget = findWidget(id);
+  if (!widget || widget->on == on) return;
+  widget->on = on;
+  widget->dirty = true;
+}
+
+void setWidgetHidden(WidgetId id, bool hidden) {
+  Widget* widget = findWidget(id);
+  if (!widget || widget->hidden == hidden) return;
+  widget->hidden = hidden;
+  widget->dirty = true;
+}
+
+// --- Drawing and Touch ---
+
+// With fullRedraw the screen has just been cleared and every visible widget
+// is drawn; otherwise only dirty widgets are cleared and drawn again.
+void drawWidgets(ActiveScreen screen, bool fullRedraw) {
+  const ScreenWidgets* list = findScreen(screen);
+  if (!list) return;
+
+  for (int i = 0; i < list->count; i++) {
+    Widget& widget = list->widgets[i];
+    if (!fullRedraw && !widget.dirty) continue;
+    if (!fullRedraw) tft.fillRect(widget.x, widget.y, widget.w, widget.h, TFT_BLACK);
+    if (!widget.hidden) drawWidget(widget);
+    widget.dirty = false;
+  }
+}
+
+// Returns the touched control on the screen, or WID_NONE. Labels, values and
+// hidden widgets never take a touch.
+WidgetId hitTestWidgets(ActiveScreen screen, uint16_t x, uint16_t y) {
+  const Widget* widget = findTouchedWidget(screen, x, y);
+  return widget ? widget->id : WID_NONE;
+}
+
+// Hit-tests a new press and draws the control under it highlighted until
+// releasePressedWidget(). Returns the control, or WID_NONE.
+WidgetId pressWidget(ActiveScreen screen, uint16_t x, uint16_t y) {
+  releasePressedWidget(screen);
+  Widget* widget = findTouchedWidget(screen, x, y);
+  if (!widget) return WID_NONE;
+
+  widget->pressed = true;
+  widget->dirty = true;
+  pressedWidget = widget;
+  pressedScreen = screen;
+  drawWidgets(screen, false);
+  return widget->id;
+}
+
+// Draws the pressed control normally again, if its screen is still the one
+// shown. Call before acting on the release, which may change the screen.
+void releasePressedWidget(ActiveScreen activeScreen) {
+  if (!pressedWidget) return;
+  pressedWidget->pressed = false;
+  pressedWidget->dirty = true;
+  if (pressedScreen == activeScreen) drawWidgets(activeScreen, false);
+  pressedWidget = nullptr;
+}
+
+// True when the control being pressed repeats while held: the "-" and "+"
+// of a stepper.
+bool pressedWidgetRepeats() {
+  return pressedWidget && pressedWidget->kind == WIDGET_STEP;
+}
@@ -0,0 +1,31 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#include "declarations.h"
+#include "world_map.h"
+
+// Decodes one row of the land mask, scaled to a width x height map, into one
+// byte per pixel (1 = land). Rows are encoded independently, so a screen can
+// be drawn top to bottom without holding the whole map in RAM.
+void decodeWorldMapRow(int y, int width, int height, uint8_t* land) {
+  int sourceRow = y * WORLD_MAP_HEIGHT / height;
+  const uint8_t* run = WORLD_MAP_RLE + WORLD_MAP_ROW_OFFSETS[sourceRow];
+  const uint8_t* end = WORLD_MAP_RLE + WORLD_MAP_ROW_OFFSETS[sourceRow + 1];
+
+  int sourceX = 0;
+  int x = 0;
+  uint8_t value = 0; // Every row starts with a sea run
+  for (; run < end; run++) {
+    sourceX += *run;
+    int runEnd = sourceX * width / WORLD_MAP_WIDTH;
+    while (x < runEnd && x < width) land[x++] = value;
+    value ^= 1;
+  }
+  while (x < width) land[x++] = 0;
+}
@@ -0,0 +1,113 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Generated by tools/make_world_map.py - do not edit by hand.
+// Equirectangular land mask, 320x160, run-length encoded per row
+// (alternating sea/land run lengths, starting with sea).
+
+#ifndef WORLD_MAP_H
+#define WORLD_MAP_H
+
+#define WORLD_MAP_WIDTH 320
+#define WORLD_MAP_HEIGHT 160
+
+const uint16_t WORLD_MAP_ROW_OFFSETS[WORLD_MAP_HEIGHT + 1] PROGMEM = {
+  0, 3, 6, 9, 12, 15, 18, 23, 28, 37, 44, 53,
+  62, 71, 80, 91, 104, 117, 130, 143, 157, 169, 183, 199,
+  214, 225, 238, 253, 268, 283, 300, 317, 334, 347, 362, 371,
+  378, 385, 392, 401, 410, 423, 438, 453, 468, 487, 504, 521,
+  536, 551, 560, 569, 578, 587, 596, 609, 622, 635, 646, 659,
+  670, 681, 698, 715, 732, 745, 760, 773, 786, 797, 812, 829,
+  844, 859, 870, 885, 898, 909, 920, 931, 942, 953, 966, 979,
+  992, 1003, 1012, 1021, 1032, 1039, 1044, 1053, 1064, 1075, 1086, 1097,
+  1108, 1117, 1126, 1135, 1144, 1153, 1162, 1171, 1178, 1185, 1192, 1199,
+  1206, 1215, 1224, 1235, 1242, 1249, 1256, 1263, 1268, 1275, 1282, 1289,
+  1294, 1299, 1302, 1305, 1308, 1311, 1314, 1317, 1320, 1323, 1326, 1329,
+  1332, 1335, 1338, 1341, 1344, 1347, 1350, 1353, 1358, 1363, 1368, 1373,
+  1378, 1383, 1388, 1393, 1398, 1403, 1407, 1411, 1415, 1419, 1423, 1427,
+  1431, 1435, 1439, 1443, 1447,
+};
+
+const uint8_t WORLD_MAP_RLE[1447] PROGMEM = {
+  255, 0, 65, 255, 0, 65, 255, 0, 65, 255, 0, 65, 255, 0, 65, 255, 0, 65, 87, 7,
+  23, 19, 184, 79, 25, 1, 37, 178, 76, 25, 1, 41, 32, 3, 69, 4, 69, 76, 67, 27,
+  12, 62, 9, 67, 76, 19, 1, 48, 26, 9, 70, 2, 69, 76, 15, 7, 46, 29, 3, 74,
+  4, 66, 74, 15, 16, 38, 69, 6, 28, 10, 64, 74, 15, 20, 33, 68, 5, 24, 19, 62,
+  53, 15, 6, 7, 29, 32, 66, 5, 19, 28, 60, 51, 20, 12, 10, 17, 31, 66, 3, 12,
+  3, 1, 43, 51, 49, 22, 10, 15, 15, 29, 66, 4, 11, 53, 5, 15, 26, 19, 10, 24,
+  18, 13, 15, 12, 29, 38, 9, 34, 78, 21, 16, 36, 5, 6, 24, 14, 11, 25, 38, 15,
+  23, 105, 2, 0, 3, 11, 49, 14, 10, 1, 14, 10, 20, 41, 20, 5, 122, 0, 7, 5,
+  76, 1, 15, 9, 16, 43, 24, 1, 123, 0, 9, 2, 72, 4, 1, 2, 14, 9, 13, 13,
+  8, 24, 149, 4, 3, 6, 69, 6, 1, 2, 13, 10, 10, 15, 8, 22, 9, 3, 139, 13,
+  68, 8, 1, 4, 9, 12, 9, 18, 2, 23, 10, 3, 139, 1, 13, 66, 12, 3, 22, 7,
+  43, 10, 3, 139, 2, 14, 63, 14, 7, 19, 5, 42, 12, 3, 120, 3, 12, 6, 16, 12,
+  6, 42, 15, 11, 19, 1, 43, 11, 8, 114, 3, 11, 8, 18, 7, 12, 39, 15, 12, 62,
+  4, 1, 6, 5, 105, 14, 6, 14, 19, 5, 15, 39, 13, 12, 52, 3, 12, 5, 6, 103,
+  15, 6, 15, 17, 4, 20, 40, 10, 13, 51, 3, 9, 2, 2, 4, 4, 104, 16, 5, 16,
+  15, 3, 24, 43, 5, 16, 49, 4, 9, 1, 3, 1, 6, 102, 18, 5, 16, 13, 1, 29,
+  44, 3, 17, 45, 3, 2, 2, 8, 3, 6, 105, 18, 4, 17, 44, 43, 2, 19, 43, 4,
+  2, 3, 5, 119, 15, 3, 18, 45, 42, 2, 21, 41, 4, 1, 5, 3, 121, 1, 1, 12,
+  1, 20, 46, 65, 45, 5, 2, 122, 1, 1, 33, 48, 64, 49, 124, 1, 2, 32, 51, 62,
+  46, 126, 1, 2, 32, 49, 64, 44, 127, 2, 2, 32, 50, 57, 51, 46, 3, 76, 3, 1,
+  33, 50, 56, 53, 28, 2, 13, 5, 75, 38, 50, 53, 56, 13, 1, 13, 8, 8, 3, 76,
+  4, 4, 31, 49, 49, 55, 12, 4, 3, 3, 10, 11, 6, 4, 74, 5, 4, 31, 49, 49,
+  54, 11, 7, 4, 3, 8, 12, 6, 4, 69, 8, 4, 32, 50, 46, 56, 10, 6, 1, 3,
+  3, 2, 26, 4, 68, 10, 1, 34, 50, 44, 58, 9, 6, 2, 5, 2, 1, 4, 2, 21,
+  3, 60, 2, 6, 9, 2, 34, 50, 43, 59, 8, 14, 1, 3, 3, 2, 21, 4, 57, 6,
+  3, 10, 2, 34, 51, 42, 59, 7, 12, 3, 5, 2, 3, 20, 4, 58, 5, 4, 8, 3,
+  34, 52, 41, 60, 4, 5, 7, 17, 4, 2, 76, 4, 3, 6, 4, 35, 52, 41, 61, 3,
+  2, 11, 20, 1, 1, 75, 5, 3, 3, 7, 35, 53, 38, 63, 15, 23, 75, 9, 6, 38,
+  55, 35, 63, 17, 21, 76, 8, 4, 41, 56, 33, 63, 21, 18, 77, 8, 2, 42, 57, 1,
+  1, 29, 63, 24, 2, 91, 52, 57, 2, 1, 21, 4, 3, 63, 117, 52, 58, 2, 1, 14,
+  11, 3, 61, 39, 2, 12, 2, 63, 52, 59, 1, 2, 12, 13, 2, 59, 42, 1, 12, 3,
+  61, 53, 60, 1, 1, 11, 14, 2, 59, 42, 2, 13, 5, 56, 54, 60, 1, 2, 10, 74,
+  44, 2, 13, 8, 52, 54, 65, 8, 74, 44, 2, 13, 2, 3, 9, 45, 2, 1, 52, 66,
+  7, 73, 46, 2, 19, 8, 43, 3, 1, 52, 66, 7, 12, 6, 54, 48, 1, 19, 9, 38,
+  60, 66, 8, 6, 2, 7, 4, 52, 48, 2, 17, 13, 13, 4, 14, 2, 1, 61, 67, 7,
+  5, 3, 13, 2, 48, 49, 2, 16, 13, 12, 6, 11, 4, 1, 61, 69, 6, 4, 3, 12,
+  5, 46, 49, 3, 14, 14, 10, 9, 10, 3, 1, 62, 71, 11, 63, 49, 3, 12, 16, 9,
+  10, 11, 12, 2, 51, 74, 7, 64, 50, 3, 9, 18, 7, 12, 2, 1, 9, 10, 3, 51,
+  77, 8, 60, 51, 2, 7, 21, 5, 16, 10, 10, 2, 51, 79, 6, 60, 52, 1, 5, 23,
+  5, 16, 10, 11, 2, 50, 82, 4, 59, 55, 27, 4, 16, 2, 1, 7, 63, 83, 3, 9,
+  2, 49, 52, 29, 4, 16, 1, 3, 6, 13, 2, 48, 84, 2, 7, 9, 45, 53, 1, 4,
+  22, 4, 16, 1, 4, 3, 14, 2, 49, 85, 2, 5, 14, 42, 57, 23, 3, 16, 2, 4,
+  1, 17, 1, 48, 87, 4, 1, 15, 42, 55, 25, 1, 1, 1, 16, 1, 21, 2, 48, 91,
+  17, 42, 53, 28, 2, 15, 2, 19, 3, 48, 91, 20, 40, 11, 1, 40, 28, 1, 16, 3,
+  12, 2, 6, 1, 48, 91, 22, 40, 3, 8, 38, 43, 2, 2, 3, 11, 3, 54, 91, 23,
+  54, 33, 45, 2, 1, 3, 9, 4, 55, 90, 25, 53, 32, 47, 2, 1, 2, 7, 6, 55,
+  89, 26, 53, 31, 49, 2, 2, 1, 4, 8, 55, 88, 28, 52, 30, 50, 3, 6, 8, 2,
+  2, 51, 89, 28, 51, 29, 52, 3, 5, 7, 2, 2, 52, 89, 30, 49, 29, 53, 3, 5,
+  6, 2, 2, 9, 6, 37, 89, 33, 47, 27, 54, 4, 5, 4, 3, 2, 9, 9, 34, 88,
+  38, 44, 25, 56, 3, 12, 1, 1, 1, 9, 10, 32, 88, 40, 42, 25, 57, 2, 12, 1,
+  14, 9, 30, 88, 41, 42, 24, 59, 1, 27, 9, 29, 89, 40, 42, 24, 59, 7, 22, 9,
+  28, 89, 40, 43, 23, 65, 2, 21, 4, 2, 4, 27, 90, 38, 44, 24, 94, 3, 27, 91,
+  37, 43, 25, 124, 91, 36, 44, 25, 81, 3, 6, 1, 33, 92, 34, 45, 25, 7, 1, 72,
+  5, 5, 1, 33, 93, 33, 45, 25, 6, 2, 71, 6, 5, 2, 32, 94, 32, 45, 25, 6,
+  3, 66, 10, 5, 3, 31, 95, 30, 46, 24, 4, 6, 65, 12, 4, 3, 31, 96, 29, 46,
+  22, 6, 5, 65, 15, 1, 5, 30, 98, 27, 46, 21, 7, 5, 64, 22, 30, 98, 26, 48,
+  19, 8, 5, 63, 24, 29, 97, 27, 48, 19, 8, 4, 61, 28, 28, 97, 27, 49, 18, 7,
+  5, 58, 32, 27, 97, 24, 52, 18, 8, 4, 58, 33, 26, 97, 22, 54, 18, 8, 3, 59,
+  34, 25, 97, 21, 55, 17, 10, 1, 60, 35, 24, 97, 20, 56, 16, 73, 34, 24, 97, 20,
+  57, 15, 73, 34, 24, 97, 19, 59, 14, 73, 34, 24, 97, 19, 59, 13, 74, 34, 24, 96,
+  19, 60, 12, 75, 33, 25, 96, 18, 62, 10, 76, 11, 5, 17, 25, 96, 17, 63, 8, 78,
+  8, 10, 14, 26, 96, 16, 65, 4, 81, 5, 13, 1, 2, 11, 26, 95, 16, 172, 11, 20,
+  1, 5, 95, 14, 174, 11, 21, 1, 4, 95, 14, 175, 9, 22, 3, 2, 95, 11, 182, 3,
+  24, 3, 2, 95, 9, 211, 2, 3, 95, 7, 187, 3, 21, 1, 6, 94, 9, 186, 3, 20,
+  3, 5, 94, 9, 187, 1, 20, 3, 6, 94, 8, 207, 3, 8, 94, 7, 207, 3, 9, 93,
+  7, 220, 93, 8, 219, 93, 7, 220, 93, 6, 221, 94, 5, 221, 94, 5, 221, 95, 5, 220,
+  96, 5, 219, 255, 0, 65, 255, 0, 65, 255, 0, 65, 255, 0, 65, 255, 0, 65, 255, 0,
+  65, 255, 0, 65, 255, 0, 65, 255, 0, 65, 255, 0, 65, 104, 1, 123, 44, 48, 102, 4,
+  100, 81, 33, 101, 5, 85, 106, 23, 98, 9, 51, 145, 17, 94, 15, 42, 157, 12, 90, 22,
+  33, 165, 10, 59, 55, 26, 172, 8, 46, 70, 21, 177, 6, 36, 82, 16, 182, 4, 25, 255,
+  0, 38, 2, 0, 255, 0, 65, 0, 255, 0, 65, 0, 255, 0, 65, 0, 255, 0, 65, 0,
+  255, 0, 65, 0, 255, 0, 65, 0, 255, 0, 65, 0, 255, 0, 65, 0, 255, 0, 65, 0,
+  255, 0, 65, 0, 255, 0, 65,
+};
+
+#endif // WORLD_MAP_H
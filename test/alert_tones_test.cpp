@@ -0,0 +1,264 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// The PCM the alert tones render: samples stay inside the DAC's range
+// around its bias, every tone rises and falls in RAMP_SAMPLES steps of
+// ENVELOPE_STEP, every step of a sequence lasts exactly its ms, and a
+// change of volume, muting included, ramps instead of jumping.
+//
+// The file-local synthesis state is inspected directly, so alert_tones.cpp
+// is built into this file. The audio task and the DAC are faked: the test
+// renders the samples itself, as the task would.
+
+#include "alert_tones.cpp"
+#include "test.h"
+#include <vector>
+
+// --- Fakes for the hardware the tone engine starts ---
+
+namespace {
+  int dacChannelsCreated = 0;
+  int audioTasksCreated = 0;
+  int audioTaskNotifications = 0;
+}
+
+esp_err_t dac_continuous_new_channels(const dac_continuous_config_t*, dac_continuous_handle_t* handle) {
+  dacChannelsCreated++;
+  *handle = (dac_continuous_handle_t)&dacChannelsCreated;
+  return ESP_OK;
+}
+
+esp_err_t dac_continuous_enable(dac_continuous_handle_t) { return ESP_OK; }
+esp_err_t dac_continuous_disable(dac_continuous_handle_t) { return ESP_OK; }
+esp_err_t dac_continuous_write(dac_continuous_handle_t, uint8_t*, size_t, size_t*, int) { return ESP_OK; }
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t, int, const char*, esp_pm_lock_handle_t* handle) {
+  *handle = nullptr;
+  return ESP_OK;
+}
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t) { return ESP_OK; }
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t) { return ESP_OK; }
+
+// The task is never run; the test calls renderSample() in its place.
+BaseType_t xTaskCreatePinnedToCore(void (*)(void*), const char*, uint32_t, void*, UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+  audioTasksCreated++;
+  *handle = (TaskHandle_t)&audioTasksCreated;
+  return pdPASS;
+}
+
+void xTaskNotifyGive(TaskHandle_t) { audioTaskNotifications++; }
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
+void vTaskDelay(TickType_t) {}
+
+// --- Tests ---
+
+namespace {
+  const uint32_t SAMPLES_PER_MS = AUDIO_SAMPLE_RATE_HZ / 1000;
+
+  // What renderSample() produced, sample by sample.
+  struct Rendered {
+    std::vector<uint8_t> samples;
+    std::vector<int32_t> envelopes;
+    std::vector<int32_t> gains;
+    std::vector<int> steps; // Index of the step playing, -1 on the sample that found the end
+  };
+
+  ApplicationState makeState(int volumePercent, CwCallsMode cwCalls) {
+    ApplicationState state;
+    state.audio.volumePercent = volumePercent;
+    state.audio.toneFrequency = 880;
+    state.audio.toneDurationMs = 100;
+    state.audio.cwCalls = cwCalls;
+    state.audio.cwWpm = 20;
+    strlcpy(state.audio.watchlist, "K1ABC", sizeof(state.audio.watchlist));
+    return state;
+  }
+
+  DxSpot makeSpot(const char* call, const char* mode) {
+    DxSpot spot = {};
+    strlcpy(spot.call, call, sizeof(spot.call));
+    strlcpy(spot.mode, mode, sizeof(spot.mode));
+    return spot;
+  }
+
+  // Renders until the alert has faded out, as the audio task does, with a
+  // limit in case it never does.
+  Rendered renderAlert() {
+    Rendered rendered;
+    const size_t limit = 60 * AUDIO_SAMPLE_RATE_HZ;
+    while (playing && rendered.samples.size() < limit) {
+      rendered.samples.push_back(renderSample());
+      rendered.envelopes.push_back(envelope);
+      rendered.gains.push_back(gain);
+      rendered.steps.push_back(playing ? nextStep - 1 : -1);
+    }
+    CHECK(!playing);
+    return rendered;
+  }
+
+  // The attack of a tone that starts at sample start, or the release of one
+  // that ends there.
+  void checkRamp(const Rendered& rendered, size_t start, bool attack) {
+    int32_t expected = attack ? 0 : FULL_SCALE;
+    for (int32_t i = 0; i < RAMP_SAMPLES; i++) {
+      expected = attack ? min(expected + ENVELOPE_STEP, FULL_SCALE) : max(expected - ENVELOPE_STEP, (int32_t)0);
+      CHECK_EQ(rendered.envelopes[start + i], expected);
+    }
+    CHECK_EQ(rendered.envelopes[start + RAMP_SAMPLES - 1], (attack ? FULL_SCALE : 0));
+    CHECK(start == 0 || rendered.envelopes[start - 1] == (attack ? 0 : FULL_SCALE));
+  }
+
+  void testSetup() {
+    ApplicationState state = makeState(100, CW_CALLS_OFF);
+    setupAudio(state);
+    setupAudio(state);
+    CHECK_EQ(dacChannelsCreated, 1);
+    CHECK_EQ(audioTasksCreated, 1);
+    CHECK_EQ(gain, FULL_SCALE);
+    CHECK_EQ(wavetable[64], 127);
+    CHECK_EQ(wavetable[192], -127);
+    CHECK(RAMP_SAMPLES * ENVELOPE_STEP >= FULL_SCALE);
+    CHECK((RAMP_SAMPLES - 1) * ENVELOPE_STEP < FULL_SCALE);
+  }
+
+  // A watchlist hit at full volume with the callsign in CW: the longest
+  // sequence and the widest swing.
+  void testWatchlistAlert() {
+    ApplicationState state = makeState(100, CW_CALLS_WATCHLIST);
+    setupAudio(state);
+    const int notifications = audioTaskNotifications;
+    playSpotAlert(state, makeSpot("K1ABC", "SSB"));
+    CHECK(playing);
+    CHECK_EQ(audioTaskNotifications, notifications + 1);
+    CHECK(stepCount > 3);
+
+    const Rendered rendered = renderAlert();
+    const ToneStep* sequence = steps;
+
+    // Every sample inside the DAC range, swinging both ways round the bias
+    uint8_t lowest = 255, highest = 0;
+    for (uint8_t sample : rendered.samples) {
+      lowest = min(lowest, sample);
+      highest = max(highest, sample);
+    }
+    CHECK(lowest >= 1);
+    CHECK(highest <= 255);
+    CHECK(AUDIO_BIAS - lowest >= 120);
+    CHECK(highest - AUDIO_BIAS >= 120);
+    CHECK_EQ(rendered.samples.back(), AUDIO_BIAS);
+
+    // Each step lasts its ms, and the steps follow each other with nothing
+    // between them
+    size_t start = 0;
+    for (int step = 0; step < stepCount; step++) {
+      size_t length = 0;
+      while (start + length < rendered.steps.size() && rendered.steps[start + length] == step) length++;
+      CHECK_EQ(length, sequence[step].ms * SAMPLES_PER_MS);
+
+      // Tones rise at their start; pauses let the tone before them fall
+      const bool tone = sequence[step].freqHz > 0;
+      const bool afterTone = step > 0 && sequence[step - 1].freqHz > 0;
+      if (tone && (step == 0 || !afterTone)) checkRamp(rendered, start, true);
+      if (!tone && afterTone) checkRamp(rendered, start, false);
+      start += length;
+    }
+    CHECK_EQ(start + 1, rendered.samples.size());
+  }
+
+  // Tones that follow each other directly glide in pitch without dipping.
+  void testDigitalAlert() {
+    ApplicationState state = makeState(50, CW_CALLS_OFF);
+    setupAudio(state);
+    playSpotAlert(state, makeSpot("DL1XYZ", "FT8"));
+    CHECK_EQ(stepCount, 3);
+
+    const Rendered rendered = renderAlert();
+    const size_t secondTone = steps[0].ms * SAMPLES_PER_MS;
+    checkRamp(rendered, 0, true);
+    CHECK_EQ(rendered.envelopes[secondTone], FULL_SCALE);
+    checkRamp(rendered, secondTone + steps[1].ms * SAMPLES_PER_MS, false);
+    for (uint8_t sample : rendered.samples) {
+      CHECK(sample >= 1);
+    }
+  }
+
+  // Checks that the gain ramps from its value before the first sample to
+  // target in RAMP_SAMPLES steps of ENVELOPE_STEP at most, then stays.
+  void checkGainRamp(const Rendered& rendered, int32_t before, int32_t target) {
+    CHECK(rendered.gains.size() > RAMP_SAMPLES);
+    int32_t previous = before;
+    for (size_t i = 0; i < rendered.gains.size(); i++) {
+      const int32_t moved = rendered.gains[i] - previous;
+      CHECK(abs(moved) <= ENVELOPE_STEP);
+      CHECK(target >= before ? moved >= 0 : moved <= 0);
+      if (i >= RAMP_SAMPLES - 1) CHECK_EQ(rendered.gains[i], target);
+      previous = rendered.gains[i];
+    }
+  }
+
+  // Muted settings queue nothing. Muting mid-alert fades the output to the
+  // bias instead of cutting it there.
+  void testMuted() {
+    ApplicationState state = makeState(0, CW_CALLS_ALL);
+    setupAudio(state);
+    const int notifications = audioTaskNotifications;
+    playSpotAlert(state, makeSpot("K1ABC", "CW"));
+    CHECK(!playing);
+    CHECK_EQ(audioTaskNotifications, notifications);
+
+    state.audio.volumePercent = 50;
+    setupAudio(state);
+    playSpotAlert(state, makeSpot("K1ABC", "CW"));
+    for (int i = 0; i < 1000; i++) renderSample();
+    CHECK(playing);
+    const int32_t before = gain;
+    CHECK(before > 0);
+
+    state.audio.volumePercent = 0;
+    setupAudio(state);
+    CHECK_EQ(gain, before);
+    const Rendered rendered = renderAlert();
+    checkGainRamp(rendered, before, 0);
+
+    // No sample steps further from the last than the ramps allow, and the
+    // output is the flat bias once the gain is down
+    for (size_t i = 1; i < rendered.samples.size(); i++) {
+      CHECK(abs(rendered.samples[i] - rendered.samples[i - 1]) <= 16);
+      if (i >= RAMP_SAMPLES - 1) CHECK_EQ(rendered.samples[i], AUDIO_BIAS);
+    }
+  }
+
+  // Turning the volume up mid-alert ramps the gain up while the alert fades.
+  void testVolumeChange() {
+    ApplicationState state = makeState(25, CW_CALLS_OFF);
+    setupAudio(state);
+    const int32_t quiet = gain;
+    playSpotAlert(state, makeSpot("DL1XYZ", "SSB"));
+    for (int i = 0; i < 1000; i++) renderSample();
+
+    state.audio.volumePercent = 100;
+    setupAudio(state);
+    CHECK_EQ(gain, quiet);
+    CHECK_EQ(gainTarget, FULL_SCALE);
+    checkGainRamp(renderAlert(), quiet, FULL_SCALE);
+
+    // The next alert starts at the new volume
+    playSpotAlert(state, makeSpot("DL1XYZ", "SSB"));
+    CHECK_EQ(gain, FULL_SCALE);
+    renderAlert();
+  }
+}
+
+int main() {
+  testSetup();
+  testWatchlistAlert();
+  testDigitalAlert();
+  testMuted();
+  testVolumeChange();
+  return testResult("alert_tones_test");
+}
@@ -0,0 +1,74 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Writes the synthetic fonts of the atlas as font headers laid out like
+// TFT_eSPI's Fonts/GFXFF ones, so the host build makes its glyph atlas with
+// tools/make_glyph_atlas.py just as the sketch's is made from the real fonts.
+// Usage: dump_fonts <directory>
+
+#include "TFT_eSPI.h"
+#include <stdio.h>
+
+namespace {
+  struct NamedFont {
+    const char* name;
+    const GFXfont* font;
+  };
+
+  const NamedFont FONTS[] = {
+    { "FreeSans9pt7b", &FreeSans9pt7b },
+    { "FreeSansBold9pt7b", &FreeSansBold9pt7b },
+    { "FreeSansBold12pt7b", &FreeSansBold12pt7b },
+  };
+
+  bool dumpFont(const char* directory, const NamedFont& entry) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.h", directory, entry.name);
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    const GFXfont* font = entry.font;
+    const int glyphCount = font->last - font->first + 1;
+    int bitmapBytes = 0;
+    for (int i = 0; i < glyphCount; i++) {
+      const GFXglyph& glyph = font->glyph[i];
+      bitmapBytes = max(bitmapBytes, glyph.bitmapOffset + (glyph.width * glyph.height + 7) / 8);
+    }
+
+    fprintf(file, "const uint8_t %sBitmaps[] PROGMEM = {\n", entry.name);
+    for (int i = 0; i < bitmapBytes; i++) {
+      const char* separator = i + 1 == bitmapBytes ? " };\n" : i % 12 == 11 ? ",\n" : ", ";
+      fprintf(file, "%s0x%02X%s", i % 12 == 0 ? "  " : "", font->bitmap[i], separator);
+    }
+    fprintf(file, "\nconst GFXglyph %sGlyphs[] PROGMEM = {\n", entry.name);
+    for (int i = 0; i < glyphCount; i++) {
+      const GFXglyph& glyph = font->glyph[i];
+      const int c = font->first + i;
+      fprintf(file, "  { %5d, %3d, %3d, %3d, %4d, %4d }%s // 0x%02X '%c'\n", glyph.bitmapOffset, glyph.width,
+              glyph.height, glyph.xAdvance, glyph.xOffset, glyph.yOffset, i + 1 < glyphCount ? ", " : " };", c, c);
+    }
+    fprintf(file, "\nconst GFXfont %s PROGMEM = {\n  (uint8_t  *)%sBitmaps,\n  (GFXglyph *)%sGlyphs,\n"
+                  "  0x%02X, 0x%02X, %d };\n", entry.name, entry.name, entry.name, font->first, font->last, font->yAdvance);
+    return fclose(file) == 0;
+  }
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <directory>\n", argv[0]);
+    return 2;
+  }
+  for (const NamedFont& entry : FONTS) {
+    if (!dumpFont(argv[1], entry)) {
+      fprintf(stderr, "Could not write %s to %s\n", entry.name, argv[1]);
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,345 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Draws every screen of the sketch on the host and compares what reaches
+// the panel with the reference images in golden/. Each screen is drawn from
+// a black frame, as runRenderBenchmark() does on the device, then flushed
+// to the panel. Also prints what each draw costs: host time, primitives and
+// pixels drawn into the frame, and what the flush pushed to the panel.
+//
+// The whole sketch is linked against the shims. Wall time is pinned by
+// wrapping time() and gettimeofday(), millis() is the shim's still clock,
+// and the fixture feeds spots through the sketch's own parser. Run with --update to rewrite the reference images after an
+// intended change to a screen, then review them before committing.
+
+#include "declarations.h"
+#include "test.h"
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+// Defined in ESP32_ham_combo.ino, which no header declares
+extern ApplicationState applicationState;
+
+// --- Pinned wall time ---
+
+namespace {
+  const time_t FIXTURE_TIME = 1750516200; // 2025-06-21 14:30:00 UTC
+}
+
+extern "C" time_t __wrap_time(time_t* out) {
+  if (out) *out = FIXTURE_TIME;
+  return FIXTURE_TIME;
+}
+
+extern "C" int __wrap_gettimeofday(struct timeval* tv, void*) {
+  tv->tv_sec = FIXTURE_TIME;
+  tv->tv_usec = 0;
+  return 0;
+}
+
+namespace {
+  const char* const GOLDEN_DIR = "golden";
+  const char* const OUTPUT_DIR = "build/render"; // Images of screens that differ
+  const int BENCHMARK_REPEATS = 20;
+
+  struct Screen {
+    const char* name;
+    const char* file;
+    ActiveScreen screen;
+    void (*draw)(ApplicationState& state);
+  };
+
+  // The screens of runRenderBenchmark()
+  const Screen SCREENS[] = {
+    { "Spots", "spots", SCREEN_SPOTS, [](ApplicationState& s) { drawSpotsScreen(s); } },
+    { "Spots + Prop", "spots_prop", SCREEN_SPOTS_AND_PROP, [](ApplicationState& s) { drawSpotsAndPropScreen(s); } },
+    { "Clock", "clock", SCREEN_CLOCK, [](ApplicationState& s) { s.lastSecond = -1; drawClockScreen(s); } },
+    { "Propagation", "propagation", SCREEN_PROPAGATION, [](ApplicationState& s) { drawPropagationScreen(s); } },
+    { "Grey Line", "grey_line", SCREEN_GREY_LINE, [](ApplicationState& s) { drawGreyLineScreen(s); } },
+    { "Band Map", "band_map", SCREEN_BAND_MAP, [](ApplicationState& s) { drawBandMapScreen(s); } },
+    { "Spot Map", "spot_map", SCREEN_SPOT_MAP, [](ApplicationState& s) { drawSpotMapScreen(s); } },
+    { "Settings Menu", "settings_menu", SCREEN_SETTINGS_MENU, [](ApplicationState& s) { drawSettingsMenuScreen(s); } },
+    { "Display Settings", "display_settings", SCREEN_DISPLAY_SETTINGS, [](ApplicationState& s) { drawDisplaySettingsScreen(s); } },
+    { "Audio Settings", "audio_settings", SCREEN_AUDIO_SETTINGS, [](ApplicationState& s) { drawAudioSettingsScreen(s); } },
+    { "Sleep Settings", "sleep_settings", SCREEN_SLEEP_SETTINGS, [](ApplicationState& s) { drawSleepSettingsScreen(s); } },
+    { "System Settings", "system_settings", SCREEN_SYSTEM_SETTINGS, [](ApplicationState& s) { drawSystemSettingsScreen(s); } },
+    { "Info", "info", SCREEN_INFO, [](ApplicationState& s) { drawInfoScreen(s); } },
+    { "Updates", "updates", SCREEN_UPDATES_INFO, [](ApplicationState& s) { drawUpdatesScreen(s); } },
+    { "Wi-Fi Reset", "wifi_reset", SCREEN_WIFI_RESET_CONFIRM, [](ApplicationState& s) { drawWifiResetConfirmScreen(s); } },
+    { "Grace Period", "grace_period", SCREEN_SLEEP_GRACE_PERIOD, [](ApplicationState& s) { drawGracePeriodScreen(s); } }
+  };
+
+  const char* const SPOT_LINES[] = {
+    "DX de DL1ABC:    14074.0  JA1XYZ       FT8 -12dB from PM95            1402Z",
+    "DX de G4XYZ:      7012.5  VK2ABC       CW 22 dB 25 WPM CQ             1410Z",
+    "DX de OH2BH:     21295.0  PY2XX        SSB 59 loud                    1415Z",
+    "DX de SP9KR:     28074.0  ZS6ABC       FT8 -08dB                      1421Z",
+    "DX de W1AW:      18100.0  VP8LP        FT4 -15dB                      1424Z",
+    "DX de EA8TX:     10136.0  K1ABC        FT8 -03dB                      1428Z"
+  };
+
+  // A quiet sun, bands open up to 15 m
+  void loadSolarReport(ApplicationState& state) {
+    SolarPropagationData& report = state.solarData;
+    report.solarFlux = 168;
+    report.aIndex = 8;
+    report.kIndex = 2;
+    report.sunspots = 142;
+    strlcpy(report.xray, "C1.4", sizeof(report.xray));
+    strlcpy(report.geomagneticField, "QUIET", sizeof(report.geomagneticField));
+    strlcpy(report.signalNoiseLevel, "S1-S2", sizeof(report.signalNoiseLevel));
+
+    // Day, then night: 80-40, 30-20, 17-15, 12-10
+    const PropagationCondition conditions[8] = { FAIR, GOOD, GOOD, FAIR, GOOD, GOOD, FAIR, POOR };
+    memcpy(report.propagation, conditions, sizeof(conditions));
+    strlcpy(report.vhf.aurora, "Band Closed", sizeof(report.vhf.aurora));
+    strlcpy(report.vhf.eSkipEurope2m, "Band Closed", sizeof(report.vhf.eSkipEurope2m));
+    strlcpy(report.vhf.eSkipEurope4m, "50MHz ES", sizeof(report.vhf.eSkipEurope4m));
+    strlcpy(report.vhf.eSkipEurope6m, "50MHz ES", sizeof(report.vhf.eSkipEurope6m));
+
+    state.propDataAvailable = true;
+    updateBandConditions(state);
+  }
+
+  // On top of the settings a device has with nothing saved: a station in
+  // Warsaw logged in to HamAlert for an hour, and a full spot list and
+  // solar report. The band map needs the display set up first.
+  void loadFixture(ApplicationState& state) {
+    configTzTime(state.network.timezone, NTP_SERVER);
+    setMicros(3600ULL * 1000000);
+    state.network.hamAlertConnected = true;
+
+    strlcpy(state.station.locator, "KO02MF", sizeof(state.station.locator));
+    state.station.locationValid = locatorToLatLon(state.station.locator, state.station.latitude, state.station.longitude);
+    updateSolarEphemeris(state);
+
+    loadSolarReport(state);
+    for (const char* line : SPOT_LINES) {
+      DxSpot spot;
+      CHECK(parseSpotLine(line, spot));
+      locateSpot(spot, state);
+      addSpot(spot, state);
+    }
+  }
+
+  // --- PNG, 8-bit RGB, unfiltered ---
+
+  void appendBigEndian(std::string& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) out += (char)(value >> shift);
+  }
+
+  void appendChunk(std::string& out, const char* type, const std::string& data) {
+    appendBigEndian(out, data.size());
+    const std::string body = type + data;
+    out += body;
+    appendBigEndian(out, crc32(0, (const Bytef*)body.data(), body.size()));
+  }
+
+  uint32_t readBigEndian(const std::string& in, size_t at) {
+    return ((uint8_t)in[at] << 24) | ((uint8_t)in[at + 1] << 16) | ((uint8_t)in[at + 2] << 8) | (uint8_t)in[at + 3];
+  }
+
+  const char PNG_SIGNATURE[] = "\x89PNG\r\n\x1a\n";
+
+  bool writePng(const std::string& path, int width, int height, const std::vector<uint8_t>& rgb) {
+    std::string raw;
+    for (int y = 0; y < height; y++) {
+      raw += '\0'; // Filter: none
+      raw.append((const char*)&rgb[y * width * 3], width * 3);
+    }
+    uLongf packedSize = compressBound(raw.size());
+    std::string packed(packedSize, '\0');
+    if (compress2((Bytef*)&packed[0], &packedSize, (const Bytef*)raw.data(), raw.size(), 9) != Z_OK) return false;
+    packed.resize(packedSize);
+
+    std::string header;
+    appendBigEndian(header, width);
+    appendBigEndian(header, height);
+    header += std::string("\x08\x02\x00\x00\x00", 5); // 8-bit RGB, not interlaced
+
+    std::string png(PNG_SIGNATURE, 8);
+    appendChunk(png, "IHDR", header);
+    appendChunk(png, "IDAT", packed);
+    appendChunk(png, "IEND", "");
+
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    const bool written = fwrite(png.data(), 1, png.size(), file) == png.size();
+    return fclose(file) == 0 && written;
+  }
+
+  // Reads only what writePng() writes
+  bool readPng(const std::string& path, int width, int height, std::vector<uint8_t>& rgb) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    std::string png;
+    char buffer[4096];
+    for (size_t n; (n = fread(buffer, 1, sizeof(buffer), file)) > 0;) png.append(buffer, n);
+    fclose(file);
+    if (png.compare(0, 8, std::string(PNG_SIGNATURE, 8)) != 0) return false;
+
+    std::string packed;
+    for (size_t at = 8; at + 8 <= png.size();) {
+      const uint32_t length = readBigEndian(png, at);
+      const std::string type = png.substr(at + 4, 4);
+      if (at + 12 + length > png.size()) return false;
+      if (type == "IHDR") {
+        if (readBigEndian(png, at + 8) != (uint32_t)width || readBigEndian(png, at + 12) != (uint32_t)height) return false;
+        if (png.compare(at + 16, 5, std::string("\x08\x02\x00\x00\x00", 5)) != 0) return false;
+      }
+      if (type == "IDAT") packed += png.substr(at + 8, length);
+      at += 12 + length;
+    }
+
+    std::string raw((width * 3 + 1) * height, '\0');
+    uLongf rawSize = raw.size();
+    if (uncompress((Bytef*)&raw[0], &rawSize, (const Bytef*)packed.data(), packed.size()) != Z_OK) return false;
+    if (rawSize != raw.size()) return false;
+
+    rgb.resize(width * height * 3);
+    for (int y = 0; y < height; y++) {
+      const char* row = &raw[y * (width * 3 + 1)];
+      if (row[0] != 0) return false;
+      memcpy(&rgb[y * width * 3], row + 1, width * 3);
+    }
+    return true;
+  }
+
+  std::vector<uint8_t> panelToRgb() {
+    const uint16_t* pixels = panel.getFramebuffer();
+    const int count = panel.width() * panel.height();
+    std::vector<uint8_t> rgb(count * 3);
+    for (int i = 0; i < count; i++) {
+      const uint16_t color = pixels[i];
+      rgb[i * 3] = ((color >> 11) & 0x1F) * 255 / 31;
+      rgb[i * 3 + 1] = ((color >> 5) & 0x3F) * 255 / 63;
+      rgb[i * 3 + 2] = (color & 0x1F) * 255 / 31;
+    }
+    return rgb;
+  }
+
+  // Differing pixels in red over a dimmed copy of the reference
+  std::vector<uint8_t> diffImage(const std::vector<uint8_t>& actual, const std::vector<uint8_t>& expected, int& differing) {
+    std::vector<uint8_t> diff(actual.size());
+    differing = 0;
+    for (size_t i = 0; i < actual.size(); i += 3) {
+      const bool same = memcmp(&actual[i], &expected[i], 3) == 0;
+      if (!same) differing++;
+      diff[i] = same ? expected[i] / 4 : 255;
+      diff[i + 1] = same ? expected[i + 1] / 4 : 0;
+      diff[i + 2] = same ? expected[i + 2] / 4 : 0;
+    }
+    return diff;
+  }
+
+  // --- Rendering ---
+
+  double elapsedMicros(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  void clearScreen() {
+    tft.fillScreen(TFT_BLACK);
+    flushFrame();
+  }
+
+  // Draws the screen from a black frame and returns the draw time in us
+  double drawScreen(ApplicationState& state, const Screen& entry) {
+    clearScreen();
+    state.activeScreen = entry.screen;
+    const auto start = std::chrono::steady_clock::now();
+    entry.draw(state);
+    return elapsedMicros(start);
+  }
+
+  void checkScreen(ApplicationState& state, const Screen& entry, bool update) {
+    drawScreen(state, entry);
+    flushFrame();
+
+    const int width = panel.width(), height = panel.height();
+    const std::vector<uint8_t> actual = panelToRgb();
+    const std::string golden = std::string(GOLDEN_DIR) + "/" + entry.file + ".png";
+    if (update) {
+      CHECK(writePng(golden, width, height, actual));
+      return;
+    }
+
+    std::vector<uint8_t> expected;
+    if (!readPng(golden, width, height, expected)) {
+      checksRun++;
+      checksFailed++;
+      printf("%s: cannot read %s, run with --update to create it\n", entry.name, golden.c_str());
+      return;
+    }
+
+    int differing = 0;
+    const std::vector<uint8_t> diff = diffImage(actual, expected, differing);
+    CHECK_EQ(differing, 0);
+    if (differing == 0) return;
+
+    const std::string base = std::string(OUTPUT_DIR) + "/" + entry.file;
+    writePng(base + ".png", width, height, actual);
+    writePng(base + "_diff.png", width, height, diff);
+    printf("%s: %d pixels differ from %s, see %s.png and %s_diff.png\n", entry.name, differing, golden.c_str(),
+           base.c_str(), base.c_str());
+  }
+
+  // Mean host time over BENCHMARK_REPEATS draws, then the frame and panel
+  // counts of one more draw and its flush. Host times only compare screens
+  // with each other; they say nothing absolute about the ESP32.
+  void benchmarkScreen(ApplicationState& state, const Screen& entry) {
+    double drawMicros = 0;
+    for (int i = 0; i < BENCHMARK_REPEATS; i++) {
+      drawMicros += drawScreen(state, entry);
+      flushFrame();
+    }
+    drawMicros /= BENCHMARK_REPEATS;
+
+    clearScreen();
+    panel.resetShimStats();
+    state.activeScreen = entry.screen;
+    entry.draw(state);
+    const TftShimStats drawnToPanel = panel.getShimStats();
+    const auto start = std::chrono::steady_clock::now();
+    flushFrame();
+    const double flushMicros = elapsedMicros(start);
+    const FrameStats& frame = getFrameStats();
+
+    printf("%-16s %8.1f %7lu %7lu %6u %6lu %7lu %8lu %9.1f\n", entry.name, drawMicros,
+           (unsigned long)frame.drawCalls, (unsigned long)frame.pixelsWritten, frame.tilesPushed,
+           (unsigned long)frame.bytesPushed, (unsigned long)drawnToPanel.drawCalls,
+           (unsigned long)drawnToPanel.pixelsWritten, flushMicros);
+  }
+}
+
+int main(int argc, char** argv) {
+  const bool update = argc > 1 && strcmp(argv[1], "--update") == 0;
+  std::filesystem::remove_all(OUTPUT_DIR);
+  std::filesystem::create_directories(OUTPUT_DIR);
+
+  // As setup() starts the display
+  ApplicationState& state = applicationState;
+  loadSettings(state);
+  panel.init();
+  panel.setRotation(state.display.screenRotation);
+  CHECK(setupFrameBuffer());
+  layoutWidgets();
+  checkGlyphAtlases();
+  loadFixture(state);
+
+  for (const Screen& entry : SCREENS) checkScreen(state, entry, update);
+
+  printf("Screen            draw us   draws  pixels  tiles  bytes  direct  direct px  flush us\n");
+  for (const Screen& entry : SCREENS) benchmarkScreen(state, entry);
+
+  return testResult("render_test");
+}
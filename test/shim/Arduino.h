@@ -0,0 +1,225 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in for the Arduino-ESP32 core: just enough of its API for the
+// sketch sources to compile with g++ on a PC. The core is defined in
+// arduino_shim.cpp; the other headers here are defined, inertly, in
+// library_shim.cpp for tests that link the whole sketch.
+
+#ifndef SHIM_ARDUINO_H
+#define SHIM_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <string>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+#define ONLOW 4
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define constrain(a, l, h) ((a) < (l) ? (l) : ((a) > (h) ? (h) : (a)))
+using std::min;
+using std::max;
+
+size_t strlcpy(char* dst, const char* src, size_t size);
+size_t strlcat(char* dst, const char* src, size_t size);
+
+unsigned long millis();
+unsigned long micros();
+void setMicros(uint64_t us); // Host only: sets the clock millis() and micros() read
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+void analogWrite(int pin, int value);
+void attachInterrupt(int interrupt, void (*handler)(), int mode);
+void detachInterrupt(int interrupt);
+int digitalPinToInterrupt(int pin);
+
+class String {
+public:
+  String(const char* s = "");
+  String(int value);
+  String(unsigned int value);
+  String(long value);
+  String(unsigned long value);
+  String(float value, int decimals = 2);
+  String(double value, int decimals = 2);
+  const char* c_str() const;
+  unsigned int length() const;
+  String operator+(const String& other) const;
+  String& operator+=(const String& other);
+  String& operator+=(char c);
+  bool operator==(const String& other) const;
+  bool operator!=(const String& other) const;
+  char operator[](int index) const;
+  int indexOf(const char* s) const;
+  int indexOf(char c) const;
+  long toInt() const;
+  float toFloat() const;
+  void replace(const String& from, const String& to);
+  String substring(int from, int to = -1) const;
+  void trim();
+  bool startsWith(const String& prefix) const;
+  void toUpperCase();
+  void reserve(int size);
+private:
+  std::string text;
+};
+String operator+(const char* left, const String& right);
+
+class Print {
+public:
+  size_t print(const String& s);
+  size_t print(const char* s);
+  size_t print(int value);
+  size_t print(char c);
+  size_t println(const String& s);
+  size_t println(const char* s);
+  size_t println(int value);
+  size_t println();
+  size_t printf(const char* format, ...);
+  virtual size_t write(uint8_t c);
+  virtual size_t write(const uint8_t* buffer, size_t size);
+};
+
+class Stream : public Print {
+public:
+  virtual int available();
+  virtual int read();
+  virtual int peek();
+  String readStringUntil(char terminator);
+  size_t readBytes(char* buffer, size_t length);
+  size_t readBytes(uint8_t* buffer, size_t length);
+  void setTimeout(unsigned long ms);
+};
+
+class HardwareSerial : public Stream {
+public:
+  void begin(int baud);
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+  uint32_t getFreeHeap();
+  uint32_t getMinFreeHeap();
+  uint32_t getMaxAllocHeap();
+  const char* getChipModel();
+  uint32_t getCpuFreqMHz();
+  uint32_t getCycleCount();
+  void restart();
+};
+extern EspClass ESP;
+
+bool setCpuFrequencyMhz(uint32_t mhz);
+uint32_t getCpuFrequencyMhz();
+uint32_t getApbFrequency();
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+void configTzTime(const char* tz, const char* server1, const char* server2 = nullptr, const char* server3 = nullptr);
+
+// --- ESP-IDF ---
+typedef int esp_err_t;
+#define ESP_OK 0
+const char* esp_err_to_name(esp_err_t error);
+
+typedef int gpio_num_t;
+#define GPIO_NUM_36 36
+#define GPIO_INTR_LOW_LEVEL 4
+
+typedef enum {
+  ESP_SLEEP_WAKEUP_UNDEFINED,
+  ESP_SLEEP_WAKEUP_EXT0,
+  ESP_SLEEP_WAKEUP_TIMER,
+  ESP_SLEEP_WAKEUP_GPIO
+} esp_sleep_wakeup_cause_t;
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause();
+esp_err_t esp_sleep_enable_ext0_wakeup(int pin, int level);
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t us);
+esp_err_t esp_sleep_enable_gpio_wakeup();
+esp_err_t esp_sleep_enable_wifi_wakeup();
+esp_err_t esp_light_sleep_start();
+void esp_deep_sleep_start();
+esp_err_t gpio_wakeup_enable(int pin, int level);
+
+typedef void* esp_timer_handle_t;
+typedef void (*esp_timer_cb_t)(void* arg);
+typedef struct {
+  esp_timer_cb_t callback;
+  void* arg;
+  int dispatch_method;
+  const char* name;
+  bool skip_unhandled_events;
+} esp_timer_create_args_t;
+#define ESP_TIMER_TASK 0
+int64_t esp_timer_get_time();
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle);
+esp_err_t esp_timer_start_once(esp_timer_handle_t handle, uint64_t us);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t handle, uint64_t us);
+esp_err_t esp_timer_stop(esp_timer_handle_t handle);
+uint32_t xthal_get_ccount();
+
+// --- FreeRTOS ---
+typedef void* TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdMS_TO_TICKS(ms) (ms)
+#define portMAX_DELAY 0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+#define portYIELD_FROM_ISR(woken) (void)(woken)
+#define ARDUINO_RUNNING_CORE 1
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void*), const char* name, uint32_t stack, void* arg, UBaseType_t priority, TaskHandle_t* handle, BaseType_t core);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelete(TaskHandle_t handle);
+TickType_t xTaskGetTickCount();
+void xTaskNotifyGive(TaskHandle_t handle);
+void vTaskNotifyGiveFromISR(TaskHandle_t handle, BaseType_t* woken);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+inline void portENTER_CRITICAL(portMUX_TYPE*) {}
+inline void portEXIT_CRITICAL(portMUX_TYPE*) {}
+
+#endif
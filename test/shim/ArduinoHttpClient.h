@@ -0,0 +1,33 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_ARDUINOHTTPCLIENT_H
+#define SHIM_ARDUINOHTTPCLIENT_H
+
+#include "WiFiClient.h"
+
+class HttpClient {
+public:
+  HttpClient(Client& client, const char* host, uint16_t port);
+  int get(const char* path);
+  int responseStatusCode();
+  int skipResponseHeaders();
+  int contentLength();
+  String responseBody();
+  bool endOfBodyReached();
+  int available();
+  int read();
+  bool connected();
+  void connectionKeepAlive();
+  void stop();
+};
+
+#endif
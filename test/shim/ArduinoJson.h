@@ -0,0 +1,34 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_ARDUINOJSON_H
+#define SHIM_ARDUINOJSON_H
+
+#include "Arduino.h"
+
+struct JsonVariant {
+  operator const char*() const;
+  JsonVariant operator[](const char* key) const;
+};
+
+class JsonDocument {
+public:
+  JsonVariant operator[](const char* key);
+};
+
+struct DeserializationError {
+  operator bool() const;
+  const char* c_str() const;
+};
+
+DeserializationError deserializeJson(JsonDocument& doc, Stream& input);
+
+#endif
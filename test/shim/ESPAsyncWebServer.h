@@ -0,0 +1,50 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_ESPASYNCWEBSERVER_H
+#define SHIM_ESPASYNCWEBSERVER_H
+
+#include "Arduino.h"
+
+#define HTTP_GET 1
+#define HTTP_POST 2
+#define HTTP_ANY 255
+
+class AsyncWebParameter {
+public:
+  const String& value() const;
+};
+
+class AsyncWebServerResponse {
+public:
+  void addHeader(const char* name, const String& value);
+};
+
+class AsyncWebServerRequest {
+public:
+  int method();
+  bool hasParam(const char* name, bool post = false);
+  AsyncWebParameter* getParam(const char* name, bool post = false);
+  String arg(const char* name);
+  void send(int code, const char* type, const String& content);
+  void send(AsyncWebServerResponse* response);
+  AsyncWebServerResponse* beginResponse(const char* type, size_t length, std::function<size_t(uint8_t*, size_t, size_t)> filler);
+  AsyncWebServerResponse* beginChunkedResponse(const char* type, std::function<size_t(uint8_t*, size_t, size_t)> filler);
+};
+
+class AsyncWebServer {
+public:
+  AsyncWebServer(int port);
+  void on(const char* uri, int method, std::function<void(AsyncWebServerRequest*)> handler);
+  void begin();
+};
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_PREFERENCES_H
+#define SHIM_PREFERENCES_H
+
+#include "Arduino.h"
+
+class Preferences {
+public:
+  bool begin(const char* name, bool readOnly = false);
+  void end();
+  bool clear();
+  bool isKey(const char* key);
+  size_t putBool(const char* key, bool value);
+  bool getBool(const char* key, bool fallback = false);
+  size_t putUChar(const char* key, uint8_t value);
+  uint8_t getUChar(const char* key, uint8_t fallback = 0);
+  size_t putShort(const char* key, int16_t value);
+  int16_t getShort(const char* key, int16_t fallback = 0);
+  size_t putUShort(const char* key, uint16_t value);
+  uint16_t getUShort(const char* key, uint16_t fallback = 0);
+  size_t putInt(const char* key, int32_t value);
+  int32_t getInt(const char* key, int32_t fallback = 0);
+  size_t putLong(const char* key, int32_t value);
+  int32_t getLong(const char* key, int32_t fallback = 0);
+  size_t putULong(const char* key, uint32_t value);
+  uint32_t getULong(const char* key, uint32_t fallback = 0);
+  size_t putString(const char* key, const String& value);
+  String getString(const char* key, const String& fallback = String());
+  size_t putBytes(const char* key, const void* value, size_t length);
+  size_t getBytes(const char* key, void* buffer, size_t length);
+  size_t getBytesLength(const char* key);
+};
+
+#endif
@@ -0,0 +1,37 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_SPI_H
+#define SHIM_SPI_H
+
+#include "Arduino.h"
+
+#define VSPI 3
+#define HSPI 2
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+class SPISettings {
+public:
+  SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t mode = SPI_MODE0);
+};
+
+class SPIClass {
+public:
+  SPIClass(int bus = 0);
+  void begin(int sck = -1, int miso = -1, int mosi = -1, int ss = -1);
+  void beginTransaction(SPISettings settings);
+  void endTransaction();
+  uint8_t transfer(uint8_t data);
+  uint16_t transfer16(uint16_t data);
+};
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in for TFT_eSPI that rasterizes into memory. The panel keeps
+// an RGB565 framebuffer in its current rotation; sprites keep 4 bpp palette
+// indices (as the frame uses) or RGB565. Shapes and text are built from the
+// virtual primitives the way the library builds them, so FrameSprite's
+// overrides see the same calls as on the device.
+//
+// The fonts are synthetic: every character is a 5x8 base glyph scaled to
+// the font's size, with metrics close to the real ones. Layout matches the
+// device closely, the letter shapes do not. See fonts_shim.cpp.
+
+#ifndef SHIM_TFT_ESPI_H
+#define SHIM_TFT_ESPI_H
+
+#include "SPI.h"
+#include <vector>
+
+#define TFT_WIDTH 240
+#define TFT_HEIGHT 320
+#define SPI_FREQUENCY 80000000
+#define TFT_BL 21
+#define TOUCH_CS 33
+#define TOUCH_IRQ 36
+#define TFT_DISPOFF 0x28
+#define TFT_DISPON 0x29
+
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_DARKGREEN 0x03E0
+#define TFT_DARKCYAN 0x03EF
+#define TFT_MAROON 0x7800
+#define TFT_PURPLE 0x780F
+#define TFT_DARKGREY 0x7BEF
+#define TFT_LIGHTGREY 0xD69A
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_CYAN 0x07FF
+#define TFT_RED 0xF800
+#define TFT_MAGENTA 0xF81F
+#define TFT_ORANGE 0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_YELLOW 0xFFE0
+#define TFT_WHITE 0xFFFF
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define CL_DATUM 3
+#define MC_DATUM 4
+#define CC_DATUM 4
+#define MR_DATUM 5
+#define CR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+typedef struct {
+  uint16_t bitmapOffset;
+  uint8_t width;
+  uint8_t height;
+  uint8_t xAdvance;
+  int8_t xOffset;
+  int8_t yOffset;
+} GFXglyph;
+
+typedef struct {
+  uint8_t* bitmap;
+  GFXglyph* glyph;
+  uint16_t first;
+  uint16_t last;
+  uint8_t yAdvance;
+} GFXfont;
+
+extern const GFXfont FreeSans9pt7b;
+extern const GFXfont FreeSans12pt7b;
+extern const GFXfont FreeSansBold9pt7b;
+extern const GFXfont FreeSansBold12pt7b;
+extern const GFXfont FreeSansBold18pt7b;
+
+// Host only: what a display or sprite was asked to draw.
+struct TftShimStats {
+  uint32_t drawCalls = 0;     // Leaf primitives, pushImage included
+  uint64_t pixelsWritten = 0; // After clipping
+};
+
+class TFT_eSPI {
+public:
+  TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+  virtual ~TFT_eSPI() = default;
+  void init();
+  void setRotation(uint8_t rotation);
+  uint8_t getRotation();
+  virtual int16_t width();
+  virtual int16_t height();
+
+  void invertDisplay(bool invert);
+  void writecommand(uint8_t command);
+  void writedata(uint8_t data);
+  void startWrite();
+  void endWrite();
+  void setSwapBytes(bool swap);
+  bool getSwapBytes();
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data);
+
+  virtual void drawPixel(int32_t x, int32_t y, uint32_t color);
+  virtual void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+  virtual void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+  virtual void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+  virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void fillScreen(uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+  void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color);
+  void drawCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+  void fillCircle(int32_t x, int32_t y, int32_t r, uint32_t color);
+
+  virtual void drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size);
+  virtual int16_t drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font);
+  void setTextColor(uint16_t color);
+  void setTextColor(uint16_t color, uint16_t bg, bool bgFill = false);
+  void setTextDatum(uint8_t datum);
+  uint8_t getTextDatum();
+  void setTextFont(uint8_t font);
+  void setTextSize(uint8_t size);
+  void setFreeFont(const GFXfont* font);
+  void loadFont(const uint8_t* font);
+  int16_t drawString(const String& text, int32_t x, int32_t y);
+  int16_t drawString(const char* text, int32_t x, int32_t y);
+  int16_t drawString(const char* text, int32_t x, int32_t y, uint8_t font);
+  int16_t textWidth(const String& text);
+  int16_t textWidth(const char* text);
+  int16_t textWidth(const char* text, uint8_t font);
+  int16_t fontHeight();
+  int16_t fontHeight(int16_t font);
+
+  uint32_t textcolor, textbgcolor;
+  uint8_t textfont, textsize, textdatum;
+
+  // --- Host only ---
+  const uint16_t* getFramebuffer() const { return framebuffer.data(); }
+  bool isInverted() const { return inverted; }
+  const TftShimStats& getShimStats() const { return shimStats; }
+  void resetShimStats() { shimStats = TftShimStats(); }
+
+protected:
+  // Clips a rectangle to width() x height(). Returns false if nothing is left.
+  bool clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h);
+  void countPixels(int64_t pixels);
+  void drawCircleQuadrants(int32_t x, int32_t y, int32_t r, uint8_t quadrants, uint32_t color);
+  void fillCircleHalves(int32_t x, int32_t y, int32_t r, uint8_t halves, int32_t stretch, uint32_t color);
+
+  GFXfont* gfxFont;
+  uint8_t glyph_ab, glyph_bb; // Free font extent above and below the baseline
+  bool bgFill;
+  bool _swapBytes;
+  uint8_t rotation;
+  int16_t _init_width, _init_height;
+  int16_t _width, _height;
+
+private:
+  std::vector<uint16_t> framebuffer; // RGB565, _width x _height
+  bool inverted;
+  TftShimStats shimStats;
+};
+
+class TFT_eSprite : public TFT_eSPI {
+public:
+  explicit TFT_eSprite(TFT_eSPI* display);
+  void* setColorDepth(int8_t depth);
+  void* createSprite(int16_t w, int16_t h, uint8_t frames = 1);
+  void createPalette(const uint16_t* colors, uint8_t count = 16);
+  void* getPointer();
+
+  int16_t width() override;
+  int16_t height() override;
+  void drawPixel(int32_t x, int32_t y, uint32_t color) override;
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) override;
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) override;
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) override;
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) override;
+  void drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size) override;
+  int16_t drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) override;
+
+  // --- Host only ---
+  // RGB565 at (x, y), through the palette at 4 bpp.
+  uint16_t readPixelColor(int32_t x, int32_t y);
+
+private:
+  void writeRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+
+  TFT_eSPI* display;
+  int8_t colorDepth;
+  std::vector<uint8_t> pixels4;   // 4 bpp, two pixels a byte, high nibble first
+  std::vector<uint16_t> pixels16;
+  uint16_t palette[16];
+};
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_WIFI_H
+#define SHIM_WIFI_H
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+#define WL_CONNECTED 3
+#define WIFI_STA 1
+#define WIFI_IF_STA 0
+
+class IPAddress {
+public:
+  IPAddress(int a = 0, int b = 0, int c = 0, int d = 0);
+  String toString() const;
+
+private:
+  uint8_t octets[4];
+};
+
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+
+typedef struct {
+  struct {
+    uint8_t ssid[32];
+    uint8_t password[64];
+    uint8_t channel;
+    bool bssid_set;
+    uint8_t bssid[6];
+    uint16_t listen_interval;
+  } sta;
+} wifi_config_t;
+
+class WiFiClass {
+public:
+  int begin();
+  void begin(const char* ssid, const char* password);
+  void begin(const char* ssid, const char* password, int32_t channel, const uint8_t* bssid, bool connect = true);
+  int status();
+  void mode(int mode);
+  bool reconnect();
+  bool disconnect(bool wifiOff = false);
+  bool setAutoReconnect(bool enable);
+  bool setSleep(bool enable);
+  bool setSleep(wifi_ps_type_t type);
+  IPAddress localIP();
+  String SSID();
+  int RSSI();
+  int32_t channel();
+  uint8_t* BSSID();
+  void softAP(const char* ssid);
+  void softAPConfig(IPAddress ip, IPAddress gateway, IPAddress subnet);
+};
+extern WiFiClass WiFi;
+
+esp_err_t esp_wifi_get_config(int interface, wifi_config_t* config);
+esp_err_t esp_wifi_set_config(int interface, wifi_config_t* config);
+esp_err_t esp_wifi_set_ps(wifi_ps_type_t type);
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_WIFICLIENT_H
+#define SHIM_WIFICLIENT_H
+
+#include "Arduino.h"
+
+class Client : public Stream {
+public:
+  using Stream::read;
+  virtual int connect(const char* host, uint16_t port);
+  virtual int read(uint8_t* buffer, size_t size);
+  virtual void flush();
+  virtual void stop();
+  virtual uint8_t connected();
+  int fd() const;
+  void setNoDelay(bool noDelay);
+};
+
+class WiFiClient : public Client {};
+
+#endif
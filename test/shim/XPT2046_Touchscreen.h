@@ -0,0 +1,34 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_XPT2046_TOUCHSCREEN_H
+#define SHIM_XPT2046_TOUCHSCREEN_H
+
+#include "SPI.h"
+
+class TS_Point {
+public:
+  int16_t x, y, z;
+};
+
+class XPT2046_Touchscreen {
+public:
+  XPT2046_Touchscreen(uint8_t csPin, uint8_t irqPin = 255);
+  bool begin(SPIClass& spi);
+  void setRotation(uint8_t rotation);
+  bool touched();
+  bool tirqTouched();
+  bool bufferEmpty();
+  TS_Point getPoint();
+  void readData(uint16_t* x, uint16_t* y, uint8_t* z);
+};
+
+#endif
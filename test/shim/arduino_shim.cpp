@@ -0,0 +1,293 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host definitions of the Arduino core functions the tests reach. Serial
+// output goes to stdout and reads find nothing. Time stands still unless
+// delay() or setMicros() moves it, so whatever the sketch derives from
+// millis() comes out the same on every run. Pins read high and ignore
+// writes.
+
+#include "Arduino.h"
+#include <stdarg.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+  uint64_t clockMicros = 0;
+}
+
+size_t strlcpy(char* dst, const char* src, size_t size) {
+  const size_t length = strlen(src);
+  if (size > 0) {
+    const size_t copied = length < size - 1 ? length : size - 1;
+    memcpy(dst, src, copied);
+    dst[copied] = '\0';
+  }
+  return length;
+}
+
+size_t strlcat(char* dst, const char* src, size_t size) {
+  const size_t used = strnlen(dst, size);
+  if (used == size) return size + strlen(src);
+  return used + strlcpy(dst + used, src, size - used);
+}
+
+unsigned long millis() {
+  return clockMicros / 1000;
+}
+
+unsigned long micros() {
+  return clockMicros;
+}
+
+void setMicros(uint64_t us) {
+  clockMicros = us;
+}
+
+void delay(unsigned long ms) {
+  clockMicros += ms * 1000ULL;
+}
+
+void delayMicroseconds(unsigned int us) {
+  clockMicros += us;
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+void pinMode(int, int) {}
+void digitalWrite(int, int) {}
+void analogWrite(int, int) {}
+void attachInterrupt(int, void (*)(), int) {}
+void detachInterrupt(int) {}
+
+int digitalRead(int) {
+  return HIGH;
+}
+
+int digitalPinToInterrupt(int pin) {
+  return pin;
+}
+
+// A fixed ESP32-D0WD at full clock
+uint32_t EspClass::getFreeHeap() { return 180000; }
+uint32_t EspClass::getMinFreeHeap() { return 150000; }
+uint32_t EspClass::getMaxAllocHeap() { return 110000; }
+const char* EspClass::getChipModel() { return "ESP32-D0WD-V3"; }
+uint32_t EspClass::getCpuFreqMHz() { return 240; }
+uint32_t EspClass::getCycleCount() { return clockMicros * 240; }
+void EspClass::restart() { exit(0); }
+
+bool setCpuFrequencyMhz(uint32_t) { return true; }
+uint32_t getCpuFrequencyMhz() { return 240; }
+uint32_t getApbFrequency() { return 80000000; }
+
+// Wall time is the host's
+bool getLocalTime(struct tm* info, uint32_t) {
+  const time_t now = time(nullptr);
+  return localtime_r(&now, info) != nullptr;
+}
+
+void configTzTime(const char* tz, const char*, const char*, const char*) {
+  setenv("TZ", tz, 1);
+  tzset();
+}
+
+const char* esp_err_to_name(esp_err_t error) {
+  return error == ESP_OK ? "ESP_OK" : "ESP_FAIL";
+}
+
+// --- Serial ---
+
+void HardwareSerial::begin(int) {}
+
+int Stream::available() {
+  return 0;
+}
+
+int Stream::read() {
+  return -1;
+}
+
+int Stream::peek() {
+  return -1;
+}
+
+String Stream::readStringUntil(char) {
+  return String();
+}
+
+size_t Stream::readBytes(char*, size_t) {
+  return 0;
+}
+
+size_t Stream::readBytes(uint8_t*, size_t) {
+  return 0;
+}
+
+void Stream::setTimeout(unsigned long) {}
+
+// --- Print ---
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+size_t Print::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t Print::print(const char* s) {
+  return write((const uint8_t*)s, strlen(s));
+}
+
+size_t Print::print(const String& s) {
+  return print(s.c_str());
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print(int value) {
+  return printf("%d", value);
+}
+
+size_t Print::println() {
+  return print("\n");
+}
+
+size_t Print::println(const char* s) {
+  return print(s) + println();
+}
+
+size_t Print::println(const String& s) {
+  return print(s) + println();
+}
+
+size_t Print::println(int value) {
+  return print(value) + println();
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buffer[512];
+  va_list args;
+  va_start(args, format);
+  const int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (length <= 0) return 0;
+  return write((const uint8_t*)buffer, min((size_t)length, sizeof(buffer) - 1));
+}
+
+// --- String ---
+
+String::String(const char* s) : text(s ? s : "") {}
+String::String(int value) : text(std::to_string(value)) {}
+String::String(unsigned int value) : text(std::to_string(value)) {}
+String::String(long value) : text(std::to_string(value)) {}
+String::String(unsigned long value) : text(std::to_string(value)) {}
+String::String(float value, int decimals) : String((double)value, decimals) {}
+
+String::String(double value, int decimals) {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+  text = buffer;
+}
+
+const char* String::c_str() const {
+  return text.c_str();
+}
+
+unsigned int String::length() const {
+  return text.length();
+}
+
+String String::operator+(const String& other) const {
+  String result(*this);
+  result += other;
+  return result;
+}
+
+String& String::operator+=(const String& other) {
+  text += other.text;
+  return *this;
+}
+
+String& String::operator+=(char c) {
+  text += c;
+  return *this;
+}
+
+bool String::operator==(const String& other) const {
+  return text == other.text;
+}
+
+bool String::operator!=(const String& other) const {
+  return text != other.text;
+}
+
+char String::operator[](int index) const {
+  return index >= 0 && index < (int)text.size() ? text[index] : '\0';
+}
+
+int String::indexOf(const char* s) const {
+  const size_t found = text.find(s);
+  return found == std::string::npos ? -1 : (int)found;
+}
+
+int String::indexOf(char c) const {
+  const size_t found = text.find(c);
+  return found == std::string::npos ? -1 : (int)found;
+}
+
+long String::toInt() const {
+  return atol(text.c_str());
+}
+
+float String::toFloat() const {
+  return atof(text.c_str());
+}
+
+void String::replace(const String& from, const String& to) {
+  if (from.text.empty()) return;
+  for (size_t at = text.find(from.text); at != std::string::npos; at = text.find(from.text, at + to.text.size())) {
+    text.replace(at, from.text.size(), to.text);
+  }
+}
+
+String String::substring(int from, int to) const {
+  const int size = text.size();
+  if (to < 0 || to > size) to = size;
+  from = constrain(from, 0, to);
+  return String(text.substr(from, to - from).c_str());
+}
+
+void String::trim() {
+  const size_t first = text.find_first_not_of(" \t\r\n");
+  const size_t last = text.find_last_not_of(" \t\r\n");
+  text = first == std::string::npos ? "" : text.substr(first, last - first + 1);
+}
+
+bool String::startsWith(const String& prefix) const {
+  return text.compare(0, prefix.text.size(), prefix.text) == 0;
+}
+
+void String::toUpperCase() {
+  for (char& c : text) c = toupper(c);
+}
+
+void String::reserve(int size) {
+  text.reserve(size);
+}
+
+String operator+(const char* left, const String& right) {
+  return String(left) + right;
+}
@@ -0,0 +1,37 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_DAC_CONTINUOUS_H
+#define SHIM_DAC_CONTINUOUS_H
+
+#include "Arduino.h"
+
+#define DAC_CHANNEL_MASK_CH1 2
+#define DAC_DIGI_CLK_SRC_DEFAULT 0
+#define DAC_CHANNEL_MODE_SIMUL 0
+
+typedef void* dac_continuous_handle_t;
+typedef struct {
+  int chan_mask;
+  uint32_t desc_num;
+  size_t buf_size;
+  uint32_t freq_hz;
+  int8_t offset;
+  int clk_src;
+  int chan_mode;
+} dac_continuous_config_t;
+
+esp_err_t dac_continuous_new_channels(const dac_continuous_config_t* config, dac_continuous_handle_t* handle);
+esp_err_t dac_continuous_enable(dac_continuous_handle_t handle);
+esp_err_t dac_continuous_disable(dac_continuous_handle_t handle);
+esp_err_t dac_continuous_write(dac_continuous_handle_t handle, uint8_t* data, size_t length, size_t* written, int timeoutMs);
+
+#endif
@@ -0,0 +1,20 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_GPIO_H
+#define SHIM_GPIO_H
+
+#include "Arduino.h"
+
+esp_err_t gpio_intr_enable(gpio_num_t pin);
+esp_err_t gpio_intr_disable(gpio_num_t pin);
+
+#endif
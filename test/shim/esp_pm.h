@@ -0,0 +1,31 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_ESP_PM_H
+#define SHIM_ESP_PM_H
+
+#include "Arduino.h"
+
+typedef struct {
+  int max_freq_mhz;
+  int min_freq_mhz;
+  bool light_sleep_enable;
+} esp_pm_config_t;
+
+typedef void* esp_pm_lock_handle_t;
+typedef enum { ESP_PM_CPU_FREQ_MAX, ESP_PM_APB_FREQ_MAX, ESP_PM_NO_LIGHT_SLEEP } esp_pm_lock_type_t;
+
+esp_err_t esp_pm_configure(const void* config);
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t type, int arg, const char* name, esp_pm_lock_handle_t* handle);
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t handle);
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t handle);
+
+#endif
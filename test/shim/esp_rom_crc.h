@@ -0,0 +1,19 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_ESP_ROM_CRC_H
+#define SHIM_ESP_ROM_CRC_H
+
+#include <stdint.h>
+
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buffer, uint32_t length);
+
+#endif
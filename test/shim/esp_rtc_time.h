@@ -0,0 +1,19 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_ESP_RTC_TIME_H
+#define SHIM_ESP_RTC_TIME_H
+
+#include <stdint.h>
+
+uint64_t esp_rtc_get_time_us(void);
+
+#endif
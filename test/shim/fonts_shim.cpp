@@ -0,0 +1,219 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Synthetic stand-ins for the GFX free fonts the sketch uses. The real font
+// data ships with TFT_eSPI, which the host build does without. Each font is
+// built at start-up from the 5x8 base glyphs below, stretched to roughly the
+// real font's cap height, advance and line spacing, and trimmed to each
+// glyph's ink so the spacing is proportional. The result is in the real
+// GFXfont format, so the glyph atlas and TFT_eSprite's text code read it
+// exactly as they read the real fonts.
+
+#include "TFT_eSPI.h"
+#include "fonts_shim.h"
+
+namespace {
+  // Printable ASCII, one byte a row, bit 4 the leftmost column.
+  const uint8_t BASE_GLYPHS[95][BASE_GLYPH_HEIGHT] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // space
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04, 0x00, // !
+    0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // "
+    0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A, 0x00, // #
+    0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04, 0x00, // $
+    0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03, 0x00, // %
+    0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D, 0x00, // &
+    0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // quote
+    0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02, 0x00, // (
+    0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08, 0x00, // )
+    0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00, 0x00, // *
+    0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00, 0x00, // +
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x08, // ,
+    0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00, // -
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00, // .
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00, // /
+    0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E, 0x00, // 0
+    0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00, // 1
+    0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F, 0x00, // 2
+    0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E, 0x00, // 3
+    0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02, 0x00, // 4
+    0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E, 0x00, // 5
+    0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E, 0x00, // 6
+    0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08, 0x00, // 7
+    0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E, 0x00, // 8
+    0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C, 0x00, // 9
+    0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00, 0x00, // :
+    0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x08, 0x00, // ;
+    0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02, 0x00, // <
+    0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00, 0x00, // =
+    0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00, // >
+    0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04, 0x00, // ?
+    0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E, 0x00, // @
+    0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00, // A
+    0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E, 0x00, // B
+    0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E, 0x00, // C
+    0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C, 0x00, // D
+    0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F, 0x00, // E
+    0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10, 0x00, // F
+    0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F, 0x00, // G
+    0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00, // H
+    0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00, // I
+    0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C, 0x00, // J
+    0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11, 0x00, // K
+    0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F, 0x00, // L
+    0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11, 0x00, // M
+    0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x00, // N
+    0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00, // O
+    0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10, 0x00, // P
+    0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D, 0x00, // Q
+    0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11, 0x00, // R
+    0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E, 0x00, // S
+    0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, // T
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00, // U
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00, // V
+    0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A, 0x00, // W
+    0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11, 0x00, // X
+    0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x00, // Y
+    0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F, 0x00, // Z
+    0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E, 0x00, // [
+    0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, // backslash
+    0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E, 0x00, // ]
+    0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, // ^
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x00, // _
+    0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // `
+    0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00, // a
+    0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E, 0x00, // b
+    0x00, 0x00, 0x0E, 0x10, 0x10, 0x11, 0x0E, 0x00, // c
+    0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F, 0x00, // d
+    0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E, 0x00, // e
+    0x06, 0x09, 0x08, 0x1C, 0x08, 0x08, 0x08, 0x00, // f
+    0x00, 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E, // g
+    0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x11, 0x00, // h
+    0x04, 0x00, 0x0C, 0x04, 0x04, 0x04, 0x0E, 0x00, // i
+    0x02, 0x00, 0x06, 0x02, 0x02, 0x02, 0x12, 0x0C, // j
+    0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12, 0x00, // k
+    0x0C, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00, // l
+    0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11, 0x00, // m
+    0x00, 0x00, 0x16, 0x19, 0x11, 0x11, 0x11, 0x00, // n
+    0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00, // o
+    0x00, 0x00, 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, // p
+    0x00, 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x01, // q
+    0x00, 0x00, 0x16, 0x19, 0x10, 0x10, 0x10, 0x00, // r
+    0x00, 0x00, 0x0F, 0x10, 0x0E, 0x01, 0x1E, 0x00, // s
+    0x08, 0x08, 0x1C, 0x08, 0x08, 0x09, 0x06, 0x00, // t
+    0x00, 0x00, 0x11, 0x11, 0x11, 0x13, 0x0D, 0x00, // u
+    0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00, // v
+    0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A, 0x00, // w
+    0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x00, // x
+    0x00, 0x00, 0x11, 0x11, 0x11, 0x0F, 0x01, 0x0E, // y
+    0x00, 0x00, 0x1F, 0x02, 0x04, 0x08, 0x1F, 0x00, // z
+    0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02, 0x00, // {
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, // |
+    0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08, 0x00, // }
+    0x00, 0x00, 0x08, 0x15, 0x02, 0x00, 0x00, 0x00, // ~
+  };
+
+  const uint16_t FIRST_CHAR = 0x20;
+  const uint16_t LAST_CHAR = 0x7E;
+  const int CHAR_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+  const int MAX_GLYPH_BYTES = 64; // Up to 16 x 32 pixels
+
+  bool baseBit(uint16_t c, int column, int row) {
+    if (c < FIRST_CHAR || c > LAST_CHAR) return false;
+    return BASE_GLYPHS[c - FIRST_CHAR][row] & (0x10 >> column);
+  }
+
+  struct FontStorage {
+    uint8_t bitmap[CHAR_COUNT * MAX_GLYPH_BYTES];
+    GFXglyph glyphs[CHAR_COUNT];
+  };
+
+  // Scale of a synthetic font: the base glyph's 5 columns stretch to
+  // columnsWidth and its 8 rows to height, so 7/8 of height is above the
+  // baseline.
+  struct FontShape {
+    uint8_t columnsWidth;
+    uint8_t height;
+    uint8_t spaceAdvance;
+    bool bold; // Strokes one pixel wider
+  };
+
+  void buildFont(FontStorage& font, const FontShape& shape) {
+    const int ascent = shape.height * 7 / 8;
+    uint16_t offset = 0;
+    for (uint16_t c = FIRST_CHAR; c <= LAST_CHAR; c++) {
+      GFXglyph& glyph = font.glyphs[c - FIRST_CHAR];
+
+      // Ink columns of the base glyph
+      int first = BASE_GLYPH_WIDTH, last = -1;
+      for (int column = 0; column < BASE_GLYPH_WIDTH; column++) {
+        for (int row = 0; row < BASE_GLYPH_HEIGHT; row++) {
+          if (baseBit(c, column, row)) {
+            first = min(first, column);
+            last = max(last, column);
+          }
+        }
+      }
+
+      glyph.bitmapOffset = offset;
+      glyph.xOffset = 1;
+      glyph.yOffset = -ascent;
+      if (last < 0) {
+        glyph.width = 0;
+        glyph.height = 0;
+        glyph.xAdvance = shape.spaceAdvance;
+        continue;
+      }
+
+      const int inkWidth = ((last - first + 1) * shape.columnsWidth + BASE_GLYPH_WIDTH / 2) / BASE_GLYPH_WIDTH;
+      glyph.width = inkWidth + (shape.bold ? 1 : 0);
+      glyph.height = shape.height;
+      glyph.xAdvance = glyph.width + 2;
+
+      // Bits run on from row to row, as in the real fonts
+      uint8_t* bits = font.bitmap + offset;
+      memset(bits, 0, MAX_GLYPH_BYTES);
+      int bit = 0;
+      for (int y = 0; y < glyph.height; y++) {
+        const int row = y * BASE_GLYPH_HEIGHT / shape.height;
+        for (int x = 0; x < glyph.width; x++, bit++) {
+          const int column = first + x * BASE_GLYPH_WIDTH / shape.columnsWidth;
+          const int left = first + (x - 1) * BASE_GLYPH_WIDTH / shape.columnsWidth;
+          const bool set = (x < inkWidth && baseBit(c, column, row)) || (shape.bold && x > 0 && baseBit(c, left, row));
+          if (set) bits[bit / 8] |= 0x80 >> (bit % 8);
+        }
+      }
+      offset += (bit + 7) / 8;
+    }
+  }
+
+  FontStorage sans9, sans12, sansBold9, sansBold12, sansBold18;
+
+  // Runs before main(), and so before anything reads the fonts
+  struct FontBuilder {
+    FontBuilder() {
+      buildFont(sans9, { 7, 16, 5, false });
+      buildFont(sans12, { 9, 21, 7, false });
+      buildFont(sansBold9, { 7, 16, 5, true });
+      buildFont(sansBold12, { 9, 21, 7, true });
+      buildFont(sansBold18, { 14, 32, 10, true });
+    }
+  } fontBuilder;
+}
+
+// Line spacing as in the real fonts
+const GFXfont FreeSans9pt7b = { sans9.bitmap, sans9.glyphs, FIRST_CHAR, LAST_CHAR, 22 };
+const GFXfont FreeSans12pt7b = { sans12.bitmap, sans12.glyphs, FIRST_CHAR, LAST_CHAR, 29 };
+const GFXfont FreeSansBold9pt7b = { sansBold9.bitmap, sansBold9.glyphs, FIRST_CHAR, LAST_CHAR, 22 };
+const GFXfont FreeSansBold12pt7b = { sansBold12.bitmap, sansBold12.glyphs, FIRST_CHAR, LAST_CHAR, 29 };
+const GFXfont FreeSansBold18pt7b = { sansBold18.bitmap, sansBold18.glyphs, FIRST_CHAR, LAST_CHAR, 42 };
+
+bool shimGlyphPixel(uint16_t c, int x, int y, int w, int h) {
+  if (x < 0 || y < 0 || x >= w || y >= h) return false;
+  return baseBit(c, x * BASE_GLYPH_WIDTH / w, y * BASE_GLYPH_HEIGHT / h);
+}
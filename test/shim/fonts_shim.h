@@ -0,0 +1,24 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+#ifndef SHIM_FONTS_SHIM_H
+#define SHIM_FONTS_SHIM_H
+
+#include <stdint.h>
+
+// Every character of the synthetic fonts comes from one 5x8 base glyph:
+// 7 rows above the baseline and a descender row below.
+const int BASE_GLYPH_WIDTH = 5;
+const int BASE_GLYPH_HEIGHT = 8;
+
+// Pixel (x, y) of character c with its base glyph stretched to w x h.
+// Characters outside printable ASCII are blank.
+bool shimGlyphPixel(uint16_t c, int x, int y, int w, int h);
+
+#endif
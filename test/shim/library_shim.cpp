@@ -0,0 +1,282 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Inert host definitions of the libraries and ESP-IDF services the sketch
+// links against, for tests that link the whole sketch. Nothing here talks
+// to hardware or the network: WiFi reports a fixed station that is already
+// joined, HTTP requests and JSON parsing fail, Preferences are empty and
+// forget what is written, tasks and timers are never started.
+
+#include "WiFi.h"
+#include "WiFiClient.h"
+#include "ArduinoHttpClient.h"
+#include "ArduinoJson.h"
+#include "ESPAsyncWebServer.h"
+#include "Preferences.h"
+#include "XPT2046_Touchscreen.h"
+#include "esp_pm.h"
+#include "esp_random.h"
+#include "esp_rom_crc.h"
+#include "esp_rtc_time.h"
+#include "esp_wifi.h"
+#include "driver/dac_continuous.h"
+#include "driver/gpio.h"
+#include "mbedtls/ssl.h"
+
+WiFiClass WiFi;
+
+// --- WiFi ---
+
+IPAddress::IPAddress(int a, int b, int c, int d) : octets{ (uint8_t)a, (uint8_t)b, (uint8_t)c, (uint8_t)d } {}
+
+String IPAddress::toString() const {
+  char text[16];
+  snprintf(text, sizeof(text), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+  return String(text);
+}
+
+namespace {
+  uint8_t stationBssid[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+}
+
+int WiFiClass::begin() { return WL_CONNECTED; }
+void WiFiClass::begin(const char*, const char*) {}
+void WiFiClass::begin(const char*, const char*, int32_t, const uint8_t*, bool) {}
+int WiFiClass::status() { return WL_CONNECTED; }
+void WiFiClass::mode(int) {}
+bool WiFiClass::reconnect() { return true; }
+bool WiFiClass::disconnect(bool) { return true; }
+bool WiFiClass::setAutoReconnect(bool) { return true; }
+bool WiFiClass::setSleep(bool) { return true; }
+bool WiFiClass::setSleep(wifi_ps_type_t) { return true; }
+IPAddress WiFiClass::localIP() { return IPAddress(192, 168, 1, 50); }
+String WiFiClass::SSID() { return String("HamShack"); }
+int WiFiClass::RSSI() { return -61; }
+int32_t WiFiClass::channel() { return 6; }
+uint8_t* WiFiClass::BSSID() { return stationBssid; }
+void WiFiClass::softAP(const char*) {}
+void WiFiClass::softAPConfig(IPAddress, IPAddress, IPAddress) {}
+
+esp_err_t esp_wifi_get_config(int, wifi_config_t* config) {
+  memset(config, 0, sizeof(*config));
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_config(int, wifi_config_t*) { return ESP_OK; }
+esp_err_t esp_wifi_set_ps(wifi_ps_type_t) { return ESP_OK; }
+esp_err_t esp_wifi_connect() { return ESP_OK; }
+
+int Client::connect(const char*, uint16_t) { return 0; }
+int Client::read(uint8_t*, size_t) { return -1; }
+void Client::flush() {}
+void Client::stop() {}
+uint8_t Client::connected() { return 0; }
+int Client::fd() const { return -1; }
+void Client::setNoDelay(bool) {}
+
+// TLS: never reached, as no connection is made
+void mbedtls_ssl_config_init(mbedtls_ssl_config*) {}
+int mbedtls_ssl_config_defaults(mbedtls_ssl_config*, int, int, int) { return -1; }
+void mbedtls_ssl_config_free(mbedtls_ssl_config*) {}
+void mbedtls_ssl_conf_authmode(mbedtls_ssl_config*, int) {}
+void mbedtls_ssl_conf_rng(mbedtls_ssl_config*, int (*)(void*, unsigned char*, size_t), void*) {}
+void mbedtls_ssl_conf_max_tls_version(mbedtls_ssl_config*, mbedtls_ssl_protocol_version) {}
+void mbedtls_ssl_conf_session_tickets(mbedtls_ssl_config*, int) {}
+void mbedtls_ssl_conf_read_timeout(mbedtls_ssl_config*, uint32_t) {}
+void mbedtls_ssl_init(mbedtls_ssl_context*) {}
+int mbedtls_ssl_setup(mbedtls_ssl_context*, const mbedtls_ssl_config*) { return -1; }
+int mbedtls_ssl_set_hostname(mbedtls_ssl_context*, const char*) { return -1; }
+void mbedtls_ssl_set_bio(mbedtls_ssl_context*, void*, mbedtls_ssl_send_t*, mbedtls_ssl_recv_t*, mbedtls_ssl_recv_timeout_t*) {}
+void mbedtls_ssl_set_export_keys_cb(mbedtls_ssl_context*, mbedtls_ssl_export_keys_t*, void*) {}
+int mbedtls_ssl_handshake(mbedtls_ssl_context*) { return -1; }
+int mbedtls_ssl_read(mbedtls_ssl_context*, unsigned char*, size_t) { return -1; }
+int mbedtls_ssl_write(mbedtls_ssl_context*, const unsigned char*, size_t) { return -1; }
+size_t mbedtls_ssl_get_bytes_avail(const mbedtls_ssl_context*) { return 0; }
+int mbedtls_ssl_close_notify(mbedtls_ssl_context*) { return 0; }
+void mbedtls_ssl_free(mbedtls_ssl_context*) {}
+void mbedtls_ssl_session_init(mbedtls_ssl_session*) {}
+int mbedtls_ssl_set_session(mbedtls_ssl_context*, const mbedtls_ssl_session*) { return -1; }
+int mbedtls_ssl_get_session(const mbedtls_ssl_context*, mbedtls_ssl_session*) { return -1; }
+void mbedtls_ssl_session_free(mbedtls_ssl_session*) {}
+void esp_fill_random(void* buffer, size_t length) { memset(buffer, 0, length); }
+
+// --- HTTP, JSON and the web server ---
+
+HttpClient::HttpClient(Client&, const char*, uint16_t) {}
+int HttpClient::get(const char*) { return -1; }
+int HttpClient::responseStatusCode() { return -1; }
+int HttpClient::skipResponseHeaders() { return -1; }
+int HttpClient::contentLength() { return 0; }
+String HttpClient::responseBody() { return String(); }
+bool HttpClient::endOfBodyReached() { return true; }
+int HttpClient::available() { return 0; }
+int HttpClient::read() { return -1; }
+bool HttpClient::connected() { return false; }
+void HttpClient::connectionKeepAlive() {}
+void HttpClient::stop() {}
+
+JsonVariant::operator const char*() const { return nullptr; }
+JsonVariant JsonVariant::operator[](const char*) const { return JsonVariant(); }
+JsonVariant JsonDocument::operator[](const char*) { return JsonVariant(); }
+DeserializationError::operator bool() const { return true; }
+const char* DeserializationError::c_str() const { return "NoMemory"; }
+
+DeserializationError deserializeJson(JsonDocument&, Stream&) {
+  return DeserializationError();
+}
+
+const String& AsyncWebParameter::value() const {
+  static const String empty;
+  return empty;
+}
+
+void AsyncWebServerResponse::addHeader(const char*, const String&) {}
+int AsyncWebServerRequest::method() { return 0; }
+bool AsyncWebServerRequest::hasParam(const char*, bool) { return false; }
+AsyncWebParameter* AsyncWebServerRequest::getParam(const char*, bool) { return nullptr; }
+String AsyncWebServerRequest::arg(const char*) { return String(); }
+void AsyncWebServerRequest::send(int, const char*, const String&) {}
+void AsyncWebServerRequest::send(AsyncWebServerResponse*) {}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(const char*, size_t, std::function<size_t(uint8_t*, size_t, size_t)>) {
+  return nullptr;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse(const char*, std::function<size_t(uint8_t*, size_t, size_t)>) {
+  return nullptr;
+}
+
+AsyncWebServer::AsyncWebServer(int) {}
+void AsyncWebServer::on(const char*, int, std::function<void(AsyncWebServerRequest*)>) {}
+void AsyncWebServer::begin() {}
+
+// --- Preferences ---
+
+bool Preferences::begin(const char*, bool) { return true; }
+void Preferences::end() {}
+bool Preferences::clear() { return true; }
+bool Preferences::isKey(const char*) { return false; }
+size_t Preferences::putBool(const char*, bool) { return 0; }
+bool Preferences::getBool(const char*, bool fallback) { return fallback; }
+size_t Preferences::putUChar(const char*, uint8_t) { return 0; }
+uint8_t Preferences::getUChar(const char*, uint8_t fallback) { return fallback; }
+size_t Preferences::putShort(const char*, int16_t) { return 0; }
+int16_t Preferences::getShort(const char*, int16_t fallback) { return fallback; }
+size_t Preferences::putUShort(const char*, uint16_t) { return 0; }
+uint16_t Preferences::getUShort(const char*, uint16_t fallback) { return fallback; }
+size_t Preferences::putInt(const char*, int32_t) { return 0; }
+int32_t Preferences::getInt(const char*, int32_t fallback) { return fallback; }
+size_t Preferences::putLong(const char*, int32_t) { return 0; }
+int32_t Preferences::getLong(const char*, int32_t fallback) { return fallback; }
+size_t Preferences::putULong(const char*, uint32_t) { return 0; }
+uint32_t Preferences::getULong(const char*, uint32_t fallback) { return fallback; }
+size_t Preferences::putString(const char*, const String&) { return 0; }
+String Preferences::getString(const char*, const String& fallback) { return fallback; }
+size_t Preferences::putBytes(const char*, const void*, size_t) { return 0; }
+size_t Preferences::getBytes(const char*, void*, size_t) { return 0; }
+size_t Preferences::getBytesLength(const char*) { return 0; }
+
+// --- SPI and touch ---
+
+SPISettings::SPISettings(uint32_t, uint8_t, uint8_t) {}
+SPIClass::SPIClass(int) {}
+void SPIClass::begin(int, int, int, int) {}
+void SPIClass::beginTransaction(SPISettings) {}
+void SPIClass::endTransaction() {}
+uint8_t SPIClass::transfer(uint8_t) { return 0; }
+uint16_t SPIClass::transfer16(uint16_t) { return 0; }
+
+XPT2046_Touchscreen::XPT2046_Touchscreen(uint8_t, uint8_t) {}
+bool XPT2046_Touchscreen::begin(SPIClass&) { return true; }
+void XPT2046_Touchscreen::setRotation(uint8_t) {}
+bool XPT2046_Touchscreen::touched() { return false; }
+bool XPT2046_Touchscreen::tirqTouched() { return false; }
+bool XPT2046_Touchscreen::bufferEmpty() { return true; }
+TS_Point XPT2046_Touchscreen::getPoint() { return TS_Point(); }
+
+void XPT2046_Touchscreen::readData(uint16_t* x, uint16_t* y, uint8_t* z) {
+  *x = *y = 0;
+  *z = 0;
+}
+
+// --- ESP-IDF ---
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() { return ESP_SLEEP_WAKEUP_UNDEFINED; }
+esp_err_t esp_sleep_enable_ext0_wakeup(int, int) { return ESP_OK; }
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t) { return ESP_OK; }
+esp_err_t esp_sleep_enable_gpio_wakeup() { return ESP_OK; }
+esp_err_t esp_sleep_enable_wifi_wakeup() { return ESP_OK; }
+esp_err_t esp_light_sleep_start() { return ESP_OK; }
+void esp_deep_sleep_start() { exit(0); }
+esp_err_t gpio_wakeup_enable(int, int) { return ESP_OK; }
+esp_err_t gpio_intr_enable(gpio_num_t) { return ESP_OK; }
+esp_err_t gpio_intr_disable(gpio_num_t) { return ESP_OK; }
+
+int64_t esp_timer_get_time() { return micros(); }
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t*, esp_timer_handle_t* handle) {
+  *handle = nullptr;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t, uint64_t) { return ESP_OK; }
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t, uint64_t) { return ESP_OK; }
+esp_err_t esp_timer_stop(esp_timer_handle_t) { return ESP_OK; }
+uint32_t xthal_get_ccount() { return ESP.getCycleCount(); }
+uint64_t esp_rtc_get_time_us() { return micros(); }
+
+// Bitwise CRC-32 (IEEE), as the ROM computes it
+uint32_t esp_rom_crc32_le(uint32_t crc, const uint8_t* buffer, uint32_t length) {
+  crc = ~crc;
+  while (length--) {
+    crc ^= *buffer++;
+    for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return ~crc;
+}
+
+esp_err_t esp_pm_configure(const void*) { return ESP_OK; }
+
+esp_err_t esp_pm_lock_create(esp_pm_lock_type_t, int, const char*, esp_pm_lock_handle_t* handle) {
+  *handle = nullptr;
+  return ESP_OK;
+}
+
+esp_err_t esp_pm_lock_acquire(esp_pm_lock_handle_t) { return ESP_OK; }
+esp_err_t esp_pm_lock_release(esp_pm_lock_handle_t) { return ESP_OK; }
+
+esp_err_t dac_continuous_new_channels(const dac_continuous_config_t*, dac_continuous_handle_t* handle) {
+  *handle = nullptr;
+  return ESP_OK;
+}
+
+esp_err_t dac_continuous_enable(dac_continuous_handle_t) { return ESP_OK; }
+esp_err_t dac_continuous_disable(dac_continuous_handle_t) { return ESP_OK; }
+
+esp_err_t dac_continuous_write(dac_continuous_handle_t, uint8_t*, size_t length, size_t* written, int) {
+  if (written) *written = length;
+  return ESP_OK;
+}
+
+// --- FreeRTOS ---
+
+// Tasks are not started, so whatever they would do stays undone
+TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+
+BaseType_t xTaskCreatePinnedToCore(void (*)(void*), const char*, uint32_t, void*, UBaseType_t, TaskHandle_t* handle, BaseType_t) {
+  if (handle) *handle = nullptr;
+  return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+void vTaskDelete(TaskHandle_t) {}
+TickType_t xTaskGetTickCount() { return millis() / portTICK_PERIOD_MS; }
+void xTaskNotifyGive(TaskHandle_t) {}
+void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t*) {}
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t) { return 0; }
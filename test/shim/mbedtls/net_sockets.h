@@ -0,0 +1,22 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_MBEDTLS_NET_SOCKETS_H
+#define SHIM_MBEDTLS_NET_SOCKETS_H
+
+#include "ssl.h"
+
+#define MBEDTLS_ERR_NET_INVALID_CONTEXT -0x0045
+#define MBEDTLS_ERR_NET_RECV_FAILED -0x004C
+#define MBEDTLS_ERR_NET_SEND_FAILED -0x004E
+#define MBEDTLS_ERR_NET_CONN_RESET -0x0050
+
+#endif
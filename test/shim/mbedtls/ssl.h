@@ -0,0 +1,70 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host stand-in, declarations only. See Arduino.h.
+
+#ifndef SHIM_MBEDTLS_SSL_H
+#define SHIM_MBEDTLS_SSL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MBEDTLS_ERR_SSL_WANT_READ -0x6900
+#define MBEDTLS_ERR_SSL_WANT_WRITE -0x6880
+#define MBEDTLS_ERR_SSL_TIMEOUT -0x6800
+#define MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY -0x7880
+
+#define MBEDTLS_SSL_IS_CLIENT 0
+#define MBEDTLS_SSL_TRANSPORT_STREAM 0
+#define MBEDTLS_SSL_PRESET_DEFAULT 0
+#define MBEDTLS_SSL_VERIFY_NONE 0
+#define MBEDTLS_SSL_SESSION_TICKETS_ENABLED 1
+
+typedef enum { MBEDTLS_SSL_VERSION_TLS1_2 = 0x0303 } mbedtls_ssl_protocol_version;
+typedef enum { MBEDTLS_SSL_KEY_EXPORT_TLS12_MASTER_SECRET = 0 } mbedtls_ssl_key_export_type;
+typedef enum { MBEDTLS_SSL_TLS_PRF_NONE } mbedtls_tls_prf_types;
+
+typedef struct { int unused; } mbedtls_ssl_config;
+typedef struct { int unused; } mbedtls_ssl_context;
+typedef struct { int unused; } mbedtls_ssl_session;
+
+typedef int mbedtls_ssl_send_t(void* context, const unsigned char* buffer, size_t length);
+typedef int mbedtls_ssl_recv_t(void* context, unsigned char* buffer, size_t length);
+typedef int mbedtls_ssl_recv_timeout_t(void* context, unsigned char* buffer, size_t length, uint32_t timeoutMs);
+typedef void mbedtls_ssl_export_keys_t(void* context, mbedtls_ssl_key_export_type type, const unsigned char* secret, size_t length,
+                                       const unsigned char clientRandom[32], const unsigned char serverRandom[32], mbedtls_tls_prf_types prf);
+
+void mbedtls_ssl_config_init(mbedtls_ssl_config* config);
+int mbedtls_ssl_config_defaults(mbedtls_ssl_config* config, int endpoint, int transport, int preset);
+void mbedtls_ssl_config_free(mbedtls_ssl_config* config);
+void mbedtls_ssl_conf_authmode(mbedtls_ssl_config* config, int mode);
+void mbedtls_ssl_conf_rng(mbedtls_ssl_config* config, int (*rng)(void*, unsigned char*, size_t), void* context);
+void mbedtls_ssl_conf_max_tls_version(mbedtls_ssl_config* config, mbedtls_ssl_protocol_version version);
+void mbedtls_ssl_conf_session_tickets(mbedtls_ssl_config* config, int tickets);
+void mbedtls_ssl_conf_read_timeout(mbedtls_ssl_config* config, uint32_t timeoutMs);
+
+void mbedtls_ssl_init(mbedtls_ssl_context* ssl);
+int mbedtls_ssl_setup(mbedtls_ssl_context* ssl, const mbedtls_ssl_config* config);
+int mbedtls_ssl_set_hostname(mbedtls_ssl_context* ssl, const char* host);
+void mbedtls_ssl_set_bio(mbedtls_ssl_context* ssl, void* context, mbedtls_ssl_send_t* send, mbedtls_ssl_recv_t* receive,
+                         mbedtls_ssl_recv_timeout_t* receiveTimeout);
+void mbedtls_ssl_set_export_keys_cb(mbedtls_ssl_context* ssl, mbedtls_ssl_export_keys_t* callback, void* context);
+int mbedtls_ssl_handshake(mbedtls_ssl_context* ssl);
+int mbedtls_ssl_read(mbedtls_ssl_context* ssl, unsigned char* buffer, size_t length);
+int mbedtls_ssl_write(mbedtls_ssl_context* ssl, const unsigned char* buffer, size_t length);
+size_t mbedtls_ssl_get_bytes_avail(const mbedtls_ssl_context* ssl);
+int mbedtls_ssl_close_notify(mbedtls_ssl_context* ssl);
+void mbedtls_ssl_free(mbedtls_ssl_context* ssl);
+
+void mbedtls_ssl_session_init(mbedtls_ssl_session* session);
+int mbedtls_ssl_set_session(mbedtls_ssl_context* ssl, const mbedtls_ssl_session* session);
+int mbedtls_ssl_get_session(const mbedtls_ssl_context* ssl, mbedtls_ssl_session* session);
+void mbedtls_ssl_session_free(mbedtls_ssl_session* session);
+
+#endif
@@ -0,0 +1,578 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Host TFT_eSPI: the panel and sprites rasterize into memory. Text, lines
+// and shapes follow the library's own algorithms over the virtual
+// primitives, so a sprite subclass is called the way it is on the device.
+
+#include "TFT_eSPI.h"
+#include "fonts_shim.h"
+
+namespace {
+  // Built-in numbered fonts: layout metrics of the real fonts, with a
+  // synthetic glyph centred in each character cell.
+  struct NumberFont {
+    uint8_t height;
+    uint8_t baseline;
+    uint8_t advance;
+    uint8_t glyphWidth;
+    uint8_t glyphHeight; // 7/8 of it above the baseline
+  };
+
+  const NumberFont NUMBER_FONTS[9] = {
+    {},
+    { 8, 7, 6, 5, 8 },       // 1: GLCD
+    { 16, 13, 8, 6, 14 },
+    {},
+    { 26, 19, 14, 10, 21 },
+    {},
+    { 48, 38, 27, 18, 42 },
+    { 48, 47, 32, 22, 52 },
+    { 75, 58, 55, 40, 66 },
+  };
+
+  bool isNumberFont(uint8_t font) {
+    return font > 1 && font < 9 && NUMBER_FONTS[font].height > 0;
+  }
+
+  // Narrow punctuation as in the real fonts
+  int32_t numberAdvance(const NumberFont& font, uint16_t c) {
+    if (c == ' ') return font.advance / 2;
+    if (c == ':' || c == '.') return font.advance * 2 / 5;
+    return font.advance;
+  }
+
+  uint16_t swap16(uint16_t value) {
+    return (value << 8) | (value >> 8);
+  }
+}
+
+// --- TFT_eSPI: panel ---
+
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h)
+  : textcolor(TFT_WHITE), textbgcolor(TFT_WHITE), textfont(1), textsize(1), textdatum(TL_DATUM),
+    gfxFont(nullptr), glyph_ab(0), glyph_bb(0), bgFill(false), _swapBytes(false), rotation(0),
+    _init_width(w), _init_height(h), _width(w), _height(h),
+    framebuffer(w * h, TFT_BLACK), inverted(false) {}
+
+void TFT_eSPI::init() {}
+
+void TFT_eSPI::setRotation(uint8_t r) {
+  rotation = r & 3;
+  const bool landscape = rotation & 1;
+  _width = landscape ? _init_height : _init_width;
+  _height = landscape ? _init_width : _init_height;
+}
+
+uint8_t TFT_eSPI::getRotation() {
+  return rotation;
+}
+
+int16_t TFT_eSPI::width() {
+  return _width;
+}
+
+int16_t TFT_eSPI::height() {
+  return _height;
+}
+
+void TFT_eSPI::invertDisplay(bool invert) {
+  inverted = invert;
+}
+
+// Raw commands (hardware scrolling, display on/off) have no effect here
+void TFT_eSPI::writecommand(uint8_t) {}
+void TFT_eSPI::writedata(uint8_t) {}
+void TFT_eSPI::startWrite() {}
+void TFT_eSPI::endWrite() {}
+
+void TFT_eSPI::setSwapBytes(bool swap) {
+  _swapBytes = swap;
+}
+
+bool TFT_eSPI::getSwapBytes() {
+  return _swapBytes;
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t* data) {
+  pushImage(x, y, w, h, (const uint16_t*)data);
+}
+
+// Buffers hold big-endian pixels, the order the panel takes them in;
+// _swapBytes is for buffers in native order.
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t* data) {
+  const int32_t stride = w;
+  int32_t dx = x, dy = y;
+  if (!clip(x, y, w, h)) return;
+  data += (y - dy) * stride + (x - dx);
+  for (int32_t row = 0; row < h; row++) {
+    uint16_t* out = &framebuffer[(y + row) * _width + x];
+    const uint16_t* in = data + row * stride;
+    for (int32_t col = 0; col < w; col++) out[col] = _swapBytes ? in[col] : swap16(in[col]);
+  }
+  countPixels((int64_t)w * h);
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  fillRect(x, y, 1, 1, color);
+}
+
+// Bresenham, with runs sent as fast lines
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+  const bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+
+  const int32_t dx = x1 - x0, dy = abs(y1 - y0);
+  const int32_t ystep = y0 < y1 ? 1 : -1;
+  int32_t err = dx >> 1, start = x0, length = 0;
+  for (; x0 <= x1; x0++) {
+    length++;
+    err -= dy;
+    if (err < 0) {
+      if (length == 1) steep ? drawPixel(y0, start, color) : drawPixel(start, y0, color);
+      else steep ? drawFastVLine(y0, start, length, color) : drawFastHLine(start, y0, length, color);
+      length = 0;
+      y0 += ystep;
+      start = x0 + 1;
+      err += dx;
+    }
+  }
+  if (length) steep ? drawFastVLine(y0, start, length, color) : drawFastHLine(start, y0, length, color);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  if (!clip(x, y, w, h)) return;
+  for (int32_t row = y; row < y + h; row++) {
+    std::fill_n(&framebuffer[row * _width + x], w, (uint16_t)color);
+  }
+  countPixels((int64_t)w * h);
+}
+
+// --- TFT_eSPI: shapes ---
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+  fillRect(0, 0, _width, _height, color);
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+void TFT_eSPI::drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+  drawFastHLine(x + r, y, w - r - r, color);
+  drawFastHLine(x + r, y + h - 1, w - r - r, color);
+  drawFastVLine(x, y + r, h - r - r, color);
+  drawFastVLine(x + w - 1, y + r, h - r - r, color);
+  drawCircleQuadrants(x + r, y + r, r, 1, color);
+  drawCircleQuadrants(x + w - r - 1, y + r, r, 2, color);
+  drawCircleQuadrants(x + w - r - 1, y + h - r - 1, r, 4, color);
+  drawCircleQuadrants(x + r, y + h - r - 1, r, 8, color);
+}
+
+void TFT_eSPI::fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r, uint32_t color) {
+  fillRect(x, y + r, w, h - r - r, color);
+  fillCircleHalves(x + r, y + h - r - 1, r, 1, w - r - r - 1, color);
+  fillCircleHalves(x + r, y + r, r, 2, w - r - r - 1, color);
+}
+
+// Midpoint circle
+void TFT_eSPI::drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  drawPixel(x0, y0 + r, color);
+  drawPixel(x0, y0 - r, color);
+  drawPixel(x0 + r, y0, color);
+  drawPixel(x0 - r, y0, color);
+  drawCircleQuadrants(x0, y0, r, 0x0F, color);
+}
+
+void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  drawFastHLine(x0 - r, y0, r + r + 1, color);
+  fillCircleHalves(x0, y0, r, 3, 0, color);
+}
+
+// Quadrants: 1 top left, 2 top right, 4 bottom right, 8 bottom left
+void TFT_eSPI::drawCircleQuadrants(int32_t x0, int32_t y0, int32_t r, uint8_t quadrants, uint32_t color) {
+  int32_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (quadrants & 0x4) {
+      drawPixel(x0 + x, y0 + y, color);
+      drawPixel(x0 + y, y0 + x, color);
+    }
+    if (quadrants & 0x2) {
+      drawPixel(x0 + x, y0 - y, color);
+      drawPixel(x0 + y, y0 - x, color);
+    }
+    if (quadrants & 0x8) {
+      drawPixel(x0 - y, y0 + x, color);
+      drawPixel(x0 - x, y0 + y, color);
+    }
+    if (quadrants & 0x1) {
+      drawPixel(x0 - y, y0 - x, color);
+      drawPixel(x0 - x, y0 - y, color);
+    }
+  }
+}
+
+// Halves: 1 lower, 2 upper, each stretched right by stretch pixels
+void TFT_eSPI::fillCircleHalves(int32_t x0, int32_t y0, int32_t r, uint8_t halves, int32_t stretch, uint32_t color) {
+  if (r <= 0) return;
+  int32_t f = 1 - r, ddF_x = 1, ddF_y = -r - r, y = 0;
+  stretch++;
+  while (y < r) {
+    if (f >= 0) {
+      if (halves & 0x1) drawFastHLine(x0 - y, y0 + r, y + y + stretch, color);
+      if (halves & 0x2) drawFastHLine(x0 - y, y0 - r, y + y + stretch, color);
+      r--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    y++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (halves & 0x1) drawFastHLine(x0 - r, y0 + y, r + r + stretch, color);
+    if (halves & 0x2) drawFastHLine(x0 - r, y0 - y, r + r + stretch, color);
+  }
+}
+
+// --- TFT_eSPI: text ---
+
+// GLCD font 1 when no free font is set, otherwise the free font at (x, y)
+// on its baseline
+void TFT_eSPI::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size) {
+  if (!gfxFont) {
+    if (bg != color) fillRect(x, y, 6 * size, 8 * size, bg);
+    for (int32_t row = 0; row < BASE_GLYPH_HEIGHT; row++) {
+      int32_t run = 0;
+      for (int32_t col = 0; col <= BASE_GLYPH_WIDTH; col++) {
+        const bool set = shimGlyphPixel(c, col, row, BASE_GLYPH_WIDTH, BASE_GLYPH_HEIGHT);
+        if (set) {
+          run++;
+          continue;
+        }
+        if (!run) continue;
+        if (size == 1) drawFastHLine(x + col - run, y + row, run, color);
+        else fillRect(x + (col - run) * size, y + row * size, run * size, size, color);
+        run = 0;
+      }
+    }
+    return;
+  }
+
+  if (c < gfxFont->first || c > gfxFont->last) return;
+  const GFXglyph& glyph = gfxFont->glyph[c - gfxFont->first];
+  const uint8_t* bitmap = gfxFont->bitmap + glyph.bitmapOffset;
+  if (bgFill && bg != color) {
+    fillRect(x, y - glyph_ab * size, glyph.xAdvance * size, (glyph_ab + glyph_bb) * size, bg);
+  }
+
+  uint32_t bit = 0;
+  for (int32_t yy = 0; yy < glyph.height; yy++) {
+    int32_t run = 0;
+    for (int32_t xx = 0; xx <= glyph.width; xx++) {
+      if (xx < glyph.width && (bitmap[bit / 8] & (0x80 >> (bit % 8)))) {
+        bit++;
+        run++;
+        continue;
+      }
+      if (xx < glyph.width) bit++;
+      if (!run) continue;
+      const int32_t left = glyph.xOffset + xx - run, top = glyph.yOffset + yy;
+      if (size == 1) drawFastHLine(x + left, y + top, run, color);
+      else fillRect(x + left * size, y + top * size, run * size, size, color);
+      run = 0;
+    }
+  }
+}
+
+// Draws c in font at (x, y), the top left of the character cell, and
+// returns its advance
+int16_t TFT_eSPI::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) {
+  if (!isNumberFont(font)) {
+    drawChar(x, y, uniCode, textcolor, textbgcolor, textsize);
+    if (!gfxFont) return 6 * textsize;
+    if (uniCode < gfxFont->first || uniCode > gfxFont->last) return 0;
+    return gfxFont->glyph[uniCode - gfxFont->first].xAdvance * textsize;
+  }
+
+  const NumberFont& metrics = NUMBER_FONTS[font];
+  const int32_t advance = numberAdvance(metrics, uniCode);
+  if (textbgcolor != textcolor) fillRect(x, y, advance * textsize, metrics.height * textsize, textbgcolor);
+
+  const int32_t glyphWidth = metrics.glyphWidth * advance / metrics.advance;
+  const int32_t left = (advance - glyphWidth) / 2;
+  const int32_t top = metrics.baseline - metrics.glyphHeight * 7 / 8;
+  for (int32_t row = 0; row < metrics.glyphHeight; row++) {
+    int32_t run = 0;
+    for (int32_t col = 0; col <= glyphWidth; col++) {
+      if (shimGlyphPixel(uniCode, col, row, glyphWidth, metrics.glyphHeight)) {
+        run++;
+        continue;
+      }
+      if (!run) continue;
+      const int32_t runX = x + (left + col - run) * textsize, runY = y + (top + row) * textsize;
+      if (textsize == 1) drawFastHLine(runX, runY, run, textcolor);
+      else fillRect(runX, runY, run * textsize, textsize, textcolor);
+      run = 0;
+    }
+  }
+  return advance * textsize;
+}
+
+void TFT_eSPI::setTextColor(uint16_t color) {
+  textcolor = textbgcolor = color;
+}
+
+void TFT_eSPI::setTextColor(uint16_t color, uint16_t bg, bool fill) {
+  textcolor = color;
+  textbgcolor = bg;
+  bgFill = fill;
+}
+
+void TFT_eSPI::setTextDatum(uint8_t datum) {
+  textdatum = datum;
+}
+
+uint8_t TFT_eSPI::getTextDatum() {
+  return textdatum;
+}
+
+void TFT_eSPI::setTextFont(uint8_t font) {
+  textfont = font > 0 && font < 9 ? font : 1;
+  gfxFont = nullptr;
+}
+
+void TFT_eSPI::setTextSize(uint8_t size) {
+  textsize = size > 0 ? min<uint8_t>(size, 7) : 1;
+}
+
+// Like the library, the extent skips the last character
+void TFT_eSPI::setFreeFont(const GFXfont* font) {
+  textfont = 1;
+  gfxFont = (GFXfont*)font;
+  glyph_ab = 0;
+  glyph_bb = 0;
+  if (!font) return;
+  for (uint16_t c = 0; c < font->last - font->first; c++) {
+    const GFXglyph& glyph = font->glyph[c];
+    if (-glyph.yOffset > glyph_ab) glyph_ab = -glyph.yOffset;
+    if (glyph.height + glyph.yOffset > glyph_bb) glyph_bb = glyph.height + glyph.yOffset;
+  }
+}
+
+// Smooth fonts are not supported; the sketch only unloads them
+void TFT_eSPI::loadFont(const uint8_t*) {}
+
+int16_t TFT_eSPI::drawString(const String& text, int32_t x, int32_t y) {
+  return drawString(text.c_str(), x, y, textfont);
+}
+
+int16_t TFT_eSPI::drawString(const char* text, int32_t x, int32_t y) {
+  return drawString(text, x, y, textfont);
+}
+
+int16_t TFT_eSPI::drawString(const char* text, int32_t x, int32_t y, uint8_t font) {
+  const bool freeFont = !isNumberFont(font) && gfxFont;
+  int32_t cheight = fontHeight(font);
+  if (freeFont) {
+    // Free fonts draw from the baseline
+    cheight = glyph_ab * textsize;
+    y += cheight;
+    if (textdatum == BL_DATUM || textdatum == BC_DATUM || textdatum == BR_DATUM) cheight += glyph_bb * textsize;
+  }
+
+  const int32_t cwidth = textWidth(text, font);
+  switch (textdatum) {
+    case TC_DATUM: x -= cwidth / 2; break;
+    case TR_DATUM: x -= cwidth; break;
+    case ML_DATUM: y -= cheight / 2; break;
+    case MC_DATUM: x -= cwidth / 2; y -= cheight / 2; break;
+    case MR_DATUM: x -= cwidth; y -= cheight / 2; break;
+    case BL_DATUM: y -= cheight; break;
+    case BC_DATUM: x -= cwidth / 2; y -= cheight; break;
+    case BR_DATUM: x -= cwidth; y -= cheight; break;
+  }
+
+  int32_t advance = 0;
+  for (const char* p = text; *p; p++) advance += drawChar((uint8_t)*p, x + advance, y, font);
+  return advance;
+}
+
+int16_t TFT_eSPI::textWidth(const String& text) {
+  return textWidth(text.c_str(), textfont);
+}
+
+int16_t TFT_eSPI::textWidth(const char* text) {
+  return textWidth(text, textfont);
+}
+
+// Free fonts end at the last glyph's ink, not its advance
+int16_t TFT_eSPI::textWidth(const char* text, uint8_t font) {
+  int32_t width = 0;
+  if (isNumberFont(font)) {
+    for (const char* p = text; *p; p++) width += numberAdvance(NUMBER_FONTS[font], (uint8_t)*p);
+  } else if (gfxFont) {
+    for (const char* p = text; *p; p++) {
+      const uint16_t c = (uint8_t)*p;
+      if (c < gfxFont->first || c > gfxFont->last) continue;
+      const GFXglyph& glyph = gfxFont->glyph[c - gfxFont->first];
+      if (p[1]) width += glyph.xAdvance;
+      else width += max<int32_t>(glyph.xAdvance, glyph.xOffset + glyph.width);
+    }
+  } else {
+    width = 6 * strlen(text);
+  }
+  return width * textsize;
+}
+
+int16_t TFT_eSPI::fontHeight() {
+  return fontHeight(textfont);
+}
+
+int16_t TFT_eSPI::fontHeight(int16_t font) {
+  if (font == 1 && gfxFont) return gfxFont->yAdvance * textsize;
+  if (font < 1 || font > 8 || !NUMBER_FONTS[font].height) return 8 * textsize;
+  return NUMBER_FONTS[font].height * textsize;
+}
+
+// --- Host only ---
+
+bool TFT_eSPI::clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h) {
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  w = min<int32_t>(w, _width - x);
+  h = min<int32_t>(h, _height - y);
+  return w > 0 && h > 0;
+}
+
+void TFT_eSPI::countPixels(int64_t pixels) {
+  shimStats.drawCalls++;
+  shimStats.pixelsWritten += pixels;
+}
+
+// --- TFT_eSprite ---
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI* tft)
+  : TFT_eSPI(0, 0), display(tft), colorDepth(16), palette() {}
+
+void* TFT_eSprite::setColorDepth(int8_t depth) {
+  colorDepth = depth == 4 ? 4 : 16;
+  return nullptr;
+}
+
+void* TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t) {
+  _init_width = _width = w;
+  _init_height = _height = h;
+  if (colorDepth == 4) {
+    pixels4.assign((w + 1) / 2 * h, 0);
+    return pixels4.data();
+  }
+  pixels16.assign(w * h, TFT_BLACK);
+  return pixels16.data();
+}
+
+void TFT_eSprite::createPalette(const uint16_t* colors, uint8_t count) {
+  memcpy(palette, colors, min<uint8_t>(count, 16) * sizeof(uint16_t));
+}
+
+void* TFT_eSprite::getPointer() {
+  return colorDepth == 4 ? (void*)pixels4.data() : (void*)pixels16.data();
+}
+
+int16_t TFT_eSprite::width() {
+  return _width;
+}
+
+int16_t TFT_eSprite::height() {
+  return _height;
+}
+
+void TFT_eSprite::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  writeRect(x, y, 1, 1, color);
+}
+
+void TFT_eSprite::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+  TFT_eSPI::drawLine(x0, y0, x1, y1, color);
+}
+
+void TFT_eSprite::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  writeRect(x, y, w, 1, color);
+}
+
+void TFT_eSprite::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  writeRect(x, y, 1, h, color);
+}
+
+void TFT_eSprite::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  writeRect(x, y, w, h, color);
+}
+
+void TFT_eSprite::drawChar(int32_t x, int32_t y, uint16_t c, uint32_t color, uint32_t bg, uint8_t size) {
+  TFT_eSPI::drawChar(x, y, c, color, bg, size);
+}
+
+int16_t TFT_eSprite::drawChar(uint16_t uniCode, int32_t x, int32_t y, uint8_t font) {
+  return TFT_eSPI::drawChar(uniCode, x, y, font);
+}
+
+uint16_t TFT_eSprite::readPixelColor(int32_t x, int32_t y) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return TFT_BLACK;
+  if (colorDepth == 16) return pixels16[y * _width + x];
+  const uint8_t packed = pixels4[y * ((_width + 1) / 2) + x / 2];
+  return palette[x & 1 ? packed & 0x0F : packed >> 4];
+}
+
+// At 4 bpp the colour is a palette index
+void TFT_eSprite::writeRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  if (!clip(x, y, w, h)) return;
+  countPixels((int64_t)w * h);
+  if (colorDepth == 16) {
+    for (int32_t row = y; row < y + h; row++) std::fill_n(&pixels16[row * _width + x], w, (uint16_t)color);
+    return;
+  }
+  const int32_t stride = (_width + 1) / 2;
+  const uint8_t index = color & 0x0F;
+  for (int32_t row = y; row < y + h; row++) {
+    uint8_t* line = &pixels4[row * stride];
+    for (int32_t col = x; col < x + w; col++) {
+      uint8_t& packed = line[col / 2];
+      packed = col & 1 ? (packed & 0xF0) | index : (packed & 0x0F) | (index << 4);
+    }
+  }
+}
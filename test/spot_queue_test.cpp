@@ -0,0 +1,177 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Spot queue under a real producer and consumer thread: spots come out in
+// order, none are lost while the reader stays within SPOT_QUEUE_SIZE, and
+// when it overruns the drop-oldest count matches the spots that went missing
+// (which is the path where popSpot's claim races pushSpot's drop).
+
+#include "declarations.h"
+#include "test.h"
+#include <thread>
+#include <vector>
+
+namespace {
+  const uint32_t STRESS_SPOTS = 100000;
+
+  // Sleeps rather than yields, so the other thread gets to run even on a
+  // single-core machine.
+  void pause() {
+    std::this_thread::sleep_for(std::chrono::microseconds(1));
+  }
+
+  // Every field the test looks at carries the sequence number, so a copy
+  // that pushSpot overwrote halfway would not pass isIntact().
+  DxSpot makeSpot(uint32_t sequence) {
+    DxSpot spot = {};
+    snprintf(spot.call, sizeof(spot.call), "S%07lu", (unsigned long)sequence);
+    snprintf(spot.spotter, sizeof(spot.spotter), "R%07lu", (unsigned long)sequence);
+    spot.spotHour = sequence % 24;
+    spot.spotMinute = sequence % 60;
+    spot.band = sequence;
+    spot.dxSunrise = ~sequence;
+    return spot;
+  }
+
+  uint32_t sequenceOf(const DxSpot& spot) {
+    return (uint32_t)spot.band;
+  }
+
+  bool isIntact(const DxSpot& spot) {
+    const DxSpot expected = makeSpot(sequenceOf(spot));
+    return strcmp(spot.call, expected.call) == 0 && strcmp(spot.spotter, expected.spotter) == 0 &&
+           spot.spotHour == expected.spotHour && spot.spotMinute == expected.spotMinute &&
+           spot.dxSunrise == expected.dxSunrise;
+  }
+
+  void drainQueue() {
+    DxSpot spot;
+    while (popSpot(spot)) {}
+  }
+
+  // Fills the ring and then pushes five more from one thread, so the drops
+  // are known exactly.
+  void testDropOldest() {
+    drainQueue();
+    const uint32_t droppedBefore = getDroppedSpotCount();
+
+    for (uint32_t i = 0; i < SPOT_QUEUE_SIZE; i++) CHECK(pushSpot(makeSpot(i)));
+    for (uint32_t i = SPOT_QUEUE_SIZE; i < SPOT_QUEUE_SIZE + 5; i++) CHECK(!pushSpot(makeSpot(i)));
+    CHECK_EQ(getDroppedSpotCount() - droppedBefore, 5);
+
+    DxSpot spot;
+    for (uint32_t i = 5; i < SPOT_QUEUE_SIZE + 5; i++) {
+      CHECK(popSpot(spot));
+      CHECK_EQ(sequenceOf(spot), i);
+      CHECK(isIntact(spot));
+    }
+    CHECK(!popSpot(spot));
+  }
+
+  // The producer waits whenever SPOT_QUEUE_SIZE spots are unread, so nothing
+  // may be dropped and every spot must arrive, in order.
+  void testNoLossWithinCapacity() {
+    drainQueue();
+    const uint32_t droppedBefore = getDroppedSpotCount();
+    std::atomic<uint32_t> consumed(0);
+    uint32_t failedPushes = 0;
+
+    std::thread producer([&]() {
+      for (uint32_t i = 0; i < STRESS_SPOTS; i++) {
+        while (i - consumed.load(std::memory_order_acquire) >= SPOT_QUEUE_SIZE) pause();
+        if (!pushSpot(makeSpot(i))) failedPushes++;
+      }
+    });
+
+    uint32_t expected = 0;
+    uint32_t outOfOrder = 0;
+    uint32_t torn = 0;
+    DxSpot spot;
+    while (expected < STRESS_SPOTS) {
+      if (!popSpot(spot)) {
+        pause();
+        continue;
+      }
+      if (sequenceOf(spot) != expected) outOfOrder++;
+      if (!isIntact(spot)) torn++;
+      expected = sequenceOf(spot) + 1;
+      consumed.store(expected, std::memory_order_release);
+    }
+    producer.join();
+
+    CHECK_EQ(failedPushes, 0);
+    CHECK_EQ(outOfOrder, 0);
+    CHECK_EQ(torn, 0);
+    CHECK_EQ(getDroppedSpotCount() - droppedBefore, 0);
+    CHECK(!popSpot(spot));
+  }
+
+  // The producer pushes with only short breaks against a consumer that keeps
+  // stalling.
+  // Whatever was dropped must be exactly what the consumer never saw.
+  void testDropCountOnOverrun() {
+    drainQueue();
+    const uint32_t droppedBefore = getDroppedSpotCount();
+    std::atomic<bool> producerDone(false);
+    uint32_t failedPushes = 0;
+
+    std::thread producer([&]() {
+      for (uint32_t i = 0; i < STRESS_SPOTS; i++) {
+        if (!pushSpot(makeSpot(i))) failedPushes++;
+        if (i % 256 == 0) pause();
+      }
+      producerDone.store(true, std::memory_order_release);
+    });
+
+    std::vector<uint32_t> received;
+    received.reserve(STRESS_SPOTS);
+    uint32_t torn = 0;
+    DxSpot spot;
+    for (;;) {
+      const bool done = producerDone.load(std::memory_order_acquire);
+      if (popSpot(spot)) {
+        if (!isIntact(spot)) torn++;
+        received.push_back(sequenceOf(spot));
+        if (received.size() % 64 == 0) pause();
+      } else if (done) {
+        break;
+      } else {
+        pause();
+      }
+    }
+    producer.join();
+
+    const uint32_t dropped = getDroppedSpotCount() - droppedBefore;
+    uint32_t outOfOrder = 0;
+    uint32_t missing = received.empty() ? STRESS_SPOTS : received[0];
+    for (size_t i = 1; i < received.size(); i++) {
+      if (received[i] <= received[i - 1]) {
+        outOfOrder++;
+      } else {
+        missing += received[i] - received[i - 1] - 1;
+      }
+    }
+
+    CHECK(dropped > 0); // Otherwise the test did not overrun the ring
+    CHECK_EQ(torn, 0);
+    CHECK_EQ(outOfOrder, 0);
+    CHECK(!received.empty() && received.back() == STRESS_SPOTS - 1); // The newest spot is never dropped
+    CHECK_EQ(failedPushes, dropped);
+    CHECK_EQ(missing, dropped);
+    CHECK_EQ(received.size() + dropped, STRESS_SPOTS);
+    printf("overrun: %lu spots received, %lu dropped\n", (unsigned long)received.size(), (unsigned long)dropped);
+  }
+}
+
+int main() {
+  testDropOldest();
+  testNoLossWithinCapacity();
+  testDropCountOnOverrun();
+  return testResult("spot_queue_test");
+}
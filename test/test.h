@@ -0,0 +1,49 @@
+/*
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+*/
+
+// Minimal check macros shared by the host tests. A failed check is printed
+// and counted; the test keeps going and main() returns testResult().
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+namespace {
+  int checksRun = 0;
+  int checksFailed = 0;
+
+  int testResult(const char* name) {
+    printf("%s: %d checks, %d failed\n", name, checksRun, checksFailed);
+    return checksFailed == 0 ? 0 : 1;
+  }
+}
+
+#define CHECK(condition) \
+  do { \
+    checksRun++; \
+    if (!(condition)) { \
+      checksFailed++; \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    } \
+  } while (0)
+
+#define CHECK_EQ(actual, expected) \
+  do { \
+    checksRun++; \
+    const long long actualValue = (long long)(actual); \
+    const long long expectedValue = (long long)(expected); \
+    if (actualValue != expectedValue) { \
+      checksFailed++; \
+      printf("%s:%d: check failed: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #actual, #expected, \
+             actualValue, expectedValue); \
+    } \
+  } while (0)
+
+#endif
@@ -0,0 +1,77 @@
+#!/bin/sh
+#
+# ESP32 Ham Combo
+# Copyright (c) 2025 Leszek (HF7A)
+# https://github.com/hf7a/ESP32-ham-combo
+#
+# Licensed under CC BY-NC-SA 4.0.
+# Commercial use is prohibited.
+#
+# Runs a local TLS server for the HamQSL and GitHub fetches, to measure the
+# HTTPS client with HTTPS_USE_TEST_SERVER. It serves a solar report at
+# /solarxml.php and a release at the GitHub API path, from a self-signed
+# certificate, with TLS session resumption by ticket and by session ID.
+# Each response closes the connection, so every fetch after the first is a
+# resumed handshake.
+#
+# Usage: tools/https_test_server.sh [port]
+#   NO_TICKETS=1  resume by session ID only
+#   KEY=ec        use a P-256 key instead of RSA 2048
+#
+# Then, in constants.h, set HTTPS_USE_TEST_SERVER to 1 and
+# HTTPS_TEST_SERVER_HOST to this computer's address, and flash. The serial
+# log reports each request:
+#   HTTPS 192.168.1.100: full handshake ... ms, request ... ms, peak heap ... bytes
+#   HTTPS 192.168.1.100: resumed handshake ... ms, request ... ms, peak heap ... bytes
+# The first fetch for each host is a full handshake. The later ones should
+# be resumed; shorten PROPAGATION_UPDATE_INTERVAL_MS to see them sooner.
+# To check the server alone:
+#   openssl s_client -connect localhost:4443 -tls1_2 -reconnect < /dev/null | grep -E "^(New|Reused)"
+
+set -e
+
+PORT=${1:-4443}
+FW_REPO=hf7a/ESP32-ham-combo
+DIR=$(mktemp -d)
+trap 'rm -rf "$DIR"' EXIT INT TERM
+cd "$DIR"
+
+if [ "$KEY" = ec ]; then
+  NEWKEY="-newkey ec -pkeyopt ec_paramgen_curve:prime256v1"
+else
+  NEWKEY="-newkey rsa:2048"
+fi
+openssl req -x509 $NEWKEY -nodes -days 30 -subj /CN=ham-combo-test \
+  -keyout key.pem -out cert.pem 2> /dev/null
+
+cat > solarxml.php <<'EOF'
+<?xml version="1.0" encoding="utf-8"?>
+<solar><solardata>
+<solarflux>168</solarflux><aindex>8</aindex><kindex>2</kindex>
+<xray>C1.4</xray><sunspots>142</sunspots>
+<geomagfield>QUIET</geomagfield><signalnoise>S1-S2</signalnoise>
+<calculatedconditions>
+<band name="80m-40m" time="day">Fair</band>
+<band name="30m-20m" time="day">Good</band>
+<band name="17m-15m" time="day">Good</band>
+<band name="12m-10m" time="day">Fair</band>
+<band name="80m-40m" time="night">Good</band>
+<band name="30m-20m" time="night">Good</band>
+<band name="17m-15m" time="night">Fair</band>
+<band name="12m-10m" time="night">Poor</band>
+</calculatedconditions>
+<calculatedvhfconditions>
+<phenomenon name="vhf-aurora" location="northern_hemi">Band Closed</phenomenon>
+<phenomenon name="E-Skip" location="europe">Band Closed</phenomenon>
+</calculatedvhfconditions>
+</solardata></solar>
+EOF
+
+mkdir -p "repos/$FW_REPO/releases"
+echo '{"tag_name": "v0.0-test"}' > "repos/$FW_REPO/releases/latest"
+
+TICKETS=
+if [ -n "$NO_TICKETS" ]; then TICKETS=-no_ticket; fi
+
+echo "Serving on port $PORT. Stop with Ctrl-C."
+openssl s_server -accept "$PORT" -cert cert.pem -key key.pem -WWW $TICKETS -quiet
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+
+Generates ESP32_ham_combo/glyph_atlas.h, the run-length glyph atlas the
+sketch draws its busy-screen free fonts from, out of the GFX font headers
+that ship with TFT_eSPI (Fonts/GFXFF). Each glyph's bitmap becomes
+alternating background/foreground run lengths, starting with background,
+runs over 255 split by a zero-length run, as in world_map.h.
+
+Every font is stamped with a CRC32 of the glyph bits and sizes the runs were
+made from. At startup the sketch computes the same over the font it is built
+with and leaves a font that differs (another TFT_eSPI version) to the
+library's own drawing, so stale tables never draw wrong glyphs.
+
+Usage:
+  GFXFF=~/Arduino/libraries/TFT_eSPI/Fonts/GFXFF
+  python3 tools/make_glyph_atlas.py $GFXFF/FreeSans9pt7b.h \\
+      $GFXFF/FreeSansBold9pt7b.h $GFXFF/FreeSansBold12pt7b.h \\
+      > ESP32_ham_combo/glyph_atlas.h
+"""
+
+import re
+import sys
+import zlib
+
+
+def parse_font(path):
+    with open(path) as f:
+        # Comments name each glyph, braces and all
+        text = re.sub(r"//[^\n]*", "", f.read())
+
+    font = re.search(r"const\s+GFXfont\s+(\w+)\s*(?:PROGMEM)?\s*=\s*\{(.*?)\}\s*;", text, re.S)
+    if not font:
+        sys.exit("%s: no GFXfont" % path)
+    name = font.group(1)
+    fields = [field.strip() for field in font.group(2).split(",")]
+    first, last = int(fields[2], 0), int(fields[3], 0)
+
+    bitmap = re.search(r"const\s+uint8_t\s+%sBitmaps\[\]\s*(?:PROGMEM)?\s*=\s*\{(.*?)\}\s*;" % name, text, re.S)
+    glyphs = re.search(r"const\s+GFXglyph\s+%sGlyphs\[\]\s*(?:PROGMEM)?\s*=\s*\{(.*)\}\s*;" % name, text, re.S)
+    if not bitmap or not glyphs:
+        sys.exit("%s: no bitmap or glyph table for %s" % (path, name))
+    bitmap = [int(value, 0) for value in bitmap.group(1).replace(",", " ").split()]
+    # bitmapOffset, width, height, xAdvance, xOffset, yOffset
+    glyphs = [[int(value, 0) for value in glyph.split(",")]
+              for glyph in re.findall(r"\{([^{}]*)\}", glyphs.group(1))]
+    if len(glyphs) != last - first + 1:
+        sys.exit("%s: %d glyphs for characters 0x%02X-0x%02X" % (path, len(glyphs), first, last))
+    return name, first, last, bitmap, glyphs
+
+
+def encode_glyph(bitmap, glyph):
+    offset, width, height = glyph[0], glyph[1], glyph[2]
+    pixels = width * height
+    bits = [bool(bitmap[offset + bit // 8] & (0x80 >> (bit % 8))) for bit in range(pixels)]
+    runs = []
+    value = False  # Every glyph starts with a background run
+    bit = 0
+    while bit < pixels:
+        length = 0
+        while bit < pixels and bits[bit] == value and length < 255:
+            bit += 1
+            length += 1
+        runs.append(length)
+        value = not value
+    return runs
+
+
+def font_crc(first, last, bitmap, glyphs):
+    # As glyph_atlas.cpp computes it: first and last character, the bitmap
+    # bytes up to the end of the last glyph, then each glyph's offset and size
+    used = max(glyph[0] + (glyph[1] * glyph[2] + 7) // 8 for glyph in glyphs)
+    crc = zlib.crc32(bytes([first & 0xFF, first >> 8, last & 0xFF, last >> 8]))
+    crc = zlib.crc32(bytes(bitmap[:used]), crc)
+    for glyph in glyphs:
+        crc = zlib.crc32(bytes([glyph[0] & 0xFF, glyph[0] >> 8, glyph[1], glyph[2]]), crc)
+    return crc
+
+
+def print_array(declaration, values, per_line):
+    print("%s PROGMEM = {" % declaration)
+    for i in range(0, len(values), per_line):
+        print("  " + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    print("};")
+    print("")
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    fonts = [parse_font(path) for path in sys.argv[1:]]
+
+    print("/*")
+    print("ESP32 Ham Combo")
+    print("Copyright (c) 2025 Leszek (HF7A)")
+    print("https://github.com/hf7a/ESP32-ham-combo")
+    print("")
+    print("Licensed under CC BY-NC-SA 4.0.")
+    print("Commercial use is prohibited.")
+    print("*/")
+    print("")
+    print("// Generated by tools/make_glyph_atlas.py - do not edit by hand.")
+    print("// Run-length glyph atlas of %s" % ", ".join(font[0] for font in fonts))
+    print("// (alternating background/foreground run lengths per glyph, starting")
+    print("// with background). Included by glyph_atlas.cpp, which defines GlyphAtlas.")
+    print("")
+    print("#ifndef GLYPH_ATLAS_H")
+    print("#define GLYPH_ATLAS_H")
+    print("")
+
+    entries = []
+    for name, first, last, bitmap, glyphs in fonts:
+        runs = []
+        starts = []
+        for glyph in glyphs:
+            starts.append(len(runs))
+            runs += encode_glyph(bitmap, glyph)
+        starts.append(len(runs))
+        print_array("const uint16_t %s_GLYPH_START[%d]" % (name.upper(), len(starts)), starts, 12)
+        print_array("const uint8_t %s_RUNS[%d]" % (name.upper(), len(runs)), runs, 20)
+        entries.append("  { &%s, %s_GLYPH_START, %s_RUNS, 0x%08X },"
+                       % (name, name.upper(), name.upper(), font_crc(first, last, bitmap, glyphs)))
+
+    print("#define GLYPH_ATLAS_COUNT %d" % len(fonts))
+    print("")
+    print("const GlyphAtlas GLYPH_ATLASES[GLYPH_ATLAS_COUNT] = {")
+    for entry in entries:
+        print(entry)
+    print("};")
+    print("")
+    print("#endif // GLYPH_ATLAS_H")
+
+
+if __name__ == "__main__":
+    main()
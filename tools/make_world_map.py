@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+"""
+ESP32 Ham Combo
+Copyright (c) 2025 Leszek (HF7A)
+https://github.com/hf7a/ESP32-ham-combo
+
+Licensed under CC BY-NC-SA 4.0.
+Commercial use is prohibited.
+
+Generates ESP32_ham_combo/world_map.h: an equirectangular land/sea mask,
+run-length encoded per row so the firmware can decode any row on its own.
+
+The outlines below are coarse hand-traced coastlines (lon, lat in degrees).
+Land polygons are painted first, then seas are cut out, then islands that
+sit inside those seas are painted back in.
+
+Usage: python3 tools/make_world_map.py > ESP32_ham_combo/world_map.h
+"""
+
+WIDTH = 320
+HEIGHT = 160
+
+LAND = [
+    # Afro-Eurasia (inland seas are cut out below)
+    [(-6,35.8),(-9.8,31),(-9.8,29.5),(-13,27.7),(-17,21),(-17.2,14.7),(-16.8,12.5),(-15,11),(-13.3,9),
+     (-11.5,7),(-7.5,4.5),(-4,5.2),(1,6),(3,6.4),(6,4.3),(8.5,4.5),(9.5,3.5),(9.5,1),(9,-1),(11.5,-5),
+     (12.2,-6),(13.3,-9),(12,-14),(11.8,-17),(14.5,-22.5),(15.2,-27),(16.5,-28.6),(18.4,-34),(20,-34.8),
+     (25.6,-34),(28,-33),(30.8,-30),(32.5,-28.5),(32.6,-26),(35.5,-24),(35.3,-21.5),(34.7,-19.8),
+     (36.8,-17.8),(40.5,-15.5),(40.5,-11),(39.3,-7.5),(39,-5),(40.5,-2.5),(42,-0.5),(44,1.9),(47.5,4.8),
+     (49,7.5),(51.2,10.5),(51,11.8),(48,11.2),(45,10.4),(43.3,11.5),(43,12.5),(43.5,12.7),(45,13),
+     (48,14),(52,16),(55,17),(57.8,19),(59.8,22.5),(58.5,23.5),(56.5,24.5),(56.3,26.3),(57.3,25.8),
+     (61.5,25.2),(66.5,25.3),(68.5,23.5),(70,21),(72.6,21.5),(73,18),(74.5,14),(76,10),(77.5,8.1),
+     (79.5,9),(80.2,13),(80.2,15.5),(82.5,17),(84,18),(86.5,20),(88,21.7),(90,22),(92,21.5),(94,19),
+     (94.5,16),(97.5,16.5),(98.3,12),(98.5,8),(100.3,4),(101.3,2.8),(103.8,1.3),(104.2,1.5),
+     (103.4,4.5),(102.2,6.2),(100.5,8),(99.5,10),(99.2,12),(100,13.4),(100.9,13),(102,12),(103,11),
+     (104.5,10.5),(105,8.6),(107,10.5),(109.3,12),(108.8,15.5),(106.5,17.5),(105.8,19),(106.5,20),
+     (108.5,21.6),(110,21),(110,20.2),(113,22.2),(116.5,23),(119,25.5),(120.5,27.5),(121.8,30.8),
+     (121,32.5),(120,35),(122.5,37),(119,37.2),(118,39),(121.5,40.8),(122,40),(124.5,39.8),
+     (125.2,37.7),(126.5,37.5),(126.3,34.5),(129.3,35.2),(129.5,37),(128,39),(129.8,41),(131,42.6),
+     (133,42.8),(135,43.5),(138,46.5),(140.5,48.5),(141,52.5),(139,54),(135,54.7),(137.5,56.5),
+     (142,59.3),(148,59.5),(152,59),(155,59.5),(156,61.5),(160,61.5),(156,57.5),(156.5,51),
+     (158.5,52.7),(160,54.2),(162,56),(163,58),(164.5,59.8),(170,60),(174,61.7),(177.5,62.5),
+     (179,63),(180,65),(180,69),(170,70),(160,69.7),(150,71.5),(140,72),(130,71),(120,73),(113,73.5),
+     (104,77.7),(97,76),(87,74.5),(80,73.5),(74,72.5),(70,73),(68,70),(61,69.5),(59,69),(54,68.5),
+     (44,68.5),(41,66.7),(33,69.3),(28,71),(23,70.8),(19,70),(15,68.5),(12.5,66),(10,64.5),(7,63),
+     (5,61.5),(5.5,59),(8,58),(8.6,55.5),(8,53.7),(5,53.3),(4,51.5),(1.5,50.2),(-1.5,48.8),
+     (-4.5,48.3),(-1.2,46),(-1.5,43.5),(-8,43.6),(-8.8,42.5),(-9.5,39),(-9,37),(-6,36.2)],
+    # North America (Hudson Bay is cut out below)
+    [(-82,68.5),(-80,64),(-75,62.5),(-70,61.5),(-65,60.3),(-64,58),(-61.5,56),(-57.5,53),(-55.8,51.5),
+     (-60,48),(-60,46),(-61,45.5),(-66,43.8),(-70,43.8),(-70,41.7),(-74,40.6),(-76,37),(-75.5,35.3),
+     (-78,34),(-81,31.5),(-80,27),(-80.2,25.3),(-81.5,25.5),(-82.5,28),(-84,30),(-89,30.3),(-90,29),
+     (-94,29.7),(-97.3,27.7),(-97.5,25),(-97.5,22),(-97,19),(-94.5,18.2),(-91,18.6),(-90.5,21),
+     (-87,21.5),(-88,18),(-88.5,16),(-84,15.5),(-83.5,11),(-81.5,9),(-79,9.5),(-77.3,8.6),(-77.8,7.3),
+     (-80,7.5),(-80.5,8.3),(-82,8.2),(-84,9.5),(-86,11.5),(-88,13.2),(-92,14.5),(-95,16),(-98,16.5),
+     (-102,18),(-105.5,20.5),(-105.5,23),(-109,25.5),(-112,29),(-114.7,31.7),(-113.2,29),(-110,24),
+     (-111.5,24.5),(-114,27.8),(-115.5,29.5),(-117,32.5),(-120.5,34.5),(-122.5,37.5),(-124,40),
+     (-124.5,43),(-124,46.5),(-124.7,48.4),(-123,49),(-128,51),(-131,54),(-134,57),(-137,58.5),
+     (-140,60),(-146,60.8),(-151,59.5),(-154,57.5),(-158,56),(-162,55),(-165,54.5),(-158,58.5),
+     (-162,60),(-165,61.5),(-166,63.5),(-161,64.5),(-165,64.6),(-168,65.5),(-164,68.5),(-156,71.3),
+     (-141,69.6),(-128,70),(-116,68.5),(-108,68),(-96,67.5),(-90,69)],
+    # South America
+    [(-77,8.7),(-75,11),(-72,12.3),(-68,11),(-64,10.6),(-61,10.5),(-58,7),(-54,5.8),(-51.5,4),(-50,1.5),
+     (-48.5,-1),(-44,-2.5),(-39,-3.5),(-35,-5.5),(-35,-9),(-38.5,-13),(-39,-17.5),(-41,-22),(-44.5,-23.2),
+     (-48.5,-26),(-48.8,-28.5),(-51,-31),(-53,-34),(-57,-36.5),(-57.5,-38),(-62,-39),(-65,-41),
+     (-64,-42.5),(-65.5,-45),(-67.5,-46.5),(-66,-48),(-69,-51),(-68.5,-52.5),(-66,-55),(-71,-55.5),
+     (-74.5,-52),(-75.5,-47),(-74,-44),(-73.5,-41),(-73.5,-37),(-71.5,-32),(-71.3,-28),(-70.5,-23),
+     (-70.2,-18.5),(-72,-17),(-76,-14),(-78.5,-10),(-81,-6),(-81,-4),(-80,-2),(-80.5,0.5),(-79.5,2),
+     (-77.5,4),(-77.3,7)],
+    # Greenland and the Canadian Arctic
+    [(-73,78),(-60,82),(-35,83.5),(-20,82),(-18,77),(-22,72),(-22,70),(-32,68),(-40,65),(-43,60),
+     (-48,61),(-52,64.5),(-54,68),(-55,71),(-58,75.5),(-68,76.5)],
+    [(-90,72),(-80,73.7),(-70,71),(-62,66.5),(-65,62.8),(-72,63),(-78,65),(-82,69)],
+    [(-95,76.5),(-80,76.5),(-70,79),(-62,82),(-80,83),(-95,81)],
+    [(-125,71.5),(-118,74.5),(-100,73.5),(-100,69.5),(-115,69)],
+    [(-97,73),(-80,74.5),(-80,76),(-97,76)],
+    # Chukotka east of the date line
+    [(-180,65),(-180,69),(-175,67.8),(-171.5,66.5),(-170,66),(-173,64.5),(-178,64.9)],
+    # Australia and Oceania
+    [(114,-22),(114.2,-26.3),(115,-30),(115,-34.3),(118,-35),(121,-33.9),(124,-33),(126.2,-32.3),
+     (131.2,-31.5),(134.2,-32.8),(135.8,-34.9),(137.7,-33),(138,-35.6),(140,-38),(143.5,-38.8),
+     (146.4,-39.1),(150,-37.5),(150.8,-34.3),(153.2,-29),(153,-25.3),(151,-23.5),(149.5,-22.3),
+     (146.3,-19),(145.3,-15),(143.6,-14),(142.5,-10.7),(141.6,-12.8),(141.5,-17),(140,-17.7),
+     (136.7,-15.9),(135.5,-14.7),(136.8,-12.2),(132.6,-11.5),(130,-13),(129.5,-15),(127,-14),
+     (125,-14.5),(123.5,-17),(121.5,-19),(118.8,-20.3),(116,-21)],
+    [(144.6,-40.7),(148.3,-40.9),(148.2,-42.2),(146.9,-43.6),(145.2,-42.2)],
+    [(172.7,-34.4),(174.5,-36),(175.9,-37.6),(178.5,-37.7),(177.9,-39.1),(176.8,-40),(175.2,-41.6),
+     (174.5,-39.8),(173.8,-39.2),(174.6,-37.8)],
+    [(172.7,-40.5),(174.3,-41.7),(173,-43.8),(171.2,-44.5),(169,-46.6),(166.5,-46.1),(168.3,-44),
+     (170.9,-42.7),(172.1,-40.9)],
+    [(131,-1.2),(134,-0.8),(137.7,-1.5),(141,-2.6),(145.8,-4.8),(147.7,-6.3),(150.5,-10.5),(147,-10),
+     (144,-7.8),(141,-9.1),(138,-8.3),(137.6,-5.5),(135,-4.3),(132.7,-4),(132,-2.8)],
+    # South-East Asia
+    [(109,1.5),(111,2.8),(113,3.2),(115.5,5.2),(117,7),(119.2,5.2),(118,4.2),(117.7,1),(118.8,1),
+     (116.5,-1.5),(116,-3.8),(114.5,-3.5),(111,-3),(110,-1.7),(109,0)],
+    [(95.3,5.6),(97.5,5.2),(100.3,2.2),(103.5,-1),(106,-3),(105.8,-5.8),(104.5,-5.9),(102.3,-4),
+     (100.3,-0.8),(98.6,1.7),(96.3,3.9)],
+    [(105.2,-6.8),(106,-6),(108.3,-6.3),(111,-6.5),(114.5,-7.7),(114.5,-8.7),(110.5,-8.2),(106.5,-7.4)],
+    [(119.4,-5.5),(119,-3.5),(119.8,0),(120.5,1.2),(124.8,1.6),(122,0.5),(121,-1),(123.3,-1),
+     (121.5,-1.9),(122.3,-4.7),(120.5,-2.5),(120.4,-5.5)],
+    [(119.8,16.3),(120.6,18.5),(122.2,18.5),(122,16.5),(124,13),(121.5,13.8),(120.5,14.5)],
+    [(122,7),(123.5,8.5),(125.5,9.8),(126.5,7.2),(125.5,5.7),(124,6.5)],
+    [(122,10),(123,11.5),(125.7,12.3),(125,10),(123.5,9.5)],
+    [(120.1,23),(121,25.2),(122,25),(120.8,22)],
+    [(108.6,19.2),(110.7,20.1),(111,19.6),(109.6,18.2)],
+    [(79.8,6),(79.8,8.3),(80.2,9.8),(81.9,7.5),(81.6,6.2),(80.3,5.9)],
+    # Japan and Sakhalin
+    [(129.6,33.5),(131,34.3),(132.5,35.5),(136,35.8),(137.4,37.4),(139.5,38.3),(140,40.5),(141.4,41.4),
+     (142,39.5),(141,37),(140.8,35.7),(139.8,35),(138,34.6),(136.8,34.3),(135,33.6),(133,33),
+     (132,31.5),(130.3,31)],
+    [(140,41.5),(140,43.2),(141.8,45.4),(145.3,44.3),(145.5,43.3),(143.3,42),(141,41.8)],
+    [(142,46),(141.8,52),(142.7,54.3),(143.5,50),(144,49),(143,46.6)],
+    # Arctic islands
+    [(52,71),(57,70.6),(56.5,72.7),(68,76.9),(66,77),(58,75.8),(53.5,73.5)],
+    [(11,78.5),(11,79.8),(18,80.5),(27,80.2),(22,78.3),(16,76.5)],
+    [(94,79),(100,81),(105,79.5),(102,78)],
+    # North Atlantic islands
+    [(-24,65.5),(-22,66.4),(-16,66.5),(-13.5,65.2),(-15,64.2),(-18.7,63.4),(-22.7,63.8)],
+    [(-5.7,50),(-3,50.6),(1.4,51.2),(1.7,52.7),(0,53.5),(-1.6,55.6),(-2,57.6),(-3.5,58.6),(-5,58.6),
+     (-6.2,57.5),(-5.6,55.3),(-4.9,54.8),(-3.2,54.8),(-3,53.4),(-4.6,53.3),(-4.2,52.2),(-5.2,51.7),
+     (-3,51.4),(-4.2,51.2)],
+    [(-6,52.2),(-6.2,54),(-5.6,55.2),(-8,55.3),(-10,54.2),(-10.3,52),(-9.5,51.5),(-8,51.7)],
+    [(-59.4,47.6),(-55.6,51.6),(-53,49.5),(-52.7,47.5),(-53.6,46.6),(-56,47.6)],
+    # Caribbean
+    [(-85,21.9),(-81,23.2),(-77.5,21.8),(-74.2,20.2),(-77.5,19.8),(-81,21.6)],
+    [(-74.5,18.5),(-72.5,19.9),(-69.2,19.5),(-68.3,18.5),(-71.5,17.6),(-74.5,18.2)],
+    [(-67.3,18.5),(-65.6,18.4),(-65.6,18),(-67.2,17.9)],
+    # Madagascar
+    [(44,-25),(43.3,-22),(44.4,-16.2),(46.5,-15.7),(49.3,-12),(50.5,-15.5),(47.2,-24.9),(45.2,-25.6)],
+    # Antarctica
+    [(-180,-90),(-180,-78),(-150,-77),(-120,-74),(-100,-73),(-80,-73),(-68,-70),(-57,-63.3),(-60,-64.5),
+     (-62,-67),(-60,-70),(-45,-77),(-30,-76),(-20,-73),(0,-70),(30,-69.5),(60,-67.5),(90,-66.5),
+     (120,-66.5),(150,-68.5),(165,-71),(170,-73),(180,-78),(180,-90)],
+]
+
+SEAS = [
+    # Mediterranean
+    [(-5.4,36.2),(-2,36.7),(0,38.7),(0,39.5),(3,41.8),(3.2,43),(5,43.3),(7,43.6),(9,44.4),(10.5,43),
+     (12.5,41.5),(15.5,40),(16,38),(17,39),(18.5,40.2),(16,41.5),(13.5,43.7),(12.3,45.3),(13.7,45.7),
+     (15,44.5),(17,43),(19.5,41.8),(19.5,40),(21,38),(22.5,36.5),(24,38),(23,40.5),(26,40.8),
+     (26.5,38.5),(28,36.8),(30,36.2),(32,36.2),(34.5,36.8),(36.2,36.7),(35.9,35.5),(35,33),(34.3,31.3),
+     (32.3,31.3),(30,31.3),(25,31.8),(20,32),(19,30.3),(15.5,31.3),(13,32.9),(11,33.3),(10.2,34.5),
+     (11,35.5),(10.3,37),(9,37.2),(5,36.8),(1,36.5),(-2,35.1),(-6,35.9)],
+    # Black Sea
+    [(28,41.5),(29,41.2),(31,41.2),(35,42),(38,41),(41.5,41.5),(41.6,42.5),(40,43.5),(38,44.5),
+     (37,45.3),(35,45),(33.5,44.5),(32.5,45.5),(31,46.6),(30,45.3),(28.7,44.3),(28,43)],
+    # Caspian Sea
+    [(47.5,45.5),(49,46.5),(51.5,47),(53,46.8),(53,45),(51,44.5),(51.3,43),(52.7,42),(53,40.5),
+     (53.8,37.5),(51,36.7),(49,37.5),(49,39),(49.5,40.3),(48,42),(47,43.5)],
+    # Red Sea
+    [(32.5,29.9),(33.5,27),(35.5,24),(37.3,21),(38.5,18),(39.7,15.5),(41.5,13.8),(43.3,12.5),
+     (42.8,14.5),(42.5,16.5),(40.5,19.5),(39,21.5),(37,25),(35,28),(34.9,29.5)],
+    # Persian Gulf
+    [(48,30),(50,29.5),(51.5,27.8),(54,26.7),(56.4,27),(56.3,26.3),(56,25.5),(54,24.2),(51.5,24),
+     (51.5,25.5),(50,26.5),(48.5,28)],
+    # Baltic Sea
+    [(7.5,58),(10.5,59.3),(11.7,58),(12.7,56.5),(14.3,55.5),(16.5,56.8),(18.5,59.5),(17.5,62.5),
+     (21.5,65.5),(25,65.5),(21.5,63),(22,60.5),(30,60),(24,59.3),(24,57.5),(21,57),(21,55.5),
+     (18.5,54.7),(14,54),(10.8,54),(10.5,56),(10.6,57.7),(8.5,57.1)],
+    # Hudson Bay
+    [(-95,58.5),(-94,61),(-88.5,64),(-86.5,66.5),(-82,66.5),(-80,63),(-78,62.5),(-77,60),(-78,56),
+     (-79,54.5),(-80,51.5),(-82,52.5),(-82,55),(-88,56.5),(-93,58)],
+]
+
+ISLANDS = [
+    [(12.4,38),(15.6,38.3),(15.1,36.7),(12.6,37.5)],
+    [(8.4,39),(8.2,41),(9.6,41.2),(9.7,39.2)],
+    [(8.6,41.4),(8.6,43),(9.5,43),(9.5,41.4)],
+    [(23.5,35.3),(26.3,35.3),(26.2,35),(23.5,35.2)],
+    [(32.3,35.1),(34.6,35.7),(34,34.6),(32.5,34.7)],
+]
+
+
+def inside(poly, x, y):
+    result = False
+    j = len(poly) - 1
+    for i in range(len(poly)):
+        xi, yi = poly[i]
+        xj, yj = poly[j]
+        if (yi > y) != (yj > y) and x < (xj - xi) * (y - yi) / (yj - yi) + xi:
+            result = not result
+        j = i
+    return result
+
+
+def rasterize():
+    rows = []
+    for py in range(HEIGHT):
+        lat = 90 - (py + 0.5) * 180 / HEIGHT
+        row = []
+        for px in range(WIDTH):
+            lon = -180 + (px + 0.5) * 360 / WIDTH
+            land = any(inside(p, lon, lat) for p in LAND)
+            if land and any(inside(p, lon, lat) for p in SEAS):
+                land = False
+            if not land and any(inside(p, lon, lat) for p in ISLANDS):
+                land = True
+            row.append(land)
+        rows.append(row)
+    return rows
+
+
+def encode_row(row):
+    # Alternating run lengths, starting with sea. Runs longer than 255 are
+    # split with a zero-length run of the other kind.
+    runs = []
+    current = False
+    length = 0
+    for land in row:
+        if land != current:
+            runs.append(length)
+            current = land
+            length = 0
+        length += 1
+    runs.append(length)
+    out = []
+    for i, run in enumerate(runs):
+        while run > 255:
+            out += [255, 0]
+            run -= 255
+        out.append(run)
+    return out
+
+
+def main():
+    rows = rasterize()
+    data = []
+    offsets = []
+    for row in rows:
+        offsets.append(len(data))
+        data += encode_row(row)
+    offsets.append(len(data))
+
+    print("/*")
+    print("ESP32 Ham Combo")
+    print("Copyright (c) 2025 Leszek (HF7A)")
+    print("https://github.com/hf7a/ESP32-ham-combo")
+    print("")
+    print("Licensed under CC BY-NC-SA 4.0.")
+    print("Commercial use is prohibited.")
+    print("*/")
+    print("")
+    print("// Generated by tools/make_world_map.py - do not edit by hand.")
+    print("// Equirectangular land mask, %dx%d, run-length encoded per row" % (WIDTH, HEIGHT))
+    print("// (alternating sea/land run lengths, starting with sea).")
+    print("")
+    print("#ifndef WORLD_MAP_H")
+    print("#define WORLD_MAP_H")
+    print("")
+    print("#define WORLD_MAP_WIDTH %d" % WIDTH)
+    print("#define WORLD_MAP_HEIGHT %d" % HEIGHT)
+    print("")
+    print("const uint16_t WORLD_MAP_ROW_OFFSETS[WORLD_MAP_HEIGHT + 1] PROGMEM = {")
+    for i in range(0, len(offsets), 12):
+        print("  " + ", ".join(str(v) for v in offsets[i:i + 12]) + ",")
+    print("};")
+    print("")
+    print("const uint8_t WORLD_MAP_RLE[%d] PROGMEM = {" % len(data))
+    for i in range(0, len(data), 20):
+        print("  " + ", ".join(str(v) for v in data[i:i + 20]) + ",")
+    print("};")
+    print("")
+    print("#endif // WORLD_MAP_H")
+
+
+if __name__ == "__main__":
+    main()